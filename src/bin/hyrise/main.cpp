@@ -20,8 +20,11 @@
 #include "helper/HwlocHelper.h"
 #include "helper/Settings.h"
 #include "net/AsyncConnection.h"
+#include "net/ServerLoops.h"
 #include "io/StorageManager.h"
 #include "access/CheckpointDaemon.h"
+#include "access/system/AdmissionControl.h"
+#include "access/system/PlanCache.h"
 #include "taskscheduler/SharedScheduler.h"
 
 namespace po = boost::program_options;
@@ -62,6 +65,7 @@ class InfoFile {
 
 int main(int argc, char* argv[]) {
   size_t port = 0;
+  size_t binary_port = 0;
   int worker_threads = 0;
   std::string logPropertyFile;
   std::string scheduler_name;
@@ -70,12 +74,19 @@ int main(int argc, char* argv[]) {
   size_t checkpoint_interval = 0;
   bool recover = 0;
   bool recoverAndExit = 0;
+  size_t recovery_threads = 1;
   size_t commit_window_ms = 0;
+  size_t plan_cache_size = 0;
+  size_t network_threads = 1;
+  std::string workload_classes;
 
   // Program Options
   po::options_description desc("Allowed Parameters");
   desc.add_options()("help", "Shows this help message")(
       "port,p", po::value<size_t>(&port)->default_value(DEFAULT_PORT), "Server Port")(
+      "binaryPort",
+      po::value<size_t>(&binary_port)->default_value(0),
+      "Port of the binary query protocol, 0 disables it")(
       "logdef,l",
       po::value<std::string>(&logPropertyFile)->default_value("build/log.properties"),
       "Log4CXX Log Properties File")(
@@ -93,9 +104,22 @@ int main(int argc, char* argv[]) {
           "recoverAndExit,x",
           po::value<bool>(&recoverAndExit)->zero_tokens(),
           "Recover tables on load and exit (for benchmarking purposes)")(
+          "recoveryThreads",
+          po::value<size_t>(&recovery_threads)->default_value(getNumberOfCoresOnSystem()),
+          "Number of threads replaying the log during recovery")(
           "nodes",
           po::value<std::string>(&numa_nodes_str)->default_value(""),
-          "comma-separated list of NUMA-nodes to use (e.g., 0,2) - defaults to all - CURRENTLY UNUSED")
+          "comma-separated list of NUMA-nodes to use (e.g., 0,2) - defaults to all - CURRENTLY UNUSED")(
+          "planCacheSize",
+          po::value<size_t>(&plan_cache_size)->default_value(access::PlanCache::kDefaultCapacity),
+          "Number of transformed query plans kept for repeated queries, 0 disables the plan cache")(
+          "networkThreads",
+          po::value<size_t>(&network_threads)->default_value(1),
+          "Number of event loops accepting and answering HTTP connections")(
+          "workloadClasses",
+          po::value<std::string>(&workload_classes)->default_value(""),
+          "Comma-separated workload classes of the form name:share[:limit] with the share of the worker threads "
+          "reserved for the class and its maximum number of concurrent queries, no classes disable admission control")
 #ifdef PERSISTENCY_BUFFEREDLOGGER
       ("checkpointInterval,c",
        po::value<size_t>(&checkpoint_interval)->default_value(0),
@@ -142,10 +166,12 @@ int main(int argc, char* argv[]) {
 
   // Bind the program to the first NUMA node for schedulers that have core bound threads
   // set number of threads to core-count -1
+  bool core_bound = false;
   if ((scheduler_name == "CoreBoundQueuesScheduler") || (scheduler_name == "WSCoreBoundQueuesScheduler") ||
       (scheduler_name == "WSCoreBoundPriorityQueuesScheduler") ||
       (scheduler_name == "CoreBoundPriorityQueuesScheduler")) {
     bindCurrentThreadToCore(0);
+    core_bound = true;
     if (worker_threads == -1)
       worker_threads = getNumberOfCoresOnSystem() - 1;
   }
@@ -162,6 +188,15 @@ int main(int argc, char* argv[]) {
   Settings::getInstance()->numa_nodes = numa_nodes;
   Settings::getInstance()->numa_cores = numa_cores;
   Settings::getInstance()->commit_window_ms = commit_window_ms;
+  Settings::getInstance()->plan_cache_size = plan_cache_size;
+  Settings::getInstance()->network_threads = network_threads;
+  try {
+    Settings::getInstance()->workload_classes = access::AdmissionControl::parseClasses(workload_classes);
+  }
+  catch (const std::runtime_error& e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
   Settings::getInstance()->printInfo();
 
 
@@ -170,7 +205,7 @@ int main(int argc, char* argv[]) {
     struct timeval start = {0, 0}, end = {0, 0};
     std::cout << "Recovering tables..." << std::endl;
     gettimeofday(&start, nullptr);
-    io::StorageManager::getInstance()->recoverTables();
+    io::StorageManager::getInstance()->recoverTables(recovery_threads);
     gettimeofday(&end, nullptr);
     auto recoveryTime = (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_usec - start.tv_usec);
     std::cout << "Done. Recovery time was " << recoveryTime << std::endl;
@@ -195,27 +230,27 @@ int main(int argc, char* argv[]) {
 
   taskscheduler::SharedScheduler::getInstance().init(scheduler_name, worker_threads, maxTaskSize);
 
-  // Main Server Loop
-  struct ev_loop* loop = ev_default_loop(0);
-  ebb_server server;
-  // Initialize server based on libev event loop
-  ebb_server_init(&server, loop);
+  // Server loops, with core bound schedulers each loop runs on the core of a worker queue
+  net::ServerLoops loops(network_threads, core_bound);
 
-
-  // Define handler for ebb
-  server.new_connection = net::new_connection;
-
-  if (ebb_server_listen_on_port(&server, port) == -1) {
+  if (loops.listen(port) == -1) {
     std::cout << "Failed to start server" << std::endl;
     return EXIT_FAILURE;
   }
 
-  InfoFile port_file(PORT_FILE, server.port);
+  if (binary_port > 0) {
+    if (loops.listenBinary(binary_port) == -1) {
+      std::cout << "Failed to listen on binary port " << binary_port << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::cout << "Started binary protocol on port " << binary_port << std::endl;
+  }
+
+  InfoFile port_file(PORT_FILE, port);
   InfoFile pid_file(PID_FILE, getpid());
 
-  std::cout << "Started server on port " << server.port << std::endl;
-  ev_loop(loop, 0);
+  std::cout << "Started server on port " << port << " with " << loops.size() << " network threads" << std::endl;
+  loops.run();
   LOG4CXX_INFO(logger, "Stopping Server...");
-  ev_default_destroy();
   return EXIT_SUCCESS;
 }
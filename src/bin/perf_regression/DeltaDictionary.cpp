@@ -0,0 +1,75 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include <gtest/gtest-bench.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "storage/ConcurrentUnorderedDictionary.h"
+
+namespace hyrise {
+namespace storage {
+
+class DeltaDictionaryTest : public ::testing::TestWithParam<std::size_t> {
+ public:
+  static const std::size_t values_per_thread = 200000;
+  std::vector<std::vector<hyrise_string_t>> values;
+
+  void SetUp() {
+    // mostly new distinct strings, every tenth value is shared by all threads
+    values.resize(GetParam());
+    for (std::size_t t = 0; t < values.size(); ++t) {
+      values[t].reserve(values_per_thread);
+      for (std::size_t i = 0; i < values_per_thread; ++i) {
+        auto owner = (i % 10 == 0) ? 0 : t;
+        values[t].push_back("customer_" + std::to_string(owner) + "_" + std::to_string(i));
+      }
+    }
+  }
+
+  template <typename F>
+  void run(const std::string& mode, F insert) {
+    ConcurrentUnorderedDictionary<hyrise_string_t> dict;
+    std::vector<std::thread> threads;
+
+    auto before = std::chrono::high_resolution_clock::now();
+    for (std::size_t t = 0; t < values.size(); ++t) {
+      threads.emplace_back([&, t]() { insert(dict, values[t]); });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    auto after = std::chrono::high_resolution_clock::now();
+
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(after - before).count();
+    this->RecordProperty("threads", values.size());
+    this->RecordProperty("mode", mode.c_str());
+    this->RecordProperty("distinct values", dict.size());
+    this->RecordProperty("inserts/ms", values.size() * values_per_thread * 1000 / (us + 1));
+  }
+};
+
+TEST_P(DeltaDictionaryTest, concurrent_add_value) {
+  run("single", [](ConcurrentUnorderedDictionary<hyrise_string_t>& dict, const std::vector<hyrise_string_t>& values) {
+    for (const auto& value : values) {
+      dict.addValue(value);
+    }
+  });
+}
+
+TEST_P(DeltaDictionaryTest, concurrent_add_values) {
+  run("batched", [](ConcurrentUnorderedDictionary<hyrise_string_t>& dict, const std::vector<hyrise_string_t>& values) {
+    const std::size_t batch_size = 1000;
+    for (auto it = values.begin(); it < values.end(); it += batch_size) {
+      dict.addValues(std::vector<hyrise_string_t>(it, std::min(it + batch_size, values.end())));
+    }
+  });
+}
+
+INSTANTIATE_TEST_CASE_P(DeltaDictionaryTestInst,
+                        DeltaDictionaryTest,
+                        ::testing::ValuesIn(std::vector<std::size_t>{1, 2, 4, 8, 16, 32}));
+}
+}
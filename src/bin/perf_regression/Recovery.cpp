@@ -0,0 +1,80 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include <gtest/gtest-bench.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "io/BufferedLogger.h"
+#include "io/StorageManager.h"
+#include "io/TransactionManager.h"
+#include "io/shortcuts.h"
+#include "access/InsertScan.h"
+#include "access/tx/Commit.h"
+#include "storage/Store.h"
+
+namespace hyrise {
+namespace access {
+
+#ifdef PERSISTENCY_BUFFEREDLOGGER
+
+class RecoveryTest : public ::testing::TestWithParam<std::size_t> {
+ public:
+  const std::string tableName = "RECOVERY_BENCHMARK";
+  storage::atable_ptr_t data;
+
+  void SetUp() {
+    io::BufferedLogger::getInstance().truncate();
+
+    data = io::Loader::shortcuts::load("test/test10k_12.tbl");
+    auto tbl = io::Loader::shortcuts::load("test/test10k_12.tbl");
+    tbl->setName(tableName);
+    io::StorageManager::getInstance()->add(tableName, tbl);
+    io::StorageManager::getInstance()->persistTable(tableName);
+
+    // fill the log with committed inserts
+    for (std::size_t i = 0; i < 100; ++i) {
+      auto ctx = tx::TransactionManager::getInstance().buildContext();
+      InsertScan is;
+      is.setEvent("NO_PAPI");
+      is.setTXContext(ctx);
+      is.addInput(tbl);
+      is.setInputData(data);
+      is.execute();
+
+      Commit c;
+      c.setEvent("NO_PAPI");
+      c.setTXContext(ctx);
+      c.addInput(tbl);
+      c.execute();
+    }
+    io::BufferedLogger::getInstance().flush();
+  }
+
+  void TearDown() { io::StorageManager::getInstance()->removeTable(tableName); }
+};
+
+TEST_P(RecoveryTest, log_replay) {
+  auto threads = GetParam();
+
+  // replay into an empty table of the same layout
+  io::StorageManager::getInstance()->removeTable(tableName);
+  storage::atable_ptr_t restored(new storage::Store(data->copy_structure_modifiable()));
+  io::StorageManager::getInstance()->add(tableName, restored);
+
+  auto before = std::chrono::high_resolution_clock::now();
+  auto bytes = io::BufferedLogger::getInstance().restore(threads);
+  auto after = std::chrono::high_resolution_clock::now();
+
+  auto us = std::chrono::duration_cast<std::chrono::microseconds>(after - before).count();
+  this->RecordProperty("threads", threads);
+  this->RecordProperty("log bytes", bytes);
+  this->RecordProperty("GB/s", std::to_string(bytes / 1e3 / us).c_str());
+}
+
+INSTANTIATE_TEST_CASE_P(RecoveryTestInst, RecoveryTest, ::testing::ValuesIn(std::vector<std::size_t>{1, 2, 4, 8, 16}));
+
+#endif
+}
+}
@@ -0,0 +1,42 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <stdexcept>
+
+#include "helper/MemoryPolicy.h"
+
+namespace hyrise {
+namespace helper {
+
+TEST(MemoryPolicyTest, parse_and_print) {
+  EXPECT_TRUE(MemoryPolicy::parse("default").isDefault());
+  EXPECT_TRUE(MemoryPolicy::parse("").isDefault());
+  EXPECT_EQ("default", MemoryPolicy().toString());
+
+  auto policy = MemoryPolicy::parse("node:1,hugetlb");
+  EXPECT_EQ(MemoryPolicy::NodePlacement, policy.placement);
+  EXPECT_EQ(1u, policy.node);
+  EXPECT_EQ(MemoryPolicy::ExplicitHugePages, policy.pages);
+  EXPECT_EQ("node:1,hugetlb", policy.toString());
+
+  EXPECT_EQ("thp", MemoryPolicy::parse("thp").toString());
+  auto interleaved = MemoryPolicy::parse("interleaved,thp");
+  EXPECT_EQ(interleaved, MemoryPolicy::parse(interleaved.toString()));
+  EXPECT_THROW(MemoryPolicy::parse("remote"), std::runtime_error);
+}
+
+TEST(MemoryPolicyTest, allocations_are_zeroed) {
+  for (const auto& name : {"default", "local,thp", "interleaved,hugetlb"}) {
+    auto policy = MemoryPolicy::parse(name);
+    for (size_t bytes : {size_t(100), kMemoryPolicyMinimumBytes + 100}) {
+      auto data = static_cast<char*>(policy.allocate(bytes));
+      EXPECT_EQ(0, data[0]);
+      EXPECT_EQ(0, data[bytes - 1]);
+      std::memset(data, 1, bytes);
+      policy.deallocate(data, bytes);
+    }
+  }
+}
+}
+}  // namespace hyrise::helper
@@ -0,0 +1,68 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "helper/QueryArena.h"
+
+namespace hyrise {
+namespace helper {
+
+TEST(QueryArenaTest, allocations_are_aligned_and_accounted) {
+  QueryArena arena(1024);
+  size_t before = QueryArena::threadAllocatedBytes();
+
+  auto region = arena.createRegion();
+  auto first = region->allocate(3, 1);
+  auto second = region->allocate(8, 8);
+  auto large = region->allocate(4096, 64);
+
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(second) % 8);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(large) % 64);
+  EXPECT_LT(static_cast<char*>(first), static_cast<char*>(second));
+  EXPECT_EQ(3u + 8u + 4096u, arena.allocatedBytes());
+  EXPECT_EQ(3u + 8u + 4096u, QueryArena::threadAllocatedBytes() - before);
+  EXPECT_GE(arena.reservedBytes(), 1024u + 4096u);
+}
+
+TEST(QueryArenaTest, containers_allocate_from_the_arena) {
+  auto arena = std::make_shared<QueryArena>();
+  typedef ArenaAllocator<std::pair<const int, int>> allocator_t;
+  std::unordered_multimap<int, int, std::hash<int>, std::equal_to<int>, allocator_t> map((allocator_t(arena)));
+
+  for (int i = 0; i < 1000; ++i) {
+    map.insert(std::make_pair(i % 10, i));
+  }
+
+  EXPECT_EQ(100u, map.count(3));
+  EXPECT_GT(arena->allocatedBytes(), 1000 * sizeof(std::pair<const int, int>));
+}
+
+TEST(QueryArenaTest, regions_bump_through_blocks_of_their_own) {
+  QueryArena arena(1024);
+  auto first = arena.createRegion();
+  auto second = arena.createRegion();
+
+  auto a = static_cast<char*>(first->allocate(8, 8));
+  auto b = static_cast<char*>(second->allocate(8, 8));
+  auto c = static_cast<char*>(first->allocate(8, 8));
+
+  // the second region did not take memory from the block of the first one
+  EXPECT_EQ(a + 8, c);
+  EXPECT_NE(a + 8, b);
+  EXPECT_EQ(16u, first->allocatedBytes());
+  EXPECT_EQ(8u, second->allocatedBytes());
+  EXPECT_EQ(24u, arena.allocatedBytes());
+  EXPECT_EQ(2048u, arena.reservedBytes());
+}
+
+TEST(QueryArenaTest, allocator_without_arena_uses_the_heap) {
+  std::vector<int, ArenaAllocator<int>> values;
+  size_t before = QueryArena::threadAllocatedBytes();
+  values.assign(100, 1);
+  EXPECT_EQ(before, QueryArena::threadAllocatedBytes());
+}
+}
+}  // namespace hyrise::helper
@@ -0,0 +1,114 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/system/AdmissionControl.h"
+#include "testing/test.h"
+
+namespace hyrise {
+namespace access {
+
+class AdmissionControlTests : public AccessTest {};
+
+namespace {
+// Records the tickets of resumed queries in the order they are admitted
+struct Resumed {
+  std::vector<std::string> order;
+  std::vector<AdmissionControl::ticket_ptr_t> tickets;
+
+  AdmissionControl::resume_t as(const std::string& query) {
+    return [this, query](const AdmissionControl::ticket_ptr_t& ticket) {
+      order.push_back(query);
+      tickets.push_back(ticket);
+    };
+  }
+};
+}
+
+TEST_F(AdmissionControlTests, parse_classes) {
+  auto classes = AdmissionControl::parseClasses("oltp:0.5,olap:0.25:2");
+  ASSERT_EQ(2u, classes.size());
+  EXPECT_EQ("oltp", classes[0].name);
+  EXPECT_DOUBLE_EQ(0.5, classes[0].reserved_share);
+  EXPECT_EQ(0u, classes[0].max_concurrency);
+  EXPECT_EQ("olap", classes[1].name);
+  EXPECT_EQ(2u, classes[1].max_concurrency);
+
+  EXPECT_TRUE(AdmissionControl::parseClasses("").empty());
+  EXPECT_THROW(AdmissionControl::parseClasses("oltp"), std::runtime_error);
+  EXPECT_THROW(AdmissionControl::parseClasses("oltp:half"), std::runtime_error);
+  EXPECT_THROW(AdmissionControl(4, AdmissionControl::parseClasses("a:0.75,b:0.5")), std::runtime_error);
+}
+
+TEST_F(AdmissionControlTests, disabled_without_classes) {
+  AdmissionControl control(1, {});
+  Resumed resumed;
+  auto first = control.admit("olap", 0, resumed.as("first"));
+  auto second = control.admit(AdmissionControl::kDefaultClass, 0, resumed.as("second"));
+  ASSERT_NE(nullptr, first);
+  ASSERT_NE(nullptr, second);
+  EXPECT_EQ(AdmissionControl::kDefaultClass, first->workloadClass());
+
+  auto metrics = control.metrics();
+  ASSERT_EQ(1u, metrics.size());
+  EXPECT_EQ(2u, metrics[0].running);
+  first.reset();
+  second.reset();
+  EXPECT_EQ(2u, control.metrics()[0].completed);
+}
+
+TEST_F(AdmissionControlTests, reserved_workers_are_kept_free) {
+  // two of four workers are reserved for oltp, olap may use the other two
+  AdmissionControl control(4, AdmissionControl::parseClasses("oltp:0.5,olap:0"));
+  Resumed resumed;
+  auto report_1 = control.admit("olap", 0, resumed.as("report_1"));
+  auto report_2 = control.admit("olap", 0, resumed.as("report_2"));
+  auto report_3 = control.admit("olap", 0, resumed.as("report_3"));
+  ASSERT_NE(nullptr, report_1);
+  ASSERT_NE(nullptr, report_2);
+  EXPECT_EQ(nullptr, report_3);
+
+  auto transaction_1 = control.admit("oltp", 0, resumed.as("transaction_1"));
+  auto transaction_2 = control.admit("oltp", 0, resumed.as("transaction_2"));
+  EXPECT_NE(nullptr, transaction_1);
+  EXPECT_NE(nullptr, transaction_2);
+  EXPECT_EQ(nullptr, control.admit("oltp", 0, resumed.as("transaction_3")));
+
+  // the finished transaction frees a reserved worker for the waiting one
+  transaction_1.reset();
+  ASSERT_EQ(std::vector<std::string>({"transaction_3"}), resumed.order);
+  EXPECT_EQ("oltp", resumed.tickets[0]->workloadClass());
+
+  report_1.reset();
+  EXPECT_EQ(std::vector<std::string>({"transaction_3", "report_3"}), resumed.order);
+}
+
+TEST_F(AdmissionControlTests, concurrency_limit_queues_in_order) {
+  AdmissionControl control(8, AdmissionControl::parseClasses("olap:0:1"));
+  Resumed resumed;
+  auto running = control.admit("olap", 0, resumed.as("running"));
+  ASSERT_NE(nullptr, running);
+  EXPECT_EQ(nullptr, control.admit("olap", 0, resumed.as("first")));
+  EXPECT_EQ(nullptr, control.admit("olap", 0, resumed.as("second")));
+
+  // other classes are not affected by the limit
+  EXPECT_NE(nullptr, control.admit(AdmissionControl::kDefaultClass, 0, resumed.as("default")));
+
+  auto metrics = control.metrics();
+  EXPECT_EQ("olap", metrics[0].name);
+  EXPECT_EQ(1u, metrics[0].running);
+  EXPECT_EQ(2u, metrics[0].queued);
+
+  running.reset();
+  ASSERT_EQ(std::vector<std::string>({"first"}), resumed.order);
+  // releasing the ticket of the first query admits the second one
+  std::vector<AdmissionControl::ticket_ptr_t> finished;
+  finished.swap(resumed.tickets);
+  finished.clear();
+  EXPECT_EQ(std::vector<std::string>({"first", "second"}), resumed.order);
+
+  metrics = control.metrics();
+  EXPECT_EQ(3u, metrics[0].admitted);
+  EXPECT_EQ(2u, metrics[0].completed);
+  EXPECT_EQ(0u, metrics[0].queued);
+  EXPECT_LE(metrics[0].p50_latency_ms, metrics[0].max_latency_ms);
+}
+}
+}
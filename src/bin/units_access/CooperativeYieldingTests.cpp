@@ -0,0 +1,111 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/GroupByScan.h"
+#include "access/HashBuild.h"
+#include "access/SimpleTableScan.h"
+#include "access/TableScan.h"
+#include "access/expressions/predicates.h"
+#include "io/shortcuts.h"
+#include "taskscheduler/PriorityQueueType.h"
+#include "testing/test.h"
+
+namespace hyrise {
+namespace access {
+
+class CooperativeYieldingTests : public AccessTest {
+ protected:
+  // company_id repeats every 1000 rows, the table spans several morsels
+  storage::atable_ptr_t largeTable() {
+    auto companies = io::Loader::shortcuts::load("test/tables/companies.tbl");
+    const size_t rows = 3 * PlanOperation::kMorselSize + 100;
+    auto table = companies->copy_structure_modifiable(nullptr, rows);
+    table->resize(rows);
+    for (size_t row = 0; row < rows; ++row) {
+      table->setValue<hyrise_int_t>(0, row, row % 1000);
+      table->setValue<hyrise_string_t>(1, row, "company");
+    }
+    return table;
+  }
+
+  // Runs the operation like a scheduler would while a high priority task
+  // waits, so it yields after every morsel. Returns how often it yielded.
+  size_t executePreempted(PlanOperation& op) {
+    taskscheduler::PriorityQueueType queue;
+    auto urgent = std::make_shared<taskscheduler::WaitTask>();
+    urgent->setPriority(taskscheduler::Task::HIGH_PRIORITY);
+    queue.push(urgent);
+
+    size_t yields = 0;
+    while (!op.runPreemptible(taskscheduler::waitingHighPriorityTasks(queue)))
+      ++yields;
+
+    std::shared_ptr<taskscheduler::Task> popped;
+    queue.try_pop(popped);
+    return yields;
+  }
+};
+
+TEST_F(CooperativeYieldingTests, table_scan_resumes_after_yield) {
+  auto table = largeTable();
+
+  TableScan reference(std::unique_ptr<EqualsExpression<hyrise_int_t>>(new EqualsExpression<hyrise_int_t>(0, 0, 7)));
+  reference.addInput(table);
+  reference.execute();
+
+  TableScan preempted(std::unique_ptr<EqualsExpression<hyrise_int_t>>(new EqualsExpression<hyrise_int_t>(0, 0, 7)));
+  preempted.addInput(table);
+  EXPECT_EQ(3u, executePreempted(preempted));
+
+  ASSERT_EQ(reference.getResultTable()->size(), preempted.getResultTable()->size());
+  ASSERT_TABLE_EQUAL(reference.getResultTable(), preempted.getResultTable());
+}
+
+TEST_F(CooperativeYieldingTests, simple_table_scan_resumes_after_yield) {
+  auto table = largeTable();
+
+  for (bool positions : {true, false}) {
+    SimpleTableScan reference;
+    reference.addInput(table);
+    reference.setPredicate(new EqualsExpression<hyrise_int_t>(0, 0, 7));
+    reference.setProducesPositions(positions);
+    reference.execute();
+
+    SimpleTableScan preempted;
+    preempted.addInput(table);
+    preempted.setPredicate(new EqualsExpression<hyrise_int_t>(0, 0, 7));
+    preempted.setProducesPositions(positions);
+    EXPECT_EQ(3u, executePreempted(preempted));
+
+    ASSERT_EQ(reference.getResultTable()->size(), preempted.getResultTable()->size());
+    ASSERT_TABLE_EQUAL(reference.getResultTable(), preempted.getResultTable());
+  }
+}
+
+TEST_F(CooperativeYieldingTests, group_by_scan_resumes_after_yield) {
+  auto table = largeTable();
+
+  HashBuild hb;
+  hb.addInput(table);
+  hb.addField(0);
+  hb.setKey("groupby");
+  hb.execute();
+  const auto& hash = hb.getResultHashTable();
+
+  GroupByScan reference;
+  reference.addInput(table);
+  reference.addInput(hash);
+  reference.addField(0);
+  reference.addFunction(new CountAggregateFun(1));
+  reference.execute();
+
+  GroupByScan preempted;
+  preempted.addInput(table);
+  preempted.addInput(hash);
+  preempted.addField(0);
+  preempted.addFunction(new CountAggregateFun(1));
+  EXPECT_LT(0u, executePreempted(preempted));
+
+  ASSERT_EQ(1000u, preempted.getResultTable()->size());
+  ASSERT_TABLE_EQUAL(reference.getResultTable(), preempted.getResultTable());
+}
+}
+}
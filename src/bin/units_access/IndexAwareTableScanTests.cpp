@@ -9,6 +9,8 @@
 #include "helper/checked_cast.h"
 #include "access/InsertScan.h"
 #include "storage/Store.h"
+#include "storage/DeltaIndex.h"
+#include "io/StorageManager.h"
 #include "io/TransactionManager.h"
 #include "access/expressions/pred_LessThanExpression.h"
 #include "access/expressions/pred_CompoundExpression.h"
@@ -103,5 +105,22 @@ TEST_F(IndexAwareTableScanTests, basic_index_aware_table_scan_test_intersect) {
   EXPECT_RELATION_EQ(result, reference);
 }
 
+TEST_F(IndexAwareTableScanTests, batched_insert_fills_delta_indices) {
+  auto sm = io::StorageManager::getInstance();
+  auto col_0 = std::dynamic_pointer_cast<storage::DeltaIndex<hyrise_int_t>>(
+      sm->getInvertedIndex("mcidx__foo__delta__col_0"));
+  auto col_1 = std::dynamic_pointer_cast<storage::DeltaIndex<hyrise_float_t>>(
+      sm->getInvertedIndex("mcidx__foo__delta__col_1"));
+  auto store = checked_pointer_cast<storage::Store>(t);
+  auto main_size = store->getMainTable()->size();
+
+  // all three rows of the insert are indexed, with their positions in the store
+  ASSERT_EQ(3u, col_0->size());
+  ASSERT_EQ(3u, col_1->size());
+  ASSERT_EQ(1u, col_0->getPositionsForKey(200).size());
+  ASSERT_EQ(main_size + 1, *col_0->getPositionsForKey(200).cbegin());
+  ASSERT_EQ(2u, col_1->getPositionsForKey(456).size());
+}
+
 }  // namespace access
 }  // namespace hyrise
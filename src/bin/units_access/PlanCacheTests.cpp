@@ -0,0 +1,72 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/system/PlanCache.h"
+#include "io/shortcuts.h"
+#include "io/StorageManager.h"
+#include "testing/test.h"
+
+namespace hyrise {
+namespace access {
+
+class PlanCacheTests : public AccessTest {};
+
+namespace {
+Json::Value plan(const std::string& table) {
+  Json::Value result;
+  result["operators"]["0"]["type"] = "GetTable";
+  result["operators"]["0"]["name"] = table;
+  return result;
+}
+}
+
+TEST_F(PlanCacheTests, evicts_least_recently_used) {
+  PlanCache cache(2);
+  cache.put("a", plan("a"));
+  cache.put("b", plan("b"));
+  ASSERT_NE(nullptr, cache.get("a"));
+  cache.put("c", plan("c"));
+
+  EXPECT_EQ(2u, cache.size());
+  EXPECT_NE(nullptr, cache.get("a"));
+  EXPECT_EQ(nullptr, cache.get("b"));
+  EXPECT_EQ("c", (*cache.get("c"))["operators"]["0"]["name"].asString());
+  EXPECT_EQ(3u, cache.hits());
+  EXPECT_EQ(1u, cache.misses());
+}
+
+TEST_F(PlanCacheTests, zero_capacity_disables_cache) {
+  PlanCache cache(0);
+  cache.put("a", plan("a"));
+  EXPECT_EQ(nullptr, cache.get("a"));
+}
+
+TEST_F(PlanCacheTests, table_changes_invalidate_plans) {
+  auto sm = io::StorageManager::getInstance();
+  PlanCache cache;
+  cache.put("a", plan("myTable"));
+
+  sm->loadTable("myTable", io::Loader::shortcuts::load("test/lin_xxs.tbl"));
+  EXPECT_EQ(nullptr, cache.get("a"));
+
+  cache.put("a", plan("myTable"));
+  sm->removeTable("myTable");
+  EXPECT_EQ(nullptr, cache.get("a"));
+}
+
+TEST_F(PlanCacheTests, binds_parameters) {
+  Json::Value placeholder;
+  placeholder["parameter"] = "table";
+  auto cached = plan("");
+  cached["operators"]["0"]["name"] = placeholder;
+  cached["operators"]["1"]["values"].append(placeholder);
+
+  Json::Value parameters;
+  parameters["table"] = "lin_xxs";
+  auto bound = PlanCache::bindParameters(cached, parameters);
+
+  EXPECT_EQ("lin_xxs", bound["operators"]["0"]["name"].asString());
+  EXPECT_EQ("lin_xxs", bound["operators"]["1"]["values"][0u].asString());
+  EXPECT_TRUE(cached["operators"]["0"]["name"].isObject());
+  EXPECT_THROW(PlanCache::bindParameters(cached, Json::Value()), std::runtime_error);
+}
+}
+}
@@ -0,0 +1,68 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/system/ResultBatch.h"
+#include "io/shortcuts.h"
+#include "storage/AbstractTable.h"
+#include "testing/test.h"
+
+#include <endian.h>
+
+#include <cstring>
+
+namespace hyrise {
+namespace access {
+
+class ResultBatchTests : public AccessTest {};
+
+namespace {
+// Reads the little endian integer of type T at position and advances it
+template <typename T>
+T read(const std::string& batch, size_t& position) {
+  T value;
+  memcpy(&value, batch.data() + position, sizeof(T));
+  position += sizeof(T);
+  return value;
+}
+
+std::string readString(const std::string& batch, size_t& position) {
+  uint32_t length = le32toh(read<uint32_t>(batch, position));
+  position += length;
+  return batch.substr(position - length, length);
+}
+}
+
+TEST_F(ResultBatchTests, encodes_columns) {
+  auto t = io::Loader::shortcuts::load("test/alltypes.tbl");
+  std::string batch = generateResultBatch("{}", t, 2, 1);
+
+  size_t position = 0;
+  EXPECT_EQ("{}", readString(batch, position));
+  ASSERT_EQ(3u, le32toh(read<uint32_t>(batch, position)));
+  ASSERT_EQ(2u, le64toh(read<uint64_t>(batch, position)));
+
+  EXPECT_EQ(IntegerType, read<uint8_t>(batch, position));
+  EXPECT_EQ("col_int", readString(batch, position));
+  EXPECT_EQ(StringType, read<uint8_t>(batch, position));
+  EXPECT_EQ("col_string", readString(batch, position));
+  EXPECT_EQ(FloatType, read<uint8_t>(batch, position));
+  EXPECT_EQ("col_float", readString(batch, position));
+
+  for (size_t row = 1; row < 3; ++row)
+    EXPECT_EQ(t->getValue<hyrise_int_t>(0, row), (int64_t)le64toh(read<uint64_t>(batch, position)));
+  for (size_t row = 1; row < 3; ++row)
+    EXPECT_EQ(t->getValue<hyrise_string_t>(1, row), readString(batch, position));
+  for (size_t row = 1; row < 3; ++row)
+    EXPECT_FLOAT_EQ(t->getValue<hyrise_float_t>(2, row), read<float>(batch, position));
+  EXPECT_EQ(batch.size(), position);
+}
+
+TEST_F(ResultBatchTests, encodes_missing_table_as_empty_batch) {
+  std::string batch = generateResultBatch("{}", nullptr);
+
+  size_t position = 0;
+  EXPECT_EQ("{}", readString(batch, position));
+  EXPECT_EQ(0u, le32toh(read<uint32_t>(batch, position)));
+  EXPECT_EQ(0u, le64toh(read<uint64_t>(batch, position)));
+  EXPECT_EQ(batch.size(), position);
+}
+}
+}
@@ -0,0 +1,105 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/system/ResultStreamWriter.h"
+#include "io/shortcuts.h"
+#include "net/AbstractConnection.h"
+#include "storage/AbstractTable.h"
+#include "testing/test.h"
+
+#include <string>
+#include <vector>
+
+namespace hyrise {
+namespace access {
+
+namespace {
+// Collects the parts of a streamed response
+class StreamCollector : public net::AbstractConnection {
+ public:
+  std::vector<std::string> parts;
+  size_t status = 0;
+  bool ended = false;
+  bool congested = false;
+
+  std::string getBody() const { return ""; }
+  std::string getPath() const { return ""; }
+  bool hasBody() const { return false; }
+  void respond(const std::string& message, size_t status, const std::string& contentType) {}
+
+  void beginResponse(size_t status, const std::string& contentType) { this->status = status; }
+  void sendResponsePart(const std::string& data) { parts.push_back(data); }
+  void endResponse() { ended = true; }
+  bool isCongested() const { return congested; }
+
+  Json::Value document() const {
+    std::string body;
+    for (const auto& part : parts)
+      body += part;
+    Json::Value result;
+    Json::Reader reader;
+    EXPECT_TRUE(reader.parse(body, result));
+    return result;
+  }
+};
+}
+
+class ResultStreamWriterTests : public AccessTest {};
+
+TEST_F(ResultStreamWriterTests, streams_rows) {
+  auto t = io::Loader::shortcuts::load("test/alltypes.tbl");
+  Json::Value metadata;
+  metadata["real_size"] = Json::Value((Json::UInt64)t->size());
+
+  StreamCollector connection;
+  ResultStreamWriter(&connection, ResultStreamWriter::RowLayout).write(metadata, t, 2, 1, 200);
+
+  ASSERT_TRUE(connection.ended);
+  EXPECT_EQ(200u, connection.status);
+  Json::Value document = connection.document();
+  EXPECT_EQ(t->size(), document["real_size"].asUInt64());
+  ASSERT_EQ(2u, document["rows"].size());
+  for (unsigned row = 0; row < 2; ++row) {
+    EXPECT_EQ(t->getValue<hyrise_int_t>(0, row + 1), document["rows"][row][0].asInt64());
+    EXPECT_EQ(t->getValue<hyrise_string_t>(1, row + 1), document["rows"][row][1].asString());
+    EXPECT_FLOAT_EQ(t->getValue<hyrise_float_t>(2, row + 1), document["rows"][row][2].asFloat());
+  }
+}
+
+TEST_F(ResultStreamWriterTests, streams_columns_in_parts) {
+  auto t = io::Loader::shortcuts::load("test/alltypes.tbl");
+
+  StreamCollector connection;
+  ResultStreamWriter(&connection, ResultStreamWriter::ColumnLayout, 16).write(Json::Value(), t, 0, 0, 500);
+
+  EXPECT_EQ(500u, connection.status);
+  EXPECT_LT(1u, connection.parts.size());
+  Json::Value document = connection.document();
+  ASSERT_EQ(t->columnCount(), document["columns"].size());
+  for (unsigned row = 0; row < t->size(); ++row) {
+    EXPECT_EQ(t->getValue<hyrise_int_t>(0, row), document["columns"][0][row].asInt64());
+    EXPECT_EQ(t->getValue<hyrise_string_t>(1, row), document["columns"][1][row].asString());
+    EXPECT_FLOAT_EQ(t->getValue<hyrise_float_t>(2, row), document["columns"][2][row].asFloat());
+  }
+}
+
+TEST_F(ResultStreamWriterTests, pauses_while_congested) {
+  auto t = io::Loader::shortcuts::load("test/alltypes.tbl");
+
+  StreamCollector connection;
+  connection.congested = true;
+  ResultStreamWriter writer(&connection, ResultStreamWriter::ColumnLayout);
+  writer.start(Json::Value(), t, 0, 0, 200);
+
+  // one batch of the first column is written before the writer notices
+  EXPECT_FALSE(writer.proceed(true));
+  EXPECT_FALSE(connection.ended);
+
+  connection.congested = false;
+  EXPECT_TRUE(writer.proceed(true));
+  ASSERT_TRUE(connection.ended);
+  Json::Value document = connection.document();
+  ASSERT_EQ(t->columnCount(), document["columns"].size());
+  for (unsigned row = 0; row < t->size(); ++row)
+    EXPECT_EQ(t->getValue<hyrise_int_t>(0, row), document["columns"][0][row].asInt64());
+}
+}
+}
@@ -0,0 +1,181 @@
+// Copyright (c) 2015 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/sql/SQLStatementTransformer.h"
+#include "access/sql/parser/SQLParser.h"
+#include "io/StorageManager.h"
+#include "testing/test.h"
+
+#include "helper.h"
+
+#include <algorithm>
+
+namespace hyrise {
+namespace access {
+namespace sql {
+
+class SQLQueryOptimizerTests : public AccessTest {
+ public:
+  virtual void SetUp() {
+    AccessTest::SetUp();
+    io::StorageManager::getInstance()->loadTableFile("companies", "companies.tbl");
+    io::StorageManager::getInstance()->loadTableFile("employees", "employees.tbl");
+    io::StorageManager::getInstance()->loadTableFile("filter", "filter.tbl");
+  }
+
+ protected:
+  void transform(const std::string& query) {
+    _statements.reset(hsql::SQLParser::parseSQLString(query.c_str()));
+    ASSERT_TRUE(_statements->isValid);
+    _transformer.reset(new SQLStatementTransformer("optimizer_test"));
+    _transformer->transformStatement(_statements->getStatement(0));
+  }
+
+  const task_list_t& tasks() { return _transformer->getTaskList(); }
+
+  // Operations of the given type in the order they were added
+  std::vector<plan_op_t> operations(const std::string& name) {
+    std::vector<plan_op_t> result;
+    for (const task_t& task : tasks()) {
+      auto op = std::dynamic_pointer_cast<PlanOperation>(task);
+      if (op->planOperationName() == name)
+        result.push_back(op);
+    }
+    return result;
+  }
+
+  size_t position(const plan_op_t& op) {
+    return std::find(tasks().begin(), tasks().end(), op) - tasks().begin();
+  }
+
+  // Runs the operations in the order they were added, which respects their dependencies
+  storage::c_atable_ptr_t execute() {
+    auto ctx = getNewTXContext();
+    for (const task_t& task : tasks()) {
+      auto op = std::dynamic_pointer_cast<PlanOperation>(task);
+      op->setTXContext(ctx);
+      op->execute();
+    }
+    return std::dynamic_pointer_cast<PlanOperation>(tasks().back())->getResultTable();
+  }
+
+  std::unique_ptr<hsql::SQLStatementList> _statements;
+  std::unique_ptr<SQLStatementTransformer> _transformer;
+};
+
+TEST_F(SQLQueryOptimizerTests, smallest_relation_is_read_first) {
+  transform("SELECT * FROM employees JOIN companies ON employees.employee_company_id = companies.company_id;");
+
+  // relations are validated in the order of the FROM clause
+  auto validated = operations("ValidatePositions");
+  ASSERT_EQ(2u, validated.size());
+  auto builds = operations("HashBuild");
+  auto probes = operations("HashJoinProbe");
+  ASSERT_EQ(1u, builds.size());
+  ASSERT_EQ(1u, probes.size());
+
+  // the join starts with the four companies and probes with the six employees
+  EXPECT_TRUE(builds[0]->isDependency(validated[1]));
+  EXPECT_TRUE(probes[0]->isDependency(builds[0]));
+  EXPECT_TRUE(probes[0]->isDependency(validated[0]));
+}
+
+TEST_F(SQLQueryOptimizerTests, hash_table_is_built_over_smaller_input) {
+  transform("SELECT * FROM companies, employees, filter WHERE company_id = employee_company_id AND employee_id = AGE;");
+
+  auto validated = operations("ValidatePositions");
+  auto builds = operations("HashBuild");
+  auto probes = operations("HashJoinProbe");
+  ASSERT_EQ(3u, validated.size());
+  ASSERT_EQ(2u, builds.size());
+  ASSERT_EQ(2u, probes.size());
+
+  // the four companies are smaller than the six employees
+  EXPECT_TRUE(builds[0]->isDependency(validated[0]));
+  EXPECT_TRUE(probes[0]->isDependency(validated[1]));
+
+  // the five rows of filter are smaller than the six rows joined so far
+  EXPECT_TRUE(builds[1]->isDependency(validated[2]));
+  EXPECT_TRUE(probes[1]->isDependency(builds[1]));
+  EXPECT_TRUE(probes[1]->isDependency(probes[0]));
+}
+
+TEST_F(SQLQueryOptimizerTests, single_relation_predicates_are_scanned_before_join) {
+  transform("SELECT * FROM companies JOIN employees ON companies.company_id = employees.employee_company_id "
+            "WHERE employees.employee_id = 1;");
+
+  auto validated = operations("ValidatePositions");
+  auto scans = operations("SimpleTableScan");
+  auto builds = operations("HashBuild");
+  ASSERT_EQ(2u, validated.size());
+  ASSERT_EQ(1u, scans.size());
+  ASSERT_EQ(1u, builds.size());
+
+  // the predicate leaves one of the employees, so the hash table is built over the scan
+  EXPECT_TRUE(scans[0]->isDependency(validated[1]));
+  EXPECT_TRUE(builds[0]->isDependency(scans[0]));
+  EXPECT_LT(position(scans[0]), position(builds[0]));
+
+  auto result = execute();
+  ASSERT_EQ(1u, result->size());
+  EXPECT_EQ(1, result->getValue<hyrise_int_t>(result->numberOfColumn("employee_id"), 0));
+}
+
+TEST_F(SQLQueryOptimizerTests, projection_restores_from_column_order) {
+  // a join lists the columns of its right table first
+  transform("SELECT * FROM employees JOIN companies ON employees.employee_company_id = companies.company_id;");
+  ASSERT_EQ(1u, operations("ProjectionScan").size());
+  EXPECT_EQ(tasks().back(), operations("ProjectionScan")[0]);
+
+  auto result = execute();
+  std::vector<std::string> columns = {
+      "company_id", "company_name", "employee_id", "employee_company_id", "employee_name"};
+  ASSERT_EQ(columns.size(), result->columnCount());
+  for (size_t column = 0; column < columns.size(); ++column)
+    EXPECT_EQ(columns[column], result->nameOfColumn(column));
+
+  ASSERT_EQ(6u, result->size());
+  for (size_t row = 0; row < result->size(); ++row)
+    EXPECT_EQ(result->getValue<hyrise_int_t>(0, row), result->getValue<hyrise_int_t>(3, row));
+
+  // the join result already has the column order of the FROM clause
+  transform("SELECT * FROM companies JOIN employees ON companies.company_id = employees.employee_company_id;");
+  EXPECT_TRUE(operations("ProjectionScan").empty());
+}
+
+TEST_F(SQLQueryOptimizerTests, relations_without_join_key_are_combined_as_cross_product) {
+  transform("SELECT * FROM companies, filter;");
+
+  auto validated = operations("ValidatePositions");
+  auto products = operations("CrossProduct");
+  ASSERT_EQ(2u, validated.size());
+  ASSERT_EQ(1u, products.size());
+  EXPECT_TRUE(operations("HashBuild").empty());
+  EXPECT_TRUE(products[0]->isDependency(validated[0]));
+  EXPECT_TRUE(products[0]->isDependency(validated[1]));
+
+  // every one of the four companies is combined with each of the five rows of filter
+  auto result = execute();
+  ASSERT_EQ(20u, result->size());
+  ASSERT_EQ(6u, result->columnCount());
+  EXPECT_EQ("company_id", result->nameOfColumn(0));
+  EXPECT_EQ("NAME", result->nameOfColumn(2));
+  for (size_t row = 0; row < result->size(); ++row) {
+    EXPECT_EQ(static_cast<hyrise_int_t>(row / 5 + 1), result->getValue<hyrise_int_t>(0, row));
+    EXPECT_EQ(static_cast<hyrise_int_t>(row % 5 + 20), result->getValue<hyrise_int_t>(3, row));
+  }
+}
+
+TEST_F(SQLQueryOptimizerTests, cross_product_follows_keyed_joins) {
+  transform("SELECT * FROM companies, filter, employees WHERE company_id = employee_company_id;");
+
+  auto probes = operations("HashJoinProbe");
+  auto products = operations("CrossProduct");
+  ASSERT_EQ(1u, probes.size());
+  ASSERT_EQ(1u, products.size());
+  EXPECT_TRUE(products[0]->isDependency(probes[0]));
+
+  auto result = execute();
+  EXPECT_EQ(30u, result->size());
+}
+}
+}
+}
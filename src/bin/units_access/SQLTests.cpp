@@ -2,11 +2,16 @@
 
 #include <access/sql/SQLQueryParser.h>
 #include <access/sql/parser/SQLParser.h>
+#include <access/sql/PreparedStatementManager.h>
+#include <access/sql/SQLStatementTransformer.h>
 
 #include <io/shortcuts.h>
+#include <io/StorageManager.h>
 
 #include <testing/test.h>
 
+#include "helper.h"
+
 using namespace hsql;
 
 namespace hyrise {
@@ -102,6 +107,108 @@ TEST_F(SQLTests, select_parser_test) {
 }
 
 
+TEST_F(SQLTests, parameter_binding_test) {
+	SQLStatementList* prep_list = SQLParser::parseSQLString("PREPARE prep: SELECT * FROM test WHERE a = ? AND b = ?;");
+	SQLStatementList* exec_list = SQLParser::parseSQLString("EXECUTE prep(42, 'text');");
+	ASSERT_TRUE(prep_list->isValid);
+	ASSERT_TRUE(exec_list->isValid);
+
+	auto plan = std::make_shared<PreparedPlan>((PrepareStatement*) prep_list->getStatement(0));
+	ExecuteStatement* exec = (ExecuteStatement*) exec_list->getStatement(0);
+	ASSERT_EQ(plan->numPlaceholders(), 2u);
+
+	ParameterBinding binding(plan, *exec->parameters);
+	EXPECT_EQ(exec->parameters->size(), 0u);
+
+	Expr* first = binding.resolve(plan->getStatement()->placeholders[0]);
+	Expr* second = binding.resolve(plan->getStatement()->placeholders[1]);
+	EXPECT_EQ(first->type, kExprLiteralInt);
+	EXPECT_EQ(first->ival, 42);
+	EXPECT_EQ(second->type, kExprLiteralString);
+	EXPECT_STREQ(second->name, "text");
+
+	// The prepared statement itself is left untouched
+	EXPECT_EQ(plan->getStatement()->placeholders[0]->type, kExprPlaceholder);
+	EXPECT_EQ(plan->getStatement()->placeholders[1]->type, kExprPlaceholder);
+
+	delete exec;
+	delete exec_list;
+	delete prep_list;
+}
+
+TEST_F(SQLTests, prepared_plan_table_info_test) {
+	PreparedPlan plan(new PrepareStatement());
+
+	TableInfo info;
+	info.addField("a", "test", TableInfo::kInteger);
+	plan.putTableInfo("test", info);
+
+	TableInfo cached;
+	EXPECT_TRUE(plan.getTableInfo("test", cached));
+	EXPECT_EQ(cached.fields, info.fields);
+	EXPECT_EQ(cached.data_types, info.data_types);
+	EXPECT_FALSE(plan.getTableInfo("other", cached));
+
+	// Loading a table invalidates the cached columns of all tables
+	io::StorageManager::getInstance()->loadTableFile("prepared_plan_test", "students.tbl");
+	EXPECT_FALSE(plan.getTableInfo("test", cached));
+	io::StorageManager::getInstance()->removeTable("prepared_plan_test");
+}
+
+TEST_F(SQLTests, prepared_select_reuses_transformed_plan_test) {
+	io::StorageManager::getInstance()->loadTableFile("prepared_companies", "companies.tbl");
+	SQLStatementList* prep_list = SQLParser::parseSQLString("PREPARE prep_select: SELECT * FROM prepared_companies WHERE company_id = ?;");
+	ASSERT_TRUE(prep_list->isValid);
+	SQLStatementTransformer prepare("prepare");
+	prepare.transformStatement(prep_list->getStatement(0));
+	// The manager owns the prepared statement now
+	prep_list->statements.clear();
+	delete prep_list;
+
+	auto execute = [](const std::string& query, task_list_t& tasks) {
+		SQLStatementList* exec_list = SQLParser::parseSQLString(query.c_str());
+		SQLStatementTransformer transformer("execute");
+		transformer.transformStatement(exec_list->getStatement(0));
+		delete exec_list;
+
+		tasks = transformer.getTaskList();
+		auto ctx = getNewTXContext();
+		for (const task_t& task : tasks) {
+			auto op = std::dynamic_pointer_cast<PlanOperation>(task);
+			op->setTXContext(ctx);
+			op->execute();
+		}
+		return std::dynamic_pointer_cast<PlanOperation>(tasks.back())->getResultTable();
+	};
+
+	task_list_t first_tasks, second_tasks;
+	auto first = execute("EXECUTE prep_select(2);", first_tasks);
+	auto second = execute("EXECUTE prep_select(3);", second_tasks);
+
+	// The second execution runs copies of the operations with its own value bound
+	ASSERT_EQ(first_tasks.size(), second_tasks.size());
+	for (size_t i = 0; i < first_tasks.size(); ++i) EXPECT_NE(first_tasks[i], second_tasks[i]);
+	ASSERT_EQ(first->size(), 1u);
+	ASSERT_EQ(second->size(), 1u);
+	EXPECT_EQ(first->getValue<hyrise_int_t>(0, 0), 2);
+	EXPECT_EQ(second->getValue<hyrise_int_t>(0, 0), 3);
+
+	// The plan is shared by executions with an integer parameter, but not with a string
+	auto plan = PreparedStatementManager::getInstance().getStatement("prep_select");
+	std::vector<Expr*> int_values = {Expr::makeLiteral((int64_t) 4)};
+	std::vector<Expr*> string_values = {Expr::makeLiteral(strdup("4"))};
+	ParameterBinding int_binding(plan, int_values);
+	ParameterBinding string_binding(plan, string_values);
+	TransformedPlan transformed;
+	EXPECT_TRUE(plan->getTransformedPlan(int_binding, transformed));
+	EXPECT_EQ(transformed.tasks.size(), first_tasks.size());
+	EXPECT_EQ(transformed.meta.last_task, transformed.tasks.back());
+	EXPECT_FALSE(plan->getTransformedPlan(string_binding, transformed));
+
+	PreparedStatementManager::getInstance().deleteStatement("prep_select");
+	io::StorageManager::getInstance()->removeTable("prepared_companies");
+}
+
 } // namespace sql
 } // namespace access
 } // namespace hyrise
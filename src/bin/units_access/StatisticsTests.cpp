@@ -0,0 +1,91 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/Statistics.h"
+#include "io/shortcuts.h"
+#include "io/StorageManager.h"
+#include "storage/Store.h"
+#include "testing/test.h"
+
+namespace hyrise {
+namespace access {
+
+class StatisticsTests : public AccessTest {};
+
+TEST_F(StatisticsTests, reports_main_chunks_and_delta_of_named_input) {
+  auto store = std::dynamic_pointer_cast<storage::Store>(io::Loader::shortcuts::load("test/tables/companies.tbl"));
+  ASSERT_TRUE((bool)store);
+  io::StorageManager::getInstance()->loadTable("companies", store);
+
+  auto rows = store->appendToDelta(1);
+  store->getDeltaTable()->setValue<hyrise_int_t>(0, rows.first, 5);
+  store->getDeltaTable()->setValue<hyrise_string_t>(1, rows.first, "IBM");
+
+  Statistics statistics;
+  statistics.addInput(store);
+  statistics.execute();
+  const auto& result = statistics.getResultTable();
+
+  std::vector<std::string> columns = {
+      "table", "column", "chunk", "rows", "distinct", "min_value_id", "max_value_id", "histogram"};
+  ASSERT_EQ(columns.size(), result->columnCount());
+  for (size_t column = 0; column < columns.size(); ++column)
+    EXPECT_EQ(columns[column], result->metadataAt(column).getName());
+
+  // every column has a row for its main chunk and one for the delta
+  ASSERT_EQ(4u, result->size());
+  std::vector<std::string> names = {"company_id", "company_id", "company_name", "company_name"};
+  std::vector<hyrise_int_t> chunks = {0, -1, 0, -1};
+  std::vector<hyrise_int_t> chunk_rows = {4, 1, 4, 1};
+  for (size_t row = 0; row < result->size(); ++row) {
+    EXPECT_EQ("companies", result->getValue<hyrise_string_t>(0, row));
+    EXPECT_EQ(names[row], result->getValue<hyrise_string_t>(1, row));
+    EXPECT_EQ(chunks[row], result->getValue<hyrise_int_t>(2, row));
+    EXPECT_EQ(chunk_rows[row], result->getValue<hyrise_int_t>(3, row));
+  }
+
+  // the main chunk of company_id has four distinct values, one per row
+  EXPECT_EQ(4, result->getValue<hyrise_int_t>(4, 0));
+  EXPECT_EQ(0, result->getValue<hyrise_int_t>(5, 0));
+  EXPECT_EQ(3, result->getValue<hyrise_int_t>(6, 0));
+  EXPECT_EQ("0 1 2 3", result->getValue<hyrise_string_t>(7, 0));
+  // the delta has no histogram
+  EXPECT_EQ(1, result->getValue<hyrise_int_t>(4, 1));
+  EXPECT_EQ("", result->getValue<hyrise_string_t>(7, 1));
+}
+
+TEST_F(StatisticsTests, unnamed_input_without_delta) {
+  auto companies = io::Loader::shortcuts::load("test/tables/companies.tbl");
+  auto store = std::dynamic_pointer_cast<storage::Store>(companies);
+  ASSERT_TRUE((bool)store);
+
+  Statistics statistics;
+  statistics.addInput(store->getMainTable());
+  statistics.execute();
+  const auto& result = statistics.getResultTable();
+
+  ASSERT_EQ(2u, result->size());
+  for (size_t row = 0; row < result->size(); ++row) {
+    EXPECT_EQ("unknown/temporary", result->getValue<hyrise_string_t>(0, row));
+    EXPECT_EQ(0, result->getValue<hyrise_int_t>(2, row));
+    EXPECT_EQ(4, result->getValue<hyrise_int_t>(3, row));
+  }
+}
+
+TEST_F(StatisticsTests, all_loaded_tables_without_input) {
+  io::StorageManager::getInstance()->loadTable("companies", io::Loader::shortcuts::load("test/tables/companies.tbl"));
+  io::StorageManager::getInstance()->loadTable("employees", io::Loader::shortcuts::load("test/tables/employees.tbl"));
+
+  Statistics statistics;
+  statistics.execute();
+  const auto& result = statistics.getResultTable();
+
+  size_t companies = 0, employees = 0;
+  for (size_t row = 0; row < result->size(); ++row) {
+    auto table = result->getValue<hyrise_string_t>(0, row);
+    companies += table == "companies";
+    employees += table == "employees";
+  }
+  EXPECT_EQ(2u, companies);
+  EXPECT_EQ(3u, employees);
+}
+}
+}
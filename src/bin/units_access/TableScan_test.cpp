@@ -4,6 +4,9 @@
 #include "access/expressions/pred_EqualsExpression.h"
 #include "access/expressions/pred_CompoundExpression.h"
 #include "io/shortcuts.h"
+#include "io/TransactionManager.h"
+#include "storage/Store.h"
+#include "storage/TableRangeView.h"
 #include "access/Barrier.h"
 #include "helper/make_unique.h"
 
@@ -28,6 +31,53 @@ TEST(TableScan, test2) {
   ASSERT_EQ(1u, result->size());
 }
 
+TEST(TableScan, row_range_starts_at_its_first_row) {
+  auto tbl = io::Loader::shortcuts::load("test/tables/companies.tbl");
+  auto range = std::make_shared<storage::TableRangeView>(tbl, 2, 4);
+
+  // company 1 is stored before the range
+  TableScan before(make_unique<EqualsExpression<hyrise_int_t>>(0, 0, 1));
+  before.addInput(range);
+  ASSERT_EQ(0u, before.execute()->getResultTable()->size());
+
+  TableScan within(make_unique<EqualsExpression<hyrise_int_t>>(0, 0, 3));
+  within.addInput(range);
+  const auto& result = within.execute()->getResultTable();
+  ASSERT_EQ(1u, result->size());
+  EXPECT_EQ(3, result->getValue<hyrise_int_t>(0, 0));
+}
+
+TEST(TableScan, instances_scan_whole_chunks) {
+  auto store = std::dynamic_pointer_cast<storage::Store>(io::Loader::shortcuts::load("test/merge1_main.tbl"));
+  store->setMainChunkSize(4);
+  auto insert = [&store](std::vector<hyrise_int_t> values) {
+    auto rows = store->appendToDelta(values.size());
+    pos_list_t positions;
+    for (size_t row = 0; row < values.size(); ++row) {
+      store->getDeltaTable()->setValue<hyrise_int_t>(0, rows.first + row, values[row]);
+      store->getDeltaTable()->setValue<hyrise_float_t>(1, rows.first + row, 0.5f);
+      store->getDeltaTable()->setValue<hyrise_string_t>(2, rows.first + row, "neu");
+      positions.push_back(store->getMainTable()->size() + rows.first + row);
+    }
+    store->commitPositions(positions, tx::TransactionManager::getInstance().getLastCommitId(), true);
+  };
+  insert({10, 11, 12});
+  store->merge();
+  insert({12, 13});
+  ASSERT_EQ(std::vector<size_t>({0, 4, 7}), store->chunkOffsets());
+
+  // one instance per main chunk and one for the delta, an even split would cut the second chunk
+  std::vector<size_t> matches = {0, 1, 1};
+  for (size_t part = 0; part < matches.size(); ++part) {
+    TableScan ts(make_unique<EqualsExpression<hyrise_int_t>>(0, 0, 12));
+    ts.addInput(store);
+    ts.setPart(part);
+    ts.setCount(matches.size());
+    const auto& result = ts.execute()->getResultTable();
+    ASSERT_EQ(matches[part], result->size()) << "part " << part;
+  }
+}
+
 TEST(TableScan, testDynamicParallelization) {
   auto MTS = 20;
 
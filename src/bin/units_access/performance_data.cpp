@@ -6,6 +6,8 @@
 #include "access/ProjectionScan.h"
 #include "access/Distinct.h"
 #include "access/Barrier.h"
+#include "access/HashBuild.h"
+#include "access/system/ResponseTask.h"
 #include "optional.hpp"
 
 namespace hyrise {
@@ -61,5 +63,22 @@ TEST_F(PerformanceDataTests, no_rows_test) {
   ASSERT_EQ(perf.in_rows, std::nullopt);
   ASSERT_EQ(perf.out_rows, std::nullopt);
 }
+
+TEST_F(PerformanceDataTests, allocated_bytes_test) {
+  auto in = io::Loader::shortcuts::load("test/tables/employees.tbl");
+
+  auto response = std::make_shared<ResponseTask>(nullptr);
+  auto hb = std::make_shared<HashBuild>();
+  hb->addInput(in);
+  hb->addField(in->numberOfColumn("employee_company_id"));
+  hb->setKey("join");
+  response->registerPlanOperation(hb);
+
+  hb->execute();
+
+  const auto& perf = response->getPerformanceData().at(0);
+  ASSERT_GT(perf->allocated_bytes, 0u);
+  ASSERT_EQ(perf->allocated_bytes, response->getQueryArena()->allocatedBytes());
+}
 }
 }
@@ -6,10 +6,12 @@
 #include "helper.h"
 #include "helper/types.h"
 #include "io/shortcuts.h"
+#include "io/TransactionManager.h"
 #include "access/radixjoin/NestedLoopEquiJoin.h"
 #include "testing/TableEqualityTest.h"
 #include "storage/Table.h"
 #include "storage/ColumnMetadata.h"
+#include "storage/Store.h"
 #include "access/RadixJoin.h"
 #include "access/storage/TableLoad.h"
 #include "access/Barrier.h"
@@ -150,6 +152,43 @@ TEST_F(RadixJoinTest, histogram_parallel_4x) {
 }
 
 
+TEST_F(RadixJoinTest, histogram_of_chunked_main) {
+  auto load = [](size_t chunk_size) {
+    auto store = std::dynamic_pointer_cast<storage::Store>(io::Loader::shortcuts::load("test/merge1_main.tbl"));
+    if (chunk_size > 0)
+      store->setMainChunkSize(chunk_size);
+    auto insert = [&store](std::vector<hyrise_int_t> values) {
+      auto rows = store->appendToDelta(values.size());
+      pos_list_t positions;
+      for (size_t row = 0; row < values.size(); ++row) {
+        store->getDeltaTable()->setValue<hyrise_int_t>(0, rows.first + row, values[row]);
+        positions.push_back(store->getMainTable()->size() + rows.first + row);
+      }
+      store->commitPositions(positions, tx::TransactionManager::getInstance().getLastCommitId(), true);
+    };
+    insert({10, 11, 12, 13, 14});
+    store->merge();
+    insert({15, 16});
+    return store;
+  };
+  auto chunked = load(4);
+  auto single = load(0);
+  ASSERT_EQ(2u, chunked->mainChunkCount());
+
+  // every chunk maps the value ids of its own dictionary
+  auto histogram = [](const storage::atable_ptr_t& table) {
+    Histogram h;
+    h.addInput(table);
+    h.addField(0);
+    h.setBits(2);
+    return h.execute()->getResultTable();
+  };
+  auto expected = histogram(single);
+  auto result = histogram(chunked);
+  for (size_t bucket = 0; bucket < 4; ++bucket)
+    EXPECT_EQ(expected->getValueId(0, bucket).valueId, result->getValueId(0, bucket).valueId);
+}
+
 TEST_F(RadixJoinTest, check_prefixsum) {
   // create input Table
   auto t1 = io::Loader::shortcuts::load("test/prefix_sum.tbl");
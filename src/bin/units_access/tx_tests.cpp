@@ -6,6 +6,7 @@
 #include "helper.h"
 
 #include <algorithm>
+#include <atomic>
 #include <thread>
 
 #include "access/Delete.h"
@@ -767,5 +768,80 @@ TEST_F(TransactionTests, delete_rollback) {
   tx::TransactionManager::rollbackTransaction(writeCtx);
   ASSERT_EQ(tx::START_TID, linxxxs->tid(0));
 }
+
+TEST_F(TransactionTests, concurrent_commits_become_visible_once) {
+  const size_t thread_count = getNumberOfCoresOnSystem() * 2;
+  const size_t commits_per_thread = 2000;
+  auto& txmgr = tx::TransactionManager::getInstance();
+  auto first_cid = txmgr.getLastCommitId() + 1;
+
+  std::atomic<bool> running(true);
+  std::atomic<bool> monotonic(true);
+  std::thread reader([&]() {
+    auto last = txmgr.getLastCommitId();
+    while (running) {
+      auto current = txmgr.getLastCommitId();
+      if (current < last) {
+        monotonic = false;
+      }
+      last = current;
+    }
+  });
+
+  // every commit context is handed to exactly one committing thread
+  std::vector<std::vector<tx::transaction_cid_t>> visible(thread_count);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < thread_count; ++t) {
+    threads.push_back(std::thread([&, t]() {
+      for (size_t i = 0; i < commits_per_thread; ++i) {
+        auto ctx = txmgr.buildContext();
+        InsertScan is;
+        is.setTXContext(ctx);
+        is.addInput(linxxxs);
+        is.setInputData(one_row);
+        is.execute();
+
+        for (auto commit_context : tx::TransactionManager::commitTransaction(ctx, false)) {
+          visible[t].push_back(commit_context->cid);
+          commit_context->release();
+        }
+      }
+    }));
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  running = false;
+  reader.join();
+
+  const size_t total = thread_count * commits_per_thread;
+  ASSERT_TRUE(monotonic);
+  ASSERT_EQ(first_cid + total - 1, txmgr.getLastCommitId());
+
+  std::vector<tx::transaction_cid_t> cids;
+  for (const auto& v : visible) {
+    cids.insert(cids.end(), v.begin(), v.end());
+  }
+  std::sort(cids.begin(), cids.end());
+  ASSERT_EQ(total, cids.size());
+  for (size_t i = 0; i < total; ++i) {
+    ASSERT_EQ(first_cid + (tx::transaction_cid_t)i, cids[i]);
+  }
+
+  // all inserted rows are visible to a new transaction
+  auto readCtx = txmgr.buildContext();
+  ProjectionScan ps;
+  ps.addInput(linxxxs);
+  ps.setTXContext(readCtx);
+  ps.addField(0);
+  ps.execute();
+
+  ValidatePositions vp;
+  vp.setTXContext(readCtx);
+  vp.addInput(ps.getResultTable());
+  vp.execute();
+  ASSERT_EQ(linxxxs_ref->size() + total, vp.getResultTable()->size());
+}
 }
 }
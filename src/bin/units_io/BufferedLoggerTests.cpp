@@ -41,7 +41,7 @@ TEST_F(BufferedLoggerTests, log_test) {
   vids.push_back(ValueId(53, 3));
   BufferedLogger::getInstance().logValue(tx, table_name, 3, &vids);
   BufferedLogger::getInstance().logInvalidation(tx, table_name, 2);
-  BufferedLogger::getInstance().logCommit(tx);
+  BufferedLogger::getInstance().logCommit(tx, 5);
   BufferedLogger::getInstance().flush();
 
   int log_fd = open(BufferedLogger::getInstance().getLogfilenameForCheckpoint(1).c_str(), O_RDONLY);
@@ -121,6 +121,53 @@ TEST_F(BufferedLoggerTests, insert_and_restore_test) {
   StorageManager::getInstance()->removeTable("TABELLE");
 }
 
+TEST_F(BufferedLoggerTests, parallel_restore_test) {
+  BufferedLogger::getInstance().truncate();
+
+  auto rows = Loader::shortcuts::load("test/alltypes.tbl");
+  auto orig = Loader::shortcuts::load("test/alltypes_empty.tbl");
+
+  orig->setName("TABELLE");
+  StorageManager::getInstance()->add("TABELLE", orig);
+  StorageManager::getInstance()->persistTable("TABELLE");
+
+  for (size_t i = 0; i < 1000; ++i) {
+    auto ctx = tx::TransactionManager::getInstance().buildContext();
+    access::InsertScan is;
+    is.setTXContext(ctx);
+    is.addInput(orig);
+    is.setInputData(rows);
+    is.execute();
+
+    if (i % 3 == 0) {
+      access::Rollback r;
+      r.addInput(orig);
+      r.setTXContext(ctx);
+      r.execute();
+    } else {
+      access::Commit c;
+      c.addInput(orig);
+      c.setTXContext(ctx);
+      c.execute();
+    }
+  }
+
+  StorageManager::getInstance()->removeTable("TABELLE");
+
+  storage::atable_ptr_t restored(new storage::Store(rows->copy_structure_modifiable()));
+  StorageManager::getInstance()->add("TABELLE", restored);
+
+  // more workers than partitions with entries must not hurt
+  ASSERT_LT(0u, BufferedLogger::getInstance().restore(8));
+
+  ASSERT_TABLE_EQUAL(orig, restored);
+  auto last_cid = tx::TransactionManager::getInstance().getLastCommitId();
+  ASSERT_EQ(std::dynamic_pointer_cast<storage::Store>(orig)->buildValidPositions(last_cid, tx::START_TID).size(),
+            std::dynamic_pointer_cast<storage::Store>(restored)->buildValidPositions(last_cid, tx::START_TID).size());
+
+  StorageManager::getInstance()->removeTable("TABELLE");
+}
+
 TEST_F(BufferedLoggerTests, pos_update_and_restore_test) {
   BufferedLogger::getInstance().truncate();
 
@@ -224,6 +271,68 @@ TEST_F(BufferedLoggerTests, simple_checkpoint_test) {
   ASSERT_TABLE_EQUAL(orig, restored);
   StorageManager::getInstance()->removeTable(tablename);
 }
+
+TEST_F(BufferedLoggerTests, checkpoint_with_running_transaction_test) {
+  BufferedLogger::getInstance().truncate();
+
+  auto rows = Loader::shortcuts::load("test/alltypes.tbl");
+  auto orig = std::dynamic_pointer_cast<storage::Store>(Loader::shortcuts::load("test/alltypes.tbl"));
+
+  const std::string tablename = "FUZZY_CHECKPOINT_TEST";
+  auto sm = StorageManager::getInstance();
+
+  orig->setName(tablename);
+  sm->add(tablename, orig);
+
+  access::Checkpoint cp;
+  cp.setWithMain(true);
+  cp.execute();
+
+  // insert rows, but commit only after the next checkpoint has started
+  auto ctx = tx::TransactionManager::getInstance().buildContext();
+  access::InsertScan is;
+  is.setTXContext(ctx);
+  is.addInput(orig);
+  is.setInputData(rows);
+  is.execute();
+
+  access::Checkpoint cp2;
+  cp2.setWithMain(false);
+  cp2.execute();
+
+  auto ctx2 = tx::TransactionManager::getInstance().buildContext();
+  access::InsertScan is2;
+  is2.setTXContext(ctx2);
+  is2.addInput(orig);
+  is2.setInputData(rows);
+  is2.execute();
+
+  access::Commit c2;
+  c2.addInput(is2.getResultTable());
+  c2.setTXContext(ctx2);
+  c2.execute();
+
+  // the first transaction started before the last checkpoint and is still
+  // running, so no further checkpoint can be taken
+  ASSERT_THROW(BufferedLogger::getInstance().startCheckpoint(std::chrono::milliseconds(10)), std::runtime_error);
+
+  access::Commit c;
+  c.addInput(is.getResultTable());
+  c.setTXContext(ctx);
+  c.execute();
+
+  auto last_cid = tx::TransactionManager::getInstance().getLastCommitId();
+  auto expected = orig->buildValidPositions(last_cid, tx::START_TID).size();
+
+  sm->removeTable(tablename);
+  sm->recoverTables();
+
+  ASSERT_TRUE(sm->exists(tablename));
+  auto restored = std::dynamic_pointer_cast<storage::Store>(sm->getTable(tablename));
+  ASSERT_TABLE_EQUAL(orig, restored);
+  ASSERT_EQ(expected, restored->buildValidPositions(last_cid, tx::START_TID).size());
+  StorageManager::getInstance()->removeTable(tablename);
+}
 #endif
 }
 }
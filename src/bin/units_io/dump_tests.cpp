@@ -20,6 +20,7 @@
 #include <io/StorageManager.h>
 #include <io/TableDump.h>
 #include <storage/AbstractTable.h>
+#include <storage/MappedFixedLengthVector.h>
 #include <storage/Store.h>
 #include <storage/TableMerger.h>
 #include <storage/AbstractMergeStrategy.h>
@@ -125,6 +126,29 @@ TEST_F(DumpTests, simple_dump_load_all) {
   ASSERT_TABLE_EQUAL(t, simpleTable);
 }
 
+TEST_F(DumpTests, simple_dump_load_mapped) {
+  auto dumper = hyrise::storage::SimpleTableDump("./test/dump");
+  ASSERT_TRUE(dumper.dump("simple", simpleTable));
+
+  TableDumpLoader input("./test/dump", "simple", TableDumpLoader::params().setMapped(true));
+  CSVHeader header("test/dump/simple/header.dat", CSVHeader::params().setCSVParams(csv::HYRISE_FORMAT));
+  auto t = Loader::load(Loader::params().setInput(input).setHeader(header));
+  ASSERT_EQ(t->size(), 100u);
+  ASSERT_TABLE_EQUAL(t, simpleTable);
+
+  // the single column partitions are backed by the dumped files, the wide one is copied
+  auto main = std::dynamic_pointer_cast<hyrise::storage::Store>(t)->getMainTable();
+  ASSERT_EQ(nullptr,
+            std::dynamic_pointer_cast<hyrise::storage::MappedFixedLengthVector<value_id_t>>(
+                main->getAttributeVectors(0).at(0).attribute_vector));
+  ASSERT_NE(nullptr,
+            std::dynamic_pointer_cast<hyrise::storage::MappedFixedLengthVector<value_id_t>>(
+                main->getAttributeVectors(9).at(0).attribute_vector));
+
+  // merging replaces the mapped main with a regular one
+  std::dynamic_pointer_cast<hyrise::storage::Store>(t)->merge();
+  ASSERT_TABLE_EQUAL(t, simpleTable);
+}
 
 TEST_F(DumpTests, simple_dump_should_not_dump_delta) {
 
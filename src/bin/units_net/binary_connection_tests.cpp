@@ -0,0 +1,141 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include <gtest/gtest.h>
+
+#include <endian.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "net/BinaryConnection.h"
+#include "net/Router.h"
+#include "taskscheduler/SharedScheduler.h"
+
+namespace hyrise {
+namespace net {
+
+class BinaryEchoHandler : public AbstractRequestHandler {
+  AbstractConnection* _connection;
+
+ public:
+  explicit BinaryEchoHandler(AbstractConnection* connection) : _connection(connection) {}
+  static std::string name() { return "BinaryEchoHandler"; }
+  const std::string vname() { return name(); }
+  void operator()() { _connection->respond(_connection->getPath() + "|" + _connection->getBody()); }
+};
+
+bool binary_echo_registered = Router::registerRoute<BinaryEchoHandler>("/binary_echo/");
+
+namespace {
+void appendUint32(std::string& out, uint32_t value) {
+  value = htole32(value);
+  out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+uint32_t readUint32(const char* data) {
+  uint32_t value;
+  memcpy(&value, data, sizeof(value));
+  return le32toh(value);
+}
+
+std::string frame(uint8_t type, const std::string& payload) {
+  std::string result;
+  appendUint32(result, payload.size());
+  result.push_back(static_cast<char>(type));
+  return result + payload;
+}
+
+std::string request(uint8_t type, const std::string& path, const std::string& body) {
+  std::string payload;
+  appendUint32(payload, path.size());
+  return frame(type, payload + path + body);
+}
+
+std::string statement(uint8_t type, uint32_t id, const std::string& body = "") {
+  std::string payload;
+  appendUint32(payload, id);
+  return frame(type, payload + body);
+}
+}
+
+class BinaryConnectionTests : public ::testing::Test {
+ protected:
+  void SetUp() {
+    if (!taskscheduler::SharedScheduler::getInstance().isInitialized())
+      taskscheduler::SharedScheduler::getInstance().resetScheduler("ThreadPerTaskScheduler");
+    loop = ev_loop_new(0);
+    ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+    fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL, 0) | O_NONBLOCK);
+    fcntl(fds[1], F_SETFL, fcntl(fds[1], F_GETFL, 0) | O_NONBLOCK);
+    new BinaryConnection(loop, fds[0]);
+  }
+
+  void TearDown() {
+    // the connection deletes itself once it notices the closed socket
+    ::close(fds[1]);
+    ev_run(loop, EVRUN_NOWAIT);
+    ev_loop_destroy(loop);
+  }
+
+  // Runs the loop until count frames arrived, returns them as (type, payload)
+  std::vector<std::pair<uint8_t, std::string> > receive(size_t count) {
+    std::vector<std::pair<uint8_t, std::string> > frames;
+    std::string buffer;
+    for (size_t attempt = 0; frames.size() < count && attempt < 1000; ++attempt) {
+      ev_run(loop, EVRUN_NOWAIT);
+      char data[4096];
+      ssize_t received = recv(fds[1], data, sizeof(data), 0);
+      if (received > 0)
+        buffer.append(data, received);
+      while (buffer.size() >= kFrameHeaderSize && buffer.size() >= kFrameHeaderSize + readUint32(buffer.data())) {
+        size_t length = readUint32(buffer.data());
+        frames.emplace_back(buffer[sizeof(uint32_t)], buffer.substr(kFrameHeaderSize, length));
+        buffer.erase(0, kFrameHeaderSize + length);
+      }
+      usleep(1000);
+    }
+    return frames;
+  }
+
+  struct ev_loop* loop;
+  int fds[2];
+};
+
+TEST_F(BinaryConnectionTests, requests_are_answered_in_order) {
+  std::string requests = request(RequestFrame, "/binary_echo/", "query=1") +
+                         request(RequestFrame, "/binary_echo/", "query=2") +
+                         request(RequestFrame, "/not_routed", "");
+  ASSERT_EQ((ssize_t)requests.size(), send(fds[1], requests.data(), requests.size(), 0));
+
+  auto frames = receive(3);
+  ASSERT_EQ(3u, frames.size());
+  EXPECT_EQ(ResponseFrame, frames[0].first);
+  EXPECT_EQ(200u, readUint32(frames[0].second.data()));
+  EXPECT_EQ("/binary_echo/|query=1", frames[0].second.substr(sizeof(uint32_t)));
+  EXPECT_EQ("/binary_echo/|query=2", frames[1].second.substr(sizeof(uint32_t)));
+  EXPECT_EQ(404u, readUint32(frames[2].second.data()));
+}
+
+TEST_F(BinaryConnectionTests, prepared_statements) {
+  std::string prepare = request(PrepareFrame, "/binary_echo/", "query=q");
+  ASSERT_EQ((ssize_t)prepare.size(), send(fds[1], prepare.data(), prepare.size(), 0));
+  auto prepared = receive(1);
+  ASSERT_EQ(1u, prepared.size());
+  ASSERT_EQ(PreparedFrame, prepared[0].first);
+  uint32_t id = readUint32(prepared[0].second.data());
+
+  std::string requests = statement(ExecuteFrame, id, "parameters=p") + statement(ExecuteFrame, id) +
+                         statement(CloseFrame, id) + statement(ExecuteFrame, id);
+  ASSERT_EQ((ssize_t)requests.size(), send(fds[1], requests.data(), requests.size(), 0));
+
+  auto frames = receive(3);
+  ASSERT_EQ(3u, frames.size());
+  EXPECT_EQ("/binary_echo/|query=q&parameters=p", frames[0].second.substr(sizeof(uint32_t)));
+  EXPECT_EQ("/binary_echo/|query=q", frames[1].second.substr(sizeof(uint32_t)));
+  EXPECT_EQ(404u, readUint32(frames[2].second.data()));
+}
+}
+}
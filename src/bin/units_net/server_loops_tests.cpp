@@ -0,0 +1,255 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <endian.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "net/AsyncConnection.h"
+#include "net/BinaryConnection.h"
+#include "net/Router.h"
+#include "net/ServerLoops.h"
+#include "taskscheduler/SharedScheduler.h"
+#include "taskscheduler/Task.h"
+
+namespace hyrise {
+namespace net {
+
+// Answers with the request body, bodies starting with "slow" take a while
+class PipelineEchoHandler : public AbstractRequestHandler {
+  AbstractConnection* _connection;
+
+ public:
+  explicit PipelineEchoHandler(AbstractConnection* connection) : _connection(connection) {}
+  static std::string name() { return "PipelineEchoHandler"; }
+  const std::string vname() { return name(); }
+  void operator()() {
+    std::string body = _connection->getBody();
+    if (body.compare(0, 4, "slow") == 0)
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    _connection->respond(body);
+  }
+};
+
+bool pipeline_echo_registered = Router::registerRoute<PipelineEchoHandler>("/pipeline_echo/");
+
+// "stream" streams a response larger than the stream buffer, "wait" answers
+// once the stream was produced or after a second
+class PipelineStreamHandler : public AbstractRequestHandler {
+  AbstractConnection* _connection;
+
+ public:
+  static std::mutex mutex;
+  static std::condition_variable streamed_cv;
+  static bool streamed;
+
+  explicit PipelineStreamHandler(AbstractConnection* connection) : _connection(connection) {}
+  static std::string name() { return "PipelineStreamHandler"; }
+  const std::string vname() { return name(); }
+  void operator()() {
+    if (_connection->getBody() == "stream") {
+      _connection->beginResponse();
+      for (size_t i = 0; i < 4; ++i)
+        _connection->sendResponsePart(std::string(1 << 19, 'x'));
+      _connection->endResponse();
+      std::lock_guard<std::mutex> lock(mutex);
+      streamed = true;
+      streamed_cv.notify_all();
+    } else {
+      std::unique_lock<std::mutex> lock(mutex);
+      bool waited = streamed_cv.wait_for(lock, std::chrono::seconds(1), []() { return streamed; });
+      _connection->respond(waited ? "streamed-before" : "streamed-after");
+    }
+  }
+};
+
+std::mutex PipelineStreamHandler::mutex;
+std::condition_variable PipelineStreamHandler::streamed_cv;
+bool PipelineStreamHandler::streamed = false;
+
+bool pipeline_stream_registered = Router::registerRoute<PipelineStreamHandler>("/pipeline_stream/");
+
+namespace {
+// Returns a port that is currently free
+int freePort() {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t length = sizeof(addr);
+  bind(fd, reinterpret_cast<struct sockaddr*>(&addr), length);
+  getsockname(fd, reinterpret_cast<struct sockaddr*>(&addr), &length);
+  close(fd);
+  return ntohs(addr.sin_port);
+}
+
+int connectTo(int port) {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(port);
+  if (connect(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+std::string post(const std::string& path, const std::string& body) {
+  return "POST " + path + " HTTP/1.1\r\nContent-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+}
+}
+
+TEST(ServerLoopsTests, closed_pipelines_are_reused) {
+  struct ev_loop* loop = ev_loop_new(0);
+  {
+    ServerLoop server_loop(nullptr, loop, taskscheduler::Task::NO_PREFERRED_CORE);
+    AsyncPipeline* pipeline = server_loop.acquirePipeline();
+    AsyncConnection* request = pipeline->acquireRequest();
+    request->body = "body";
+    pipeline->releaseRequest(request);
+    EXPECT_EQ(1u, pipeline->idleRequests());
+
+    server_loop.releasePipeline(pipeline);
+    EXPECT_EQ(1u, server_loop.idlePipelines());
+
+    AsyncPipeline* reused = server_loop.acquirePipeline();
+    EXPECT_EQ(pipeline, reused);
+    AsyncConnection* reused_request = reused->acquireRequest();
+    EXPECT_EQ(request, reused_request);
+    EXPECT_FALSE(reused_request->hasBody());
+    reused->releaseRequest(reused_request);
+    delete reused;
+  }
+  ev_loop_destroy(loop);
+}
+
+TEST(ServerLoopsTests, all_loops_listen_on_one_port_until_shutdown) {
+  ServerLoops loops(3, false);
+  ASSERT_EQ(3u, loops.size());
+  int port = freePort();
+  ASSERT_EQ(port, loops.listen(port));
+
+  // the loops have nothing left to do once they stopped listening
+  loops.shutdown();
+  loops.run();
+}
+
+TEST(ServerLoopsTests, pipelined_responses_keep_request_order) {
+  if (!taskscheduler::SharedScheduler::getInstance().isInitialized())
+    taskscheduler::SharedScheduler::getInstance().resetScheduler("ThreadPerTaskScheduler");
+
+  ServerLoops loops(1, false);
+  int port = freePort();
+  ASSERT_EQ(port, loops.listen(port));
+  std::thread server([&loops]() { loops.run(); });
+
+  int client = connectTo(port);
+  ASSERT_LE(0, client);
+  // the second request finishes first, but has to be answered second
+  std::string requests = post("/pipeline_echo/", "slow-1") + post("/pipeline_echo/", "fast-2");
+  ASSERT_EQ((ssize_t)requests.size(), send(client, requests.data(), requests.size(), 0));
+
+  std::string responses;
+  char buffer[4096];
+  while (responses.find("fast-2") == std::string::npos) {
+    ssize_t received = recv(client, buffer, sizeof(buffer), 0);
+    if (received <= 0)
+      break;
+    responses.append(buffer, received);
+  }
+  close(client);
+  loops.shutdown();
+  server.join();
+
+  ASSERT_NE(std::string::npos, responses.find("fast-2"));
+  EXPECT_LT(responses.find("slow-1"), responses.find("fast-2"));
+  EXPECT_EQ(responses.find("HTTP/1.1 200"), 0u);
+}
+TEST(ServerLoopsTests, pipelined_streams_do_not_wait_for_earlier_requests) {
+  if (!taskscheduler::SharedScheduler::getInstance().isInitialized())
+    taskscheduler::SharedScheduler::getInstance().resetScheduler("ThreadPerTaskScheduler");
+
+  ServerLoops loops(1, false);
+  int port = freePort();
+  ASSERT_EQ(port, loops.listen(port));
+  std::thread server([&loops]() { loops.run(); });
+
+  int client = connectTo(port);
+  ASSERT_LE(0, client);
+  // the first request only finishes after the stream of the second was produced
+  std::string requests = post("/pipeline_stream/", "wait") + post("/pipeline_stream/", "stream");
+  ASSERT_EQ((ssize_t)requests.size(), send(client, requests.data(), requests.size(), 0));
+
+  std::string responses;
+  char buffer[1 << 16];
+  while (responses.find("0\r\n\r\n") == std::string::npos) {
+    ssize_t received = recv(client, buffer, sizeof(buffer), 0);
+    if (received <= 0)
+      break;
+    responses.append(buffer, received);
+  }
+  close(client);
+  loops.shutdown();
+  server.join();
+
+  EXPECT_NE(std::string::npos, responses.find("streamed-before"));
+  EXPECT_EQ(std::string::npos, responses.find("streamed-after"));
+}
+
+TEST(ServerLoopsTests, shutdown_closes_binary_connections) {
+  if (!taskscheduler::SharedScheduler::getInstance().isInitialized())
+    taskscheduler::SharedScheduler::getInstance().resetScheduler("ThreadPerTaskScheduler");
+
+  ServerLoops loops(1, false);
+  int port = freePort();
+  int binary_port = freePort();
+  ASSERT_EQ(port, loops.listen(port));
+  ASSERT_EQ(binary_port, loops.listenBinary(binary_port));
+  std::thread server([&loops]() { loops.run(); });
+
+  int client = connectTo(binary_port);
+  ASSERT_LE(0, client);
+  // a response shows that the connection was accepted
+  std::string path = "/pipeline_echo/";
+  std::string payload(4, '\0');
+  uint32_t path_length = htole32(path.size());
+  memcpy(&payload[0], &path_length, sizeof(path_length));
+  payload += path + "binary";
+  std::string request(4, '\0');
+  uint32_t length = htole32(payload.size());
+  memcpy(&request[0], &length, sizeof(length));
+  request.push_back(static_cast<char>(RequestFrame));
+  request += payload;
+  ASSERT_EQ((ssize_t)request.size(), send(client, request.data(), request.size(), 0));
+
+  std::string response;
+  char buffer[4096];
+  while (response.find("binary") == std::string::npos) {
+    ssize_t received = recv(client, buffer, sizeof(buffer), 0);
+    if (received <= 0)
+      break;
+    response.append(buffer, received);
+  }
+  ASSERT_NE(std::string::npos, response.find("binary"));
+
+  // the loops end although the client keeps its connection open
+  loops.shutdown();
+  server.join();
+  EXPECT_EQ(0, recv(client, buffer, sizeof(buffer), 0));
+  close(client);
+}
+}
+}
@@ -4,8 +4,11 @@
 #include <limits>
 
 #include "storage/storage_types.h"
+#include "storage/AttributeVectorFactory.h"
 #include "storage/BitCompressedVector.h"
 #include "storage/FixedLengthVector.h"
+#include "storage/FrequencyPartitionedVector.h"
+#include "storage/RunLengthVector.h"
 
 namespace hyrise {
 namespace storage {
@@ -37,6 +40,24 @@ TEST(BitCompressedTests, empty_size_does_not_change_with_reserve) {
   ASSERT_EQ(128u, tuples.capacity());
 }
 
+TEST(BitCompressedTests, memory_policy_keeps_values) {
+  // large enough to leave malloc behind
+  const size_t rows = 1 << 20;
+  BitCompressedVector<value_id_t> tuples(1, rows, {20});
+  tuples.resize(rows);
+  for (size_t row = 0; row < rows; ++row)
+    tuples.set(0, row, row);
+
+  tuples.setMemoryPolicy(helper::MemoryPolicy::parse("interleaved,thp"));
+  auto copy = tuples.copy();
+  tuples.setMemoryPolicy(helper::MemoryPolicy());
+
+  for (size_t row = 0; row < rows; row += 4099) {
+    ASSERT_EQ(row, tuples.get(0, row));
+    ASSERT_EQ(row, copy->get(0, row));
+  }
+}
+
 TEST(FixedLengthVectorTest, increment_test) {
   size_t cols = 1;
   size_t rows = 3;
@@ -49,5 +70,60 @@ TEST(FixedLengthVectorTest, increment_test) {
   EXPECT_EQ(1u, tuples.atomic_inc(0, 0));
   EXPECT_EQ(2u, tuples.get(0, 0));
 }
+
+TEST(RunLengthVectorTest, runs_and_rows) {
+  RunLengthVector<value_id_t> runs;
+  for (value_id_t value : {3, 3, 3, 1, 1, 7}) {
+    runs.push_back(value);
+  }
+  ASSERT_EQ(6u, runs.size());
+  ASSERT_EQ(3u, runs.runCount());
+  EXPECT_EQ(3u, runs.get(0, 2));
+  EXPECT_EQ(1u, runs.get(0, 3));
+  EXPECT_EQ(7u, runs.get(0, 5));
+  EXPECT_THROW(runs.set(0, 0, 1), std::runtime_error);
+
+  // runs are clipped to the requested range
+  size_t sum = 0;
+  runs.forEachRun(1, 5, [&sum](value_id_t value, size_t length) { sum += value * length; });
+  EXPECT_EQ(3u * 2 + 1u * 2, sum);
+}
+
+TEST(FrequencyPartitionedVectorTest, frequent_values_and_exceptions) {
+  auto source = std::make_shared<FixedLengthVector<value_id_t>>(1, 100);
+  for (size_t row = 0; row < 100; ++row) {
+    source->set(0, row, row % 10 == 0 ? 100 + row : row % 3);
+  }
+  FrequencyPartitionedVector<value_id_t> encoded(source, 0, {0, 1, 2}, 2);
+  ASSERT_EQ(100u, encoded.size());
+  ASSERT_EQ(10u, encoded.exceptionCount());
+  for (size_t row = 0; row < 100; ++row) {
+    EXPECT_EQ(source->get(0, row), encoded.get(0, row));
+  }
+}
+
+TEST(AttributeVectorFactoryTest, encoding_follows_column_statistics) {
+  const size_t rows = 10000;
+  std::vector<std::shared_ptr<FixedLengthVector<value_id_t>>> columns;
+  for (size_t i = 0; i < 3; ++i) {
+    columns.push_back(std::make_shared<FixedLengthVector<value_id_t>>(1, rows));
+  }
+  for (size_t row = 0; row < rows; ++row) {
+    columns[0]->set(0, row, row / 1000);                            // sorted, 10 values
+    columns[1]->set(0, row, row % 97 == 0 ? row % 1000 : row % 2);  // skewed
+    columns[2]->set(0, row, row % 1000);                            // uniform
+  }
+
+  auto sorted = create_encoded_attribute_vector(columns[0], 0, 10);
+  ASSERT_NE(nullptr, std::dynamic_pointer_cast<RunLengthVector<value_id_t>>(sorted));
+  auto skewed = create_encoded_attribute_vector(columns[1], 0, 1000);
+  ASSERT_NE(nullptr, std::dynamic_pointer_cast<FrequencyPartitionedVector<value_id_t>>(skewed));
+  ASSERT_EQ(nullptr, create_encoded_attribute_vector(columns[2], 0, 1000));
+
+  for (size_t row = 0; row < rows; ++row) {
+    ASSERT_EQ(columns[0]->get(0, row), sorted->get(0, row));
+    ASSERT_EQ(columns[1]->get(0, row), skewed->get(0, row));
+  }
+}
 }
 }  // namespace hyrise::storage
@@ -0,0 +1,81 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "testing/test.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "storage/DeltaIndex.h"
+
+namespace hyrise {
+namespace storage {
+
+class DeltaIndexTest : public ::hyrise::Test {};
+
+namespace {
+pos_list_t to_list(const PositionRange& range) { return pos_list_t(range.cbegin(), range.cend()); }
+}
+
+TEST_F(DeltaIndexTest, range_lookups) {
+  DeltaIndex<hyrise_int_t> index;
+  // enough entries for several levels of nodes, each key appears three times
+  for (pos_t pos = 0; pos < 3000; ++pos) {
+    index.add(pos % 1000, pos);
+  }
+  ASSERT_EQ(3000u, index.size());
+
+  ASSERT_EQ(pos_list_t({42, 1042, 2042}), to_list(index.getPositionsForKey(42)));
+  ASSERT_EQ(0u, index.getPositionsForKey(1000).size());
+  ASSERT_EQ(30u, index.getPositionsForKeyLT(10).size());
+  ASSERT_EQ(33u, index.getPositionsForKeyLTE(10).size());
+  ASSERT_EQ(9u, index.getPositionsForKeyBetween(12, 10).size());
+  ASSERT_EQ(3u, index.getPositionsForKeyGT(998).size());
+  ASSERT_EQ(6u, index.getPositionsForKeyGTE(998).size());
+}
+
+TEST_F(DeltaIndexTest, string_keys) {
+  DeltaIndex<hyrise_string_t> index;
+  for (pos_t pos = 0; pos < 500; ++pos) {
+    index.add("key_" + std::to_string(pos % 50), pos);
+  }
+  ASSERT_EQ(10u, index.getPositionsForKey("key_7").size());
+  ASSERT_EQ(20u, index.getPositionsForKeyBetween("key_7", "key_8").size());
+}
+
+TEST_F(DeltaIndexTest, lookups_during_concurrent_inserts) {
+  DeltaIndex<hyrise_int_t> index;
+  const size_t thread_count = 4;
+  const size_t rows_per_thread = 20000;
+
+  std::atomic<bool> done(false);
+  std::thread reader([&]() {
+    while (!done) {
+      auto positions = to_list(index.getPositionsForKey(7));
+      ASSERT_TRUE(std::is_sorted(positions.begin(), positions.end()));
+    }
+  });
+
+  std::vector<std::thread> writers;
+  for (size_t t = 0; t < thread_count; ++t) {
+    writers.emplace_back([&, t]() {
+      for (size_t row = t; row < thread_count * rows_per_thread; row += thread_count) {
+        index.add(row % 100, row);
+      }
+    });
+  }
+  for (auto& writer : writers) {
+    writer.join();
+  }
+  done = true;
+  reader.join();
+
+  ASSERT_EQ(thread_count * rows_per_thread, index.size());
+  auto positions = to_list(index.getPositionsForKey(7));
+  ASSERT_EQ(thread_count * rows_per_thread / 100, positions.size());
+  for (size_t i = 0; i < positions.size(); ++i) {
+    ASSERT_EQ(7 + i * 100, positions[i]);
+  }
+}
+}
+}
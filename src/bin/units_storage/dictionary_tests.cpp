@@ -1,6 +1,11 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "testing/test.h"
 
+#include <set>
+#include <thread>
+
+#include "storage/ConcurrentUnorderedDictionary.h"
+#include "storage/FrameOfReferenceDictionary.h"
 #include "storage/OrderIndifferentDictionary.h"
 #include "storage/OrderPreservingDictionary.h"
 #include "storage/PassThroughDictionary.h"
@@ -154,5 +159,136 @@ TEST_F(DictionaryTest, order_preserving_string_exists) {
   ASSERT_FALSE(dict.valueExists("c"));
   ASSERT_FALSE(dict.valueExists("321"));
 }
+
+TEST_F(DictionaryTest, order_preserving_string_front_coding) {
+  // enough values to span several blocks, sharing long prefixes
+  std::vector<std::string> values;
+  for (size_t i = 0; i < 100; ++i) {
+    values.push_back("customer_" + std::to_string(1000 + i * 2));
+  }
+
+  OrderPreservingDictionary<std::string> dict;
+  for (const auto& value : values) {
+    dict.addValue(value);
+  }
+  ASSERT_EQ(values.size(), dict.size());
+
+  for (size_t i = 0; i < values.size(); ++i) {
+    ASSERT_EQ(values[i], dict.getValueForValueId(i));
+    ASSERT_EQ(i, dict.getValueIdForValue(values[i]));
+    ASSERT_EQ(i, dict.getUpperBoundValueIdForValue(values[i]) - 1);
+  }
+
+  // values between two entries and around the ends
+  ASSERT_EQ(18u, dict.getLowerBoundValueIdForValue("customer_1035"));
+  ASSERT_EQ(18u, dict.getUpperBoundValueIdForValue("customer_1035"));
+  ASSERT_EQ(0u, dict.getLowerBoundValueIdForValue("a"));
+  ASSERT_EQ(values.size(), dict.getLowerBoundValueIdForValue("z"));
+  ASSERT_EQ(std::numeric_limits<value_id_t>::max(), dict.findValueIdForValue("customer_1035"));
+  ASSERT_EQ(values.front(), dict.getSmallestValue());
+  ASSERT_EQ(values.back(), dict.getGreatestValue());
+
+  size_t i = 0;
+  for (auto it = dict.begin(); it != dict.end(); ++it, ++i) {
+    ASSERT_EQ(values[i], *it);
+    ASSERT_EQ(i, it.getValueId());
+  }
+  ASSERT_EQ(values.size(), i);
+  ASSERT_EQ(values, *dict.getValueList());
+}
+
+TEST_F(DictionaryTest, concurrent_unordered_distinct_value_ids) {
+  ConcurrentUnorderedDictionary<std::string> dict;
+  const size_t value_count = 1000;
+
+  // all threads add the same values, in different orders
+  std::vector<std::thread> threads;
+  std::vector<std::vector<value_id_t>> value_ids(8, std::vector<value_id_t>(value_count));
+  for (size_t t = 0; t < value_ids.size(); ++t) {
+    threads.emplace_back([&, t]() {
+      for (size_t i = 0; i < value_count; ++i) {
+        size_t value = (t % 2 == 0) ? i : value_count - 1 - i;
+        value_ids[t][value] = dict.addValue("value_" + std::to_string(value));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(value_count, dict.size());
+  std::set<value_id_t> distinct(value_ids[0].begin(), value_ids[0].end());
+  ASSERT_EQ(value_count, distinct.size());
+  for (size_t t = 1; t < value_ids.size(); ++t) {
+    ASSERT_EQ(value_ids[0], value_ids[t]);
+  }
+  for (size_t i = 0; i < value_count; ++i) {
+    ASSERT_EQ("value_" + std::to_string(i), dict.getValueForValueId(value_ids[0][i]));
+  }
+}
+
+TEST_F(DictionaryTest, concurrent_unordered_batched_insert) {
+  ConcurrentUnorderedDictionary<hyrise_int_t> dict;
+  auto existing = dict.addValue(7);
+
+  auto value_ids = dict.addValues({3, 7, 5, 3});
+  ASSERT_EQ(3u, dict.size());
+  ASSERT_EQ(4u, value_ids.size());
+  ASSERT_EQ(existing, value_ids[1]);
+  ASSERT_EQ(value_ids[0], value_ids[3]);
+  ASSERT_NE(value_ids[0], value_ids[2]);
+  ASSERT_EQ(5, dict.getValueForValueId(value_ids[2]));
+}
+
+TEST_F(DictionaryTest, frame_of_reference_lookups) {
+  FrameOfReferenceDictionary<hyrise_int_t> dict(-10, 100);
+  ASSERT_TRUE(dict.isOrdered());
+  ASSERT_EQ(100u, dict.size());
+  ASSERT_EQ(-10, dict.getSmallestValue());
+  ASSERT_EQ(89, dict.getGreatestValue());
+
+  ASSERT_EQ(15u, dict.findValueIdForValue(5));
+  ASSERT_EQ(5, dict.getValueForValueId(15));
+  ASSERT_EQ(std::numeric_limits<value_id_t>::max(), dict.findValueIdForValue(-11));
+  ASSERT_EQ(std::numeric_limits<value_id_t>::max(), dict.findValueIdForValue(90));
+
+  // bounds are clamped to the frame like the ones of an ordered dictionary
+  ASSERT_EQ(0u, dict.getLowerBoundValueIdForValue(-50));
+  ASSERT_EQ(15u, dict.getLowerBoundValueIdForValue(5));
+  ASSERT_EQ(16u, dict.getUpperBoundValueIdForValue(5));
+  ASSERT_EQ(100u, dict.getUpperBoundValueIdForValue(500));
+
+  hyrise_int_t expected = -10;
+  for (auto it = dict.begin(); it != dict.end(); ++it) {
+    ASSERT_EQ(expected, *it);
+    ASSERT_EQ(static_cast<value_id_t>(expected + 10), it.getValueId());
+    ++expected;
+  }
+  ASSERT_EQ(90, expected);
+}
+
+TEST_F(DictionaryTest, frame_of_reference_selection) {
+  OrderPreservingDictionary<hyrise_int_t> dense;
+  OrderPreservingDictionary<hyrise_int_t> sparse;
+  for (hyrise_int_t value = 0; value < 2000; ++value) {
+    dense.addValue(1000 + value * 2);
+    sparse.addValue(1000 + value * 100);
+  }
+
+  auto reference = create_frame_of_reference_dictionary<hyrise_int_t>(dense, 2000);
+  ASSERT_NE(nullptr, reference);
+  ASSERT_EQ(3999u, reference->size());
+  ASSERT_EQ(20u, reference->getValueIdForValue(dense.getValueForValueId(10)));
+
+  // too many repeated values or too wide a range keep the dictionary
+  ASSERT_EQ(nullptr, create_frame_of_reference_dictionary<hyrise_int_t>(dense, 4000));
+  ASSERT_EQ(nullptr, create_frame_of_reference_dictionary<hyrise_int_t>(sparse, 2000));
+
+  OrderPreservingDictionary<hyrise_float_t> floats;
+  for (size_t value = 0; value < 2000; ++value) {
+    floats.addValue(value);
+  }
+  ASSERT_EQ(nullptr, create_frame_of_reference_dictionary<hyrise_float_t>(floats, 2000));
+}
 }
 }  // namepsace hyrise::storage
@@ -1,6 +1,8 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "testing/test.h"
 
+#include <limits>
+
 #include "io/shortcuts.h"
 #include "storage/GroupkeyIndex.h"
 
@@ -150,5 +152,25 @@ TEST_F(GroupkeyTest, getBetween) {
   ASSERT_TRUE(check_equality(index.getPositionsForKeyBetween(300, 350), {}));
   ASSERT_TRUE(check_equality(index.getPositionsForKeyBetween(0, 800), {0, 1, 2, 3, 4}));
 }
+TEST_F(GroupkeyTest, packedPostings) {
+  // widths of 1, 17 and 64 bit, values straddle word boundaries for the odd width
+  std::vector<pos_list_t> lists = {{0, 1, 1, 0, 1},
+                                   {0, 131071, 5, 65536, 17, 99999, 3, 1, 2, 4, 6, 7},
+                                   {std::numeric_limits<pos_t>::max(), 0, 42}};
+  std::vector<size_t> widths = {1, 17, 64};
+
+  for (size_t l = 0; l < lists.size(); ++l) {
+    PackedPositions packed(lists[l]);
+    ASSERT_EQ(widths[l], packed.bits());
+    ASSERT_EQ(lists[l].size(), packed.size());
+    ASSERT_TRUE(std::equal(lists[l].begin(), lists[l].end(), packed.begin()));
+
+    for (size_t begin = 0; begin <= lists[l].size(); ++begin) {
+      pos_list_t decoded;
+      packed.decode(begin, lists[l].size(), decoded);
+      ASSERT_EQ(pos_list_t(lists[l].begin() + begin, lists[l].end()), decoded);
+    }
+  }
+}
 }
 }
@@ -9,9 +9,15 @@
 
 #include "io/shortcuts.h"
 
+#include "access/expressions/pred_EqualsExpression.h"
+#include "access/expressions/pred_LessThanExpression.h"
+
 #include "storage/AbstractTable.h"
+#include "storage/RunLengthVector.h"
 #include "storage/Store.h"
 
+#include "io/TransactionManager.h"
+
 #include "helper/types.h"
 #include "helper/vector_helpers.h"
 
@@ -235,5 +241,92 @@ TEST_F(MergeTests, store_merge_compex) {
 
   EXPECT_RELATION_EQ(ref, result[0]);
 }
+
+TEST_F(MergeTests, store_merge_chunked_main) {
+  auto store = std::dynamic_pointer_cast<Store>(io::Loader::shortcuts::load("test/merge1_main.tbl"));
+  store->setMainChunkSize(4);
+
+  auto insert = [&store](hyrise_int_t value) {
+    auto rows = store->appendToDelta(1);
+    store->getDeltaTable()->setValue<hyrise_int_t>(0, rows.first, value);
+    store->getDeltaTable()->setValue<hyrise_float_t>(1, rows.first, value + 0.5f);
+    store->getDeltaTable()->setValue<hyrise_string_t>(2, rows.first, "neu");
+    store->commitPositions({store->getMainTable()->size() + rows.first},
+                           tx::TransactionManager::getInstance().getLastCommitId(),
+                           true);
+  };
+
+  // the loaded main is sealed, the delta becomes a chunk of its own
+  for (hyrise_int_t value : {10, 11, 12})
+    insert(value);
+  store->merge();
+  ASSERT_EQ(2u, store->mainChunkCount());
+  ASSERT_EQ(7u, store->size());
+
+  // the open chunk is compacted together with the next delta
+  for (hyrise_int_t value : {13, 1})
+    insert(value);
+  store->merge();
+  ASSERT_EQ(2u, store->mainChunkCount());
+  ASSERT_EQ(9u, store->size());
+
+  std::vector<hyrise_int_t> expected = {4, 2, 0, 6, 10, 11, 12, 13, 1};
+  for (size_t row = 0; row < expected.size(); ++row) {
+    EXPECT_EQ(expected[row], store->getValue<hyrise_int_t>(0, row));
+  }
+  EXPECT_EQ("neu", store->getValue<hyrise_string_t>(2, 8));
+  EXPECT_EQ("fuenf", store->getValue<hyrise_string_t>(2, 3));
+
+  // every chunk has a dictionary of its own
+  std::vector<c_atable_ptr_t> input = {store};
+  access::EqualsExpression<hyrise_int_t> equals(0, 0, 12);
+  access::LessThanExpression<hyrise_int_t> less_than(0, 0, 11);
+  equals.walk(input);
+  less_than.walk(input);
+  for (size_t row = 0; row < expected.size(); ++row) {
+    EXPECT_EQ(expected[row] == 12, equals(row)) << "row " << row;
+    EXPECT_EQ(expected[row] < 11, less_than(row)) << "row " << row;
+  }
+
+  // main indices and chunks exclude each other
+  EXPECT_THROW(store->addMainIndex(nullptr, {0}), std::runtime_error);
+  auto indexed = std::dynamic_pointer_cast<Store>(io::Loader::shortcuts::load("test/merge1_main.tbl"));
+  indexed->addMainIndex(nullptr, {0});
+  EXPECT_THROW(indexed->setMainChunkSize(4), std::runtime_error);
+}
+
+TEST_F(MergeTests, store_merge_encodes_columns) {
+  auto store = std::dynamic_pointer_cast<Store>(io::Loader::shortcuts::load("test/merge1_main.tbl"));
+  const size_t rows = 5000;
+  auto inserted = store->appendToDelta(rows);
+  pos_list_t positions;
+  for (size_t row = 0; row < rows; ++row) {
+    store->getDeltaTable()->setValue<hyrise_int_t>(0, inserted.first + row, row / 1000);
+    store->getDeltaTable()->setValue<hyrise_float_t>(1, inserted.first + row, row + 0.5f);
+    store->getDeltaTable()->setValue<hyrise_string_t>(2, inserted.first + row, "neu");
+    positions.push_back(store->getMainTable()->size() + inserted.first + row);
+  }
+  store->commitPositions(positions, tx::TransactionManager::getInstance().getLastCommitId(), true);
+  store->merge();
+
+  // long runs are run-length encoded, the unique floats stay as they are
+  auto main = store->getMainTable();
+  ASSERT_EQ(rows + 4, main->size());
+  auto runLength = [&main](size_t column) {
+    const auto& vector = main->getAttributeVectors(column)[0].attribute_vector;
+    return std::dynamic_pointer_cast<RunLengthVector<value_id_t>>(vector);
+  };
+  EXPECT_NE(nullptr, runLength(0));
+  EXPECT_EQ(nullptr, runLength(1));
+  EXPECT_NE(nullptr, runLength(2));
+
+  EXPECT_EQ(6, store->getValue<hyrise_int_t>(0, 3));
+  EXPECT_EQ("fuenf", store->getValue<hyrise_string_t>(2, 3));
+  for (size_t row = 0; row < rows; ++row) {
+    ASSERT_EQ(static_cast<hyrise_int_t>(row / 1000), store->getValue<hyrise_int_t>(0, row + 4));
+    ASSERT_FLOAT_EQ(row + 0.5f, store->getValue<hyrise_float_t>(1, row + 4));
+  }
+  EXPECT_EQ("neu", store->getValue<hyrise_string_t>(2, rows + 3));
+}
 }
 }
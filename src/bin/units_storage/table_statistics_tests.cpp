@@ -0,0 +1,77 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "testing/test.h"
+
+#include "io/shortcuts.h"
+#include "storage/Store.h"
+#include "storage/TableStatistics.h"
+
+namespace hyrise {
+namespace storage {
+
+class TableStatisticsTests : public ::hyrise::Test {};
+
+TEST_F(TableStatisticsTests, main_histogram_and_delta) {
+  auto store = std::dynamic_pointer_cast<Store>(io::Loader::shortcuts::load("test/tables/companies.tbl"));
+  ASSERT_TRUE((bool)store);
+
+  TableStatistics statistics(store);
+  ASSERT_EQ(1u, statistics.chunkCount());
+  EXPECT_EQ(4u, statistics.rows());
+  EXPECT_EQ(0u, statistics.deltaRows());
+
+  const ColumnStatistics& ids = statistics.chunk(0).column(0);
+  EXPECT_EQ(4u, ids.distinct);
+  EXPECT_EQ(0u, ids.min);
+  EXPECT_EQ(3u, ids.max);
+  EXPECT_EQ(std::vector<value_id_t>({0, 1, 2, 3}), ids.histogram);
+  EXPECT_DOUBLE_EQ(4.0, statistics.distinctValues(0));
+
+  // company_id is 1, 2, 3 and 4
+  EXPECT_DOUBLE_EQ(0.5, statistics.fractionBelow<hyrise_int_t>(0, 3, false));
+  EXPECT_DOUBLE_EQ(0.75, statistics.fractionBelow<hyrise_int_t>(0, 3, true));
+  EXPECT_DOUBLE_EQ(0.0, statistics.fractionBelow<hyrise_int_t>(0, 0, true));
+  EXPECT_DOUBLE_EQ(1.0, statistics.fractionBelow<hyrise_int_t>(0, 10, false));
+
+  // rows in the delta count without a merge
+  auto write_area = store->appendToDelta(1);
+  store->copyRowToDelta(store, 0, write_area.first, 1);
+  TableStatistics with_delta(store);
+  EXPECT_EQ(5u, with_delta.rows());
+  EXPECT_EQ(1u, with_delta.deltaRows());
+  EXPECT_LE(4.0, with_delta.distinctValues(0));
+  EXPECT_GE(5.0, with_delta.distinctValues(0));
+}
+
+TEST_F(TableStatisticsTests, main_statistics_are_kept_until_main_changes) {
+  auto store = std::dynamic_pointer_cast<Store>(io::Loader::shortcuts::load("test/tables/companies.tbl"));
+  ASSERT_TRUE((bool)store);
+
+  auto first = store->mainStatistics();
+  auto second = store->mainStatistics();
+  ASSERT_EQ(1u, first.size());
+  EXPECT_EQ(first[0].second, second[0].second);
+
+  auto employees = std::dynamic_pointer_cast<Store>(io::Loader::shortcuts::load("test/tables/employees.tbl"));
+  store->setMain(employees->getMainTable());
+  auto replaced = store->mainStatistics();
+  ASSERT_EQ(1u, replaced.size());
+  EXPECT_NE(first[0].second, replaced[0].second);
+  EXPECT_EQ(6u, replaced[0].second->rows());
+}
+
+TEST_F(TableStatisticsTests, equi_depth_buckets_with_repeated_values) {
+  auto store = std::dynamic_pointer_cast<Store>(io::Loader::shortcuts::load("test/tables/employees.tbl"));
+  ASSERT_TRUE((bool)store);
+
+  // employee_company_id is 1, 2, 3, 3, 4 and 4
+  ChunkStatistics statistics(store->getMainTable());
+  const ColumnStatistics& column = statistics.column(1);
+  EXPECT_EQ(4u, column.distinct);
+  EXPECT_EQ(std::vector<value_id_t>({0, 1, 2, 2, 3, 3}), column.histogram);
+  EXPECT_DOUBLE_EQ(0.0, statistics.rowsBelow(1, 0));
+  EXPECT_DOUBLE_EQ(2.0, statistics.rowsBelow(1, 2));
+  EXPECT_DOUBLE_EQ(4.0, statistics.rowsBelow(1, 3));
+  EXPECT_DOUBLE_EQ(6.0, statistics.rowsBelow(1, 4));
+}
+}
+}
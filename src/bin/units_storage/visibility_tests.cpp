@@ -101,6 +101,32 @@ TEST_F(VisibilityTests, read_your_own_writes) {
   EXPECT_RELATION_EQ(io::Loader::shortcuts::load("test/lin_xxxs.tbl"), r);
 }
 
+TEST_F(VisibilityTests, deleted_main_rows_are_tracked_sparsely) {
+  auto& txmgr = hyrise::tx::TransactionManager::getInstance();
+  auto ctx_a = txmgr.buildContext();
+  auto ctx_b = txmgr.buildContext();
+
+  auto main_size = linxxxs->size();
+  ASSERT_EQ(0u, linxxxs->mainRowStateCount());
+  ASSERT_EQ(tx::START_TID, linxxxs->tid(0));
+
+  ASSERT_EQ(tx::TX_CODE::TX_OK, linxxxs->markForDeletion(0, ctx_a.tid));
+  ASSERT_EQ(tx::TX_CODE::TX_FAIL_CONCURRENT_COMMIT, linxxxs->markForDeletion(0, ctx_b.tid));
+  ASSERT_EQ(1u, linxxxs->mainRowStateCount());
+  // main rows are visible since the beginning
+  ASSERT_EQ(tx::UNKNOWN_CID, linxxxs->getBeginCid(1));
+  ASSERT_THROW(linxxxs->setBeginCid(1, ctx_a.lastCid + 1), std::runtime_error);
+
+  linxxxs->commitPositions({0}, ctx_a.lastCid + 1, false);
+  ASSERT_EQ(ctx_a.lastCid + 1, linxxxs->getEndCid(0));
+
+  // transactions started before the commit still see the row
+  ASSERT_TRUE(linxxxs->isVisibleForTransaction(0, ctx_b.lastCid, ctx_b.tid));
+  ASSERT_EQ(main_size, linxxxs->buildValidPositions(ctx_b.lastCid, ctx_b.tid).size());
+  ASSERT_FALSE(linxxxs->isVisibleForTransaction(0, ctx_a.lastCid + 1, ctx_b.tid));
+  ASSERT_EQ(main_size - 1, linxxxs->buildValidPositions(ctx_a.lastCid + 1, ctx_b.tid).size());
+}
+
 // TEST_F (VisibilityTests, read_writes_after_commit) {
 // 	auto&	 txmgr = hyrise::tx::TransactionManager::getInstance();
 // 	auto ctx_a = txmgr.buildContext();
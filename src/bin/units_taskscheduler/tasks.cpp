@@ -1,7 +1,13 @@
 // Copyright (c) 2014 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 #include "testing/test.h"
 #include "taskscheduler/Task.h"
+#include "taskscheduler/PriorityQueueType.h"
+#include "taskscheduler/ThreadLevelQueue.h"
 
 namespace hyrise {
 namespace taskscheduler {
@@ -51,5 +57,91 @@ TEST_F(MixedDependencies, noPredecessors) { ASSERT_ANY_THROW(t1->getFirstPredece
 
 // If multiple predecessors are found, return the first that was assigned.
 TEST_F(MixedDependencies, multiplePredecessors) { EXPECT_EQ(t1, t2->getFirstPredecessorOf<Task>()); }
+// Processes a number of steps and yields between two steps when asked to
+class YieldingTask : public Task {
+ public:
+  explicit YieldingTask(size_t steps, size_t step_microseconds = 0) : _steps(steps), _step_microseconds(step_microseconds) {}
+
+  const std::string vname() override { return "YieldingTask"; }
+
+  void operator()() override {
+    bool progressed = false;
+    while (done < _steps) {
+      if (progressed && shouldYield()) {
+        yield();
+        return;
+      }
+      if (_step_microseconds)
+        std::this_thread::sleep_for(std::chrono::microseconds(_step_microseconds));
+      ++done;
+      progressed = true;
+    }
+  }
+
+  std::atomic<size_t> done{0};
+
+ private:
+  size_t _steps;
+  size_t _step_microseconds;
+};
+
+TEST(CooperativeYielding, runsToCompletionWithoutWaitingHighPriorityTasks) {
+  PriorityQueueType queue;
+  auto task = std::make_shared<YieldingTask>(10);
+  EXPECT_TRUE(task->runPreemptible(waitingHighPriorityTasks(queue)));
+  EXPECT_EQ(10u, task->done);
+}
+
+TEST(CooperativeYielding, yieldsWhileHighPriorityTaskIsQueued) {
+  PriorityQueueType queue;
+  auto urgent = std::make_shared<FooTask>();
+  urgent->setPriority(Task::HIGH_PRIORITY);
+  queue.push(urgent);
+
+  auto task = std::make_shared<YieldingTask>(10);
+  EXPECT_FALSE(task->runPreemptible(waitingHighPriorityTasks(queue)));
+  EXPECT_EQ(1u, task->done);
+
+  // tasks that are not run by a scheduler or have high priority themselves do not yield
+  (*task)();
+  EXPECT_EQ(10u, task->done);
+  auto other = std::make_shared<YieldingTask>(10);
+  other->setPriority(Task::HIGH_PRIORITY);
+  EXPECT_TRUE(other->runPreemptible(waitingHighPriorityTasks(queue)));
+
+  // nor do tasks running from another queue
+  PriorityQueueType other_queue;
+  auto elsewhere = std::make_shared<YieldingTask>(10);
+  EXPECT_TRUE(elsewhere->runPreemptible(waitingHighPriorityTasks(other_queue)));
+
+  std::shared_ptr<Task> popped;
+  ASSERT_TRUE(queue.try_pop(popped));
+  EXPECT_EQ(urgent, popped);
+  auto later = std::make_shared<YieldingTask>(10);
+  EXPECT_TRUE(later->runPreemptible(waitingHighPriorityTasks(queue)));
+}
+
+TEST(CooperativeYielding, highPriorityTaskOvertakesRunningTask) {
+  auto scheduler = std::make_shared<ThreadLevelPriorityQueue>(1);
+  scheduler->init();
+
+  auto report = std::make_shared<YieldingTask>(1000, 1000);
+  auto report_done = std::make_shared<WaitTask>();
+  report_done->addDependency(report);
+  scheduler->schedule(report_done);
+  scheduler->schedule(report);
+  while (report->done == 0)
+    std::this_thread::yield();
+
+  auto urgent = std::make_shared<WaitTask>();
+  urgent->setPriority(Task::HIGH_PRIORITY);
+  scheduler->schedule(urgent);
+  urgent->wait();
+  EXPECT_LT(report->done, 1000u);
+
+  report_done->wait();
+  EXPECT_EQ(1000u, report->done);
+  scheduler->shutdown();
+}
 }
 }
@@ -0,0 +1,46 @@
+#include "access/AdmissionStatusHandler.h"
+
+#include "json.h"
+#include "net/AbstractConnection.h"
+#include "access/system/AdmissionControl.h"
+
+namespace hyrise {
+namespace access {
+
+bool AdmissionStatusHandler::registered = net::Router::registerRoute<AdmissionStatusHandler>("/admission/");
+
+AdmissionStatusHandler::AdmissionStatusHandler(net::AbstractConnection* data) : _connection_data(data) {}
+
+std::string AdmissionStatusHandler::name() { return "AdmissionStatusHandler"; }
+
+const std::string AdmissionStatusHandler::vname() { return "AdmissionStatusHandler"; }
+
+std::string AdmissionStatusHandler::constructResponse() {
+  auto& control = AdmissionControl::getInstance();
+  Json::Value result;
+  result["enabled"] = control.enabled();
+  result["workers"] = Json::Value((Json::UInt64)control.workers());
+  for (const auto& metrics : control.metrics()) {
+    Json::Value& workload_class = result["classes"][metrics.name];
+    workload_class["reservedWorkers"] = Json::Value((Json::UInt64)metrics.reserved_workers);
+    workload_class["maxConcurrency"] = Json::Value((Json::UInt64)metrics.max_concurrency);
+    workload_class["running"] = Json::Value((Json::UInt64)metrics.running);
+    workload_class["queued"] = Json::Value((Json::UInt64)metrics.queued);
+    workload_class["admitted"] = Json::Value((Json::UInt64)metrics.admitted);
+    workload_class["completed"] = Json::Value((Json::UInt64)metrics.completed);
+    workload_class["averageWaitMs"] = metrics.average_wait_ms;
+    workload_class["averageLatencyMs"] = metrics.average_latency_ms;
+    workload_class["p50LatencyMs"] = metrics.p50_latency_ms;
+    workload_class["p99LatencyMs"] = metrics.p99_latency_ms;
+    workload_class["maxLatencyMs"] = metrics.max_latency_ms;
+  }
+  Json::StyledWriter writer;
+  return writer.write(result);
+}
+
+void AdmissionStatusHandler::operator()() {
+  std::string response(constructResponse());
+  _connection_data->respond(response);
+}
+}
+}
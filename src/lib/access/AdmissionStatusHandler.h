@@ -0,0 +1,28 @@
+#ifndef SRC_LIB_ACCESS_ADMISSIONSTATUSHANDLER_H
+#define SRC_LIB_ACCESS_ADMISSIONSTATUSHANDLER_H
+
+#include "net/Router.h"
+
+namespace hyrise {
+namespace net {
+class AbstractConnection;
+}
+namespace access {
+
+/// Reports the queue lengths and latencies of the workload classes of the admission control
+class AdmissionStatusHandler : public net::AbstractRequestHandler {
+  static bool registered;
+  net::AbstractConnection* _connection_data;
+
+ public:
+  explicit AdmissionStatusHandler(net::AbstractConnection* data);
+  std::string constructResponse();
+  void operator()();
+  static std::string name();
+  const std::string vname();
+};
+}
+}
+
+
+#endif
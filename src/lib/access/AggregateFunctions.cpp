@@ -1,6 +1,9 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "AggregateFunctions.h"
 #include <storage/meta_storage.h>
+#include <storage/BaseDictionary.h>
+#include <storage/RunLengthVector.h>
+#include <storage/TableUtils.h>
 #include "json.h"
 
 namespace hyrise {
@@ -48,8 +51,18 @@ void sum_aggregate_functor::operator()() {
     }
   } else {
     size_t input_size = input->size();
+    size_t i = 0;
+
+    // A run of equal values adds value * length
+    if (auto runs = leadingRunLengthVector(*input, sourceField)) {
+      auto dict = std::dynamic_pointer_cast<BaseDictionary<R>>(input->dictionaryAt(sourceField));
+      runs->forEachRun(0, runs->rows(), [&](value_id_t value_id, size_t length) {
+        result += dict->getValueForValueId(value_id) * static_cast<R>(length);
+      });
+      i = runs->rows();
+    }
 
-    for (size_t i = 0; i < input_size; ++i) {
+    for (; i < input_size; ++i) {
       result += input->getValue<R>(sourceField, i);
     }
   }
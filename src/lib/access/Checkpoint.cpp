@@ -21,6 +21,7 @@ void Checkpoint::executePlanOperation() {
 
   auto checkpoint_id = io::Logger::getInstance().startCheckpoint();
   if (checkpoint_id > 0) {
+    auto checkpoint_cid = io::Logger::getInstance().getCheckpointCid();
     std::string path = Settings::getInstance()->getCheckpointDir() + std::to_string(checkpoint_id) + "/";
     auto sm = io::StorageManager::getInstance();
     auto tablenames = sm->getTableNames();
@@ -46,7 +47,7 @@ void Checkpoint::executePlanOperation() {
           main_dumplor.dump(tablename, a__table);
         }
         delta_dumplor.dumpDelta(tablename, a__table);
-        delta_dumplor.dumpCidVectors(tablename, a__table);
+        delta_dumplor.dumpCidVectors(tablename, a__table, checkpoint_cid);
       }
     }
 
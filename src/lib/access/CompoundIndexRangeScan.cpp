@@ -75,10 +75,10 @@ void CompoundIndexRangeScan::executePlanOperation() {
     auto s_key = _value_key_builder_min.get();
     auto up_key = _value_key_builder_max.get_upperbound();
     assert(s_key <= up_key);
-    auto iterator_pair = _delta_index->getIteratorsForKeyBetween(s_key, up_key);
-    for (auto dp = iterator_pair.first; dp != iterator_pair.second; ++dp) {
-      if (c_store->isVisibleForTransaction(dp->second, _txContext.lastCid, _txContext.tid)) {
-        validated_delta_result.push_back(dp->second);
+    auto positions = _delta_index->getPositionsForKeyBetween(s_key, up_key);
+    for (auto dp = positions.cbegin(); dp != positions.cend(); ++dp) {
+      if (c_store->isVisibleForTransaction(*dp, _txContext.lastCid, _txContext.tid)) {
+        validated_delta_result.push_back(*dp);
       }
     }
   }
@@ -87,22 +87,22 @@ void CompoundIndexScan::executePlanOperation() {
         auto s_key = _value_key_builder.get();
         auto up_key = _value_key_builder.get_upperbound();
 
-        auto iterator_pair = _delta_index->getIteratorsForKeyBetween(s_key, up_key);
+        auto positions = _delta_index->getPositionsForKeyBetween(s_key, up_key);
 
         if (!_unique_index) {
-          for (auto dp = iterator_pair.first; dp != iterator_pair.second; ++dp) {
-            if (c_store->isVisibleForTransaction(dp->second, _txContext.lastCid, _txContext.tid)) {
-              validated_delta_result.push_back(dp->second);
+          for (auto dp = positions.cbegin(); dp != positions.cend(); ++dp) {
+            if (c_store->isVisibleForTransaction(*dp, _txContext.lastCid, _txContext.tid)) {
+              validated_delta_result.push_back(*dp);
             }
           }
         } else {
           // Evaluate a unique index
-          auto dp = iterator_pair.second;
+          auto dp = positions.cend();
           // Validate entries from delta  index backwards, as newer items are to be found at the end.;
-          while (dp != iterator_pair.first) {  // skips if start==end
+          while (dp != positions.cbegin()) {  // skips if start==end
             dp--;
-            if (c_store->isVisibleForTransaction(dp->second, _txContext.lastCid, _txContext.tid)) {
-              validated_delta_result.push_back(dp->second);
+            if (c_store->isVisibleForTransaction(*dp, _txContext.lastCid, _txContext.tid)) {
+              validated_delta_result.push_back(*dp);
               skipmain = true;
               break;  // Unique Index, one hit sufficient
             }
@@ -110,22 +110,22 @@ void CompoundIndexScan::executePlanOperation() {
         }
       } else {
         // all attr in index specified
-        auto iterator_pair = _delta_index->getIteratorsForKey(_value_key_builder.get());
+        auto positions = _delta_index->getPositionsForKey(_value_key_builder.get());
 
         if (!_unique_index) {
-          for (auto dp = iterator_pair.first; dp != iterator_pair.second; ++dp) {
-            if (c_store->isVisibleForTransaction(dp->second, _txContext.lastCid, _txContext.tid)) {
-              validated_delta_result.push_back(dp->second);
+          for (auto dp = positions.cbegin(); dp != positions.cend(); ++dp) {
+            if (c_store->isVisibleForTransaction(*dp, _txContext.lastCid, _txContext.tid)) {
+              validated_delta_result.push_back(*dp);
             }
           }
         } else {
           // Evaluate a unique index
-          auto dp = iterator_pair.second;
+          auto dp = positions.cend();
           // Validate entries from delta  index backwards, as newer items are to be found at the end.;
-          while (dp != iterator_pair.first) {  // skips if start==end
+          while (dp != positions.cbegin()) {  // skips if start==end
             dp--;
-            if (c_store->isVisibleForTransaction(dp->second, _txContext.lastCid, _txContext.tid)) {
-              validated_delta_result.push_back(dp->second);
+            if (c_store->isVisibleForTransaction(*dp, _txContext.lastCid, _txContext.tid)) {
+              validated_delta_result.push_back(*dp);
               skipmain = true;
               break;  // Unique Index, one hit sufficient
             }
@@ -64,8 +64,7 @@ class CompoundIndexScan : public PlanOperation {
       value_id_t value_id;
       size_t size;
 
-      auto main_dict =
-          checked_pointer_cast<storage::OrderPreservingDictionary<T>>(input.getTables()[0]->dictionaryAt(column));
+      auto main_dict = checked_pointer_cast<storage::BaseDictionary<T>>(input.getTables()[0]->dictionaryAt(column));
       value_id = main_dict->findValueIdForValue(value);
       size = main_dict->size();
       // if this checked cast fails, check if you passed the right T (e.g., hyrise_int_t instead of int)
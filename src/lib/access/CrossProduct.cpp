@@ -0,0 +1,41 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/CrossProduct.h"
+
+#include "access/system/QueryParser.h"
+
+#include "storage/MutableVerticalTable.h"
+#include "storage/PointerCalculator.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+auto _ = QueryParser::registerTrivialPlanOperation<CrossProduct>("CrossProduct");
+}
+
+void CrossProduct::executePlanOperation() {
+  const auto& left = getInputTable(0);
+  const auto& right = getInputTable(1);
+
+  auto left_positions = new storage::pos_list_t;
+  auto right_positions = new storage::pos_list_t;
+  left_positions->reserve(left->size() * right->size());
+  right_positions->reserve(left->size() * right->size());
+  for (storage::pos_t left_row = 0; left_row < left->size(); ++left_row) {
+    left_positions->insert(left_positions->end(), right->size(), left_row);
+    for (storage::pos_t right_row = 0; right_row < right->size(); ++right_row)
+      right_positions->push_back(right_row);
+  }
+
+  std::vector<storage::atable_ptr_t> parts = {storage::PointerCalculator::create(left, left_positions),
+                                              storage::PointerCalculator::create(right, right_positions)};
+  addResult(std::make_shared<storage::MutableVerticalTable>(parts));
+}
+
+std::shared_ptr<PlanOperation> CrossProduct::copy(const Json::Value& parameters) const {
+  auto instance = std::make_shared<CrossProduct>();
+  copyConfigurationTo(*instance);
+  return instance;
+}
+}
+}
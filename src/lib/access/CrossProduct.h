@@ -0,0 +1,21 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_CROSSPRODUCT_H_
+#define SRC_LIB_ACCESS_CROSSPRODUCT_H_
+
+#include "access/system/PlanOperation.h"
+
+namespace hyrise {
+namespace access {
+
+/// Combines every row of the first input with every row of the second
+/// input. The result has the columns of the first input followed by the
+/// columns of the second one, both referenced through position lists.
+class CrossProduct : public PlanOperation {
+ public:
+  void executePlanOperation();
+  std::shared_ptr<PlanOperation> copy(const Json::Value& parameters) const override;
+};
+}
+}
+
+#endif  // SRC_LIB_ACCESS_CROSSPRODUCT_H_
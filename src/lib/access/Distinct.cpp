@@ -53,6 +53,12 @@ std::shared_ptr<PlanOperation> Distinct::parse(const Json::Value& data) {
   return s;
 }
 
+std::shared_ptr<PlanOperation> Distinct::copy(const Json::Value& parameters) const {
+  auto instance = std::make_shared<Distinct>();
+  copyConfigurationTo(*instance);
+  return instance;
+}
+
 const std::string Distinct::vname() { return "Distinct"; }
 }
 }
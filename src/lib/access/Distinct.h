@@ -16,6 +16,7 @@ class Distinct : public PlanOperation {
 
   void executePlanOperation();
   static std::shared_ptr<PlanOperation> parse(const Json::Value& data);
+  std::shared_ptr<PlanOperation> copy(const Json::Value& parameters) const override;
   const std::string vname();
 };
 }
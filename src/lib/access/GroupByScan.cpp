@@ -187,40 +187,68 @@ void GroupByScan::writeGroupResult(storage::atable_ptr_t& resultTab,
   }
 }
 
+namespace {
+template <typename HashTableType>
+struct GroupByProgress {
+  storage::atable_ptr_t resultTab;
+  pos_t row = 0;
+  typename HashTableType::map_const_iterator_t it1, end;
+};
+}
+
 template <typename HashTableType, typename MapType, typename KeyType>
 void GroupByScan::executeGroupBy() {
-  auto resultTab = createResultTableLayout();
-
-  auto groupResults = getInputHashTable();
-  // Allocate some memory for the result tab and resize the table
-  resultTab->resize(groupResults->numKeys());
-
-  pos_t row = 0;
-  typename HashTableType::map_const_iterator_t it1, it2, end;
-  // set iterators: in the sequential case, getInputTable() returns an AggregateHashTable, in the parallel case a
-  // HashTableView<>
-  // Alternatively, a common type could be introduced
-  if (_count < 1) {
-    auto aggregateHashTable = std::dynamic_pointer_cast<const HashTableType>(groupResults);
-    it1 = aggregateHashTable->getMapBegin();
-    end = aggregateHashTable->getMapEnd();
-  } else {
-    auto hashTableView = std::dynamic_pointer_cast<const storage::HashTableView<MapType, KeyType> >(groupResults);
-    it1 = hashTableView->getMapBegin();
-    end = hashTableView->getMapEnd();
+  // a continuation picks up at the first group not written yet
+  auto progress = std::static_pointer_cast<GroupByProgress<HashTableType> >(_progress);
+  _progress.reset();
+  if (!progress) {
+    progress = std::make_shared<GroupByProgress<HashTableType> >();
+    progress->resultTab = createResultTableLayout();
+
+    auto groupResults = getInputHashTable();
+    // Allocate some memory for the result tab and resize the table
+    progress->resultTab->resize(groupResults->numKeys());
+
+    // set iterators: in the sequential case, getInputTable() returns an AggregateHashTable, in the parallel case a
+    // HashTableView<>
+    // Alternatively, a common type could be introduced
+    if (_count < 1) {
+      auto aggregateHashTable = std::dynamic_pointer_cast<const HashTableType>(groupResults);
+      progress->it1 = aggregateHashTable->getMapBegin();
+      progress->end = aggregateHashTable->getMapEnd();
+    } else {
+      auto hashTableView = std::dynamic_pointer_cast<const storage::HashTableView<MapType, KeyType> >(groupResults);
+      progress->it1 = hashTableView->getMapBegin();
+      progress->end = hashTableView->getMapEnd();
+    }
   }
+
+  auto& it1 = progress->it1;
+  const auto& end = progress->end;
+  typename HashTableType::map_const_iterator_t it2;
+  size_t processed = 0;
   for (it2 = it1; it1 != end; it1 = it2) {
+    // groups are not split, a morsel ends with the first group that fills it
+    if (processed >= kMorselSize) {
+      if (shouldYield()) {
+        yield();
+        _progress = progress;
+        return;
+      }
+      processed = 0;
+    }
     // outer loop over unique keys
     auto pos_list = std::make_shared<pos_list_t>();
     for (; (it2 != end) && (it1->first == it2->first); ++it2) {
       // inner loop, all keys equal to it1->first
       pos_list->push_back(it2->second);
     }
-    writeGroupResult(resultTab, pos_list, row);
-    row++;
+    processed += pos_list->size();
+    writeGroupResult(progress->resultTab, pos_list, progress->row);
+    progress->row++;
   }
 
-  this->addResult(resultTab);
+  this->addResult(progress->resultTab);
 }
 }
 }
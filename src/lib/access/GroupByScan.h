@@ -63,6 +63,10 @@ class GroupByScan : public ParallelizablePlanOperation {
   //
   // Default values is to use the valueID hashing
   bool _globalAggregation = false;
+
+  // position in the input hash table and result of a group by that yielded,
+  // its type depends on the hash table type
+  std::shared_ptr<void> _progress;
 };
 }
 }
@@ -19,16 +19,18 @@ void HashBuild::executePlanOperation() {
   auto input = std::dynamic_pointer_cast<const storage::TableRangeView>(getInputTable());
   if (input)
     row_offset = input->getStart();
+  const auto& arena = getQueryArena();
   if (_key == "groupby" || _key == "selfjoin") {
     if (_field_definition.size() == 1)
-      addResult(std::make_shared<storage::SingleAggregateHashTable>(getInputTable(), _field_definition, row_offset));
+      addResult(
+          std::make_shared<storage::SingleAggregateHashTable>(getInputTable(), _field_definition, row_offset, arena));
     else
-      addResult(std::make_shared<storage::AggregateHashTable>(getInputTable(), _field_definition, row_offset));
+      addResult(std::make_shared<storage::AggregateHashTable>(getInputTable(), _field_definition, row_offset, arena));
   } else if (_key == "join") {
     if (_field_definition.size() == 1)
-      addResult(std::make_shared<storage::SingleJoinHashTable>(getInputTable(), _field_definition, row_offset));
+      addResult(std::make_shared<storage::SingleJoinHashTable>(getInputTable(), _field_definition, row_offset, arena));
     else
-      addResult(std::make_shared<storage::JoinHashTable>(getInputTable(), _field_definition, row_offset));
+      addResult(std::make_shared<storage::JoinHashTable>(getInputTable(), _field_definition, row_offset, arena));
   } else {
     throw std::runtime_error("Type in Plan operation HashBuild not supported; key: " + _key);
   }
@@ -47,6 +49,13 @@ std::shared_ptr<PlanOperation> HashBuild::parse(const Json::Value& data) {
   return instance;
 }
 
+std::shared_ptr<PlanOperation> HashBuild::copy(const Json::Value& parameters) const {
+  auto instance = std::make_shared<HashBuild>();
+  copyConfigurationTo(*instance);
+  instance->_key = _key;
+  return instance;
+}
+
 const std::string HashBuild::vname() { return "HashBuild"; }
 
 void HashBuild::setKey(const std::string& key) { _key = key; }
@@ -27,6 +27,7 @@ class HashBuild : public ParallelizablePlanOperation {
   ///         "edges": [["0", "1"]]
   /// }
   static std::shared_ptr<PlanOperation> parse(const Json::Value& data);
+  std::shared_ptr<PlanOperation> copy(const Json::Value& parameters) const override;
   const std::string vname();
   void setKey(const std::string& key);
   const std::string getKey() const;
@@ -55,6 +55,13 @@ std::shared_ptr<PlanOperation> HashJoinProbe::parse(const Json::Value& data) {
   return instance;
 }
 
+std::shared_ptr<PlanOperation> HashJoinProbe::copy(const Json::Value& parameters) const {
+  auto instance = std::make_shared<HashJoinProbe>();
+  copyConfigurationTo(*instance);
+  instance->_selfjoin = _selfjoin;
+  return instance;
+}
+
 const std::string HashJoinProbe::vname() { return "HashJoinProbe"; }
 
 void HashJoinProbe::setBuildTable(const storage::c_atable_ptr_t& table) { _buildTable = table; }
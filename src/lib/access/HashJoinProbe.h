@@ -42,6 +42,7 @@ class HashJoinProbe : public ParallelizablePlanOperation {
   ///     "edges": [["0", "2"], ["2", "3"], ["1", "3"]]
   /// }
   static std::shared_ptr<PlanOperation> parse(const Json::Value& data);
+  std::shared_ptr<PlanOperation> copy(const Json::Value& parameters) const override;
   const std::string vname();
   void setBuildTable(const storage::c_atable_ptr_t& table);
   storage::c_atable_ptr_t getBuildTable() const;
@@ -72,9 +72,6 @@ void InsertScan::executePlanOperation() {
     for (size_t i = 0; i < rowCount; ++i) {
       store->copyRowToDeltaFromJSONVector(_raw_data[i], writeArea.first + i, _txContext.tid);
 
-      // Update delta indices
-      store->addRowToDeltaIndices(firstPosition + i);
-
       mods.insertPos(store, firstPosition + i);
 
 #ifdef PERSISTENCY_BUFFEREDLOGGER
@@ -87,9 +84,6 @@ void InsertScan::executePlanOperation() {
     for (size_t i = 0; i < rowCount; ++i) {
       store->copyRowToDelta(_data, i, writeArea.first + i, _txContext.tid);
 
-      // Update delta indices
-      store->addRowToDeltaIndices(firstPosition + i);
-
       mods.insertPos(store, firstPosition + i);
 
 #ifdef PERSISTENCY_BUFFEREDLOGGER
@@ -100,6 +94,9 @@ void InsertScan::executePlanOperation() {
     }
   }
 
+  // Update delta indices for all inserted rows at once
+  store->addRowsToDeltaIndices(firstPosition, rowCount);
+
   auto rsp = getResponseTask();
   if (rsp != nullptr)
     rsp->incAffectedRows(rowCount);
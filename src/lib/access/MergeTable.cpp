@@ -47,16 +47,22 @@ namespace {
 auto _2 = QueryParser::registerPlanOperation<MergeStore>("MergeStore");
 }
 
+MergeStore::MergeStore(size_t chunkSize) : _chunkSize(chunkSize) {}
+
 MergeStore::~MergeStore() {}
 
 void MergeStore::executePlanOperation() {
   auto t = checked_pointer_cast<const storage::Store>(getInputTable());
   auto store = std::const_pointer_cast<storage::Store>(t);
+  if (_chunkSize > 0)
+    store->setMainChunkSize(_chunkSize);
   store->merge();
   addResult(store);
 }
 
-std::shared_ptr<PlanOperation> MergeStore::parse(const Json::Value& data) { return std::make_shared<MergeStore>(); }
+std::shared_ptr<PlanOperation> MergeStore::parse(const Json::Value& data) {
+  return std::make_shared<MergeStore>(data.get("chunk_size", 0).asUInt());
+}
 
 namespace {
 auto _3 = QueryParser::registerPlanOperation<MergeColumnStore>("MergeColumnStore");
@@ -18,9 +18,14 @@ class MergeTable : public PlanOperation {
 
 class MergeStore : public PlanOperation {
  public:
+  // a chunk size > 0 switches the store to a chunked main before merging
+  explicit MergeStore(size_t chunkSize = 0);
   virtual ~MergeStore();
   void executePlanOperation();
   static std::shared_ptr<PlanOperation> parse(const Json::Value& data);
+
+ private:
+  size_t _chunkSize;
 };
 
 class MergeColumnStore : public PlanOperation {
@@ -25,10 +25,12 @@ size_t addEntriesForTableToResultTable(std::shared_ptr<const storage::AbstractTa
                                        std::shared_ptr<storage::AbstractTable> result,
                                        size_t row_count) {
   result->resize(result->size() + table->columnCount());
+  const std::string memory_policy = table->memoryPolicy().toString();
   for (field_t i = 0; i != table->columnCount(); ++i) {
     result->setValue<hyrise_string_t>(result->numberOfColumn("table"), row_count, tableName);
     result->setValue<hyrise_string_t>(result->numberOfColumn("column"), row_count, table->metadataAt(i).getName());
     result->setValue<hyrise_int_t>(result->numberOfColumn("data_type"), row_count, table->metadataAt(i).getType());
+    result->setValue<hyrise_string_t>(result->numberOfColumn("memory_policy"), row_count, memory_policy);
 
     ++row_count;
   }
@@ -41,6 +43,7 @@ void MetaData::executePlanOperation() {
   list.append().set_type("STRING").set_name("table");
   list.append().set_type("STRING").set_name("column");
   list.append().set_type("INTEGER").set_name("data_type");  // output as string?
+  list.append().set_type("STRING").set_name("memory_policy");
   auto meta_data = storage::TableBuilder::build(list);
 
   size_t row_count = 0;
@@ -30,16 +30,18 @@ void PipeliningHashBuild::executePlanOperation() {
   auto input = std::dynamic_pointer_cast<const storage::TableRangeView>(getInputTable());
   if (input)
     row_offset = input->getStart();
+  const auto& arena = getQueryArena();
   if (_key == "groupby" || _key == "selfjoin") {
     if (_field_definition.size() == 1)
-      emitChunk(std::make_shared<storage::SingleAggregateHashTable>(getInputTable(), _field_definition, row_offset));
+      emitChunk(
+          std::make_shared<storage::SingleAggregateHashTable>(getInputTable(), _field_definition, row_offset, arena));
     else
-      emitChunk(std::make_shared<storage::AggregateHashTable>(getInputTable(), _field_definition, row_offset));
+      emitChunk(std::make_shared<storage::AggregateHashTable>(getInputTable(), _field_definition, row_offset, arena));
   } else if (_key == "join") {
     if (_field_definition.size() == 1)
-      emitChunk(std::make_shared<storage::SingleJoinHashTable>(getInputTable(), _field_definition, row_offset));
+      emitChunk(std::make_shared<storage::SingleJoinHashTable>(getInputTable(), _field_definition, row_offset, arena));
     else
-      emitChunk(std::make_shared<storage::JoinHashTable>(getInputTable(), _field_definition, row_offset));
+      emitChunk(std::make_shared<storage::JoinHashTable>(getInputTable(), _field_definition, row_offset, arena));
   } else {
     throw std::runtime_error("Type in Plan operation HashBuild not supported; key: " + _key);
   }
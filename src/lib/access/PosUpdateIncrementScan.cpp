@@ -58,6 +58,7 @@ void PosUpdateIncrementScan::executePlanOperation() {
   auto* positions = pc->getPositions();
   // Retrieve first row index of exclusive delta space
   auto delta_row = store->appendToDelta(positions->size()).first;
+  const auto first_delta_row = delta_row;
 
   auto& txmgr = tx::TransactionManager::getInstance();
   auto& modRecord = txmgr[_txContext.tid];
@@ -86,9 +87,6 @@ void PosUpdateIncrementScan::executePlanOperation() {
     fun.set(column_idx, delta_row, _offset);
     ts(store->typeOfColumn(column_idx), fun);
 
-    // Update delta indices
-    store->addRowToDeltaIndices(main_size + delta_row);
-
     // add inserted pos to mod record. use absolute pos not pos in delta (!)
     modRecord.insertPos(store, main_size + delta_row);
 
@@ -104,6 +102,9 @@ void PosUpdateIncrementScan::executePlanOperation() {
     ++delta_row;
   }
 
+  // Update delta indices for all new row versions at once
+  store->addRowsToDeltaIndices(main_size + first_delta_row, positions->size());
+
   if (auto rsp = getResponseTask()) {
     rsp->incAffectedRows(positions->size());
   }
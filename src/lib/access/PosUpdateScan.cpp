@@ -70,9 +70,6 @@ void PosUpdateScan::executePlanOperation() {
       ts(store->typeOfColumn(fld), fun);
     }
 
-    // Update delta indices
-    store->addRowToDeltaIndices(firstPosition + counter);
-
     // Insert the new one
     modRecord.insertPos(store, firstPosition + counter);
 
@@ -87,6 +84,9 @@ void PosUpdateScan::executePlanOperation() {
     ++counter;
   }
 
+  // Update delta indices for all new row versions at once
+  store->addRowsToDeltaIndices(firstPosition, counter);
+
   // Update affected rows
   auto rsp = getResponseTask();
   if (rsp != nullptr)
@@ -39,6 +39,12 @@ std::shared_ptr<PlanOperation> ProjectionScan::parse(const Json::Value& data) {
   return p;
 }
 
+std::shared_ptr<PlanOperation> ProjectionScan::copy(const Json::Value& parameters) const {
+  auto instance = std::make_shared<ProjectionScan>();
+  copyConfigurationTo(*instance);
+  return instance;
+}
+
 const std::string ProjectionScan::vname() { return "ProjectionScan"; }
 }
 }
@@ -12,6 +12,7 @@ class ProjectionScan : public PlanOperation {
   void setupPlanOperation();
   void executePlanOperation();
   static std::shared_ptr<PlanOperation> parse(const Json::Value& data);
+  std::shared_ptr<PlanOperation> copy(const Json::Value& parameters) const override;
   const std::string vname();
 };
 }
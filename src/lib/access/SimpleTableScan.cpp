@@ -2,6 +2,7 @@
 #include "access/SimpleTableScan.h"
 
 #include "access/expressions/pred_buildExpression.h"
+#include "access/system/PlanCache.h"
 
 #include "storage/Store.h"
 #include "storage/PointerCalculator.h"
@@ -26,32 +27,42 @@ void SimpleTableScan::setupPlanOperation() { _comparator->walk(input.getTables()
 
 void SimpleTableScan::executePositional() {
   auto tbl = input.getTable(0);
-  storage::pos_list_t* pos_list = new pos_list_t();
-
-
-  size_t row = _ofDelta ? checked_pointer_cast<const storage::Store>(tbl)->deltaOffset() : 0;
-  for (size_t input_size = tbl->size(); row < input_size; ++row) {
-    if ((*_comparator)(row)) {
-      pos_list->push_back(row);
+  if (!_positions)
+    _positions.reset(new pos_list_t());
+
+  size_t first = _ofDelta ? checked_pointer_cast<const storage::Store>(tbl)->deltaOffset() : 0;
+  bool done = processMorsels(tbl->size() - first, [this, first](size_t begin, size_t end) {
+    for (size_t row = first + begin; row < first + end; ++row) {
+      if ((*_comparator)(row)) {
+        _positions->push_back(row);
+      }
     }
-  }
-  addResult(storage::PointerCalculator::create(tbl, pos_list));
+  });
+  if (done)
+    addResult(storage::PointerCalculator::create(tbl, _positions.release()));
 }
 
 void SimpleTableScan::executeMaterialized() {
   auto tbl = input.getTable(0);
-  auto result_table = tbl->copy_structure_modifiable();
-  size_t target_row = 0;
-
-  size_t row = _ofDelta ? checked_pointer_cast<const storage::Store>(tbl)->deltaOffset() : 0;
-  for (size_t input_size = tbl->size(); row < input_size; ++row) {
-    if ((*_comparator)(row)) {
-      // TODO materializing result set will make the allocation the boundary
-      result_table->resize(target_row + 1);
-      result_table->copyRowFrom(input.getTable(0), row, target_row++, true /* Copy Value*/, false /* Use Memcpy */);
+  if (!_result_table) {
+    _result_table = tbl->copy_structure_modifiable();
+    _target_row = 0;
+  }
+
+  size_t first = _ofDelta ? checked_pointer_cast<const storage::Store>(tbl)->deltaOffset() : 0;
+  bool done = processMorsels(tbl->size() - first, [this, &tbl, first](size_t begin, size_t end) {
+    for (size_t row = first + begin; row < first + end; ++row) {
+      if ((*_comparator)(row)) {
+        // TODO materializing result set will make the allocation the boundary
+        _result_table->resize(_target_row + 1);
+        _result_table->copyRowFrom(tbl, row, _target_row++, true /* Copy Value*/, false /* Use Memcpy */);
+      }
     }
+  });
+  if (done) {
+    addResult(_result_table);
+    _result_table.reset();
   }
-  addResult(result_table);
 }
 
 void SimpleTableScan::executePlanOperation() {
@@ -80,8 +91,23 @@ std::shared_ptr<PlanOperation> SimpleTableScan::parse(const Json::Value& data) {
   return pop;
 }
 
+std::shared_ptr<PlanOperation> SimpleTableScan::copy(const Json::Value& parameters) const {
+  if (_predicates.isNull())
+    return nullptr;
+  auto instance = std::make_shared<SimpleTableScan>();
+  copyConfigurationTo(*instance);
+  instance->setPredicate(_predicates, parameters);
+  instance->_ofDelta = _ofDelta;
+  return instance;
+}
+
 const std::string SimpleTableScan::vname() { return "SimpleTableScan"; }
 
 void SimpleTableScan::setPredicate(SimpleExpression* c) { _comparator = c; }
+
+void SimpleTableScan::setPredicate(const Json::Value& predicates, const Json::Value& parameters) {
+  _predicates = predicates;
+  setPredicate(buildExpression(PlanCache::bindParameters(predicates, parameters)));
+}
 }
 }
@@ -18,12 +18,22 @@ class SimpleTableScan : public ParallelizablePlanOperation {
   void executePositional();
   void executeMaterialized();
   static std::shared_ptr<PlanOperation> parse(const Json::Value& data);
+  std::shared_ptr<PlanOperation> copy(const Json::Value& parameters) const override;
   const std::string vname();
   void setPredicate(SimpleExpression* c);
+  // Builds the predicate with the given parameters bound, copies of the scan bind their own
+  void setPredicate(const Json::Value& predicates, const Json::Value& parameters);
 
  private:
   SimpleExpression* _comparator;
+  // unbound predicates if the predicate was built from them
+  Json::Value _predicates;
   bool _ofDelta = false;
+
+  // result of the morsels scanned so far
+  std::unique_ptr<storage::pos_list_t> _positions;
+  storage::atable_ptr_t _result_table;
+  size_t _target_row = 0;
 };
 }
 }
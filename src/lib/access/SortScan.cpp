@@ -135,6 +135,15 @@ std::shared_ptr<PlanOperation> SortScan::parse(const Json::Value& data) {
   return s;
 }
 
+std::shared_ptr<PlanOperation> SortScan::copy(const Json::Value& parameters) const {
+  auto instance = std::make_shared<SortScan>();
+  copyConfigurationTo(*instance);
+  instance->_sort_field = _sort_field;
+  instance->_sort_field_name = _sort_field_name;
+  instance->_asc = _asc;
+  return instance;
+}
+
 const std::string SortScan::vname() { return "SortScan"; }
 
 void SortScan::setSortField(const unsigned s) { _sort_field = s; }
@@ -13,6 +13,7 @@ class SortScan : public PlanOperation {
 
   void executePlanOperation();
   static std::shared_ptr<PlanOperation> parse(const Json::Value& data);
+  std::shared_ptr<PlanOperation> copy(const Json::Value& parameters) const override;
   const std::string vname();
   void setSortField(const unsigned s);
   void setSortField(const std::string& s);
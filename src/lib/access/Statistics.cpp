@@ -0,0 +1,98 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/Statistics.h"
+
+#include "access/system/QueryParser.h"
+
+#include "io/StorageManager.h"
+
+#include "storage/storage_types.h"
+#include "storage/TableBuilder.h"
+#include "storage/TableStatistics.h"
+
+#include <sstream>
+
+namespace hyrise {
+namespace access {
+
+namespace {
+auto _ = QueryParser::registerTrivialPlanOperation<Statistics>("Statistics");
+
+void addRow(const storage::atable_ptr_t& result,
+            const std::string& tableName,
+            const std::string& columnName,
+            hyrise_int_t chunk,
+            hyrise_int_t rows,
+            hyrise_int_t distinct,
+            hyrise_int_t min,
+            hyrise_int_t max,
+            const std::string& histogram) {
+  size_t row = result->size();
+  result->resize(row + 1);
+  result->setValue<hyrise_string_t>(0, row, tableName);
+  result->setValue<hyrise_string_t>(1, row, columnName);
+  result->setValue<hyrise_int_t>(2, row, chunk);
+  result->setValue<hyrise_int_t>(3, row, rows);
+  result->setValue<hyrise_int_t>(4, row, distinct);
+  result->setValue<hyrise_int_t>(5, row, min);
+  result->setValue<hyrise_int_t>(6, row, max);
+  result->setValue<hyrise_string_t>(7, row, histogram);
+}
+
+void addEntriesForTableToResultTable(const storage::c_atable_ptr_t& table,
+                                     const std::string& tableName,
+                                     const storage::atable_ptr_t& result) {
+  storage::TableStatistics statistics(table);
+  for (field_t column = 0; column != table->columnCount(); ++column) {
+    const std::string& columnName = table->metadataAt(column).getName();
+
+    for (size_t i = 0; i < statistics.chunkCount(); ++i) {
+      const storage::ColumnStatistics& chunk = statistics.chunk(i).column(column);
+      std::ostringstream histogram;
+      for (size_t bucket = 0; bucket < chunk.histogram.size(); ++bucket)
+        histogram << (bucket > 0 ? " " : "") << chunk.histogram[bucket];
+      addRow(result, tableName, columnName, i, statistics.chunk(i).rows(), chunk.distinct, chunk.min, chunk.max,
+             histogram.str());
+    }
+
+    if (statistics.deltaRows() > 0)
+      addRow(result, tableName, columnName, -1, statistics.deltaRows(), statistics.deltaDistinct(column), 0, 0, "");
+  }
+}
+}
+
+void Statistics::executePlanOperation() {
+  storage::TableBuilder::param_list list;
+  list.append().set_type("STRING").set_name("table");
+  list.append().set_type("STRING").set_name("column");
+  list.append().set_type("INTEGER").set_name("chunk");
+  list.append().set_type("INTEGER").set_name("rows");
+  list.append().set_type("INTEGER").set_name("distinct");
+  list.append().set_type("INTEGER").set_name("min_value_id");
+  list.append().set_type("INTEGER").set_name("max_value_id");
+  list.append().set_type("STRING").set_name("histogram");
+  auto statistics = storage::TableBuilder::build(list);
+
+  const auto& storageManager = io::StorageManager::getInstance();
+
+  if (input.numberOfTables() == 0) {
+    for (const auto& tableName : storageManager->getTableNames())
+      addEntriesForTableToResultTable(storageManager->getTable(tableName), tableName, statistics);
+  } else {
+    const auto& loaded_tables = storageManager->all();
+    for (size_t i = 0; i < input.numberOfTables(); ++i) {
+      auto inputTable = input.getTable(i);
+      std::string tableName = "unknown/temporary";
+      for (const auto& table : loaded_tables) {
+        if (table.second == inputTable) {
+          tableName = table.first;
+          break;
+        }
+      }
+      addEntriesForTableToResultTable(inputTable, tableName, statistics);
+    }
+  }
+
+  addResult(statistics);
+}
+}
+}
@@ -0,0 +1,20 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_STATISTICS_H_
+#define SRC_LIB_ACCESS_STATISTICS_H_
+
+#include "access/system/PlanOperation.h"
+
+namespace hyrise {
+namespace access {
+
+/// Reports the column statistics of the input tables, or of all loaded
+/// tables without input. Every main chunk of a column gets a row, the
+/// delta a row with chunk -1.
+class Statistics : public PlanOperation {
+ public:
+  void executePlanOperation();
+};
+}
+}
+
+#endif  // SRC_LIB_ACCESS_STATISTICS_H_
@@ -5,6 +5,7 @@
 #include "access/expressions/pred_SimpleExpression.h"
 #include "access/expressions/ExpressionRegistration.h"
 #include "storage/PointerCalculator.h"
+#include "storage/Store.h"
 #include "storage/TableRangeView.h"
 #include "helper/types.h"
 #include "helper/make_unique.h"
@@ -45,17 +46,20 @@ void TableScan::executePlanOperation() {
   }
 
   // When the input is 0, dont bother trying to generate results
-  pos_list_t* positions = new pos_list_t();
-  if (stop - start > 0) {
-    _expr->match(positions, start, stop);
-  }
+  if (!_positions)
+    _positions.reset(new pos_list_t());
+  bool done = processMorsels(stop - start, [this, start](size_t begin, size_t end) {
+    _expr->match(_positions.get(), start + begin, start + end);
+  });
+  if (!done)
+    return;
 
   std::shared_ptr<storage::PointerCalculator> result;
 
   if (tablerange)
-    result = storage::PointerCalculator::create(tablerange->getActualTable(), positions);
+    result = storage::PointerCalculator::create(tablerange->getActualTable(), _positions.release());
   else
-    result = storage::PointerCalculator::create(getInputTable(), positions);
+    result = storage::PointerCalculator::create(getInputTable(), _positions.release());
 
   addResult(result);
 }
@@ -75,6 +79,10 @@ taskscheduler::DynamicCount TableScan::determineDynamicCount(size_t maxTaskRunTi
   // this is the model solved for variable "instances"
   size_t instances = static_cast<int>(round((_a * tblsize) / (maxTaskRunTime - _b * tblsize - _c)));
 
+  // chunks of a chunked main are scanned in parallel
+  if (auto store = std::dynamic_pointer_cast<const storage::Store>(inputTable))
+    instances = std::max(instances, store->mainChunkCount() > 1 ? store->chunkOffsets().size() : 1);
+
   taskscheduler::DynamicCount count{std::max((size_t)1, instances), 0, 0, 0};
   return count;
 }
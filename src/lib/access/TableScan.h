@@ -5,6 +5,7 @@
 #include <memory>
 #include "access/system/ParallelizablePlanOperation.h"
 #include "helper/types.h"
+#include "storage/storage_types.h"
 
 namespace hyrise {
 namespace access {
@@ -30,6 +31,8 @@ class TableScan : public ParallelizablePlanOperation {
 
  private:
   std::unique_ptr<AbstractExpression> _expr;
+  // matches of the morsels scanned so far
+  std::unique_ptr<storage::pos_list_t> _positions;
 
   // parameters for MTS model
   double _a = 3.85258544e-01;
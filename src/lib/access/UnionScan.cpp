@@ -29,5 +29,11 @@ void UnionScan::executePlanOperation() {
     // addResult(std::make_shared<const HorizontalTable>(tables));
   }
 }
+
+std::shared_ptr<PlanOperation> UnionScan::copy(const Json::Value& parameters) const {
+  auto instance = std::make_shared<UnionScan>();
+  copyConfigurationTo(*instance);
+  return instance;
+}
 }
 }
@@ -10,6 +10,7 @@ namespace access {
 class UnionScan : public PlanOperation {
  public:
   void executePlanOperation();
+  std::shared_ptr<PlanOperation> copy(const Json::Value& parameters) const override;
 };
 }
 }
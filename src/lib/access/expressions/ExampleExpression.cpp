@@ -31,7 +31,7 @@ void ExampleExpression::walk(const std::vector<storage::c_atable_ptr_t>& tables)
   _table = tables.at(0);
   const auto& avs = _table->getAttributeVectors(_column);
   _vector = std::dynamic_pointer_cast<storage::FixedLengthVector<value_id_t>>(avs.at(0).attribute_vector);
-  _dict = std::dynamic_pointer_cast<storage::OrderPreservingDictionary<hyrise_int_t>>(_table->dictionaryAt(_column));
+  _dict = std::dynamic_pointer_cast<storage::BaseDictionary<hyrise_int_t>>(_table->dictionaryAt(_column));
   if (!(_vector && _dict))
     throw std::runtime_error("Could not extract proper structures");
   _valueid = _dict->getValueIdForValue(_value);
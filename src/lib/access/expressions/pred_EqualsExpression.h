@@ -2,6 +2,8 @@
 #pragma once
 
 #include "helper/types.h"
+#include "storage/RunLengthVector.h"
+#include "storage/TableUtils.h"
 
 #include "pred_common.h"
 
@@ -14,6 +16,32 @@ class EqualsExpression : public SimpleFieldExpression {
   ValueId lower_bound;
   std::shared_ptr<storage::BaseDictionary<T>> valueIdMap;
   bool value_exists;
+  // value id of the value in each subtable, e.g. the chunks of a chunked main and the delta
+  std::vector<value_id_t> subtable_value_ids;
+
+  value_id_t valueIdInSubtable(table_id_t table_id) {
+    while (subtable_value_ids.size() <= table_id) {
+      auto dictionary = std::dynamic_pointer_cast<storage::BaseDictionary<T>>(
+          table->dictionaryByTableId(field, subtable_value_ids.size()));
+      subtable_value_ids.push_back(dictionary->findValueIdForValue(value));
+    }
+    return subtable_value_ids[table_id];
+  }
+
+  // Run-length encoded leading rows are evaluated once per run
+  std::shared_ptr<storage::RunLengthVector<value_id_t>> runs;
+  pos_t run_begin = 0, run_end = 0;
+  bool run_matches = false;
+
+  bool matchRun(size_t row) {
+    if (row < run_begin || row >= run_end) {
+      auto run = runs->runIndex(row);
+      run_begin = runs->runBegin(run);
+      run_end = runs->runEnd(run);
+      run_matches = value_exists && runs->runValue(run) == lower_bound.valueId;
+    }
+    return run_matches;
+  }
 
  public:
   T value;
@@ -33,6 +61,10 @@ class EqualsExpression : public SimpleFieldExpression {
 
     value_exists =
         (lower_bound.valueId = valueIdMap->findValueIdForValue(value)) != std::numeric_limits<value_id_t>::max();
+
+    runs = storage::leadingRunLengthVector(*table, field);
+    run_begin = run_end = 0;
+    subtable_value_ids.clear();
   }
 
   virtual std::unique_ptr<AbstractExpression> clone() {
@@ -41,7 +73,15 @@ class EqualsExpression : public SimpleFieldExpression {
 
   virtual ~EqualsExpression() {}
 
-  inline virtual bool operator()(size_t row) { return value_exists && table->getValueId(field, row) == lower_bound; }
+  inline virtual bool operator()(size_t row) {
+    if (runs && row < runs->rows())
+      return matchRun(row);
+    ValueId valueId = table->getValueId(field, row);
+    if (valueId.table == lower_bound.table)
+      return value_exists && valueId.valueId == lower_bound.valueId;
+    // the value is missing from a subtable if it has the maximal value id
+    return valueId.valueId == valueIdInSubtable(valueId.table);
+  }
 };
 }
 }  // namespace hyrise::access
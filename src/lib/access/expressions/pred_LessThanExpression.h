@@ -35,10 +35,15 @@ class LessThanExpression : public SimpleFieldExpression {
 
   inline virtual bool operator()(size_t row) {
     ValueId valueId = table->getValueId(field, row);
-    if (valueId.valueId < lower_bound.valueId) {
-      return true;
-    } else
-      return false;
+    if (valueId.table == lower_bound.table) {
+      if (valueId.valueId < lower_bound.valueId) {
+        return true;
+      } else
+        return false;
+    }
+
+    // value ids of other subtables, e.g. later chunks of a chunked main, use other dictionaries
+    return table->getValue<T>(field, row) < value;
   }
 };
 }
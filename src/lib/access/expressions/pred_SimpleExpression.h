@@ -13,7 +13,7 @@ class SimpleExpression : public access::AbstractExpression {
   virtual void walk(const std::vector<storage::c_atable_ptr_t>& l) = 0;
 
   virtual void match(storage::pos_list_t* pl, const size_t start, const size_t stop) {
-    for (size_t row = 0; row < stop; ++row) {
+    for (size_t row = start; row < stop; ++row) {
       if (operator()(row)) {
         pl->push_back(row);
       }
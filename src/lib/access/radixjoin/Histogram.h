@@ -2,11 +2,14 @@
 #ifndef SRC_LIB_ACCESS_HISTOGRAM_H_
 #define SRC_LIB_ACCESS_HISTOGRAM_H_
 
+#include <algorithm>
+
 #include "access/system/ParallelizablePlanOperation.h"
 
 #include "storage/FixedLengthVector.h"
 #include "storage/BaseAttributeVector.h"
 #include "storage/BaseDictionary.h"
+#include "storage/HorizontalTable.h"
 #include "storage/PointerCalculator.h"
 #include "storage/Store.h"
 #include "helper/types.h"
@@ -86,23 +89,44 @@ void _executeRadixHashing(storage::c_atable_ptr_t sourceTab,
   const auto& main = store->getMainTable();
   const auto& delta = store->getDeltaTable();
 
-  std::shared_ptr<storage::BaseAttributeVector<value_id_t>> ivec_main, ivec_delta;
-  size_t offset_main, offset_delta;
-  std::tie(ivec_main, offset_main) = getBaseVector(main, column);
-  std::tie(ivec_delta, offset_delta) = getBaseVector(delta, column);
-
-  size_t main_size = ivec_main->size();
+  // a chunked main has an attribute vector and a dictionary per chunk
+  std::vector<storage::c_atable_ptr_t> chunks;
+  if (auto chunked = std::dynamic_pointer_cast<const storage::HorizontalTable>(main))
+    chunks = chunked->parts();
+  else
+    chunks.push_back(main);
+
+  std::vector<std::shared_ptr<storage::BaseAttributeVector<value_id_t>>> ivecs_main(chunks.size());
+  std::vector<size_t> offsets_main(chunks.size());
+  std::vector<std::shared_ptr<storage::BaseDictionary<T>>> main_dicts(chunks.size());
+  // first row after each chunk
+  std::vector<size_t> chunk_ends(chunks.size());
+  size_t main_size = 0;
+  for (size_t chunk = 0; chunk < chunks.size(); ++chunk) {
+    std::tie(ivecs_main[chunk], offsets_main[chunk]) = getBaseVector(chunks[chunk], column);
+    main_dicts[chunk] = std::dynamic_pointer_cast<storage::BaseDictionary<T>>(chunks[chunk]->dictionaryAt(column));
+    main_size += chunks[chunk]->size();
+    chunk_ends[chunk] = main_size;
+  }
 
-  const auto& main_dict = std::dynamic_pointer_cast<storage::BaseDictionary<T>>(main->dictionaryAt(column));
+  std::shared_ptr<storage::BaseAttributeVector<value_id_t>> ivec_delta;
+  size_t offset_delta;
+  std::tie(ivec_delta, offset_delta) = getBaseVector(delta, column);
   const auto& delta_dict = std::dynamic_pointer_cast<storage::BaseDictionary<T>>(delta->dictionaryAt(column));
 
   auto hasher = std::hash<T>();
   auto mask = ((1 << bits) - 1) << significantOffset;
   size_t hash_value;
+  size_t chunk = 0;
   for (size_t row = start; row < stop; ++row) {
     size_t actual_row = pc_pos_list ? pc_pos_list->at(row) : row;
     if (actual_row < main_size) {
-      hash_value = hasher(main_dict->getValueForValueId(ivec_main->get(offset_main, actual_row)));
+      // rows are mostly read in order, only search when leaving the current chunk
+      if (actual_row >= chunk_ends[chunk] || (chunk > 0 && actual_row < chunk_ends[chunk - 1]))
+        chunk = std::upper_bound(chunk_ends.begin(), chunk_ends.end(), actual_row) - chunk_ends.begin();
+      size_t chunk_row = chunk > 0 ? actual_row - chunk_ends[chunk - 1] : actual_row;
+      hash_value =
+          hasher(main_dicts[chunk]->getValueForValueId(ivecs_main[chunk]->get(offsets_main[chunk], chunk_row)));
     } else {
       hash_value = hasher(delta_dict->getValueForValueId(ivec_delta->get(offset_delta, actual_row - main_size)));
     }
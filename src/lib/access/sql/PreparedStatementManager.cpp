@@ -2,6 +2,10 @@
 
 #include "access/sql/PreparedStatementManager.h"
 
+#include "io/ResourceManager.h"
+
+#include <algorithm>
+
 using namespace hsql;
 
 namespace hyrise {
@@ -9,30 +13,171 @@ namespace access {
 namespace sql {
 
 
+namespace {
+// Copies the operations of tasks with parameters bound and the dependencies between them
+bool copyPlan(const TransformedPlan& plan, const Json::Value& parameters, TransformedPlan& copy) {
+  task_list_t tasks;
+  for (const task_t& task : plan.tasks) {
+    auto op = std::dynamic_pointer_cast<PlanOperation>(task);
+    plan_op_t instance = (op != nullptr) ? op->copy(parameters) : nullptr;
+    if (instance == nullptr) return false;
+    tasks.push_back(instance);
+  }
+
+  for (size_t i = 0; i < plan.tasks.size(); ++i) {
+    int dependencies = 0;
+    for (size_t j = 0; j < plan.tasks.size(); ++j) {
+      if (!plan.tasks[i]->isDependency(plan.tasks[j])) continue;
+      tasks[i]->addDependency(tasks[j]);
+      ++dependencies;
+    }
+    // Dependencies on tasks outside of the plan can't be copied
+    if (dependencies != plan.tasks[i]->getDependencyCount()) return false;
+  }
+
+  copy.meta = plan.meta;
+  for (task_t* task : {&copy.meta.first_task, &copy.meta.last_task}) {
+    if (*task == nullptr) continue;
+    auto it = std::find(plan.tasks.begin(), plan.tasks.end(), *task);
+    if (it == plan.tasks.end()) return false;
+    *task = tasks[it - plan.tasks.begin()];
+  }
+  copy.tasks.swap(tasks);
+  return true;
+}
+}
+
+
+PreparedPlan::PreparedPlan(PrepareStatement* stmt) :
+  _stmt(stmt),
+  _generation(io::ResourceManager::getInstance().generation()) {}
+
+PreparedPlan::~PreparedPlan() {
+  delete _stmt;
+}
+
+bool PreparedPlan::getTableInfo(const std::string& name, TableInfo& info) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  dropIfOutdated();
+
+  auto it = _tables.find(name);
+  if (it == _tables.end()) return false;
+  info.useColumnInfoFrom(it->second);
+  return true;
+}
+
+void PreparedPlan::putTableInfo(const std::string& name, const TableInfo& info) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (io::ResourceManager::getInstance().generation() != _generation) return;
+  _tables[name].useColumnInfoFrom(info);
+}
+
+bool PreparedPlan::getTransformedPlan(const ParameterBinding& parameters, TransformedPlan& plan) {
+  TransformedPlan cached;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    dropIfOutdated();
+    auto it = _plans.find(parameters.getSignature());
+    if (it == _plans.end()) return false;
+    cached = it->second;
+  }
+  return copyPlan(cached, parameters.getValues(), plan);
+}
+
+void PreparedPlan::putTransformedPlan(const ParameterBinding& parameters, const TransformedPlan& plan) {
+  // The operations of plan are executed, the cache keeps unscheduled copies
+  TransformedPlan cached;
+  if (!copyPlan(plan, parameters.getValues(), cached)) return;
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (io::ResourceManager::getInstance().generation() != _generation) return;
+  _plans[parameters.getSignature()] = cached;
+}
+
+void PreparedPlan::dropIfOutdated() {
+  size_t generation = io::ResourceManager::getInstance().generation();
+  if (generation != _generation) {
+    _tables.clear();
+    _plans.clear();
+    _generation = generation;
+  }
+}
+
+
+ParameterBinding::ParameterBinding(std::shared_ptr<PreparedPlan> plan, std::vector<Expr*>& values) :
+  _plan(plan),
+  _json_values(Json::objectValue) {
+  _values.swap(values);
+
+  for (size_t i = 0; i < _values.size(); ++i) {
+    const std::string name = std::to_string(i);
+    switch (_values[i]->type) {
+      case kExprLiteralInt:
+        _json_values[name] = (Json::Int64) _values[i]->ival;
+        _signature += 'i';
+        break;
+      case kExprLiteralFloat:
+        _json_values[name] = _values[i]->fval;
+        _signature += 'f';
+        break;
+      case kExprLiteralString:
+        _json_values[name] = _values[i]->name;
+        _signature += 's';
+        break;
+      default:
+        _signature += '?';
+    }
+  }
+}
+
+ParameterBinding::~ParameterBinding() {
+  for (Expr* value : _values) delete value;
+}
+
+Expr* ParameterBinding::resolve(Expr* expr) const {
+  if (!expr->isType(kExprPlaceholder)) return expr;
+  if (expr->ival < 0 || (size_t) expr->ival >= _values.size())
+    throw std::runtime_error("Error when transforming SQL: No value bound to placeholder");
+  return _values[expr->ival];
+}
+
+Json::Value ParameterBinding::placeholder(const Expr* expr) {
+  Json::Value value;
+  value["parameter"] = std::to_string(expr->ival);
+  return value;
+}
+
+
 PreparedStatementManager& PreparedStatementManager::getInstance() {
-	static PreparedStatementManager psm;
-	return psm;
+  static PreparedStatementManager psm;
+  return psm;
 }
 
 bool PreparedStatementManager::hasStatement(std::string name) {
-	return _data_map.count(name) == 1;
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _data_map.count(name) == 1;
 }
 
-void PreparedStatementManager::addStatement(std::string name, PrepareStatement* stmt) {
-	_data_map[name] = stmt;
+bool PreparedStatementManager::addStatement(std::string name, PrepareStatement* stmt) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_data_map.count(name) == 1) return false;
+  _data_map[name] = std::make_shared<PreparedPlan>(stmt);
+  return true;
 }
 
-PrepareStatement* PreparedStatementManager::getStatement(std::string name) {
-	return _data_map[name];
+std::shared_ptr<PreparedPlan> PreparedStatementManager::getStatement(std::string name) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto it = _data_map.find(name);
+  return (it == _data_map.end()) ? nullptr : it->second;
 }
 
 void PreparedStatementManager::deleteStatement(std::string name) {
-	delete getStatement(name);
-	_data_map.erase(name);
+  std::lock_guard<std::mutex> lock(_mutex);
+  _data_map.erase(name);
 }
 
 
 
 } // namespace sql
 } // namespace access
-} // namespace hyrise
\ No newline at end of file
+} // namespace hyrise
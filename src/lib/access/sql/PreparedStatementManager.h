@@ -3,26 +3,134 @@
 #define SRC_LIB_ACCESS_SQL_PREPAREDSTATEMENTMANAGER_H_
 
 #include "access/sql/parser/PrepareStatement.h"
+#include "access/sql/typedef_helper.h"
 #include <string>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <json.h>
 
 namespace hyrise {
 namespace access {
 namespace sql {
 
+class ParameterBinding;
+
+/**
+ * Operations of a transformed statement. The meta information describes
+ * the result of the statement, its first and last task are among tasks.
+ */
+struct TransformedPlan {
+  task_list_t tasks;
+  TransformationResult meta;
+};
+
+/**
+ * A prepared statement and the state its executions share.
+ * Executions only read the parsed statements. The values of the
+ * placeholders are bound per execution by a ParameterBinding instead of
+ * being written into the syntax tree, so executions can run concurrently.
+ */
+class PreparedPlan {
+ public:
+  explicit PreparedPlan(hsql::PrepareStatement* stmt);
+  ~PreparedPlan();
+
+  inline hsql::PrepareStatement* getStatement() const { return _stmt; }
+  inline size_t numPlaceholders() const { return _stmt->placeholders.size(); }
+
+  /**
+   * Column information of the tables looked up by earlier executions.
+   * Loading, replacing or unloading any table drops all entries.
+   * @return false if the table has not been looked up since the last change
+   */
+  bool getTableInfo(const std::string& name, TableInfo& info);
+  void putTableInfo(const std::string& name, const TableInfo& info);
+
+  /**
+   * Copies the plan transformed by an earlier execution whose parameters
+   * had the same types and binds the parameters into the copy. Plans are
+   * dropped together with the column information.
+   * @return false if there is no such plan
+   */
+  bool getTransformedPlan(const ParameterBinding& parameters, TransformedPlan& plan);
+
+  /**
+   * Keeps a copy of the plan for later executions if all of its
+   * operations can be copied.
+   */
+  void putTransformedPlan(const ParameterBinding& parameters, const TransformedPlan& plan);
+
+ private:
+  // Expects _mutex to be held
+  void dropIfOutdated();
+
+  hsql::PrepareStatement* _stmt;
+
+  std::mutex _mutex;
+  size_t _generation;
+  std::map<std::string, TableInfo> _tables;
+  std::map<std::string, TransformedPlan> _plans;
+};
+
+/**
+ * Values of the placeholders for one execution of a prepared statement.
+ * Owns the literal expressions of the execute statement and keeps the
+ * prepared plan alive while its statements are transformed.
+ */
+class ParameterBinding {
+ public:
+  /**
+   * @param[in]      plan    Prepared statement that is executed
+   * @param[in/out]  values  Literals of the execute statement, moved into the binding
+   */
+  ParameterBinding(std::shared_ptr<PreparedPlan> plan, std::vector<hsql::Expr*>& values);
+  ~ParameterBinding();
+
+  inline const std::shared_ptr<PreparedPlan>& getPlan() const { return _plan; }
+
+  // Returns the bound value for a placeholder and the expression itself otherwise
+  hsql::Expr* resolve(hsql::Expr* expr) const;
+
+  // Placeholder for the value of expr in plans, operations bind it to getValues()
+  static Json::Value placeholder(const hsql::Expr* expr);
+
+  // Values of the literals by the name of their placeholder
+  inline const Json::Value& getValues() const { return _json_values; }
+
+  // Types of the values, plans are only shared between executions of the same signature
+  inline const std::string& getSignature() const { return _signature; }
+
+ private:
+  std::shared_ptr<PreparedPlan> _plan;
+  std::vector<hsql::Expr*> _values;
+  Json::Value _json_values;
+  std::string _signature;
+};
+
+
 class PreparedStatementManager {
-public:
+ public:
   // Retrieve singleton instance
   static PreparedStatementManager& getInstance();
 
   bool hasStatement(std::string name);
-  void addStatement(std::string name, hsql::PrepareStatement* stmt);
-  hsql::PrepareStatement* getStatement(std::string name);
+
+  // Takes ownership of the statement, returns false if the name is already in use
+  bool addStatement(std::string name, hsql::PrepareStatement* stmt);
+
+  // Returns nullptr if there is no statement of this name
+  std::shared_ptr<PreparedPlan> getStatement(std::string name);
+
+  // Running executions keep the statement until they are transformed
   void deleteStatement(std::string name);
 
 
  private:
- 	std::map<std::string, hsql::PrepareStatement*> _data_map;
+  std::mutex _mutex;
+  std::map<std::string, std::shared_ptr<PreparedPlan> > _data_map;
 
   PreparedStatementManager() = default;
   PreparedStatementManager(const PreparedStatementManager&) = delete;
@@ -36,4 +144,4 @@ public:
 } // namespace sql
 } // namespace access
 } // namespace hyrise
-#endif
\ No newline at end of file
+#endif
@@ -34,7 +34,7 @@ TransformationResult SQLDataManipulationTransformer::transformInsertStatement(In
 
     // Check if types of values and columns match
     for (size_t i = 0; i < meta.fields.size(); ++i) {
-      Expr* expr = insert->values->at(i);
+      Expr* expr = _server.resolveParameter(insert->values->at(i));
       switch (meta.data_types[i]) {
         case TableInfo::kInteger: // Expect integer, allow integer
           if (!(expr->isType(kExprLiteralInt)))
@@ -55,7 +55,8 @@ TransformationResult SQLDataManipulationTransformer::transformInsertStatement(In
    
     auto insert_scan = std::make_shared<InsertScan>();
     std::vector<Json::Value> data;
-    for (Expr* expr : *insert->values) { 
+    for (Expr* value : *insert->values) { 
+      Expr* expr = _server.resolveParameter(value);
       switch (expr->type) {
         case kExprLiteralFloat: data.push_back(expr->fval); break;
         case kExprLiteralInt: data.push_back(expr->ival); break;
@@ -108,10 +109,11 @@ TransformationResult SQLDataManipulationTransformer::transformUpdateStatement(Up
 
   Json::Value update_data;
   for (UpdateClause* clause : *update->updates) {
-    switch (clause->value->type) {
-      case kExprLiteralInt: update_data[clause->column] = clause->value->ival; break;
-      case kExprLiteralFloat: update_data[clause->column] = clause->value->fval; break;
-      case kExprLiteralString: update_data[clause->column] = clause->value->name; break;
+    Expr* value = _server.resolveParameter(clause->value);
+    switch (value->type) {
+      case kExprLiteralInt: update_data[clause->column] = value->ival; break;
+      case kExprLiteralFloat: update_data[clause->column] = value->fval; break;
+      case kExprLiteralString: update_data[clause->column] = value->name; break;
       default:
         _server.throwError("Unsupported Expr type in update clause");    
     }  
@@ -8,8 +8,9 @@ namespace hyrise {
 namespace access {
 namespace sql {
 
-SQLPredicateTransformer::SQLPredicateTransformer(const TransformationResult& input) :
-	_input(input) {
+SQLPredicateTransformer::SQLPredicateTransformer(const TransformationResult& input, const ParameterBinding* parameters) :
+	_input(input),
+	_parameters(parameters) {
 
 }
 
@@ -136,6 +137,14 @@ void SQLPredicateTransformer::parsePredicateFieldAndValueIntoJson(Expr* expr, Js
 
   pred["f"] = id;
 
+  // The value of a placeholder is bound by the scan, so copies of it can bind other values of the same type
+  Json::Value placeholder;
+  if (value_expr->isType(kExprPlaceholder)) {
+    if (_parameters == nullptr) SQLStatementTransformer::throwError("Placeholder outside of a prepared statement");
+    placeholder = ParameterBinding::placeholder(value_expr);
+    value_expr = _parameters->resolve(value_expr);
+  }
+
   switch (value_expr->type) {
     case kExprLiteralInt:
       pred["vtype"] = ExpressionVType::INT;
@@ -152,6 +161,8 @@ void SQLPredicateTransformer::parsePredicateFieldAndValueIntoJson(Expr* expr, Js
     default:
       throw std::runtime_error("Error when transforming SQL: Predicate expressions not supported");
   }
+
+  if (!placeholder.isNull()) pred["value"] = placeholder;
 }
 
 
@@ -4,6 +4,7 @@
 
 #include "access/sql/typedef_helper.h"
 #include "access/sql/parser/Expr.h"
+#include "access/sql/PreparedStatementManager.h"
 
 namespace hyrise {
 namespace access {
@@ -17,7 +18,8 @@ class SQLPredicateTransformer {
   } ExpressionVType;
 
  public:
-  SQLPredicateTransformer(const TransformationResult& input);
+  // Placeholders in the predicates are replaced by the values in parameters
+  SQLPredicateTransformer(const TransformationResult& input, const ParameterBinding* parameters = nullptr);
   virtual ~SQLPredicateTransformer() {};
 
   Json::Value& buildPredicatesFromExpr(hsql::Expr* expr);
@@ -29,6 +31,7 @@ class SQLPredicateTransformer {
 
   Json::Value _json;
   const TransformationResult& _input;
+  const ParameterBinding* _parameters;
 };
 
 
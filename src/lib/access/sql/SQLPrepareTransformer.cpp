@@ -22,12 +22,8 @@ TransformationResult SQLPrepareTransformer::transformPrepareStatement(PrepareSta
   PreparedStatementManager& manager = PreparedStatementManager::getInstance();
 
   std::string name = stmt->name;
-  if (manager.hasStatement(name)) {
+  if (!manager.addStatement(name, stmt)) {
     _server.throwError("Prepared statement of this name already exists!", name);
-
-  } else {
-    manager.addStatement(name, stmt);
-
   }
 
   TransformationResult meta = ALLOC_TRANSFORMATIONRESULT();
@@ -41,42 +37,63 @@ TransformationResult SQLPrepareTransformer::transformExecuteStatement(ExecuteSta
   PreparedStatementManager& manager = PreparedStatementManager::getInstance();
 
   std::string name = exec->name;
-  if (!manager.hasStatement(name)) {
+  std::shared_ptr<PreparedPlan> plan = manager.getStatement(name);
+  if (plan == nullptr) {
     _server.throwError("Can't execute prepared statement, because it doesn't exist!", name);
+  }
 
-    _builder.addNoOp(meta);
+  size_t num_arguments = (exec->parameters == NULL) ? 0 : exec->parameters->size();
 
-  } else {
-    PrepareStatement* prep = manager.getStatement(name);
+  // Check number of parameters
+  if (plan->numPlaceholders() != num_arguments) {
+    _server.throwError("Expected a different number of parameters!", std::to_string(plan->numPlaceholders()));
+  }
 
-    size_t num_arguments = (exec->parameters == NULL) ? 0 : exec->parameters->size();
+  // The values are bound for this execution only, the prepared statement itself is never modified
+  std::vector<Expr*> values;
+  if (exec->parameters != NULL) values.swap(*exec->parameters);
+  auto parameters = std::make_shared<ParameterBinding>(plan, values);
 
-    // Check number of parameters
-    if (prep->placeholders.size() != num_arguments) {
-      _server.throwError("Expected a different number of parameters!", std::to_string(prep->placeholders.size()));
-    }
+  std::vector<SQLStatement*>& statements = plan->getStatement()->query->statements;
 
-    // Override the placeholder expression within the prepared statement
-    for (uint i = 0; i < num_arguments; ++i) {
-      (*prep->placeholders[i]) = (*exec->parameters->at(i));
-    }
+  // A single statement is transformed right away instead of in a QueryTask of its own
+  if (statements.size() == 1) {
+    _server.setParameterBinding(parameters);
+    if (statements.front()->type() != kStmtSelect) return _server.transformStatement(statements.front());
 
-    // Create the QueryTasks for each statement within our prepared statement
-    std::shared_ptr<SQLQueryTask> last_task = nullptr;
-    for (SQLStatement* stmt : prep->query->statements) {
-      auto sql_task = std::make_shared<SQLQueryTask>(stmt);
-      sql_task->setId(10);
-
-      // Chain tasks
-      if (last_task != nullptr) {
-        sql_task->addDependency(last_task);
-        sql_task->setPrevTask(last_task);
-        last_task->setNextTask(sql_task);
+    // Selects run copies of the operations transformed by an earlier execution
+    TransformedPlan transformed;
+    if (plan->getTransformedPlan(*parameters, transformed)) {
+      for (const task_t& task : transformed.tasks) {
+        auto op = std::static_pointer_cast<PlanOperation>(task);
+        _builder.addPlanOp(op, op->planOperationName());
       }
-      
-      last_task = sql_task;
-      _builder.addPlanOp(sql_task, "SQLQueryTask", meta);
+      return transformed.meta;
     }
+
+    size_t first = _builder.getTaskList().size();
+    transformed.meta = _server.transformStatement(statements.front());
+    transformed.tasks.assign(_builder.getTaskList().begin() + first, _builder.getTaskList().end());
+    plan->putTransformedPlan(*parameters, transformed);
+    return transformed.meta;
+  }
+
+  // Create the QueryTasks for each statement within our prepared statement
+  std::shared_ptr<SQLQueryTask> last_task = nullptr;
+  for (SQLStatement* stmt : statements) {
+    auto sql_task = std::make_shared<SQLQueryTask>(stmt, false);
+    sql_task->setParameterBinding(parameters);
+    sql_task->setId(10);
+
+    // Chain tasks
+    if (last_task != nullptr) {
+      sql_task->addDependency(last_task);
+      sql_task->setPrevTask(last_task);
+      last_task->setNextTask(sql_task);
+    }
+
+    last_task = sql_task;
+    _builder.addPlanOp(sql_task, "SQLQueryTask", meta);
   }
 
   return meta;
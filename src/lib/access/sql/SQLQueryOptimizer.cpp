@@ -0,0 +1,453 @@
+// Copyright (c) 2015 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/sql/SQLQueryOptimizer.h"
+#include "access/sql/SQLStatementTransformer.h"
+
+#include "io/StorageManager.h"
+#include "storage/Store.h"
+
+#include "access/CrossProduct.h"
+#include "access/HashBuild.h"
+#include "access/HashJoinProbe.h"
+#include "access/ProjectionScan.h"
+
+#include <algorithm>
+#include <set>
+
+using namespace hsql;
+
+namespace hyrise {
+namespace access {
+namespace sql {
+
+namespace {
+// Fraction of rows assumed to pass range predicates and predicates the dictionaries tell nothing about
+const double kRangeSelectivity = 1.0 / 3.0;
+const double kDefaultSelectivity = 0.5;
+
+// Number of rows assumed for subselects
+const double kUnknownCardinality = 1000000.0;
+
+void splitConjunction(Expr* expr, std::vector<Expr*>& conjuncts) {
+  if (expr->isType(kExprOperator) && expr->op_type == Expr::AND) {
+    splitConjunction(expr->expr, conjuncts);
+    splitConjunction(expr->expr2, conjuncts);
+  } else {
+    conjuncts.push_back(expr);
+  }
+}
+
+void collectColumnRefs(Expr* expr, std::vector<Expr*>& columns) {
+  if (expr == nullptr) return;
+  if (expr->isType(kExprColumnRef)) columns.push_back(expr);
+  collectColumnRefs(expr->expr, columns);
+  collectColumnRefs(expr->expr2, columns);
+}
+
+inline bool isColumnEquality(Expr* expr) {
+  return expr->isType(kExprOperator) && expr->isSimpleOp('=') &&
+         expr->expr->isType(kExprColumnRef) && expr->expr2->isType(kExprColumnRef);
+}
+
+// The dictionary of a column holds each of its distinct values once
+double estimateDistinctValues(const storage::atable_ptr_t& table, size_t column) {
+  double distinct = table->size();
+  try {
+    distinct = table->dictionaryAt(column)->size();
+  } catch (const std::exception&) {
+    // columns without dictionary
+  }
+  return std::max(1.0, std::min<double>(distinct, table->size()));
+}
+
+// Returns a negative value if the statistics can't tell
+double estimateFractionBelow(const storage::TableStatistics& statistics, size_t column,
+                             TableInfo::AbstractDataType type, Expr* value, bool inclusive) {
+  try {
+    switch (type) {
+      case TableInfo::kInteger:
+        if (value->isType(kExprLiteralInt))
+          return statistics.fractionBelow<hyrise_int_t>(column, value->ival, inclusive);
+        break;
+      case TableInfo::kFloat:
+        if (value->isType(kExprLiteralInt))
+          return statistics.fractionBelow<hyrise_float_t>(column, value->ival, inclusive);
+        if (value->isType(kExprLiteralFloat))
+          return statistics.fractionBelow<hyrise_float_t>(column, value->fval, inclusive);
+        break;
+      case TableInfo::kString:
+        if (value->isType(kExprLiteralString))
+          return statistics.fractionBelow<hyrise_string_t>(column, value->name, inclusive);
+        break;
+      default:
+        break;
+    }
+  } catch (const std::exception&) {
+    // dictionaries of an unexpected type
+  }
+  return -1.0;
+}
+}
+
+
+SQLQueryOptimizer::SQLQueryOptimizer(SQLStatementTransformer& server) :
+  _server(server),
+  _builder(server.getTaskListBuilder()) {}
+
+SQLQueryOptimizer::~SQLQueryOptimizer() {}
+
+
+
+TransformationResult SQLQueryOptimizer::transformFromWhere(TableRef* from, Expr* where) {
+  std::vector<Relation> relations;
+  std::vector<Expr*> conditions;
+
+  // Single tables and outer joins are transformed as written
+  if (!collectRelations(from, relations, conditions) || relations.size() < 2) {
+    TransformationResult meta = _server.transformTableRef(from);
+    if (where != nullptr) _server.addFilterOpFromExpr(where, meta);
+    return meta;
+  }
+
+  for (Relation& relation : relations) readRelation(relation);
+
+  // Apply predicates on a single relation directly after reading it,
+  // equality predicates between two relations are used as join keys
+  std::vector<Expr*> conjuncts;
+  for (Expr* condition : conditions) splitConjunction(condition, conjuncts);
+  if (where != nullptr) splitConjunction(where, conjuncts);
+
+  std::vector<JoinKey> join_keys;
+  std::vector<Expr*> residual;
+  for (Expr* conjunct : conjuncts) {
+    std::vector<Expr*> columns;
+    collectColumnRefs(conjunct, columns);
+    std::set<int> referenced;
+    for (Expr* column : columns) referenced.insert(findRelation(column, relations));
+
+    if (referenced.count(-1) == 1 || referenced.empty()) {
+      residual.push_back(conjunct);
+
+    } else if (referenced.size() == 1) {
+      Relation& relation = relations[*referenced.begin()];
+      _server.addFilterOpFromExpr(conjunct, relation.meta);
+      relation.cardinality = std::max(1.0, relation.cardinality * estimateSelectivity(conjunct, relation));
+      for (double& distinct : relation.distinct) distinct = std::min(distinct, relation.cardinality);
+
+    } else if (referenced.size() == 2 && isColumnEquality(conjunct)) {
+      size_t left = findRelation(conjunct->expr, relations);
+      size_t right = findRelation(conjunct->expr2, relations);
+      join_keys.push_back({{left, (size_t) relations[left].meta.getFieldID(conjunct->expr)},
+                           {right, (size_t) relations[right].meta.getFieldID(conjunct->expr2)}});
+
+    } else {
+      residual.push_back(conjunct);
+    }
+  }
+
+  // Start with the smallest relation and add the one with the smallest estimated result,
+  // relations without join key are only added as cross product when nothing else is left
+  std::vector<bool> is_joined(relations.size(), false);
+  size_t first = 0;
+  for (size_t i = 1; i < relations.size(); ++i) {
+    if (relations[i].cardinality < relations[first].cardinality) first = i;
+  }
+
+  JoinResult joined;
+  joined.meta.addTask(relations[first].meta.last_task);
+  joined.cardinality = relations[first].cardinality;
+  for (size_t i = 0; i < relations[first].meta.numColumns(); ++i) {
+    const TransformationResult& meta = relations[first].meta;
+    joined.meta.addField(meta.fields[i], meta.name, meta.data_types[i]);
+    joined.origins.push_back(column_origin_t(first, i));
+    joined.distinct.push_back(relations[first].distinct[i]);
+  }
+  is_joined[first] = true;
+
+  for (size_t step = 1; step < relations.size(); ++step) {
+    size_t best = relations.size();
+    std::vector<JoinKey> best_keys;
+    double best_cardinality = 0;
+
+    for (size_t i = 0; i < relations.size(); ++i) {
+      if (is_joined[i]) continue;
+
+      std::vector<JoinKey> keys;
+      for (const JoinKey& key : join_keys) {
+        if (is_joined[key.left.first] && key.right.first == i) keys.push_back(key);
+        else if (is_joined[key.right.first] && key.left.first == i) keys.push_back({key.right, key.left});
+      }
+
+      double cardinality = estimateJoinCardinality(joined, relations[i], keys);
+      bool better = (best == relations.size()) ||
+                    (!keys.empty() && best_keys.empty()) ||
+                    (keys.empty() == best_keys.empty() && cardinality < best_cardinality);
+      if (better) {
+        best = i;
+        best_keys = keys;
+        best_cardinality = cardinality;
+      }
+    }
+
+    joinRelation(joined, relations[best], best, best_keys);
+    is_joined[best] = true;
+  }
+
+  // Restore the column order of the FROM clause
+  std::vector<column_origin_t> order;
+  collectColumnOrder(from, relations, order);
+  TransformationResult meta = joined.meta;
+  if (order != joined.origins) {
+    auto scan = std::make_shared<ProjectionScan>();
+    TableInfo info;
+    for (const column_origin_t& origin : order) {
+      size_t id = std::find(joined.origins.begin(), joined.origins.end(), origin) - joined.origins.begin();
+      scan->addField(id);
+      info.addFieldFromInfo(meta, id);
+    }
+    _builder.addPlanOp(scan, "ProjectionScan", meta);
+    meta.useColumnInfoFrom(info);
+  }
+
+  // Predicates over several relations that are not join keys are applied to the joined result
+  for (Expr* conjunct : residual) _server.addFilterOpFromExpr(conjunct, meta);
+
+  if (from->getName() != nullptr) meta.name = from->getName();
+  return meta;
+}
+
+
+
+/**
+ * Collects the base tables and subselects of inner joins and cross products
+ * together with the join conditions.
+ * @return false if the table reference contains a join that can't be reordered
+ */
+bool SQLQueryOptimizer::collectRelations(TableRef* table, std::vector<Relation>& relations, std::vector<Expr*>& conditions) {
+  switch (table->type) {
+    case kTableName:
+    case kTableSelect: {
+      Relation relation;
+      relation.table = table;
+      relation.cardinality = 0;
+      relations.push_back(relation);
+      return true;
+    }
+    case kTableJoin:
+      if (table->join->type != kJoinInner) return false;
+      if (table->join->condition != nullptr) conditions.push_back(table->join->condition);
+      return collectRelations(table->join->left, relations, conditions) &&
+             collectRelations(table->join->right, relations, conditions);
+    case kTableCrossProduct:
+      for (TableRef* ref : *table->list) {
+        if (!collectRelations(ref, relations, conditions)) return false;
+      }
+      return true;
+  }
+  return false;
+}
+
+/**
+ * Column order of a join as written, which are the columns of the right
+ * table followed by the columns of the left table.
+ */
+void SQLQueryOptimizer::collectColumnOrder(TableRef* table, const std::vector<Relation>& relations,
+                                           std::vector<column_origin_t>& order) {
+  switch (table->type) {
+    case kTableName:
+    case kTableSelect:
+      for (size_t id = 0; id < relations.size(); ++id) {
+        if (relations[id].table != table) continue;
+        for (size_t i = 0; i < relations[id].meta.numColumns(); ++i) order.push_back(column_origin_t(id, i));
+      }
+      break;
+    case kTableJoin:
+      collectColumnOrder(table->join->right, relations, order);
+      collectColumnOrder(table->join->left, relations, order);
+      break;
+    case kTableCrossProduct:
+      for (auto it = table->list->rbegin(); it != table->list->rend(); ++it) collectColumnOrder(*it, relations, order);
+      break;
+  }
+}
+
+
+void SQLQueryOptimizer::readRelation(Relation& relation) {
+  relation.meta = _server.transformTableRef(relation.table);
+
+  if (relation.table->type == kTableName) {
+    storage::atable_ptr_t table = io::StorageManager::getInstance()->getTable(relation.table->name);
+    relation.cardinality = std::max<double>(1, table->size());
+
+    // Stores keep the statistics of their main, other tables only report their dictionary sizes
+    if (std::dynamic_pointer_cast<storage::Store>(table) != nullptr)
+      relation.statistics = std::make_shared<storage::TableStatistics>(table);
+    for (size_t i = 0; i < relation.meta.numColumns(); ++i) {
+      relation.distinct.push_back(relation.statistics != nullptr ? relation.statistics->distinctValues(i)
+                                                                 : estimateDistinctValues(table, i));
+    }
+  } else {
+    relation.cardinality = kUnknownCardinality;
+    relation.distinct.assign(relation.meta.numColumns(), kUnknownCardinality);
+  }
+}
+
+
+/**
+ * @return  Relation that contains the column, -1 if no or more than one relation does
+ */
+int SQLQueryOptimizer::findRelation(Expr* column, const std::vector<Relation>& relations) const {
+  int found = -1;
+  for (size_t i = 0; i < relations.size(); ++i) {
+    const TransformationResult& meta = relations[i].meta;
+    if (!meta.containsField(column->name)) continue;
+    if (column->hasTable() && !meta.hasName(column->table) &&
+        std::find(meta.keys.begin(), meta.keys.end(), column->table) == meta.keys.end()) continue;
+
+    if (found != -1) return -1;
+    found = i;
+  }
+  return found;
+}
+
+
+
+double SQLQueryOptimizer::estimateSelectivity(Expr* expr, const Relation& relation) const {
+  if (!expr->isType(kExprOperator)) return kDefaultSelectivity;
+
+  // Equality with a literal matches one of the distinct values
+  auto equality = [&]() {
+    Expr* column = expr->expr->isType(kExprColumnRef) ? expr->expr : expr->expr2;
+    int id = column->isType(kExprColumnRef) ? relation.meta.getFieldID(column) : -1;
+    return (id < 0) ? kDefaultSelectivity : 1.0 / relation.distinct[id];
+  };
+
+  // Range predicates on a literal use the histograms of the main
+  auto range = [&](bool less, bool inclusive) {
+    bool column_first = expr->expr->isType(kExprColumnRef);
+    Expr* column = column_first ? expr->expr : expr->expr2;
+    Expr* value = _server.resolveParameter(column_first ? expr->expr2 : expr->expr);
+    int id = column->isType(kExprColumnRef) ? relation.meta.getFieldID(column) : -1;
+    if (id < 0 || relation.statistics == nullptr) return kRangeSelectivity;
+
+    // 5 < column is the same as column > 5
+    if (!column_first) less = !less;
+    double below = estimateFractionBelow(*relation.statistics, id, relation.meta.data_types[id], value,
+                                         less ? inclusive : !inclusive);
+    if (below < 0) return kRangeSelectivity;
+    return less ? below : 1.0 - below;
+  };
+
+  switch (expr->op_type) {
+    case Expr::AND:
+      return estimateSelectivity(expr->expr, relation) * estimateSelectivity(expr->expr2, relation);
+    case Expr::OR: {
+      double first = estimateSelectivity(expr->expr, relation);
+      double second = estimateSelectivity(expr->expr2, relation);
+      return first + second - first * second;
+    }
+    case Expr::NOT:
+      return 1.0 - estimateSelectivity(expr->expr, relation);
+    case Expr::NOT_EQUALS:
+      return 1.0 - equality();
+    case Expr::LESS_EQ:
+      return range(true, true);
+    case Expr::GREATER_EQ:
+      return range(false, true);
+    case Expr::SIMPLE_OP:
+      if (expr->op_char == '=') return equality();
+      if (expr->op_char == '<') return range(true, false);
+      if (expr->op_char == '>') return range(false, false);
+      return kDefaultSelectivity;
+    default:
+      return kDefaultSelectivity;
+  }
+}
+
+
+/**
+ * Each join key matches a row with the rows sharing its value,
+ * assuming the smaller set of distinct values is contained in the larger one.
+ */
+double SQLQueryOptimizer::estimateJoinCardinality(const JoinResult& joined, const Relation& relation,
+                                                  const std::vector<JoinKey>& keys) const {
+  double cardinality = joined.cardinality * relation.cardinality;
+  for (const JoinKey& key : keys) {
+    size_t id = std::find(joined.origins.begin(), joined.origins.end(), key.left) - joined.origins.begin();
+    cardinality /= std::max(joined.distinct[id], relation.distinct[key.right.second]);
+  }
+  return std::max(1.0, cardinality);
+}
+
+
+void SQLQueryOptimizer::joinRelation(JoinResult& joined, const Relation& relation, size_t id,
+                                     const std::vector<JoinKey>& keys) {
+  JoinResult result;
+  result.cardinality = estimateJoinCardinality(joined, relation, keys);
+
+  auto add_joined = [&]() {
+    for (size_t i = 0; i < joined.meta.numColumns(); ++i) {
+      result.meta.addFieldFromInfo(joined.meta, i);
+      result.origins.push_back(joined.origins[i]);
+      result.distinct.push_back(std::min(joined.distinct[i], result.cardinality));
+    }
+  };
+  auto add_relation = [&]() {
+    for (size_t i = 0; i < relation.meta.numColumns(); ++i) {
+      result.meta.addField(relation.meta.fields[i], relation.meta.name, relation.meta.data_types[i]);
+      result.origins.push_back(column_origin_t(id, i));
+      result.distinct.push_back(std::min(relation.distinct[i], result.cardinality));
+    }
+  };
+
+  // Without a join key every row matches every row, so there is nothing to hash
+  if (keys.empty()) {
+    auto product = std::make_shared<CrossProduct>();
+    product->addDependency(joined.meta.last_task);
+    product->addDependency(relation.meta.last_task);
+    _builder.addPlanOp(product, "CrossProduct");
+    result.meta.addTask(product);
+    add_joined();
+    add_relation();
+    joined = result;
+    return;
+  }
+
+  std::vector<field_t> joined_fields;
+  std::vector<field_t> relation_fields;
+  for (const JoinKey& key : keys) {
+    joined_fields.push_back(std::find(joined.origins.begin(), joined.origins.end(), key.left) - joined.origins.begin());
+    relation_fields.push_back(key.right.second);
+  }
+
+  // The hash table is built over the smaller input, the result starts with the columns of the probing input
+  bool build_joined = joined.cardinality <= relation.cardinality;
+
+  auto build = std::make_shared<HashBuild>();
+  auto probe = std::make_shared<HashJoinProbe>();
+  build->setKey("join");
+  for (field_t field : (build_joined ? joined_fields : relation_fields)) build->addField(field);
+  for (field_t field : (build_joined ? relation_fields : joined_fields)) probe->addField(field);
+
+  build->addDependency(build_joined ? joined.meta.last_task : relation.meta.last_task);
+  probe->addDependency(build);
+  probe->addDependency(build_joined ? relation.meta.last_task : joined.meta.last_task);
+  _builder.addPlanOp(build, "HashBuild");
+  _builder.addPlanOp(probe, "HashJoinProbe");
+  result.meta.addTask(build);
+  result.meta.addTask(probe);
+
+  if (build_joined) {
+    add_relation();
+    add_joined();
+  } else {
+    add_joined();
+    add_relation();
+  }
+  joined = result;
+}
+
+
+
+} // namespace sql
+} // namespace access
+} // namespace hyrise
@@ -0,0 +1,96 @@
+// Copyright (c) 2015 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_SQL_SQLQUERYOPTIMIZER_H_
+#define SRC_LIB_ACCESS_SQL_SQLQUERYOPTIMIZER_H_
+
+#include "access/sql/typedef_helper.h"
+#include "access/sql/parser/Table.h"
+#include "storage/TableStatistics.h"
+
+#include <utility>
+
+namespace hyrise {
+namespace access {
+namespace sql {
+
+class SQLStatementTransformer;
+class TaskListBuilder;
+
+/**
+ * Plans the FROM and WHERE clause of a select statement by estimated cost.
+ *
+ * Inner joins and cross products are flattened into a set of relations.
+ * Predicates that refer to a single relation are applied right after the
+ * relation is read, equality predicates between two relations become join
+ * keys. The relations are then joined greedily, always adding the relation
+ * that yields the smallest estimated intermediate result, and every hash
+ * table is built over the smaller input.
+ *
+ * Cardinalities are estimated from the table statistics: the number of
+ * distinct values of a column from the size of its dictionaries and range
+ * predicates from the histograms of the main.
+ */
+class SQLQueryOptimizer {
+ public:
+  SQLQueryOptimizer(SQLStatementTransformer& server);
+  virtual ~SQLQueryOptimizer();
+
+  /**
+   * Transforms the FROM clause and the optional WHERE clause.
+   * Outer joins are transformed in the order they are written.
+   * @param[in]  from   Table reference of the FROM clause
+   * @param[in]  where  Condition of the WHERE clause, may be nullptr
+   * @return  Information about the result, columns are in the order the FROM clause defines
+   */
+  TransformationResult transformFromWhere(hsql::TableRef* from, hsql::Expr* where);
+
+ protected:
+  // A base table or subselect of the FROM clause
+  struct Relation {
+    hsql::TableRef* table;
+    TransformationResult meta;
+    double cardinality;
+    std::vector<double> distinct;
+    std::shared_ptr<storage::TableStatistics> statistics;
+  };
+
+  // Column of a relation, identified by position
+  typedef std::pair<size_t, size_t> column_origin_t;
+
+  // Equality predicate between the columns of two relations
+  struct JoinKey {
+    column_origin_t left;
+    column_origin_t right;
+  };
+
+  // The relations joined so far
+  struct JoinResult {
+    TransformationResult meta;
+    std::vector<column_origin_t> origins;
+    std::vector<double> distinct;
+    double cardinality;
+  };
+
+  bool collectRelations(hsql::TableRef* table, std::vector<Relation>& relations, std::vector<hsql::Expr*>& conditions);
+  void collectColumnOrder(hsql::TableRef* table, const std::vector<Relation>& relations,
+                          std::vector<column_origin_t>& order);
+
+  void readRelation(Relation& relation);
+  int findRelation(hsql::Expr* column, const std::vector<Relation>& relations) const;
+
+  double estimateSelectivity(hsql::Expr* expr, const Relation& relation) const;
+  double estimateJoinCardinality(const JoinResult& joined, const Relation& relation,
+                                 const std::vector<JoinKey>& keys) const;
+
+  void joinRelation(JoinResult& joined, const Relation& relation, size_t id, const std::vector<JoinKey>& keys);
+
+  SQLStatementTransformer& _server;
+  TaskListBuilder& _builder;
+};
+
+
+
+
+} // namespace sql
+} // namespace access
+} // namespace hyrise
+#endif
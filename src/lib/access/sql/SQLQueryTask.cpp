@@ -16,25 +16,31 @@ namespace access {
 namespace sql {
 
 
-SQLQueryTask::SQLQueryTask(SQLStatement* stmt) :
+SQLQueryTask::SQLQueryTask(SQLStatement* stmt, bool owns_statement) :
   _stmt(stmt),
+  _owns_statement(owns_statement),
   _prefix(""),
   _has_commit(false),
   _next_task(nullptr),
   _prev_task(nullptr),
-  _response_task(nullptr) {
+  _response_task(nullptr),
+  _parameters(nullptr) {
 
 }
 
 SQLQueryTask::~SQLQueryTask() {
-  delete _stmt;
+  if (_owns_statement) delete _stmt;
 }
 
 void SQLQueryTask::executePlanOperation() {
   // Transform the statement
   SQLStatementTransformer transformer = SQLStatementTransformer(_prefix);
+  transformer.setParameterBinding(_parameters);
   transformer.transformStatement(_stmt);
   _has_commit = transformer.hasCommit();
+
+  // A successfully prepared statement is owned by the PreparedStatementManager from now on
+  if (_stmt->type() == kStmtPrepare) _owns_statement = false;
   task_list_t tasks = transformer.getTaskList();
 
 
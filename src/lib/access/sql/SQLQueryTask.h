@@ -6,6 +6,7 @@
 #include <access/sql/typedef_helper.h>
 #include <access/system/PlanOperation.h>
 #include <access/system/ResponseTask.h>
+#include <access/sql/PreparedStatementManager.h>
 
 namespace hyrise {
 namespace access {
@@ -20,7 +21,11 @@ namespace sql {
  */ 
 class SQLQueryTask : public PlanOperation {
  public:
-  SQLQueryTask(hsql::SQLStatement* stmt);
+  /**
+   * @param[in]  stmt            Statement that will be transformed
+   * @param[in]  owns_statement  False for statements of a prepared statement, which outlive the task
+   */
+  SQLQueryTask(hsql::SQLStatement* stmt, bool owns_statement = true);
   virtual ~SQLQueryTask();
 
   void executePlanOperation();
@@ -29,6 +34,7 @@ class SQLQueryTask : public PlanOperation {
   inline void setPrevTask(std::shared_ptr<SQLQueryTask> task) { _prev_task = task; }
   inline void setPrefix(std::string prefix) { _prefix = prefix; }
   inline void setResponseTask(std::shared_ptr<ResponseTask> task) { _response_task = task; }
+  inline void setParameterBinding(std::shared_ptr<ParameterBinding> parameters) { _parameters = parameters; }
 
   inline bool hasCommit() const { return _has_commit; }
 
@@ -36,6 +42,7 @@ class SQLQueryTask : public PlanOperation {
 
  private:
   hsql::SQLStatement* _stmt;
+  bool _owns_statement;
   std::string _prefix;
   bool _has_commit;
 
@@ -43,6 +50,7 @@ class SQLQueryTask : public PlanOperation {
   std::shared_ptr<SQLQueryTask> _prev_task;
 
   std::shared_ptr<ResponseTask> _response_task;
+  std::shared_ptr<ParameterBinding> _parameters;
 };
 
 
@@ -35,13 +35,8 @@ TransformationResult SQLSelectTransformer::transformSelectStatement(SelectStatem
   // 5. SELECT clause
   // 6. ORDER BY clause
 
-  TransformationResult table_res = _server.transformTableRef(stmt->from_table);
-  meta = table_res;
-
-  // WHERE clause  
-  if (stmt->where_clause != nullptr) {
-    auto scan = _server.addFilterOpFromExpr(stmt->where_clause, meta);
-  }
+  // FROM and WHERE clause, joins are ordered by their estimated cost
+  meta = _server.getQueryOptimizer()->transformFromWhere(stmt->from_table, stmt->where_clause);
 
   // GROUP BY clause
   if (stmt->group_by != nullptr) {
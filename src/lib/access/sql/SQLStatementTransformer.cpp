@@ -7,12 +7,11 @@
 
 #include "io/StorageManager.h"
 
-#include "access/expressions/pred_buildExpression.h"
-
 // Operators
 
 #include "access/storage/GetTable.h"
 
+#include "access/CrossProduct.h"
 #include "access/MergeTable.h"
 #include "access/HashBuild.h"
 #include "access/HashJoinProbe.h"
@@ -33,12 +32,16 @@ SQLStatementTransformer::SQLStatementTransformer(std::string id_prefix) :
   _select_transformer(nullptr),
   _definition_transformer(nullptr),
   _manipulation_transformer(nullptr),
-  _prepare_transformer(nullptr) { /* initialize */ }
+  _prepare_transformer(nullptr),
+  _query_optimizer(nullptr),
+  _parameters(nullptr) { /* initialize */ }
 
 SQLStatementTransformer::~SQLStatementTransformer() {
   delete _select_transformer;
   delete _definition_transformer;
   delete _manipulation_transformer;
+  delete _prepare_transformer;
+  delete _query_optimizer;
 }
 
 SQLSelectTransformer* SQLStatementTransformer::getSelectTransformer() {
@@ -61,6 +64,11 @@ SQLPrepareTransformer* SQLStatementTransformer::getPrepareTransformer() {
   return _prepare_transformer;
 }
 
+SQLQueryOptimizer* SQLStatementTransformer::getQueryOptimizer() {
+  if (_query_optimizer == nullptr) _query_optimizer = new SQLQueryOptimizer(*this);
+  return _query_optimizer;
+}
+
 
 /** 
  * Transforms a statement into tasks. 
@@ -93,6 +101,13 @@ TransformationResult SQLStatementTransformer::transformStatement(SQLStatement* s
 
 
 
+Expr* SQLStatementTransformer::resolveParameter(Expr* expr) const {
+  if (!expr->isType(kExprPlaceholder)) return expr;
+  if (_parameters == nullptr) throwError("Placeholder outside of a prepared statement");
+  return _parameters->resolve(expr);
+}
+
+
 /**
  * Transform the table ref into the equivalent hyrise taskts
  *
@@ -113,24 +128,19 @@ TransformationResult SQLStatementTransformer::transformTableRef(TableRef* table_
       meta = transformJoinTable(table_ref);
       break;
     case kTableCrossProduct: {
-      // Do a hash join without predicate
       TransformationResult left = transformTableRef(table_ref->list->at(0));
       TransformationResult right = transformTableRef(table_ref->list->at(1));
 
-      auto build = std::make_shared<HashBuild>();
-      auto probe = std::make_shared<HashJoinProbe>();
-      build->setKey("join");
-      build->addDependency(left.last_task);
-      probe->addDependency(build);
-      probe->addDependency(right.last_task);
-      _builder.addPlanOp(build, "HashBuild", meta);
-      _builder.addPlanOp(probe, "HashJoinProbe", meta);
-
-      for (uint i = 0; i < right.fields.size(); ++i)
-        meta.addField(right.fields[i], right.name, right.data_types[i]);
+      auto product = std::make_shared<CrossProduct>();
+      product->addDependency(left.last_task);
+      product->addDependency(right.last_task);
+      _builder.addPlanOp(product, "CrossProduct", meta);
 
       for (uint i = 0; i < left.fields.size(); ++i)
         meta.addField(left.fields[i], left.name, left.data_types[i]);
+
+      for (uint i = 0; i < right.fields.size(); ++i)
+        meta.addField(right.fields[i], right.name, right.data_types[i]);
     }
   }
   
@@ -140,9 +150,8 @@ TransformationResult SQLStatementTransformer::transformTableRef(TableRef* table_
 }
 
 /**
- * Transforms a join table
- * In this method we try to find out which join algorithm is appropriate for the query.
- * At the moment we simply use HashJoin.
+ * Transforms a join table as written.
+ * Inner joins of select statements are ordered by the SQLQueryOptimizer instead.
  */
 TransformationResult SQLStatementTransformer::transformJoinTable(TableRef* table) {
   TransformationResult meta;
@@ -219,15 +228,25 @@ TransformationResult SQLStatementTransformer::transformHashJoin(TableRef* table)
  * Create a task to get the table specified by the name
  */
 TransformationResult SQLStatementTransformer::addGetTable(std::string name, bool validate) {
-  if (!io::StorageManager::getInstance()->exists(name)) throwError("Table doesn't exist", name);
   TransformationResult meta = ALLOC_TRANSFORMATIONRESULT();
 
+  // Executions of a prepared statement reuse the columns looked up by earlier executions
+  PreparedPlan* plan = (_parameters != nullptr) ? _parameters->getPlan().get() : nullptr;
+  TableInfo columns;
+  bool cached = (plan != nullptr) && plan->getTableInfo(name, columns);
+  if (!cached && !io::StorageManager::getInstance()->exists(name)) throwError("Table doesn't exist", name);
+
   auto get_table = std::make_shared<GetTable>(name);
   _builder.addPlanOp(get_table, "GetTable");
   meta.addTask(get_table);
 
   if (validate) _builder.addValidatePositions(meta);
 
+  if (cached) {
+    meta.useColumnInfoFrom(columns);
+    return meta;
+  }
+
   // Get meta information about the table
   std::shared_ptr<storage::AbstractTable> table = io::StorageManager::getInstance()->getTable(name);
   for (field_t i = 0; i != table->columnCount(); ++i) {
@@ -253,6 +272,7 @@ TransformationResult SQLStatementTransformer::addGetTable(std::string name, bool
     meta.addField(table->metadataAt(i).getName(), name, type);
   }
 
+  if (plan != nullptr) plan->putTableInfo(name, meta);
   return meta;
 }
 
@@ -261,12 +281,12 @@ plan_op_t SQLStatementTransformer::addFilterOpFromExpr(Expr* expr, Transformatio
   // If we have a where clause specified, we need to build a simple table scan over the result
   // Problem: Expression engine only allows comparisons like this: COLUMN = literal
   // we can't have arithmetic sub expressions or expressions consisting of multiple columns
-  SQLPredicateTransformer predicate_transformer(meta);
+  SQLPredicateTransformer predicate_transformer(meta, _parameters.get());
   Json::Value predicates = predicate_transformer.buildPredicatesFromExpr(expr);
 
   auto scan = std::make_shared<SimpleTableScan>();
   scan->setProducesPositions(true);
-  scan->setPredicate(hyrise::access::buildExpression(predicates));
+  scan->setPredicate(predicates, (_parameters != nullptr) ? _parameters->getValues() : Json::Value());
   _builder.addPlanOp(scan, "SimpleTableScan", meta);
   return scan;
 }
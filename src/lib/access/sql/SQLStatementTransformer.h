@@ -11,6 +11,8 @@
 #include "access/sql/SQLDataDefinitionTransformer.h"
 #include "access/sql/SQLDataManipulationTransformer.h"
 #include "access/sql/SQLPrepareTransformer.h"
+#include "access/sql/SQLQueryOptimizer.h"
+#include "access/sql/PreparedStatementManager.h"
 
 namespace hyrise {
 namespace access {
@@ -25,6 +27,7 @@ class SQLStatementTransformer {
   friend SQLSelectTransformer;
   friend SQLDataDefinitionTransformer;
   friend SQLDataManipulationTransformer;
+  friend SQLQueryOptimizer;
 
  public:
   /**
@@ -50,6 +53,19 @@ class SQLStatementTransformer {
   static inline void throwError(std::string msg) { throw std::runtime_error("Error when transforming SQL: " + msg); }
   static inline void throwError(std::string msg, std::string detail) { throw std::runtime_error("Error when transforming SQL: " + msg + " (" + detail + ")"); }
 
+  /**
+   * Binds the values of placeholders when transforming statements of a prepared statement.
+   * @param[in]  parameters  Values for this execution, nullptr for ad-hoc statements
+   */
+  inline void setParameterBinding(std::shared_ptr<ParameterBinding> parameters) { _parameters = parameters; }
+  inline const ParameterBinding* getParameterBinding() const { return _parameters.get(); }
+
+  /**
+   * Returns the value bound to a placeholder expression and any other expression unchanged.
+   * Throws if a placeholder is used outside of a prepared statement.
+   */
+  hsql::Expr* resolveParameter(hsql::Expr* expr) const;
+
   inline TaskListBuilder& getTaskListBuilder() { return _builder; }
   inline bool hasCommit() { return _builder.hasCommit(); }
   inline const task_list_t& getTaskList() { return _builder.getTaskList(); }
@@ -58,6 +74,7 @@ class SQLStatementTransformer {
   SQLDataDefinitionTransformer* getDataDefinitionTransformer();
   SQLDataManipulationTransformer* getDataManipulationTransformer();
   SQLPrepareTransformer* getPrepareTransformer();
+  SQLQueryOptimizer* getQueryOptimizer();
 
  protected:
   /**
@@ -87,6 +104,8 @@ class SQLStatementTransformer {
   SQLDataDefinitionTransformer* _definition_transformer;
   SQLDataManipulationTransformer* _manipulation_transformer;
   SQLPrepareTransformer* _prepare_transformer;
+  SQLQueryOptimizer* _query_optimizer;
+  std::shared_ptr<ParameterBinding> _parameters;
 };
 
 
@@ -22,6 +22,12 @@ std::shared_ptr<PlanOperation> GetTable::parse(const Json::Value& data) {
   return std::make_shared<GetTable>(data["name"].asString());
 }
 
+std::shared_ptr<PlanOperation> GetTable::copy(const Json::Value& parameters) const {
+  auto instance = std::make_shared<GetTable>(_name);
+  copyConfigurationTo(*instance);
+  return instance;
+}
+
 const std::string GetTable::vname() { return "GetTable"; }
 }
 }
@@ -40,17 +40,25 @@ std::shared_ptr<PlanOperation> DumpTable::parse(const Json::Value& data) {
 }
 
 void LoadDumpedTable::executePlanOperation() {
-  io::TableDumpLoader input(Settings::getInstance()->getDBPath(), _name);
+  io::TableDumpLoader input(Settings::getInstance()->getDBPath(),
+                            _name,
+                            io::TableDumpLoader::params().setMapped(_mapped).setPopulate(_populate).setHugePages(
+                                _hugePages));
   io::CSVHeader header(Settings::getInstance()->getDBPath() + "/" + _name + "/header.dat",
                        io::CSVHeader::params().setCSVParams(io::csv::HYRISE_FORMAT));
 
-  auto t = io::Loader::load(io::Loader::params().setInput(input).setHeader(header));
+  auto t = io::Loader::load(
+      io::Loader::params().setInput(input).setHeader(header).setMemoryPolicy(_memoryPolicy));
   addResult(checked_pointer_cast<storage::Store>(t));
 }
 
 std::shared_ptr<PlanOperation> LoadDumpedTable::parse(const Json::Value& data) {
   const auto& pop = std::make_shared<LoadDumpedTable>();
   pop->_name = data["name"].asString();
+  pop->_mapped = data["mapped"].asBool();
+  pop->_populate = data["populate"].asBool();
+  pop->_hugePages = data["hugepages"].asBool();
+  pop->_memoryPolicy = helper::MemoryPolicy::parse(data.get("memory_policy", "default").asString());
   return pop;
 }
 }
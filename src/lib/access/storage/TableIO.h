@@ -21,6 +21,12 @@ class DumpTable : public PlanOperation {
 class LoadDumpedTable : public PlanOperation {
 
   std::string _name;
+  // map the main attribute vectors instead of copying them, see io::TableDumpLoader::params
+  bool _mapped = false;
+  bool _populate = false;
+  bool _hugePages = false;
+  // placement of the copied column memory, see helper::MemoryPolicy
+  helper::MemoryPolicy _memoryPolicy;
 
  public:
   virtual ~LoadDumpedTable() = default;
@@ -52,6 +52,8 @@ void TableLoad::executePlanOperation() {
     }
     auto table = sm->getTable(_table_name);
     table->setName(_table_name);
+    if (!_memoryPolicy.isDefault())
+      table->setMemoryPolicy(_memoryPolicy);
 
     // We don't load unless the necessary prerequisites are met,
     // let StorageManager error if table does not exist
@@ -73,6 +75,9 @@ std::shared_ptr<PlanOperation> TableLoad::parse(const Json::Value& data) {
   if (data.isMember("delimiter")) {
     s->setDelimiter(data["delimiter"].asString());
   }
+  if (data.isMember("memory_policy")) {
+    s->setMemoryPolicy(helper::MemoryPolicy::parse(data["memory_policy"].asString()));
+  }
   if (data.isMember("path")) {
     s->setPath(data["path"].asString());
   } else {
@@ -101,5 +106,7 @@ void TableLoad::setDelimiter(const std::string& d) {
   _delimiter = d;
   _hasDelimiter = true;
 }
+
+void TableLoad::setMemoryPolicy(const helper::MemoryPolicy& policy) { _memoryPolicy = policy; }
 }
 }
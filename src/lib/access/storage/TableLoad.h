@@ -30,6 +30,7 @@ class TableLoad : public PlanOperation {
   void setUnsafe(const bool unsafe);
   void setRaw(const bool raw);
   void setDelimiter(const std::string& d);
+  void setMemoryPolicy(const helper::MemoryPolicy& policy);
 
  private:
   std::string _table_name;
@@ -42,6 +43,7 @@ class TableLoad : public PlanOperation {
   bool _binary;
   bool _unsafe;
   bool _raw;
+  helper::MemoryPolicy _memoryPolicy;
 };
 }
 }
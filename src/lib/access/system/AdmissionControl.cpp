@@ -0,0 +1,207 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/system/AdmissionControl.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+
+namespace hyrise {
+namespace access {
+
+const size_t AdmissionControl::kLatencySamples;
+const std::string AdmissionControl::kDefaultClass = "default";
+
+namespace {
+double milliseconds(epoch_t from, epoch_t to) { return (to > from) ? (to - from) / 1000000.0 : 0.0; }
+}
+
+AdmissionControl::Ticket::Ticket(AdmissionControl& control, size_t workload_class, epoch_t arrival)
+    : _control(control), _workload_class(workload_class), _arrival(arrival) {}
+
+AdmissionControl::Ticket::~Ticket() { _control.release(_workload_class, _arrival); }
+
+const std::string& AdmissionControl::Ticket::workloadClass() const {
+  return _control._classes[_workload_class].settings.name;
+}
+
+AdmissionControl::AdmissionControl(size_t workers, const std::vector<WorkloadClassSettings>& classes)
+    : _workers(std::max<size_t>(workers, 1)), _enabled(!classes.empty()) {
+  double reserved_share = 0;
+  for (const auto& settings : classes) {
+    if (settings.reserved_share < 0 || settings.reserved_share > 1)
+      throw std::runtime_error("Workload class " + settings.name + " reserves an invalid share of the workers");
+    reserved_share += settings.reserved_share;
+    if (findClass(settings.name) != _classes.size())
+      throw std::runtime_error("Workload class " + settings.name + " is defined twice");
+
+    WorkloadClass workload_class;
+    workload_class.settings = settings;
+    workload_class.reserved_workers = static_cast<size_t>(std::floor(settings.reserved_share * _workers));
+    _classes.push_back(workload_class);
+  }
+  if (reserved_share > 1)
+    throw std::runtime_error("Workload classes reserve more than all workers");
+
+  if (findClass(kDefaultClass) == _classes.size()) {
+    WorkloadClass workload_class;
+    workload_class.settings = {kDefaultClass, 0, 0};
+    _classes.push_back(workload_class);
+  }
+}
+
+AdmissionControl& AdmissionControl::getInstance() {
+  static AdmissionControl control(Settings::getInstance()->worker_threads, Settings::getInstance()->workload_classes);
+  return control;
+}
+
+std::vector<WorkloadClassSettings> AdmissionControl::parseClasses(const std::string& spec) {
+  std::vector<WorkloadClassSettings> classes;
+  if (spec.empty())
+    return classes;
+
+  std::vector<std::string> definitions;
+  boost::split(definitions, spec, boost::is_any_of(","));
+  for (const auto& definition : definitions) {
+    std::vector<std::string> fields;
+    boost::split(fields, definition, boost::is_any_of(":"));
+    if (fields.size() < 2 || fields.size() > 3 || fields[0].empty())
+      throw std::runtime_error("Workload class '" + definition + "' is not of the form name:share[:limit]");
+    try {
+      WorkloadClassSettings settings;
+      settings.name = fields[0];
+      settings.reserved_share = boost::lexical_cast<double>(fields[1]);
+      settings.max_concurrency = (fields.size() == 3) ? boost::lexical_cast<size_t>(fields[2]) : 0;
+      classes.push_back(settings);
+    } catch (const boost::bad_lexical_cast&) {
+      throw std::runtime_error("Workload class '" + definition + "' is not of the form name:share[:limit]");
+    }
+  }
+  return classes;
+}
+
+size_t AdmissionControl::findClass(const std::string& name) const {
+  for (size_t i = 0; i < _classes.size(); ++i)
+    if (_classes[i].settings.name == name)
+      return i;
+  return _classes.size();
+}
+
+bool AdmissionControl::canAdmit(size_t index) const {
+  if (!_enabled)
+    return true;
+
+  const WorkloadClass& workload_class = _classes[index];
+  if (workload_class.settings.max_concurrency > 0 && workload_class.running >= workload_class.settings.max_concurrency)
+    return false;
+  if (workload_class.running < workload_class.reserved_workers)
+    return true;
+
+  // workers reserved by a class are taken even while the class does not use them
+  size_t claimed = 0;
+  for (const auto& other : _classes)
+    claimed += std::max(other.running, other.reserved_workers);
+  return claimed < _workers;
+}
+
+AdmissionControl::ticket_ptr_t AdmissionControl::makeTicket(size_t index, epoch_t arrival) {
+  WorkloadClass& workload_class = _classes[index];
+  ++workload_class.running;
+  ++workload_class.admitted;
+  workload_class.total_wait_ms += milliseconds(arrival, get_epoch_nanoseconds());
+  return ticket_ptr_t(new Ticket(*this, index, arrival));
+}
+
+int AdmissionControl::nextWaiting() const {
+  int next = -1;
+  bool next_reserved = false;
+  for (size_t i = 0; i < _classes.size(); ++i) {
+    const WorkloadClass& workload_class = _classes[i];
+    if (workload_class.waiting.empty() || !canAdmit(i))
+      continue;
+    bool reserved = workload_class.running < workload_class.reserved_workers;
+    if (next == -1 || (reserved && !next_reserved) ||
+        (reserved == next_reserved && workload_class.waiting.front().arrival < _classes[next].waiting.front().arrival)) {
+      next = i;
+      next_reserved = reserved;
+    }
+  }
+  return next;
+}
+
+AdmissionControl::ticket_ptr_t AdmissionControl::admit(const std::string& class_name, epoch_t arrival, resume_t resume) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  size_t index = findClass(class_name);
+  if (index == _classes.size())
+    index = findClass(kDefaultClass);
+
+  // queries of a class are admitted in the order they arrive
+  if (_classes[index].waiting.empty() && canAdmit(index))
+    return makeTicket(index, arrival);
+
+  _classes[index].waiting.push_back({arrival, std::move(resume)});
+  return nullptr;
+}
+
+void AdmissionControl::release(size_t index, epoch_t arrival) {
+  std::vector<std::pair<resume_t, ticket_ptr_t> > resumed;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    WorkloadClass& workload_class = _classes[index];
+    --workload_class.running;
+    ++workload_class.completed;
+
+    double latency = milliseconds(arrival, get_epoch_nanoseconds());
+    if (workload_class.latencies.size() < kLatencySamples)
+      workload_class.latencies.push_back(latency);
+    else
+      workload_class.latencies[workload_class.next_latency] = latency;
+    workload_class.next_latency = (workload_class.next_latency + 1) % kLatencySamples;
+
+    for (int next = nextWaiting(); next != -1; next = nextWaiting()) {
+      Waiting waiting = std::move(_classes[next].waiting.front());
+      _classes[next].waiting.pop_front();
+      resumed.emplace_back(std::move(waiting.resume), makeTicket(next, waiting.arrival));
+    }
+  }
+
+  // resumed queries may finish and release their ticket right away
+  for (auto& query : resumed)
+    query.first(query.second);
+}
+
+std::vector<AdmissionControl::ClassMetrics> AdmissionControl::metrics() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  std::vector<ClassMetrics> result;
+  for (const auto& workload_class : _classes) {
+    ClassMetrics metrics;
+    metrics.name = workload_class.settings.name;
+    metrics.reserved_workers = workload_class.reserved_workers;
+    metrics.max_concurrency = workload_class.settings.max_concurrency;
+    metrics.running = workload_class.running;
+    metrics.queued = workload_class.waiting.size();
+    metrics.admitted = workload_class.admitted;
+    metrics.completed = workload_class.completed;
+    metrics.average_wait_ms = workload_class.admitted ? workload_class.total_wait_ms / workload_class.admitted : 0;
+
+    std::vector<double> latencies(workload_class.latencies);
+    std::sort(latencies.begin(), latencies.end());
+    metrics.average_latency_ms = metrics.p50_latency_ms = metrics.p99_latency_ms = metrics.max_latency_ms = 0;
+    if (!latencies.empty()) {
+      double total = 0;
+      for (double latency : latencies)
+        total += latency;
+      metrics.average_latency_ms = total / latencies.size();
+      metrics.p50_latency_ms = latencies[(latencies.size() - 1) / 2];
+      metrics.p99_latency_ms = latencies[(latencies.size() - 1) * 99 / 100];
+      metrics.max_latency_ms = latencies.back();
+    }
+    result.push_back(metrics);
+  }
+  return result;
+}
+}
+}
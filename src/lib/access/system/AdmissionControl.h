@@ -0,0 +1,130 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "helper/epoch.h"
+#include "helper/Settings.h"
+
+namespace hyrise {
+namespace access {
+
+/*
+ * Admission control for the queries of different workload classes.
+ *
+ * Requests name their workload class, e.g. short transactional queries
+ * and long running reports. A class may reserve a share of the worker
+ * threads and limit how many of its queries run at the same time. A query
+ * is admitted if its class is below its limit and the query either fits
+ * into the reservation of its class or into the workers no other class
+ * reserved. Every admitted query counts as one worker until its response
+ * is sent, so reports can not occupy the workers reserved for other
+ * classes.
+ *
+ * Queries that are not admitted wait in a queue per class before their
+ * plan is instantiated. When a query finishes, waiting queries of classes
+ * below their reservation are resumed first, otherwise the query that
+ * waits the longest.
+ *
+ * Without workload classes every query is admitted immediately, only the
+ * latency metrics of the default class are recorded.
+ */
+class AdmissionControl {
+ public:
+  static const size_t kLatencySamples = 1024;
+  static const std::string kDefaultClass;
+
+  // Held by an admitted query until its response is sent
+  class Ticket {
+   public:
+    ~Ticket();
+    const std::string& workloadClass() const;
+
+   private:
+    friend class AdmissionControl;
+    Ticket(AdmissionControl& control, size_t workload_class, epoch_t arrival);
+
+    AdmissionControl& _control;
+    size_t _workload_class;
+    epoch_t _arrival;
+  };
+
+  typedef std::shared_ptr<Ticket> ticket_ptr_t;
+  typedef std::function<void(const ticket_ptr_t&)> resume_t;
+
+  struct ClassMetrics {
+    std::string name;
+    size_t reserved_workers;
+    size_t max_concurrency;
+    size_t running;
+    size_t queued;
+    size_t admitted;
+    size_t completed;
+    // time between the arrival and the admission of a query
+    double average_wait_ms;
+    // time between the arrival of a query and its response, over the last kLatencySamples queries
+    double average_latency_ms;
+    double p50_latency_ms;
+    double p99_latency_ms;
+    double max_latency_ms;
+  };
+
+  AdmissionControl(size_t workers, const std::vector<WorkloadClassSettings>& classes);
+
+  // Admission control used by RequestParseTask, configured by Settings
+  static AdmissionControl& getInstance();
+
+  // Parses a comma separated list of name:share[:limit], throws for malformed classes
+  static std::vector<WorkloadClassSettings> parseClasses(const std::string& spec);
+
+  // Returns a ticket if a query of the class may run now. Otherwise the query is queued and
+  // nullptr is returned, resume is called with the ticket once the query is admitted.
+  // Unknown classes are treated as the default class.
+  ticket_ptr_t admit(const std::string& class_name, epoch_t arrival, resume_t resume);
+
+  bool enabled() const { return _enabled; }
+
+  size_t workers() const { return _workers; }
+
+  std::vector<ClassMetrics> metrics() const;
+
+ private:
+  struct Waiting {
+    epoch_t arrival;
+    resume_t resume;
+  };
+
+  struct WorkloadClass {
+    WorkloadClassSettings settings;
+    size_t reserved_workers = 0;
+    size_t running = 0;
+    size_t admitted = 0;
+    size_t completed = 0;
+    double total_wait_ms = 0;
+    std::deque<Waiting> waiting;
+    // ring buffer of the latest latencies
+    std::vector<double> latencies;
+    size_t next_latency = 0;
+  };
+
+  size_t findClass(const std::string& name) const;
+
+  // all expect _mutex to be held
+  bool canAdmit(size_t index) const;
+  ticket_ptr_t makeTicket(size_t index, epoch_t arrival);
+  int nextWaiting() const;
+
+  void release(size_t index, epoch_t arrival);
+
+  size_t _workers;
+  bool _enabled;
+  std::vector<WorkloadClass> _classes;
+  mutable std::mutex _mutex;
+};
+}
+}
@@ -43,6 +43,8 @@ typedef struct {
   unsigned node;
   std::optional<size_t> in_rows;
   std::optional<size_t> out_rows;
+  // Bytes the operation allocated from the query arena
+  size_t allocated_bytes;
 } performance_attributes_t;
 
 typedef std::vector<std::unique_ptr<performance_attributes_t>> performance_vector_t;
@@ -1,5 +1,6 @@
 #include "access/system/ParallelizablePlanOperation.h"
 
+#include "storage/Store.h"
 #include "storage/TableRangeView.h"
 
 namespace hyrise {
@@ -18,6 +19,16 @@ void ParallelizablePlanOperation::splitInput() {
   const auto& tables = input.getTables();
   if (_count > 0 && !tables.empty()) {
     auto r = distribute(tables[0]->size(), _part, _count);
+    // instances over a chunked main take whole chunks, each with its own dictionaries
+    auto store = std::dynamic_pointer_cast<const storage::Store>(tables[0]);
+    if (store && store->mainChunkCount() > 1) {
+      auto offsets = store->chunkOffsets();
+      if (_count <= offsets.size()) {
+        auto chunks = distribute(offsets.size(), _part, _count);
+        offsets.push_back(store->size());
+        r = {offsets[chunks.first], offsets[chunks.second]};
+      }
+    }
     input.setTable(
         storage::TableRangeView::create(std::const_pointer_cast<storage::AbstractTable>(tables[0]), r.first, r.second),
         0);
@@ -0,0 +1,125 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/system/PlanCache.h"
+
+#include <stdexcept>
+
+#include "helper/Settings.h"
+#include "io/ResourceManager.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+bool isPlaceholder(const Json::Value& value) {
+  return value.isObject() && value.size() == 1 && value.isMember("parameter") && value["parameter"].isString();
+}
+
+void bind(Json::Value& value, const Json::Value& parameters) {
+  if (isPlaceholder(value)) {
+    const std::string name = value["parameter"].asString();
+    if (!parameters.isObject() || !parameters.isMember(name))
+      throw std::runtime_error("No value bound to query parameter '" + name + "'");
+    value = parameters[name];
+  } else if (value.isObject()) {
+    for (const auto& member : value.getMemberNames())
+      bind(value[member], parameters);
+  } else if (value.isArray()) {
+    for (Json::ArrayIndex i = 0; i < value.size(); ++i)
+      bind(value[i], parameters);
+  }
+}
+}
+
+PlanCache::PlanCache(size_t capacity)
+    : _capacity(capacity), _generation(io::ResourceManager::getInstance().generation()) {}
+
+PlanCache& PlanCache::getInstance() {
+  static PlanCache cache(Settings::getInstance()->plan_cache_size);
+  return cache;
+}
+
+std::shared_ptr<const Json::Value> PlanCache::get(const std::string& key) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  invalidateIfOutdated();
+  auto it = _index.find(key);
+  if (it == _index.end()) {
+    ++_misses;
+    return nullptr;
+  }
+  ++_hits;
+  _entries.splice(_entries.begin(), _entries, it->second);
+  return it->second->second;
+}
+
+void PlanCache::put(const std::string& key, const Json::Value& plan) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_capacity == 0)
+    return;
+  invalidateIfOutdated();
+  auto entry = std::make_shared<const Json::Value>(plan);
+  auto it = _index.find(key);
+  if (it != _index.end()) {
+    it->second->second = entry;
+    _entries.splice(_entries.begin(), _entries, it->second);
+    return;
+  }
+  _entries.emplace_front(key, entry);
+  _index[key] = _entries.begin();
+  evict();
+}
+
+void PlanCache::clear() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _entries.clear();
+  _index.clear();
+}
+
+void PlanCache::setCapacity(size_t capacity) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _capacity = capacity;
+  evict();
+}
+
+size_t PlanCache::capacity() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _capacity;
+}
+
+size_t PlanCache::size() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _entries.size();
+}
+
+size_t PlanCache::hits() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _hits;
+}
+
+size_t PlanCache::misses() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _misses;
+}
+
+Json::Value PlanCache::bindParameters(const Json::Value& plan, const Json::Value& parameters) {
+  Json::Value result(plan);
+  bind(result, parameters);
+  return result;
+}
+
+void PlanCache::invalidateIfOutdated() {
+  size_t generation = io::ResourceManager::getInstance().generation();
+  if (generation != _generation) {
+    _entries.clear();
+    _index.clear();
+    _generation = generation;
+  }
+}
+
+void PlanCache::evict() {
+  while (_entries.size() > _capacity) {
+    _index.erase(_entries.back().first);
+    _entries.pop_back();
+  }
+}
+}
+}
@@ -0,0 +1,75 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <json.h>
+
+namespace hyrise {
+namespace access {
+
+/*
+ * Bounded LRU cache of parsed and transformed JSON query plans, keyed by
+ * the hash of the query string. A hit skips parsing and transformation of
+ * the query. Plan operations are still deserialized from a copy of the
+ * cached plan for every execution since they carry per-query state such
+ * as their inputs and transaction context.
+ *
+ * Any change to the set of loaded tables invalidates all cached plans.
+ *
+ * Plans may contain placeholders of the form {"parameter": "name"} which
+ * are bound to the values of the "parameters" object of a request, so
+ * requests that only differ in their parameters share one cached plan.
+ */
+class PlanCache {
+ public:
+  static const size_t kDefaultCapacity = 1024;
+
+  explicit PlanCache(size_t capacity = kDefaultCapacity);
+
+  // Cache used by RequestParseTask, sized by Settings::plan_cache_size
+  static PlanCache& getInstance();
+
+  // Returns the plan cached for key or nullptr
+  std::shared_ptr<const Json::Value> get(const std::string& key);
+
+  void put(const std::string& key, const Json::Value& plan);
+
+  void clear();
+
+  // A capacity of zero disables caching
+  void setCapacity(size_t capacity);
+
+  size_t capacity() const;
+
+  size_t size() const;
+
+  size_t hits() const;
+
+  size_t misses() const;
+
+  // Returns a copy of plan with all placeholders replaced, throws for unbound parameters
+  static Json::Value bindParameters(const Json::Value& plan, const Json::Value& parameters);
+
+ private:
+  typedef std::list<std::pair<std::string, std::shared_ptr<const Json::Value> > > entry_list_t;
+
+  // both expect _mutex to be held
+  void invalidateIfOutdated();
+  void evict();
+
+  entry_list_t _entries;
+  std::unordered_map<std::string, entry_list_t::iterator> _index;
+  size_t _capacity;
+  size_t _generation;
+  size_t _hits = 0;
+  size_t _misses = 0;
+  mutable std::mutex _mutex;
+};
+}
+}
@@ -129,15 +129,22 @@ const PlanOperation* PlanOperation::execute() {
   const bool recordPerformance = _performance_attr != nullptr;
 
   // Check if we really need this
-  epoch_t startTime = 0;
-  if (recordPerformance)
-    startTime = get_epoch_nanoseconds();
+  size_t allocatedBefore = 0;
+  if (recordPerformance) {
+    if (!_resuming) {
+      _execution_start = get_epoch_nanoseconds();
+      _allocated_bytes = 0;
+    }
+    allocatedBefore = helper::QueryArena::threadAllocatedBytes();
+  }
 
   PapiTracer pt;
 
-  // Start the execution
-  refreshInput();
-  setupPlanOperation();
+  // Start the execution, a continuation finds its input prepared
+  if (!_resuming) {
+    refreshInput();
+    setupPlanOperation();
+  }
 
   if (recordPerformance) {
     pt.addEvent("PAPI_TOT_CYC");
@@ -150,6 +157,14 @@ const PlanOperation* PlanOperation::execute() {
   if (recordPerformance)
     pt.stop();
 
+  _resuming = yielded();
+  if (_resuming) {
+    // a continuation may run on another thread, so each slice counts its own allocations
+    if (recordPerformance)
+      _allocated_bytes += helper::QueryArena::threadAllocatedBytes() - allocatedBefore;
+    return this;
+  }
+
   teardownPlanOperation();
 
   if (recordPerformance) {
@@ -176,17 +191,55 @@ const PlanOperation* PlanOperation::execute() {
       // the cardinality is max(size_t) by convention if there is no return table
       cardinality = std::numeric_limits<size_t>::max();
 
+    size_t allocatedBytes = _allocated_bytes + helper::QueryArena::threadAllocatedBytes() - allocatedBefore;
+
     *_performance_attr = (performance_attributes_t) {pt.value("PAPI_TOT_CYC"), pt.value(getEvent()), getEvent(),
-                                                     planOperationName(),      _operatorId,          startTime,
+                                                     planOperationName(),      _operatorId,          _execution_start,
                                                      endTime,                  threadId,             cardinality,
                                                      core,                     node,                 in_size,
-                                                     out_size};
+                                                     out_size,                 allocatedBytes};
   }
 
   setState(OpSuccess);
   return this;
 }
 
+const size_t PlanOperation::kMorselSize;
+
+bool PlanOperation::processMorsels(size_t count, const std::function<void(size_t begin, size_t end)>& process) {
+  if (!_resuming) {
+    _morsel_position = 0;
+    _morsel_count = count;
+  }
+
+  // every slice processes at least one morsel
+  bool progressed = false;
+  while (_morsel_position < _morsel_count) {
+    if (progressed && shouldYield()) {
+      yield();
+      return false;
+    }
+    size_t end = std::min(_morsel_count, _morsel_position + kMorselSize);
+    process(_morsel_position, end);
+    _morsel_position = end;
+    progressed = true;
+  }
+  return true;
+}
+
+std::shared_ptr<PlanOperation> PlanOperation::copy(const Json::Value& parameters) const { return nullptr; }
+
+void PlanOperation::copyConfigurationTo(PlanOperation& copy) const {
+  copy._limit = _limit;
+  copy.producesPositions = producesPositions;
+  copy._indexed_field_definition = _indexed_field_definition;
+  copy._named_field_definition = _named_field_definition;
+  copy._papi_disabled = _papi_disabled;
+  copy._planId = _planId;
+  copy._operatorId = _operatorId;
+  copy._planOperationName = _planOperationName;
+}
+
 void PlanOperation::setLimit(uint64_t l) { _limit = l; }
 
 void PlanOperation::setProducesPositions(bool p) { producesPositions = p; }
@@ -213,6 +266,12 @@ void PlanOperation::setResponseTask(const std::shared_ptr<access::ResponseTask>&
 
 std::shared_ptr<access::ResponseTask> PlanOperation::getResponseTask() const { return _responseTask.lock(); }
 
+std::shared_ptr<helper::QueryArena> PlanOperation::getQueryArena() const {
+  if (auto responseTask = getResponseTask())
+    return responseTask->getQueryArena();
+  return nullptr;
+}
+
 void PlanOperation::disablePapiTrace() { _papi_disabled = true; }
 }
 }
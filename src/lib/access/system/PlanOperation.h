@@ -9,10 +9,13 @@
 
 #include "storage/storage_types.h"
 #include "helper/types.h"
+#include "helper/QueryArena.h"
 #include "storage/AbstractTable.h"
 
 #include "json.h"
 
+#include <functional>
+
 
 namespace hyrise {
 namespace access {
@@ -39,6 +42,18 @@ class PlanOperation : public OutputTask {
   virtual void executePlanOperation() = 0;
   virtual void teardownPlanOperation() {}
 
+  /*!
+   *  Calls process for [0, count) in morsels of kMorselSize. Between two
+   *  morsels the operation yields if high priority tasks wait, processMorsels
+   *  then returns false and executePlanOperation() has to return right away.
+   *  Its continuation calls executePlanOperation() again, processing resumes
+   *  with the next morsel and the count of the first call.
+   */
+  bool processMorsels(size_t count, const std::function<void(size_t begin, size_t end)>& process);
+
+  /// Copies the fields, limit and identification of this operation into copy
+  void copyConfigurationTo(PlanOperation& copy) const;
+
   /* Returns true when none of the dependencies have OpFail state */
   bool allDependenciesSuccessful();
 
@@ -46,6 +61,9 @@ class PlanOperation : public OutputTask {
   std::string getDependencyErrorMessages();
 
  public:
+  /// Rows processed between two checks whether to yield
+  static const size_t kMorselSize = 65536;
+
   virtual ~PlanOperation();
 
   void setLimit(uint64_t l);
@@ -79,10 +97,21 @@ class PlanOperation : public OutputTask {
   virtual const std::string vname();
   virtual const PlanOperation* execute();
 
+  /*!
+   *  Returns an operation with the configuration of this one but without
+   *  dependencies, inputs or results. Placeholders {"parameter": name} in
+   *  the configuration are bound to parameters. Operations that can't be
+   *  copied return nullptr.
+   */
+  virtual std::shared_ptr<PlanOperation> copy(const Json::Value& parameters) const;
+
   void setErrorMessage(const std::string& message);
   void setResponseTask(const std::shared_ptr<ResponseTask>& responseTask);
   std::shared_ptr<ResponseTask> getResponseTask() const;
 
+  /// Arena for the intermediates of the query, nullptr when the operation runs without a ResponseTask
+  std::shared_ptr<helper::QueryArena> getQueryArena() const;
+
  protected:
   /// Containers to store and handle input/output or rather result data.
   OperationData input;
@@ -108,6 +137,14 @@ class PlanOperation : public OutputTask {
   std::string _planOperationName;
 
   tx::TXContext _txContext;
+
+  /// Set while the operation yielded and waits for its continuation
+  bool _resuming = false;
+  epoch_t _execution_start = 0;
+  /// Bytes allocated by the slices that ran before the last yield
+  size_t _allocated_bytes = 0;
+  size_t _morsel_position = 0;
+  size_t _morsel_count = 0;
 };
 }
 }
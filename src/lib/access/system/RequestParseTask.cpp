@@ -12,6 +12,7 @@
 #include "boost/lexical_cast.hpp"
 
 #include "access/system/ResponseTask.h"
+#include "access/system/PlanCache.h"
 #include "access/system/PlanOperation.h"
 #include "access/system/QueryTransformationEngine.h"
 #include "access/tx/Commit.h"
@@ -88,6 +89,24 @@ void RequestParseTask::operator()() {
     std::string body(_connection->getBody());
     std::map<std::string, std::string> body_data = parseHTTPFormData(body);
 
+    // queries wait for their workload class before they get a transaction and a plan, a
+    // waiting query is scheduled again once it is admitted
+    if (!_admission) {
+      auto self = std::static_pointer_cast<RequestParseTask>(shared_from_this());
+      auto ticket = AdmissionControl::getInstance().admit(
+          getOrDefault(body_data, "workload_class", AdmissionControl::kDefaultClass),
+          _queryStart,
+          [self, scheduler](const AdmissionControl::ticket_ptr_t& admitted) {
+            self->_admission = admitted;
+            scheduler->schedule(self);
+          });
+      if (!ticket)
+        return;
+      _admission = ticket;
+    }
+    // the response releases the ticket once it is sent
+    _responseTask->setAdmission(std::move(_admission));
+
     tx::TXContext ctx;
     auto ctx_it = body_data.find("session_context");
     if (ctx_it != body_data.end()) {
@@ -110,6 +129,7 @@ void RequestParseTask::operator()() {
     std::string query_string = "";
     Json::Value json_request_data;
     Json::Reader reader;
+    std::shared_ptr<const Json::Value> cached_plan;
 
     // indicates the query was successfully parsed
     bool parse_was_successful = false;
@@ -122,7 +142,18 @@ void RequestParseTask::operator()() {
     } else if (body_data.find("query") != body_data.end()) {
       is_json_query = true;
       query_string = urldecode(body_data["query"]);
-      parse_was_successful = reader.parse(query_string, json_request_data);
+    }
+
+    const std::string final_hash = hash(query_string);
+
+    if (is_json_query) {
+      // repeated queries skip parsing and transformation
+      if ((cached_plan = PlanCache::getInstance().get(final_hash))) {
+        json_request_data = *cached_plan;
+        parse_was_successful = true;
+      } else {
+        parse_was_successful = reader.parse(query_string, json_request_data);
+      }
     }
 
 
@@ -135,7 +166,6 @@ void RequestParseTask::operator()() {
         performance_data.push_back(std::unique_ptr<performance_attributes_t>(new performance_attributes_t));
       }
 
-      const std::string& final_hash = hash(query_string);
       std::shared_ptr<Task> result = nullptr;
 
       
@@ -165,9 +195,23 @@ void RequestParseTask::operator()() {
       try {
         // Generate tasks from query
         if (is_json_query) {
-          tasks = QueryParser::instance().deserialize(
-                    QueryTransformationEngine::getInstance()->transform(json_request_data),
-                    &result);
+          if (!cached_plan)
+            QueryTransformationEngine::getInstance()->transform(json_request_data);
+
+          auto parameters_it = body_data.find("parameters");
+          if (parameters_it != body_data.end()) {
+            Json::Value parameters;
+            if (!reader.parse(urldecode(parameters_it->second), parameters))
+              throw std::runtime_error("Parsing parameters: " + reader.getFormatedErrorMessages());
+            tasks = QueryParser::instance().deserialize(PlanCache::bindParameters(json_request_data, parameters),
+                                                        &result);
+          } else {
+            tasks = QueryParser::instance().deserialize(json_request_data, &result);
+          }
+
+          // only plans that deserialized successfully are cached
+          if (!cached_plan)
+            PlanCache::getInstance().put(final_hash, json_request_data);
 
         } else if (is_sql_query) {
 
@@ -259,6 +303,8 @@ void RequestParseTask::operator()() {
     if (atoi(body_data["offset"].c_str()) > 0)
       _responseTask->setTransmitOffset(atol(body_data["offset"].c_str()));
 
+    _responseTask->setColumnarLayout(getOrDefault(body_data, "layout", "rows") == "columns");
+
   } else {
     LOG4CXX_WARN(_logger, "no body received!");
   }
@@ -5,6 +5,7 @@
 #include <string>
 #include <memory>
 
+#include "access/system/AdmissionControl.h"
 #include "helper/epoch.h"
 #include "net/Router.h"
 #include "net/AbstractConnection.h"
@@ -20,6 +21,8 @@ class RequestParseTask : public net::AbstractRequestHandler {
   net::AbstractConnection* _connection;
   std::shared_ptr<ResponseTask> _responseTask;
   epoch_t _queryStart;
+  // set once the workload class of the query admitted it
+  AdmissionControl::ticket_ptr_t _admission;
 
  public:
   explicit RequestParseTask(net::AbstractConnection* connection);
@@ -1,6 +1,7 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "access/system/ResponseTask.h"
 
+#include <algorithm>
 #include <thread>
 
 #include "log4cxx/logger.h"
@@ -8,6 +9,8 @@
 
 #include "access/system/PlanOperation.h"
 #include "access/system/OutputTask.h"
+#include "access/system/ResultBatch.h"
+#include "access/system/ResultStreamWriter.h"
 #include "io/TransactionManager.h"
 #include "helper/PapiTracer.h"
 
@@ -122,7 +125,7 @@ task_states_t ResponseTask::getState() const {
   return OpSuccess;
 }
 
-Json::Value ResponseTask::generateResponseJson() {
+Json::Value ResponseTask::generateResponseJson(bool includeRows) {
   Json::Value response;
   epoch_t responseStart = _recordPerformanceData ? get_epoch_nanoseconds() : 0;
   PapiTracer pt;
@@ -150,7 +153,8 @@ Json::Value ResponseTask::generateResponseJson() {
 
       // Copy the complete result
       response["real_size"] = result->size();
-      response["rows"] = generateRowsJson(result, _transmitLimit, _transmitOffset);
+      if (includeRows)
+        response["rows"] = generateRowsJson(result, _transmitLimit, _transmitOffset);
       response["header"] = json_header;
     }
 
@@ -173,6 +177,7 @@ Json::Value ResponseTask::generateResponseJson() {
         // Put null for in/outRows if -1 was set
         element["inRows"] = attr->in_rows ? Json::Value(*(attr->in_rows)) : Json::Value();
         element["outRows"] = attr->out_rows ? Json::Value(*(attr->out_rows)) : Json::Value();
+        element["allocatedBytes"] = Json::Value((Json::UInt64)attr->allocated_bytes);
 
         if (_getSubQueryPerformanceData) {
           element["subQueryPerformanceData"] = _scriptOperation->getSubQueryPerformanceData();
@@ -202,6 +207,9 @@ Json::Value ResponseTask::generateResponseJson() {
       }
       responseElement["inRows"] = result_size ? Json::Value(*result_size) : Json::Value();
       responseElement["outRows"] = Json::Value();
+      // memory of the whole query
+      responseElement["allocatedBytes"] = Json::Value((Json::UInt64)_queryArena->allocatedBytes());
+      responseElement["reservedBytes"] = Json::Value((Json::UInt64)_queryArena->reservedBytes());
 
       json_perf.append(responseElement);
 
@@ -228,10 +236,31 @@ Json::Value ResponseTask::generateResponseJson() {
 }
 
 void ResponseTask::operator()() {
+  // continues a stream that paused for a congested client
+  if (_streamWriter) {
+    if (_streamWriter->proceed(isPreemptible()))
+      finishResponse();
+    else
+      yield();
+    return;
+  }
+
   Json::Value response;
+  // deferred group commit responses are always sent as JSON
+  bool sendBatch = connection->acceptsResultBatches() && !_group_commit;
+  bool stream = false;
+  storage::c_atable_ptr_t result;
 
   if (getDependencyCount() > _resultTaskIndex) {
-    response = generateResponseJson();
+    if (getState() != OpFail)
+      result = getResultTask()->getResultTable();
+    if (result && !sendBatch && !_group_commit) {
+      size_t rows = result->size() > _transmitOffset ? result->size() - _transmitOffset : 0;
+      if (_transmitLimit > 0)
+        rows = std::min(rows, _transmitLimit);
+      stream = _columnarLayout || rows >= kStreamingMinimumRows;
+    }
+    response = generateResponseJson(!(sendBatch || stream));
   }
 
   size_t status = 200;
@@ -250,9 +279,31 @@ void ResponseTask::operator()() {
   if (_group_commit) {
     io::GroupCommitter::getInstance().push(
         std::tuple<net::AbstractConnection*, size_t, std::string>(connection, status, fw.write(response)));
+  } else if (sendBatch) {
+    connection->respond(generateResultBatch(fw.write(response), result, _transmitLimit, _transmitOffset),
+                        status,
+                        net::kResultBatchContentType);
+  } else if (stream) {
+    _streamWriter.reset(new ResultStreamWriter(
+        connection, _columnarLayout ? ResultStreamWriter::ColumnLayout : ResultStreamWriter::RowLayout));
+    _streamWriter->start(response, result, _transmitLimit, _transmitOffset, status);
+    // a congested client requeues the task instead of holding its worker
+    if (!_streamWriter->proceed(isPreemptible())) {
+      yield();
+      return;
+    }
   } else {
     connection->respond(fw.write(response), status);
   }
+  finishResponse();
+}
+
+void ResponseTask::finishResponse() {
+  _streamWriter.reset();
+  // the intermediates go away with the last operation that still references them
+  _queryArena.reset();
+  // lets the next query of a waiting workload class run
+  _admission.reset();
 }
 
 void ResponseTask::setGroupCommit(bool group_commit) { _group_commit = group_commit; }
@@ -7,7 +7,10 @@
 
 #include "json.h"
 
+#include "access/system/AdmissionControl.h"
+#include "access/system/ResultStreamWriter.h"
 #include "helper/epoch.h"
+#include "helper/QueryArena.h"
 #include "access/system/OutputTask.h"
 #include "net/AbstractConnection.h"
 #include "io/TXContext.h"
@@ -19,6 +22,10 @@ namespace access {
 class PlanOperation;
 
 class ResponseTask : public taskscheduler::Task {
+ public:
+  // Results with at least this many transmitted rows are streamed instead of built in memory
+  static const size_t kStreamingMinimumRows = 10000;
+
  private:
   net::AbstractConnection* connection;
 
@@ -45,13 +52,29 @@ class ResponseTask : public taskscheduler::Task {
 
   bool _group_commit = false;
 
+  // Send the result as one array per column instead of one per row
+  bool _columnarLayout = false;
+
   bool _getSubQueryPerformanceData;
 
   std::shared_ptr<ScriptOperation> _scriptOperation;
 
+  // Backs the intermediates of the query, released once the response is sent
+  std::shared_ptr<helper::QueryArena> _queryArena;
+
+  // Admission of the query by its workload class, released once the response is sent
+  AdmissionControl::ticket_ptr_t _admission;
+
+  // Streamed response that paused for a congested client, the task continues it when it runs again
+  std::unique_ptr<ResultStreamWriter> _streamWriter;
+
+  void finishResponse();
+
  public:
   explicit ResponseTask(net::AbstractConnection* connection)
-      : connection(connection), _getSubQueryPerformanceData(false) {
+      : connection(connection),
+        _getSubQueryPerformanceData(false),
+        _queryArena(std::make_shared<helper::QueryArena>()) {
     _affectedRows = 0;
   }
 
@@ -83,6 +106,8 @@ class ResponseTask : public taskscheduler::Task {
 
   void setTransmitOffset(size_t o) { _transmitOffset = o; }
 
+  void setColumnarLayout(bool columnar) { _columnarLayout = columnar; }
+
   int getResultTaskIndex() { return _resultTaskIndex; }
 
   void setResultTaskIndex(int i) { _resultTaskIndex = i; }
@@ -91,6 +116,10 @@ class ResponseTask : public taskscheduler::Task {
 
   performance_vector_t& getPerformanceData() { return performance_data; }
 
+  const std::shared_ptr<helper::QueryArena>& getQueryArena() const { return _queryArena; }
+
+  void setAdmission(AdmissionControl::ticket_ptr_t admission) { _admission = std::move(admission); }
+
   task_states_t getState() const;
 
   std::shared_ptr<PlanOperation> getResultTask();
@@ -102,7 +131,8 @@ class ResponseTask : public taskscheduler::Task {
     _scriptOperation = scriptOperation;
   }
 
-  Json::Value generateResponseJson();
+  // Without rows the response only carries the metadata of the result
+  Json::Value generateResponseJson(bool includeRows = true);
 
   virtual void operator()();
 };
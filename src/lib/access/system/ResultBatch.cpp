@@ -0,0 +1,105 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/system/ResultBatch.h"
+
+#include <endian.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "storage/AbstractTable.h"
+#include "storage/meta_storage.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+void append(std::string& out, uint8_t value) { out.push_back(static_cast<char>(value)); }
+
+void append(std::string& out, uint32_t value) {
+  value = htole32(value);
+  out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void append(std::string& out, uint64_t value) {
+  value = htole64(value);
+  out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void appendValue(std::string& out, const hyrise_string_t& value) {
+  append(out, static_cast<uint32_t>(value.size()));
+  out.append(value);
+}
+
+void appendValue(std::string& out, hyrise_float_t value) {
+  static_assert(sizeof(hyrise_float_t) == sizeof(uint32_t), "floats are sent with 32 bits");
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  append(out, bits);
+}
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value>::type appendValue(std::string& out, T value) {
+  append(out, static_cast<uint64_t>(static_cast<int64_t>(value)));
+}
+
+// Appends the values of one column, all rows at once to keep the type dispatch out of the loop
+struct column_writer_functor {
+  typedef void value_type;
+
+  std::string& out;
+  const storage::c_atable_ptr_t& table;
+  size_t column = 0;
+  size_t first = 0;
+  size_t last = 0;
+
+  column_writer_functor(std::string& out, const storage::c_atable_ptr_t& table) : out(out), table(table) {}
+
+  template <typename R>
+  value_type operator()() {
+    for (size_t row = first; row < last; ++row)
+      appendValue(out, table->getValue<R>(column, row));
+  }
+};
+}
+
+std::string generateResultBatch(const std::string& metadata,
+                                const storage::c_atable_ptr_t& table,
+                                size_t limit,
+                                size_t offset) {
+  std::string out;
+  append(out, static_cast<uint32_t>(metadata.size()));
+  out.append(metadata);
+
+  if (!table) {
+    append(out, static_cast<uint32_t>(0));
+    append(out, static_cast<uint64_t>(0));
+    return out;
+  }
+
+  size_t first = std::min(offset, table->size());
+  size_t last = limit > 0 ? std::min(first + limit, table->size()) : table->size();
+
+  append(out, static_cast<uint32_t>(table->columnCount()));
+  append(out, static_cast<uint64_t>(last - first));
+
+  for (size_t col = 0; col < table->columnCount(); ++col) {
+    append(out, static_cast<uint8_t>(types::getOrderedType(table->typeOfColumn(col))));
+    const std::string& name = table->nameOfColumn(col);
+    append(out, static_cast<uint32_t>(name.size()));
+    out.append(name);
+  }
+
+  storage::type_switch<hyrise_basic_types> ts;
+  column_writer_functor writer(out, table);
+  writer.first = first;
+  writer.last = last;
+  for (size_t col = 0; col < table->columnCount(); ++col) {
+    writer.column = col;
+    ts(table->typeOfColumn(col), writer);
+  }
+  return out;
+}
+}
+}
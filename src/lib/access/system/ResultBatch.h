@@ -0,0 +1,32 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <string>
+
+#include "helper/types.h"
+
+namespace hyrise {
+namespace access {
+
+/*
+ * Binary columnar encoding of a query response as sent by the binary
+ * protocol (see net/BinaryConnection.h). All integers are little endian.
+ *
+ *   uint32 metadata length, metadata: the JSON response without its rows
+ *   uint32 column count, uint64 row count
+ *   per column: uint8 type (0 integer, 1 float, 2 string), uint32 name length, name
+ *   per column: the values of all rows
+ *     integer: int64 per row
+ *     float:   IEEE float per row
+ *     string:  uint32 length and the bytes per row
+ *
+ * Rows are taken from [offset, offset + limit) of the table, a limit of
+ * zero sends all rows behind offset, like the JSON response does. Without
+ * a result table the batch has no columns and no rows.
+ */
+std::string generateResultBatch(const std::string& metadata,
+                                const storage::c_atable_ptr_t& table,
+                                size_t limit = 0,
+                                size_t offset = 0);
+}
+}
@@ -0,0 +1,196 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/system/ResultStreamWriter.h"
+
+#include <algorithm>
+#include <type_traits>
+
+#include "net/AbstractConnection.h"
+#include "storage/AbstractTable.h"
+#include "storage/meta_storage.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+// Formats values exactly like Json::FastWriter does for the corresponding Json::Value
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value, std::string>::type toJson(T value) {
+  return Json::valueToString(static_cast<Json::LargestInt>(value));
+}
+
+std::string toJson(hyrise_float_t value) { return Json::valueToString(static_cast<double>(value)); }
+
+std::string toJson(const hyrise_string_t& value) { return Json::valueToQuotedString(value.c_str()); }
+
+struct format_column_functor {
+  typedef void value_type;
+
+  const storage::c_atable_ptr_t& table;
+  std::vector<std::string>* cells = nullptr;
+  size_t column = 0;
+  size_t first = 0;
+  size_t last = 0;
+
+  explicit format_column_functor(const storage::c_atable_ptr_t& table) : table(table) {}
+
+  template <typename R>
+  value_type operator()() {
+    for (size_t row = first; row < last; ++row)
+      (*cells)[row - first] = toJson(table->getValue<R>(column, row));
+  }
+};
+}
+
+ResultStreamWriter::ResultStreamWriter(net::AbstractConnection* connection, layout_t layout, size_t chunkBytes)
+    : _connection(connection), _layout(layout), _chunkBytes(chunkBytes) {
+  _buffer.reserve(chunkBytes + chunkBytes / 4);
+}
+
+void ResultStreamWriter::write(const Json::Value& metadata,
+                               const storage::c_atable_ptr_t& table,
+                               size_t limit,
+                               size_t offset,
+                               size_t status) {
+  start(metadata, table, limit, offset, status);
+  proceed(false);
+}
+
+void ResultStreamWriter::start(const Json::Value& metadata,
+                               const storage::c_atable_ptr_t& table,
+                               size_t limit,
+                               size_t offset,
+                               size_t status) {
+  _connection->beginResponse(status);
+
+  Json::FastWriter writer;
+  bool firstMember = true;
+  append('{');
+  for (const auto& name : metadata.getMemberNames()) {
+    if (!firstMember)
+      append(',');
+    firstMember = false;
+    append(Json::valueToQuotedString(name.c_str()));
+    append(':');
+    std::string value = writer.write(metadata[name]);
+    value.pop_back();  // FastWriter terminates documents with a newline
+    append(value);
+  }
+
+  _table = table;
+  if (table) {
+    _first = std::min(offset, table->size());
+    _last = limit > 0 ? std::min(_first + limit, table->size()) : table->size();
+    _next = _first;
+    _column = 0;
+    if (!firstMember)
+      append(',');
+    append(_layout == RowLayout ? "\"rows\":[" : "\"columns\":[");
+  }
+}
+
+bool ResultStreamWriter::proceed(bool pauseWhenCongested) {
+  while (!bodyComplete()) {
+    if (_layout == RowLayout)
+      writeRowBatch();
+    else
+      writeColumnBatch();
+    if (pauseWhenCongested && !bodyComplete() && _connection->isCongested())
+      return false;
+  }
+
+  if (_table)
+    append(']');
+  append("}\n");
+
+  flush();
+  _connection->endResponse();
+  _table.reset();
+  return true;
+}
+
+bool ResultStreamWriter::bodyComplete() const {
+  if (!_table)
+    return true;
+  return _layout == RowLayout ? _next == _last : _column == _table->columnCount();
+}
+
+void ResultStreamWriter::writeRowBatch() {
+  storage::type_switch<hyrise_basic_types> ts;
+  format_column_functor format(_table);
+  size_t columns = _table->columnCount();
+  _cells.resize(columns);
+
+  format.first = _next;
+  format.last = std::min(_next + kRowsPerBatch, _last);
+  for (size_t col = 0; col < columns; ++col) {
+    _cells[col].resize(format.last - format.first);
+    format.column = col;
+    format.cells = &_cells[col];
+    ts(_table->typeOfColumn(col), format);
+  }
+
+  for (size_t row = 0; row < format.last - format.first; ++row) {
+    if (_next + row != _first)
+      append(',');
+    append('[');
+    for (size_t col = 0; col < columns; ++col) {
+      if (col > 0)
+        append(',');
+      append(_cells[col][row]);
+    }
+    append(']');
+  }
+  _next = format.last;
+}
+
+void ResultStreamWriter::writeColumnBatch() {
+  storage::type_switch<hyrise_basic_types> ts;
+  format_column_functor format(_table);
+  _cells.resize(1);
+  format.cells = &_cells[0];
+
+  if (_next == _first) {
+    if (_column > 0)
+      append(',');
+    append('[');
+  }
+
+  format.column = _column;
+  format.first = _next;
+  format.last = std::min(_next + kRowsPerBatch, _last);
+  _cells[0].resize(format.last - format.first);
+  ts(_table->typeOfColumn(_column), format);
+  for (size_t row = 0; row < format.last - format.first; ++row) {
+    if (_next + row != _first)
+      append(',');
+    append(_cells[0][row]);
+  }
+  _next = format.last;
+
+  if (_next == _last) {
+    append(']');
+    ++_column;
+    _next = _first;
+  }
+}
+
+void ResultStreamWriter::append(const std::string& data) {
+  _buffer.append(data);
+  if (_buffer.size() >= _chunkBytes)
+    flush();
+}
+
+void ResultStreamWriter::append(char data) {
+  _buffer.push_back(data);
+  if (_buffer.size() >= _chunkBytes)
+    flush();
+}
+
+void ResultStreamWriter::flush() {
+  if (_buffer.empty())
+    return;
+  _connection->sendResponsePart(_buffer);
+  _buffer.clear();
+}
+}
+}
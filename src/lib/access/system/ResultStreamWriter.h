@@ -0,0 +1,84 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "json.h"
+
+#include "helper/types.h"
+
+namespace hyrise {
+namespace net {
+class AbstractConnection;
+}
+
+namespace access {
+
+/*
+ * Serializes a JSON query response straight from the result table into
+ * the response of a connection, in parts of about chunkBytes bytes that
+ * are sent while the rest is still being encoded. Values are read column
+ * by column for a batch of rows at a time, no Json::Value is built per
+ * cell.
+ *
+ * The row layout produces the same document as ResponseTask's JSON
+ * response, "rows" holds one array per row. The column layout instead
+ * holds one array per column in "columns".
+ *
+ * A response is written by start() followed by proceed() until it returns
+ * true. Producers that can be requeued pause between two batches while the
+ * connection is congested and proceed once they run again.
+ */
+class ResultStreamWriter {
+ public:
+  typedef enum {
+    RowLayout,
+    ColumnLayout
+  } layout_t;
+
+  static const size_t kDefaultChunkBytes = 1 << 16;
+  static const size_t kRowsPerBatch = 1024;
+
+  ResultStreamWriter(net::AbstractConnection* connection, layout_t layout, size_t chunkBytes = kDefaultChunkBytes);
+
+  // Sends the members of metadata followed by rows [offset, offset + limit) of table
+  void write(const Json::Value& metadata,
+             const storage::c_atable_ptr_t& table,
+             size_t limit,
+             size_t offset,
+             size_t status);
+
+  // Begins the response with the members of metadata
+  void start(const Json::Value& metadata,
+             const storage::c_atable_ptr_t& table,
+             size_t limit,
+             size_t offset,
+             size_t status);
+  // Sends further rows, returns false if it paused for a congested connection before the response was complete
+  bool proceed(bool pauseWhenCongested);
+
+ private:
+  bool bodyComplete() const;
+  void writeRowBatch();
+  void writeColumnBatch();
+  void append(const std::string& data);
+  void append(char data);
+  void flush();
+
+  net::AbstractConnection* _connection;
+  layout_t _layout;
+  size_t _chunkBytes;
+  std::string _buffer;
+  // formatted values of the current batch, one vector per column
+  std::vector<std::vector<std::string> > _cells;
+
+  storage::c_atable_ptr_t _table;
+  size_t _first = 0;
+  size_t _last = 0;
+  // first row of the next batch and, in the column layout, its column
+  size_t _next = 0;
+  size_t _column = 0;
+};
+}
+}
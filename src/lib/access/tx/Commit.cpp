@@ -11,7 +11,10 @@ auto _ = QueryParser::registerPlanOperation<Commit>("Commit");
 }
 
 void Commit::executePlanOperation() {
-  tx::TransactionManager::commitTransaction(_txContext, _flush_log);
+  // there is no connection to respond to, so we only release the commit contexts we made visible
+  for (auto commit_context : tx::TransactionManager::commitTransaction(_txContext, _flush_log)) {
+    commit_context->release();
+  }
   for (const auto& x : input.getTables()) {
     addResult(x);
   }
@@ -47,5 +47,11 @@ void ValidatePositions::executePlanOperation() {
 std::shared_ptr<PlanOperation> ValidatePositions::parse(const Json::Value& data) {
   return std::make_shared<ValidatePositions>();
 }
+
+std::shared_ptr<PlanOperation> ValidatePositions::copy(const Json::Value& parameters) const {
+  auto instance = std::make_shared<ValidatePositions>();
+  copyConfigurationTo(*instance);
+  return instance;
+}
 }
 }
@@ -0,0 +1,62 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "helper/MappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+namespace hyrise {
+namespace helper {
+
+MappedFile::MappedFile(const std::string& path, bool populate, bool huge_pages) : _path(path) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Could not open " + path + " for mapping: " + std::strerror(errno));
+  }
+
+  struct stat stbuf;
+  if (fstat(fd, &stbuf) < 0) {
+    close(fd);
+    throw std::runtime_error("Unable to determine file size of " + path);
+  }
+  _size = stbuf.st_size;
+
+  // mmap refuses empty mappings, an empty file simply has no data
+  if (_size == 0) {
+    close(fd);
+    return;
+  }
+
+  int flags = MAP_SHARED;
+  if (populate) {
+    flags |= MAP_POPULATE;
+  }
+
+  void* ptr = mmap(nullptr, _size, PROT_READ, flags, fd, 0);
+  // the mapping stays valid after closing the descriptor
+  close(fd);
+  if (ptr == MAP_FAILED) {
+    throw std::runtime_error("Could not map " + path + ": " + std::strerror(errno));
+  }
+  _data = static_cast<char*>(ptr);
+
+#ifdef MADV_HUGEPAGE
+  // only a hint, kernels without THP support for file mappings ignore it
+  if (huge_pages) {
+    madvise(_data, _size, MADV_HUGEPAGE);
+  }
+#endif
+}
+
+MappedFile::~MappedFile() {
+  if (_data != nullptr) {
+    munmap(_data, _size);
+  }
+}
+}
+}  // namespace hyrise::helper
@@ -0,0 +1,39 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "helper/noncopyable.h"
+
+namespace hyrise {
+namespace helper {
+
+/**
+ * Read-only memory mapping of a whole file. The mapping is released
+ * when the object is destroyed, so data structures that point into
+ * the mapping keep a shared_ptr to it.
+ *
+ * By default pages are faulted in lazily on first access. populate
+ * pre-faults the whole file during construction (MAP_POPULATE) and
+ * huge_pages advises the kernel to back the mapping with transparent
+ * huge pages where the file system supports it.
+ */
+class MappedFile : noncopyable {
+ public:
+  explicit MappedFile(const std::string& path, bool populate = false, bool huge_pages = false);
+  ~MappedFile();
+
+  const char* data() const { return _data; }
+
+  size_t size() const { return _size; }
+
+  const std::string& path() const { return _path; }
+
+ private:
+  std::string _path;
+  char* _data = nullptr;
+  size_t _size = 0;
+};
+}
+}  // namespace hyrise::helper
@@ -0,0 +1,160 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "helper/MemoryPolicy.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+
+#include "helper/HwlocHelper.h"
+
+namespace hyrise {
+namespace helper {
+
+namespace {
+const size_t kHugePageSize = 1 << 21;
+
+size_t mappedLength(size_t bytes) { return (bytes + kHugePageSize - 1) & ~(kHugePageSize - 1); }
+
+bool ignoresPolicy(const MemoryPolicy& policy, size_t bytes) {
+  return policy.isDefault() || bytes < kMemoryPolicyMinimumBytes;
+}
+
+// Placement is only a hint, machines without NUMA support simply keep the memory where it is
+void bind(const MemoryPolicy& policy, void* data, size_t bytes, bool migrate) {
+  if (policy.placement == MemoryPolicy::DefaultPlacement)
+    return;
+
+  hwloc_topology_t topology = getHWTopology();
+  hwloc_obj_t obj;
+  hwloc_membind_policy_t membind;
+  switch (policy.placement) {
+    case MemoryPolicy::NodePlacement:
+      obj = hwloc_get_obj_by_type(topology, HWLOC_OBJ_NODE, policy.node);
+      membind = HWLOC_MEMBIND_BIND;
+      break;
+    case MemoryPolicy::InterleavedPlacement:
+      obj = hwloc_get_obj_by_type(topology, HWLOC_OBJ_MACHINE, 0);
+      membind = HWLOC_MEMBIND_INTERLEAVE;
+      break;
+    default:
+      obj = hwloc_get_obj_by_type(topology, HWLOC_OBJ_MACHINE, 0);
+      membind = HWLOC_MEMBIND_FIRSTTOUCH;
+      break;
+  }
+  if (obj == nullptr)
+    return;
+
+  hwloc_set_area_membind_nodeset(topology, data, bytes, obj->nodeset, membind, migrate ? HWLOC_MEMBIND_MIGRATE : 0);
+}
+}
+
+std::string MemoryPolicy::toString() const {
+  std::stringstream ss;
+  switch (placement) {
+    case LocalPlacement:
+      ss << "local";
+      break;
+    case InterleavedPlacement:
+      ss << "interleaved";
+      break;
+    case NodePlacement:
+      ss << "node:" << node;
+      break;
+    default:
+      break;
+  }
+  if (pages != DefaultPages) {
+    if (placement != DefaultPlacement)
+      ss << ",";
+    ss << (pages == TransparentHugePages ? "thp" : "hugetlb");
+  }
+  return isDefault() ? "default" : ss.str();
+}
+
+MemoryPolicy MemoryPolicy::parse(const std::string& policy) {
+  MemoryPolicy result;
+  std::stringstream ss(policy);
+  std::string token;
+  while (std::getline(ss, token, ',')) {
+    if (token == "default" || token.empty()) {
+      continue;
+    } else if (token == "local") {
+      result.placement = LocalPlacement;
+    } else if (token == "interleaved") {
+      result.placement = InterleavedPlacement;
+    } else if (token.compare(0, 5, "node:") == 0) {
+      result.placement = NodePlacement;
+      result.node = std::stoul(token.substr(5));
+    } else if (token == "thp") {
+      result.pages = TransparentHugePages;
+    } else if (token == "hugetlb") {
+      result.pages = ExplicitHugePages;
+    } else {
+      throw std::runtime_error("Unknown memory policy '" + token + "'");
+    }
+  }
+  return result;
+}
+
+void* MemoryPolicy::allocate(size_t bytes) const {
+  if (ignoresPolicy(*this, bytes)) {
+    void* data = calloc(bytes, 1);
+    if (data == nullptr)
+      throw std::bad_alloc();
+    return data;
+  }
+
+  size_t length = mappedLength(bytes);
+  void* data = MAP_FAILED;
+#ifdef MAP_HUGETLB
+  // explicit huge pages need a reserved pool, fall back to regular pages if it is exhausted
+  if (pages == ExplicitHugePages)
+    data = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+  if (data == MAP_FAILED) {
+    data = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (data == MAP_FAILED)
+      throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+    if (pages != DefaultPages)
+      madvise(data, length, MADV_HUGEPAGE);
+#endif
+  }
+
+  // anonymous pages are not faulted in yet, binding them does not need to migrate anything
+  bind(*this, data, length, false);
+  return data;
+}
+
+void MemoryPolicy::deallocate(void* data, size_t bytes) const {
+  if (data == nullptr)
+    return;
+  if (ignoresPolicy(*this, bytes))
+    free(data);
+  else
+    munmap(data, mappedLength(bytes));
+}
+
+void MemoryPolicy::apply(void* data, size_t bytes) const {
+  if (ignoresPolicy(*this, bytes))
+    return;
+
+  const uintptr_t page_size = sysconf(_SC_PAGESIZE);
+  uintptr_t begin = (reinterpret_cast<uintptr_t>(data) + page_size - 1) & ~(page_size - 1);
+  uintptr_t end = (reinterpret_cast<uintptr_t>(data) + bytes) & ~(page_size - 1);
+  if (begin >= end)
+    return;
+
+#ifdef MADV_HUGEPAGE
+  if (pages != DefaultPages)
+    madvise(reinterpret_cast<void*>(begin), end - begin, MADV_HUGEPAGE);
+#endif
+  bind(*this, reinterpret_cast<void*>(begin), end - begin, true);
+}
+}
+}  // namespace hyrise::helper
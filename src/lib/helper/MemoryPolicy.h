@@ -0,0 +1,72 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace hyrise {
+namespace helper {
+
+/**
+ * Placement of the long-lived column memory of a table, i.e. attribute
+ * vectors and dictionaries. Pages can be backed by transparent or explicit
+ * huge pages to reduce TLB misses of full scans, and NUMA placement can be
+ * local to the allocating thread, interleaved over all nodes or bound to
+ * one node. Placement goes through hwloc and is a no-op on machines
+ * without NUMA support.
+ *
+ * Policies are written as a comma separated list, e.g. "interleaved,thp"
+ * or "node:1,hugetlb"; "default" keeps the allocator's behavior.
+ */
+struct MemoryPolicy {
+  typedef enum {
+    DefaultPlacement,
+    LocalPlacement,
+    InterleavedPlacement,
+    NodePlacement
+  } placement_t;
+
+  typedef enum {
+    DefaultPages,
+    TransparentHugePages,
+    ExplicitHugePages
+  } pages_t;
+
+  placement_t placement = DefaultPlacement;
+  pages_t pages = DefaultPages;
+  // only used for NodePlacement
+  unsigned node = 0;
+
+  bool isDefault() const { return placement == DefaultPlacement && pages == DefaultPages; }
+
+  bool operator==(const MemoryPolicy& other) const {
+    return placement == other.placement && pages == other.pages && node == other.node;
+  }
+
+  bool operator!=(const MemoryPolicy& other) const { return !(*this == other); }
+
+  std::string toString() const;
+
+  static MemoryPolicy parse(const std::string& policy);
+
+  /*
+   * Allocates zeroed memory for bytes under this policy, small requests
+   * and the default policy use plain malloc. Memory must be released with
+   * deallocate of an equal policy and the same size.
+   */
+  void* allocate(size_t bytes) const;
+
+  void deallocate(void* data, size_t bytes) const;
+
+  /*
+   * Applies the policy to existing memory such as the buffer of a
+   * std::vector. Only whole pages inside the range are affected and
+   * explicit huge pages degrade to transparent ones.
+   */
+  void apply(void* data, size_t bytes) const;
+};
+
+// Below this size allocations ignore the policy, they would waste most of a huge page
+const size_t kMemoryPolicyMinimumBytes = 1 << 21;
+}
+}  // namespace hyrise::helper
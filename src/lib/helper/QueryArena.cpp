@@ -0,0 +1,76 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "helper/QueryArena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+
+namespace hyrise {
+namespace helper {
+
+namespace {
+thread_local size_t thread_allocated = 0;
+}
+
+QueryArena::QueryArena(size_t block_size) : _block_size(block_size), _reserved(0) {}
+
+QueryArena::~QueryArena() {
+  for (auto block : _blocks) {
+    free(block);
+  }
+}
+
+QueryArena::Region* QueryArena::createRegion() {
+  std::lock_guard<locking::Spinlock> guard(_lock);
+  _regions.emplace_back(new Region(*this));
+  return _regions.back().get();
+}
+
+size_t QueryArena::allocatedBytes() const {
+  std::lock_guard<locking::Spinlock> guard(_lock);
+  size_t allocated = 0;
+  for (const auto& region : _regions) {
+    allocated += region->allocatedBytes();
+  }
+  return allocated;
+}
+
+char* QueryArena::allocateBlock(size_t bytes) {
+  auto block = static_cast<char*>(malloc(bytes));
+  if (block == nullptr)
+    throw std::bad_alloc();
+  std::lock_guard<locking::Spinlock> guard(_lock);
+  _blocks.push_back(block);
+  _reserved += bytes;
+  return block;
+}
+
+QueryArena::Region::Region(QueryArena& arena) : _arena(arena), _allocated(0) {}
+
+void* QueryArena::Region::allocate(size_t bytes, size_t alignment) {
+  thread_allocated += bytes;
+  _allocated.store(_allocated.load(std::memory_order_relaxed) + bytes, std::memory_order_relaxed);
+
+  auto aligned = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(_current) + alignment - 1) & ~(alignment - 1));
+  if (_current != nullptr && aligned + bytes <= _end) {
+    _current = aligned + bytes;
+    return aligned;
+  }
+
+  // large requests get a block of their own so the current block stays usable
+  if (bytes + alignment > _arena._block_size / 4) {
+    auto block = _arena.allocateBlock(bytes + alignment);
+    return reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(block) + alignment - 1) & ~(alignment - 1));
+  }
+
+  _current = _arena.allocateBlock(_arena._block_size);
+  _end = _current + _arena._block_size;
+  aligned = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(_current) + alignment - 1) & ~(alignment - 1));
+  _current = aligned + bytes;
+  return aligned;
+}
+
+size_t QueryArena::threadAllocatedBytes() { return thread_allocated; }
+}
+}  // namespace hyrise::helper
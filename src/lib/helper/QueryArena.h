@@ -0,0 +1,149 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "helper/locking.h"
+#include "helper/noncopyable.h"
+
+namespace hyrise {
+namespace helper {
+
+/**
+ * Monotonic memory arena for the intermediates of a single query. Memory
+ * is carved out of large blocks and never returned individually, all
+ * blocks are freed at once when the arena is destroyed. The ResponseTask
+ * of a query owns its arena and drops it once the response is sent, data
+ * structures allocated from it keep it alive through their allocator.
+ *
+ * Memory is handed out by regions. Each data structure allocates from a
+ * region of its own, which bumps through its current block without locks
+ * or atomic read-modify-writes. Only taking a new block locks the arena.
+ */
+class QueryArena : noncopyable {
+ public:
+  static const size_t kDefaultBlockSize = 1 << 16;
+
+  /**
+   * Bump region within the arena. A region is only used by one thread at
+   * a time, e.g. by the operation building a hash table.
+   */
+  class Region : noncopyable {
+   public:
+    explicit Region(QueryArena& arena);
+
+    void* allocate(size_t bytes, size_t alignment = 16);
+
+    // Bytes handed out by this region
+    size_t allocatedBytes() const { return _allocated.load(std::memory_order_relaxed); }
+
+   private:
+    QueryArena& _arena;
+    char* _current = nullptr;
+    char* _end = nullptr;
+    // only written by the thread using the region, read when the arena reports its bytes
+    std::atomic<size_t> _allocated;
+  };
+
+  explicit QueryArena(size_t block_size = kDefaultBlockSize);
+  ~QueryArena();
+
+  // Creates a region that lives as long as the arena
+  Region* createRegion();
+
+  // Bytes handed out by the regions of this arena
+  size_t allocatedBytes() const;
+
+  // Bytes held in blocks by this arena
+  size_t reservedBytes() const { return _reserved; }
+
+  // Bytes handed out by any arena to the calling thread, used to account per plan operation
+  static size_t threadAllocatedBytes();
+
+ private:
+  char* allocateBlock(size_t bytes);
+
+  const size_t _block_size;
+  mutable locking::Spinlock _lock;
+  std::vector<char*> _blocks;
+  std::vector<std::unique_ptr<Region>> _regions;
+  std::atomic<size_t> _reserved;
+};
+
+/**
+ * Standard allocator on top of a QueryArena. A default constructed
+ * allocator has no arena and uses the heap, so containers keep working
+ * unchanged outside of queries.
+ */
+template <typename T>
+class ArenaAllocator {
+ public:
+  typedef T value_type;
+  typedef T* pointer;
+  typedef const T* const_pointer;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+
+  template <typename U>
+  struct rebind {
+    typedef ArenaAllocator<U> other;
+  };
+
+  ArenaAllocator() {}
+
+  // Allocates from a new region of the arena, copies of the allocator share it
+  ArenaAllocator(const std::shared_ptr<QueryArena>& arena)
+      : _arena(arena), _region(arena ? arena->createRegion() : nullptr) {}
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) : _arena(other.arena()), _region(other.region()) {}
+
+  T* allocate(size_t n, const void* hint = nullptr) {
+    if (_region)
+      return static_cast<T*>(_region->allocate(n * sizeof(T), alignof(T)));
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T* p, size_t n) {
+    if (!_region)
+      ::operator delete(p);
+  }
+
+  template <typename U, typename... Args>
+  void construct(U* p, Args&&... args) {
+    ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+  }
+
+  template <typename U>
+  void destroy(U* p) {
+    p->~U();
+  }
+
+  size_t max_size() const { return size_t(-1) / sizeof(T); }
+
+  const std::shared_ptr<QueryArena>& arena() const { return _arena; }
+  QueryArena::Region* region() const { return _region; }
+
+ private:
+  std::shared_ptr<QueryArena> _arena;
+  QueryArena::Region* _region = nullptr;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) {
+  return lhs.arena() == rhs.arena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) {
+  return !(lhs == rhs);
+}
+}
+}  // namespace hyrise::helper
@@ -6,7 +6,7 @@
 #include <stdexcept>
 #include <iostream>
 
-Settings::Settings() : threadpoolSize(1) {
+Settings::Settings() : threadpoolSize(1), plan_cache_size(1024), network_threads(1) {
 
   // Initiate the class based on Enviroment Variables
   setDBPath(getEnv("HYRISE_DB_PATH", ""));
@@ -36,6 +36,11 @@ void Settings::printInfo() {
   std::cout << del << "Scheduler: " << scheduler_name << std::endl;
   std::cout << del << "Worker Threads: " << worker_threads << std::endl;
   std::cout << del << "Port:" << port << std::endl;
+  std::cout << del << "Plan Cache Size: " << plan_cache_size << std::endl;
+  std::cout << del << "Network Threads: " << network_threads << std::endl;
+  for (const auto& workload_class : workload_classes)
+    std::cout << del << "Workload Class: " << workload_class.name << " (reserved share " << workload_class.reserved_share
+              << ", concurrency limit " << workload_class.max_concurrency << ")" << std::endl;
 
 #ifdef PERSISTENCY_NONE
   std::cout << del << "Persistency: None" << std::endl;
@@ -16,6 +16,15 @@
 
 
 
+// Workload class of the admission control, see access::AdmissionControl
+struct WorkloadClassSettings {
+  std::string name;
+  // share of the worker threads reserved for queries of the class
+  double reserved_share;
+  // maximum number of concurrently running queries, 0 for no limit
+  size_t max_concurrency;
+};
+
 /*  Singleton data container class for global settings.
     Use SettingsOperation to manipulate global settings as long as units
     implementing certain decisions are missing. */
@@ -51,6 +60,12 @@ class Settings {
   std::vector<size_t> numa_nodes, numa_cores;
   std::string scheduler_name;
   size_t commit_window_ms;
+  // number of transformed query plans cached by RequestParseTask
+  size_t plan_cache_size;
+  // number of event loops serving HTTP connections
+  size_t network_threads;
+  // workload classes queries are admitted by, none disables admission control
+  std::vector<WorkloadClassSettings> workload_classes;
 
   std::string getPersistencyDir() {
     char *persistencyDir = getenv("HYRISE_PERSISTENCY_PATH");
@@ -36,6 +36,7 @@
  *       - type ("I")           : sizeof(char)
  *
  *     Commit Entries:
+ *       - commit_id            : sizeof(transaction_cid_t)
  *       - transaction_id       : sizeof(transaction_id_t)
  *       - type ("C")           : sizeof(char)
  *
@@ -49,6 +50,7 @@
  *       - type (255)           : sizeof(char)
  *
  *     Checkpoint Start
+ *       - cutoff commit_id     : sizeof(transaction_cid_t)
  *       - checkpoint id        : sizeof(int)
  *       - type ("X")           : sizeof(char)
  *
@@ -76,13 +78,19 @@
 #include <helper/types.h>
 #include <helper/dir.h>
 
+#include <algorithm>
 #include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
 #include <thread>
 #include <boost/filesystem.hpp>
 
 namespace hyrise {
 namespace io {
 
+constexpr std::chrono::milliseconds BufferedLogger::kCheckpointTimeout;
+
 constexpr size_t LOG_BUFFER_CAPACITY = 16384;
 constexpr size_t LOG_BLOCKSIZE = 4096;  // Align log to 4KB blocks
 
@@ -133,12 +141,13 @@ void BufferedLogger::logValue(const tx::transaction_id_t transaction_id,
   _changes_since_last_checkpoint = true;
 }
 
-void BufferedLogger::logCommit(const tx::transaction_id_t transaction_id) {
-  char entry[9];
+void BufferedLogger::logCommit(const tx::transaction_id_t transaction_id, const tx::transaction_cid_t commit_id) {
+  char entry[17];
   char* cursor = entry;
+  write_value<tx::transaction_cid_t>(cursor, commit_id);
   write_value<tx::transaction_id_t>(cursor, transaction_id);
   write_value<char>(cursor, 'C');
-  _append(entry, 9);
+  _append(entry, 17);
   _changes_since_last_checkpoint = true;
 }
 
@@ -151,12 +160,13 @@ void BufferedLogger::logRollback(const tx::transaction_id_t transaction_id) {
   _changes_since_last_checkpoint = true;
 }
 
-void BufferedLogger::logStartCheckpoint(const size_t checkpoint_id) {
-  char entry[9];
+void BufferedLogger::logStartCheckpoint(const size_t checkpoint_id, const tx::transaction_cid_t cutoff) {
+  char entry[17];
   char* cursor = entry;
+  write_value<tx::transaction_cid_t>(cursor, cutoff);
   write_value<size_t>(cursor, checkpoint_id);
   write_value<char>(cursor, 'X');
-  _append(entry, 9);
+  _append(entry, 17);
 }
 
 void BufferedLogger::logEndCheckpoint(const size_t checkpoint_id) {
@@ -167,16 +177,30 @@ void BufferedLogger::logEndCheckpoint(const size_t checkpoint_id) {
   _append(entry, 9);
 }
 
-size_t BufferedLogger::startCheckpoint() {
+size_t BufferedLogger::startCheckpoint(std::chrono::milliseconds timeout) {
   if (_changes_since_last_checkpoint) {
-    _changes_since_last_checkpoint = false;
+    auto& txmgr = tx::TransactionManager::getInstance();
+    _checkpointMutex.lock();
 
-    // wait for running transaction
-    tx::TransactionManager::getInstance().waitForAllCurrentlyRunningTransactions();
+    // recovery only replays the logfiles of this and the previous checkpoint,
+    // so transactions that started before the previous checkpoint must have
+    // finished. Transactions started since then have a higher tid.
+    if (!txmgr.waitForTransactionsUpTo(_checkpoint_tid_horizon, timeout)) {
+      _checkpointMutex.unlock();
+      throw std::runtime_error("Checkpoint " + std::to_string(_checkpoint_id + 1) +
+                               " postponed, transactions started before checkpoint " +
+                               std::to_string(_checkpoint_id) + " are still running");
+    }
+    _changes_since_last_checkpoint = false;
 
-    _checkpointMutex.lock();
+    // all transactions started from now on only write to the new logfile
     openNextLogfile();
-    logStartCheckpoint(_checkpoint_id);
+    _checkpoint_tid_horizon = txmgr.getLastTransactionId();
+
+    // transactions keep running during the checkpoint, rows committed after
+    // the cutoff are dumped as uncommitted and restored from the log
+    _checkpoint_cid = txmgr.waitForCommitIdCutoff();
+    logStartCheckpoint(_checkpoint_id, _checkpoint_cid);
     return _checkpoint_id;
   } else {
     return 0;
@@ -343,7 +367,7 @@ void BufferedLogger::flush(bool blocking) {
 
 std::string BufferedLogger::getLogfilenameForCheckpoint(size_t checkpoint_id) {
   std::stringstream ss;
-  ss << _logdir << std::setw(5) << std::setfill('0') << _checkpoint_id << ".bin";
+  ss << _logdir << std::setw(5) << std::setfill('0') << checkpoint_id << ".bin";
   return ss.str();
 }
 
@@ -477,6 +501,8 @@ BufferedLogger::BufferedLogger() {
   _tail = _buffer + _buffer_capacity;
   _buffer_size = 0;
   _changes_since_last_checkpoint = true;
+  _checkpoint_cid = tx::INF_CID;
+  _checkpoint_tid_horizon = tx::UNKNOWN;
 
   // clear the complete buffer
   memset(_buffer, 0, _buffer_capacity);
@@ -485,6 +511,7 @@ BufferedLogger::BufferedLogger() {
 void BufferedLogger::truncate() {
   // clears all logs and checkpoints
   _checkpoint_id = 0;
+  _checkpoint_tid_horizon = tx::UNKNOWN;
   boost::filesystem::remove_all(Settings::getInstance()->getLogDir());
   boost::filesystem::remove_all(Settings::getInstance()->getCheckpointDir());
   boost::filesystem::remove_all(Settings::getInstance()->getTableDumpDir());
@@ -502,33 +529,138 @@ void BufferedLogger::truncate() {
   memset(_buffer, 0, _buffer_capacity);
 }
 
-void BufferedLogger::restore(const size_t thread_count) {
+namespace {
+// rows of a table are replayed in ranges of this size by the same worker
+constexpr size_t RESTORE_ROWS_PER_PARTITION = 4096;
 
-  auto logfilename = getLogfilenameForCheckpoint(_checkpoint_id);
+size_t restore_partition_for(const storage::store_ptr_t& store, size_t key, size_t thread_count) {
+  return (std::hash<storage::Store*>()(store.get()) + key) % thread_count;
+}
+}
 
-  int fd = open(logfilename.c_str(), O_RDWR);
-  assert(fd);
+template <typename T>
+T BufferedLogger::readDictionaryValue(char* cursor) {
+  read_value<int>(cursor);  // skip
+  return read_value<T>(cursor);
+}
 
-  struct stat s;
-  fstat(fd, &s);
+template <>
+storage::hyrise_string_t BufferedLogger::readDictionaryValue(char* cursor) {
+  return read_string<int>(cursor);
+}
 
-  auto logfile = (char*)mmap(0, s.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+size_t BufferedLogger::restore(const size_t thread_count) {
+  // checkpoints do not wait for running transactions, so transactions committed
+  // after the checkpoint may have written their rows to the previous logfile.
+  std::vector<size_t> checkpoint_ids = {_checkpoint_id};
+  if (_checkpoint_id > 1) {
+    checkpoint_ids.push_back(_checkpoint_id - 1);
+  }
 
-  std::vector<bool> committed_tid_bitvector;
-  std::vector<bool> rolledback_tid_bitvector;
-  committed_tid_bitvector.resize(1000000, false);  // FIXME: somehow identify largest TID upfront
-  rolledback_tid_bitvector.resize(1000000, false);  // FIXME: somehow identify largest TID upfront
+  // Replay works in two passes: all logfiles are decoded first, so the outcome
+  // of every transaction is known before any row is touched. The decoded
+  // entries are then applied by one worker per partition without locking.
+  std::vector<restore_scan_result> results;
+  std::vector<std::pair<char*, size_t>> mappings;
+  size_t bytes = 0;
+  size_t first_previous_result = 0;
+  for (auto checkpoint_id : checkpoint_ids) {
+    first_previous_result = results.size();
+    auto logfilename = getLogfilenameForCheckpoint(checkpoint_id);
+
+    int fd = open(logfilename.c_str(), O_RDONLY);
+    if (fd == -1) {
+      continue;
+    }
 
+    struct stat s;
+    fstat(fd, &s);
+    if (s.st_size == 0) {
+      close(fd);
+      continue;
+    }
+
+    auto logfile = (char*)mmap(0, s.st_size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+    close(fd);
+    mappings.push_back({logfile, s.st_size});
+    bytes += s.st_size;
+
+    scanLogfile(logfile, s.st_size, thread_count, results);
+  }
+
+  // the checkpoint already contains everything committed up to its cutoff,
+  // of the previous logfile only later commits are replayed
+  if (checkpoint_ids.size() > 1) {
+    tx::transaction_cid_t checkpoint_cid = tx::UNKNOWN_CID;
+    for (size_t i = 0; i < first_previous_result; ++i) {
+      checkpoint_cid = std::max(checkpoint_cid, results[i].checkpoint_cid);
+    }
+    for (size_t i = first_previous_result; i < results.size(); ++i) {
+      results[i].replay_after_cid = checkpoint_cid;
+    }
+  }
+
+  // resolve transaction outcomes, size the vector by the largest tid seen
+  tx::transaction_id_t max_tid = 0;
+  for (const auto& result : results) {
+    for (const auto& commit : result.committed) {
+      max_tid = std::max(max_tid, commit.first);
+    }
+  }
+  std::vector<tx::transaction_cid_t> commit_ids(max_tid + 1, tx::UNKNOWN_CID);
+  for (const auto& result : results) {
+    for (const auto& commit : result.committed) {
+      commit_ids[commit.first] = commit.second;
+    }
+  }
+
+  // grow every delta once to its final size
+  std::map<storage::store_ptr_t, storage::pos_t> max_rows;
+  for (const auto& result : results) {
+    for (const auto& max_row : result.max_rows) {
+      max_rows[max_row.first] = std::max(max_rows[max_row.first], max_row.second);
+    }
+  }
+  for (const auto& max_row : max_rows) {
+    if (max_row.second >= max_row.first->size()) {
+      max_row.first->appendToDelta(max_row.second - max_row.first->size() + 1);
+    }
+  }
+
+  thread_barrier barrier(thread_count);
   std::vector<std::thread> threads;
-  size_t number_of_blocks_in_log = s.st_size / LOG_BLOCKSIZE;
-  size_t leftover_bytes = s.st_size % LOG_BLOCKSIZE;
+  for (size_t partition = 0; partition < thread_count; ++partition) {
+    threads.push_back(std::thread(&BufferedLogger::replay_thread,
+                                  this,
+                                  partition,
+                                  std::cref(results),
+                                  std::cref(commit_ids),
+                                  std::ref(barrier)));
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (const auto& mapping : mappings) {
+    munmap(mapping.first, mapping.second);
+  }
+  return bytes;
+}
+
+void BufferedLogger::scanLogfile(char* logfile,
+                                 size_t file_size,
+                                 size_t thread_count,
+                                 std::vector<restore_scan_result>& results) {
+  size_t number_of_blocks_in_log = file_size / LOG_BLOCKSIZE;
+  size_t leftover_bytes = file_size % LOG_BLOCKSIZE;
   size_t blocks_per_thread = number_of_blocks_in_log / thread_count;
   size_t leftover_blocks = number_of_blocks_in_log % thread_count;
 
-  thread_barrier barrier(thread_count);
-
-  // size_t *thread_results = (size_t*)malloc(sizeof(size_t) * thread_count);
+  // results of previous logfiles must stay in place
+  size_t first_result = results.size();
+  results.resize(first_result + thread_count);
 
+  std::vector<std::thread> threads;
   for (size_t thread_id = 0; thread_id < thread_count; ++thread_id) {
     size_t start_block = thread_id * blocks_per_thread;
     size_t end_block = (thread_id + 1) * blocks_per_thread;
@@ -539,38 +671,43 @@ void BufferedLogger::restore(const size_t thread_count) {
       leftovers = leftover_bytes;
     }
 
-    threads.push_back(std::thread(&BufferedLogger::restore_thread,
+    threads.push_back(std::thread(&BufferedLogger::scan_thread,
                                   this,
                                   logfile,
                                   start_block,
                                   end_block,
                                   leftovers,
-                                  thread_id,
-                                  std::ref(committed_tid_bitvector),
-                                  std::ref(rolledback_tid_bitvector),
-                                  std::ref(barrier)));
+                                  thread_count,
+                                  std::ref(results[first_result + thread_id])));
   }
 
   for (auto& thread : threads) {
     thread.join();
   }
-
-  // close the file
-  if (fd)
-    close(fd);
 }
 
-void BufferedLogger::restore_thread(char* logfile,
-                                    size_t start_block,
-                                    size_t end_block,
-                                    size_t leftovers,
-                                    size_t thread_id,
-                                    std::vector<bool>& committed_tid_bitvector,
-                                    std::vector<bool>& rolledback_tid_bitvector,
-                                    thread_barrier& barrier) {
+void BufferedLogger::scan_thread(char* logfile,
+                                 size_t start_block,
+                                 size_t end_block,
+                                 size_t leftovers,
+                                 size_t thread_count,
+                                 restore_scan_result& result) {
+  result.partitions.resize(thread_count);
+
+  // avoid a StorageManager lookup for every entry
+  std::map<std::string, storage::store_ptr_t> stores;
+  auto get_store = [&stores](const std::string& table_name) -> const storage::store_ptr_t & {
+    auto& store = stores[table_name];
+    if (!store) {
+      store = std::dynamic_pointer_cast<storage::Store>(StorageManager::getInstance()->getTable(table_name));
+    }
+    return store;
+  };
 
-  std::vector<std::tuple<storage::store_ptr_t, tx::transaction_id_t, storage::pos_t>> pending_inserts;
-  std::vector<std::tuple<storage::store_ptr_t, tx::transaction_id_t, storage::pos_t>> pending_deletes;
+  auto track_row = [&result](const storage::store_ptr_t& store, storage::pos_t row) {
+    auto& max_row = result.max_rows[store];
+    max_row = std::max(max_row, row);
+  };
 
   // start reading the logfile from the back
   char* cursor = logfile + (end_block * LOG_BLOCKSIZE) - 1 + leftovers;
@@ -584,45 +721,15 @@ void BufferedLogger::restore_thread(char* logfile,
         auto table_name = read_string<char>(cursor);
         auto column = read_value<storage::field_t>(cursor);
         auto value_id = read_value<storage::value_id_t>(cursor);
-        auto store = std::dynamic_pointer_cast<storage::Store>(StorageManager::getInstance()->getTable(table_name));
-
-        switch (store->typeOfColumn(column)) {
-          // kill me...
-          case IntegerType:
-          case IntegerTypeDelta:
-          case IntegerTypeDeltaConcurrent: {
-            read_value<int>(cursor);  // skip
-            auto dict = std::dynamic_pointer_cast<storage::ConcurrentUnorderedDictionary<storage::hyrise_int_t>>(
-                store->getDeltaTable()->dictionaryAt(column));
-            auto value = read_value<storage::hyrise_int_t>(cursor);
-            assert(dict);
-            dict->setValueId(value, value_id);
-            break;
-          }
-          case FloatType:
-          case FloatTypeDelta:
-          case FloatTypeDeltaConcurrent: {
-            read_value<int>(cursor);  // skip
-            auto dict = std::dynamic_pointer_cast<storage::ConcurrentUnorderedDictionary<storage::hyrise_float_t>>(
-                store->getDeltaTable()->dictionaryAt(column));
-            auto value = read_value<storage::hyrise_float_t>(cursor);
-            assert(dict);
-            dict->setValueId(value, value_id);
-            break;
-          }
-          case StringType:
-          case StringTypeDelta:
-          case StringTypeDeltaConcurrent: {
-            auto dict = std::dynamic_pointer_cast<storage::ConcurrentUnorderedDictionary<storage::hyrise_string_t>>(
-                store->getDeltaTable()->dictionaryAt(column));
-            auto value = read_string<int>(cursor);
-            assert(dict);
-            dict->setValueId(value, value_id);
-            break;
-          }
-          default:
-            throw std::runtime_error("Unsupported column type for recovery.");
-        }
+        const auto& store = get_store(table_name);
+
+        // the value is decoded during replay, skip it
+        char* value = cursor;
+        auto length = read_value<int>(cursor);
+        cursor -= length;
+
+        result.partitions[restore_partition_for(store, column, thread_count)].dictionary_entries.push_back(
+            {store, column, value_id, value});
 
         read_value<char>(cursor);  // finished flag only used for flushing
         break;
@@ -632,36 +739,16 @@ void BufferedLogger::restore_thread(char* logfile,
       case 'V': {
         auto transaction_id = read_value<tx::transaction_id_t>(cursor);
         auto table_name = read_string<char>(cursor);
-        auto store = std::dynamic_pointer_cast<storage::Store>(StorageManager::getInstance()->getTable(table_name));
+        const auto& store = get_store(table_name);
         auto row = read_value<storage::pos_t>(cursor);
-        auto pos_in_delta = row - store->deltaOffset();
-        auto value_id = 0;
 
-        if (row >= store->size())
-          store->appendToDelta(row - store->size() + 1);
+        // the value ids are decoded during replay, skip them
+        char* value_ids = cursor;
+        cursor -= store->columnCount() * sizeof(storage::value_id_t);
 
-        for (size_t i = 1; i <= store->columnCount(); i++) {
-          value_id = read_value<storage::value_id_t>(cursor);
-          // columns were logged in ascending order - we get the last column first
-          store->getDeltaTable()->setValueId(store->columnCount() - i, pos_in_delta, ValueId(value_id, 1));
-        }
-
-        // add row to indices
-        store->addRowToDeltaIndices(row);
-
-        // handle invalidated row
-        if (committed_tid_bitvector[transaction_id] == true) {
-          store->setBeginCid(row, tx::START_TID);
-        }
-
-        if (committed_tid_bitvector[transaction_id] == true) {
-          // Transaction was committed so we set the row to valid
-          store->setBeginCid(row, tx::START_TID);
-        } else if (rolledback_tid_bitvector[transaction_id] == false) {
-          // We have not found a commit or rollback entry for the TX,
-          // so we save it for separate reprocessing
-          pending_inserts.push_back(std::make_tuple(store, transaction_id, row));
-        }  // else: Insert was rolled back, so nothing to do here
+        track_row(store, row);
+        result.partitions[restore_partition_for(store, row / RESTORE_ROWS_PER_PARTITION, thread_count)]
+            .inserts.push_back({store, transaction_id, row, value_ids});
 
         read_value<char>(cursor);  // finished flag only used for flushing
         break;
@@ -671,19 +758,12 @@ void BufferedLogger::restore_thread(char* logfile,
       case 'I': {
         auto transaction_id = read_value<tx::transaction_id_t>(cursor);
         auto table_name = read_string<char>(cursor);
-        auto store = std::dynamic_pointer_cast<storage::Store>(StorageManager::getInstance()->getTable(table_name));
+        const auto& store = get_store(table_name);
         auto invalidated_row = read_value<storage::pos_t>(cursor);
 
-        if (committed_tid_bitvector[transaction_id] == true) {
-          // Transaction was committed so we invalidate the row
-          if (invalidated_row >= store->size())
-            store->appendToDelta(invalidated_row - store->size() + 1);
-          store->setEndCid(invalidated_row, tx::START_TID);
-        } else if (rolledback_tid_bitvector[transaction_id] == false) {
-          // We have not found a commit or rollback entry for the TX,
-          // so we save it for separate reprocessing
-          pending_deletes.push_back(std::make_tuple(store, transaction_id, invalidated_row));
-        }  // else: Delete was rolled back, so nothing to do here
+        track_row(store, invalidated_row);
+        result.partitions[restore_partition_for(store, invalidated_row / RESTORE_ROWS_PER_PARTITION, thread_count)]
+            .invalidations.push_back({store, transaction_id, invalidated_row, nullptr});
 
         read_value<char>(cursor);  // finished flag only used for flushing
         break;
@@ -692,15 +772,14 @@ void BufferedLogger::restore_thread(char* logfile,
       // commited transaction
       case 'C': {
         auto transaction_id = read_value<tx::transaction_id_t>(cursor);
-        committed_tid_bitvector[transaction_id] = true;
+        result.committed.push_back({transaction_id, read_value<tx::transaction_cid_t>(cursor)});
         read_value<char>(cursor);  // finished flag only used for flushing
         break;
       }
 
       // rolled back transaction
       case 'R': {
-        auto transaction_id = read_value<tx::transaction_id_t>(cursor);
-        rolledback_tid_bitvector[transaction_id] = true;
+        read_value<tx::transaction_id_t>(cursor);  // rows of unfinished transactions are rolled back anyway
         read_value<char>(cursor);  // finished flag only used for flushing
         break;
       }
@@ -708,6 +787,7 @@ void BufferedLogger::restore_thread(char* logfile,
       // Checkpoint start
       case 'X': {
         read_value<size_t>(cursor);
+        result.checkpoint_cid = read_value<tx::transaction_cid_t>(cursor);
         read_value<char>(cursor);  // finished flag only used for flushing
         break;
       }
@@ -735,33 +815,117 @@ void BufferedLogger::restore_thread(char* logfile,
       }
     }
   }
+}
 
-  // synchronize all threads
-  barrier.wait();
-
-  for (auto pending : pending_inserts) {
-    auto store = std::get<0>(pending);
-    auto transaction_id = std::get<1>(pending);
-    auto row = std::get<2>(pending);
+template <typename T>
+void BufferedLogger::replayDictionaryEntries(std::vector<const restore_dictionary_entry*>::const_iterator begin,
+                                             std::vector<const restore_dictionary_entry*>::const_iterator end) {
+  auto dict = std::dynamic_pointer_cast<storage::ConcurrentUnorderedDictionary<T>>(
+      (*begin)->store->getDeltaTable()->dictionaryAt((*begin)->column));
+  assert(dict);
+
+  std::vector<std::pair<T, storage::value_id_t>> values;
+  values.reserve(end - begin);
+  for (auto it = begin; it != end; ++it) {
+    values.push_back({readDictionaryValue<T>((*it)->value), (*it)->value_id});
+  }
+  dict->setValueIds(values);
+}
 
-    if (committed_tid_bitvector[transaction_id] == true) {
-      // Transaction was committed so we set the row to valid
-      store->setBeginCid(row, tx::START_TID);
-    } else {
-      // We have not found a commit entry for the TX,
-      // so the row gets invalidated
-      store->setBeginCid(row, tx::INF_CID);
+void BufferedLogger::replay_thread(size_t partition,
+                                   const std::vector<restore_scan_result>& results,
+                                   const std::vector<tx::transaction_cid_t>& commit_ids,
+                                   thread_barrier& barrier) {
+  auto commit_id = [&commit_ids](tx::transaction_id_t tid) {
+    return tid < (tx::transaction_id_t)commit_ids.size() ? commit_ids[tid] : tx::UNKNOWN_CID;
+  };
+  auto is_committed = [&commit_id](tx::transaction_id_t tid) { return commit_id(tid) != tx::UNKNOWN_CID; };
+
+  // Each column belongs to exactly one partition, so its dictionary
+  // entries are inserted as a single batch. Value ids of the previous
+  // logfile that the checkpoint dictionary already contains are skipped.
+  std::vector<const restore_dictionary_entry*> dictionary_entries;
+  for (const auto& result : results) {
+    for (const auto& entry : result.partitions[partition].dictionary_entries) {
+      if (result.replay_after_cid != tx::UNKNOWN_CID &&
+          entry.value_id < entry.store->getDeltaTable()->dictionaryAt(entry.column)->size()) {
+        continue;
+      }
+      dictionary_entries.push_back(&entry);
+    }
+  }
+  std::sort(dictionary_entries.begin(),
+            dictionary_entries.end(),
+            [](const restore_dictionary_entry* a, const restore_dictionary_entry* b) {
+    return std::make_pair(a->store.get(), a->column) < std::make_pair(b->store.get(), b->column);
+  });
+
+  auto begin = dictionary_entries.cbegin();
+  while (begin != dictionary_entries.cend()) {
+    auto end = std::find_if(begin, dictionary_entries.cend(), [&begin](const restore_dictionary_entry* entry) {
+      return entry->store != (*begin)->store || entry->column != (*begin)->column;
+    });
+
+    switch ((*begin)->store->typeOfColumn((*begin)->column)) {
+      case IntegerType:
+      case IntegerTypeDelta:
+      case IntegerTypeDeltaConcurrent:
+        replayDictionaryEntries<storage::hyrise_int_t>(begin, end);
+        break;
+      case FloatType:
+      case FloatTypeDelta:
+      case FloatTypeDeltaConcurrent:
+        replayDictionaryEntries<storage::hyrise_float_t>(begin, end);
+        break;
+      case StringType:
+      case StringTypeDelta:
+      case StringTypeDeltaConcurrent:
+        replayDictionaryEntries<storage::hyrise_string_t>(begin, end);
+        break;
+      default:
+        throw std::runtime_error("Unsupported column type for recovery.");
     }
+    begin = end;
   }
 
-  for (auto pending : pending_deletes) {
-    auto store = std::get<0>(pending);
-    auto transaction_id = std::get<1>(pending);
-    auto row = std::get<2>(pending);
+  // rows are added to the delta indices, which need complete dictionaries
+  barrier.wait();
+
+  for (const auto& result : results) {
+    // entries of the previous logfile are replayed only for transactions
+    // that committed after the checkpoint cutoff
+    auto replay = [&result, &commit_id](tx::transaction_id_t tid) {
+      return result.replay_after_cid == tx::UNKNOWN_CID || commit_id(tid) > result.replay_after_cid;
+    };
+
+    for (const auto& insert : result.partitions[partition].inserts) {
+      const auto& store = insert.store;
+      // rows below the delta were merged into the main of the checkpoint
+      if (!replay(insert.transaction_id) || insert.row < store->deltaOffset()) {
+        continue;
+      }
+      auto pos_in_delta = insert.row - store->deltaOffset();
+      char* cursor = insert.value_ids;
 
-    if (committed_tid_bitvector[transaction_id] == true) {
-      // The delete was committed so we invalidate the row
-      store->setEndCid(row, tx::START_TID);
+      for (size_t i = 1; i <= store->columnCount(); i++) {
+        auto value_id = read_value<storage::value_id_t>(cursor);
+        // columns were logged in ascending order - we get the last column first
+        store->getDeltaTable()->setValueId(store->columnCount() - i, pos_in_delta, ValueId(value_id, 1));
+      }
+
+      // rows of rolled back or unfinished transactions stay invisible and unindexed
+      if (is_committed(insert.transaction_id)) {
+        store->addRowToDeltaIndices(insert.row);
+        store->setBeginCid(insert.row, tx::START_TID);
+      } else {
+        store->setBeginCid(insert.row, tx::INF_CID);
+      }
+    }
+
+    for (const auto& invalidation : result.partitions[partition].invalidations) {
+      if (is_committed(invalidation.transaction_id) && replay(invalidation.transaction_id)) {
+        invalidation.store->setEndCid(invalidation.row, tx::START_TID);
+      }
     }
   }
 }
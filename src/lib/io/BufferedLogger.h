@@ -1,9 +1,12 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <cstdio>
 #include <cstring>
+#include <map>
 #include <mutex>
+#include <vector>
 
 #include "storage/storage_types.h"
 #include "helper/types.h"
@@ -17,6 +20,9 @@ class BufferedLogger {
   BufferedLogger(const BufferedLogger&) = delete;
   BufferedLogger& operator=(const BufferedLogger&) = delete;
 
+  // how long a checkpoint waits for transactions that started before the previous one
+  static constexpr std::chrono::milliseconds kCheckpointTimeout{1000};
+
   static BufferedLogger& getInstance();
 
   template <typename T>
@@ -85,15 +91,18 @@ class BufferedLogger {
                        const std::string& table_name,
                        const storage::pos_t invalidated_row);
 
-  void logCommit(tx::transaction_id_t transaction_id);
+  void logCommit(tx::transaction_id_t transaction_id, tx::transaction_cid_t commit_id);
   void logRollback(tx::transaction_id_t transaction_id);
   void flush(bool blocking = true);
   void truncate();
-  void restore(const size_t thread_count);
+  // replays the logfiles since the last checkpoint, returns the number of bytes read
+  size_t restore(const size_t thread_count);
 
-  size_t startCheckpoint();
+  // Returns the id of the started checkpoint or 0 if nothing changed since the last one. Waits up to
+  // timeout for transactions that started before the last checkpoint and throws if they do not finish.
+  size_t startCheckpoint(std::chrono::milliseconds timeout = kCheckpointTimeout);
   size_t endCheckpoint();
-  void logStartCheckpoint(const size_t checkpoint_id);
+  void logStartCheckpoint(const size_t checkpoint_id, const tx::transaction_cid_t cutoff);
   void logEndCheckpoint(const size_t checkpoint_id);
   void openNextLogfile();
 
@@ -105,19 +114,70 @@ class BufferedLogger {
     return _checkpoint_id;
   };
 
+  // commit id up to which the running checkpoint contains committed rows
+  tx::transaction_cid_t getCheckpointCid() {
+    return _checkpoint_cid;
+  };
+
  private:
   BufferedLogger();
 
   void _append(const char* str, const unsigned char len);
 
-  void restore_thread(char* logfile,
-                      size_t start_block,
-                      size_t end_block,
-                      size_t leftovers,
-                      size_t thread_id,
-                      std::vector<bool>& committed_tid_bitvector,
-                      std::vector<bool>& rolledback_tid_bitvector,
-                      thread_barrier& barrier);
+  // Log entries are decoded by one worker per range of log blocks and
+  // replayed by the worker owning their partition. Entries keep a cursor
+  // into the mapped logfile, their payload is only read during replay.
+  struct restore_dictionary_entry {
+    storage::store_ptr_t store;
+    storage::field_t column;
+    storage::value_id_t value_id;
+    char* value;
+  };
+
+  struct restore_row_entry {
+    storage::store_ptr_t store;
+    tx::transaction_id_t transaction_id;
+    storage::pos_t row;
+    char* value_ids;
+  };
+
+  struct restore_partition {
+    std::vector<restore_dictionary_entry> dictionary_entries;
+    std::vector<restore_row_entry> inserts;
+    std::vector<restore_row_entry> invalidations;
+  };
+
+  struct restore_scan_result {
+    std::vector<restore_partition> partitions;
+    // transaction id and commit id of every commit entry
+    std::vector<std::pair<tx::transaction_id_t, tx::transaction_cid_t>> committed;
+    std::map<storage::store_ptr_t, storage::pos_t> max_rows;
+    // cutoff of the checkpoint started in this logfile
+    tx::transaction_cid_t checkpoint_cid = tx::UNKNOWN_CID;
+    // set for the previous logfile, only later commits are replayed from it
+    tx::transaction_cid_t replay_after_cid = tx::UNKNOWN_CID;
+  };
+
+  void scanLogfile(char* logfile, size_t file_size, size_t thread_count, std::vector<restore_scan_result>& results);
+
+  void scan_thread(char* logfile,
+                   size_t start_block,
+                   size_t end_block,
+                   size_t leftovers,
+                   size_t thread_count,
+                   restore_scan_result& result);
+
+  void replay_thread(size_t partition,
+                     const std::vector<restore_scan_result>& results,
+                     const std::vector<tx::transaction_cid_t>& commit_ids,
+                     thread_barrier& barrier);
+
+  template <typename T>
+  void replayDictionaryEntries(std::vector<const restore_dictionary_entry*>::const_iterator begin,
+                               std::vector<const restore_dictionary_entry*>::const_iterator end);
+
+  template <typename T>
+  T readDictionaryValue(char* cursor);
 
   char* getBufferWriteArea(const size_t size);
   void writePaddingEntry(size_t absolute_write_pos, size_t padding);
@@ -142,10 +202,18 @@ class BufferedLogger {
   std::atomic<size_t> _checkpoint_id;
 
   bool _changes_since_last_checkpoint;
+
+  // rows committed after this cid are not part of the current checkpoint
+  tx::transaction_cid_t _checkpoint_cid;
+  // transactions up to this tid may have written to the previous logfile
+  tx::transaction_id_t _checkpoint_tid_horizon;
   std::string _logdir;
 };
 
 template <>
 void BufferedLogger::logDictionaryValue(char*& cursor, const storage::hyrise_string_t& value);
+
+template <>
+storage::hyrise_string_t BufferedLogger::readDictionaryValue(char* cursor);
 }
 }
@@ -28,6 +28,7 @@ param_member_impl(Loader::params, bool, ReturnsMutableVerticalTable)
 param_member_impl(Loader::params, bool, Compressed)
 param_member_impl(Loader::params, storage::c_atable_ptr_t, ReferenceTable)
 param_member_impl(Loader::params, bool, DeltaDataStructure)
+param_member_impl(Loader::params, helper::MemoryPolicy, MemoryPolicy)
 
 Loader::params::params()
     : Input(nullptr),
@@ -38,14 +39,16 @@ Loader::params::params()
       ReturnsMutableVerticalTable(false),
       Compressed(false),
       ReferenceTable(),
-      DeltaDataStructure(false) {}
+      DeltaDataStructure(false),
+      MemoryPolicy() {}
 
 Loader::params::params(const Loader::params& other)
     : BasePath(other.getBasePath()),
       TableName(other.getTableName()),
       ModifiableMutableVerticalTable(other.getModifiableMutableVerticalTable()),
       ReturnsMutableVerticalTable(other.getReturnsMutableVerticalTable()),
-      Compressed(other.getCompressed()) {
+      Compressed(other.getCompressed()),
+      MemoryPolicy(other.getMemoryPolicy()) {
   if (other.Input != nullptr)
     Input = other.Input->clone();
   if (other.Header != nullptr)
@@ -68,6 +71,7 @@ Loader::params& Loader::params::operator=(const Loader::params& other) {
     setModifiableMutableVerticalTable(other.getModifiableMutableVerticalTable());
     setCompressed(other.getCompressed());
     setReferenceTable(other.getReferenceTable());
+    setMemoryPolicy(other.getMemoryPolicy());
   }
   // by convention, always return *this
   return *this;
@@ -85,6 +89,7 @@ Loader::params* Loader::params::clone() const {
   p->setModifiableMutableVerticalTable(ModifiableMutableVerticalTable);
   p->setReferenceTable(ReferenceTable);
   p->setCompressed(Compressed);
+  p->setMemoryPolicy(MemoryPolicy);
   return p;
 }
 
@@ -160,6 +165,10 @@ std::shared_ptr<storage::AbstractTable> Loader::load(const params& args) {
     result = s;
   }
 
+  if (!args.getMemoryPolicy().isDefault()) {
+    result->setMemoryPolicy(args.getMemoryPolicy());
+  }
+
   if (!args.getModifiableMutableVerticalTable() && args.getReturnsMutableVerticalTable()) {
     table = std::dynamic_pointer_cast<storage::Store>(result)->getMainTable();
     result = table;
@@ -4,6 +4,7 @@
 #include <memory>
 #include <string>
 
+#include "helper/MemoryPolicy.h"
 #include "helper/types.h"
 #include "storage/storage_types.h"
 
@@ -46,6 +47,8 @@ class params {
   param_member(storage::c_atable_ptr_t, ReferenceTable);
 
   param_member(bool, DeltaDataStructure);
+  /// Placement of the column memory of the loaded table
+  param_member(helper::MemoryPolicy, MemoryPolicy);
 
  public:
   params();
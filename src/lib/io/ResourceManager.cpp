@@ -25,6 +25,8 @@ size_t ResourceManager::size() const {
   return _resources.size();
 }
 
+size_t ResourceManager::generation() const { return _generation; }
+
 bool ResourceManager::exists(const std::string& name, bool unsafe) const {
   if (!unsafe)
     auto lock = lock_guard(_resource_mutex);
@@ -42,12 +44,14 @@ void ResourceManager::assureExists(const std::string& name, bool unsafe) const {
 void ResourceManager::clear() const {
   auto lock = lock_guard(_resource_mutex);
   _resources.clear();
+  ++_generation;
 }
 
 void ResourceManager::remove(const std::string& name) const {
   auto lock = lock_guard(_resource_mutex);
   assureExists(name);
   _resources.erase(name);
+  ++_generation;
 }
 
 void ResourceManager::replace(const std::string& name,
@@ -55,6 +59,7 @@ void ResourceManager::replace(const std::string& name,
   auto lock = lock_guard(_resource_mutex);
   assureExists(name);
   _resources.at(name) = resource;
+  ++_generation;
 }
 
 void ResourceManager::add(const std::string& name, const std::shared_ptr<storage::AbstractResource>& resource) const {
@@ -68,6 +73,7 @@ void ResourceManager::add(const std::string& name, const std::shared_ptr<storage
     store->enableLogging();
   }
   _resources.insert(make_pair(name, resource));
+  ++_generation;
 }
 
 std::shared_ptr<storage::AbstractResource> ResourceManager::getResource(const std::string& name, bool unsafe) const {
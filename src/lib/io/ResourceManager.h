@@ -1,6 +1,7 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #pragma once
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -77,6 +78,10 @@ class ResourceManager {
   /// Return number of elements in storage
   size_t size() const;
 
+  /// Counter that changes whenever a resource is added, replaced or removed,
+  /// used to invalidate state derived from the current set of resources
+  size_t generation() const;
+
   /// Get a copy of the full resource map, otherwise, we would need to
   /// lock the whole structure while other operations are running on
   /// top of it
@@ -87,6 +92,7 @@ class ResourceManager {
   mutable resource_map _resources;
   /// Mutex protecting the _schema map
   mutable std::recursive_mutex _resource_mutex;
+  mutable std::atomic<size_t> _generation{0};
 
   ResourceManager() = default;
   ResourceManager(const ResourceManager&) = delete;
@@ -183,33 +183,31 @@ void StorageManager::persistTable(const std::string& name, std::string path) {
 #ifdef PERSISTENCY_BUFFEREDLOGGER
 void StorageManager::recoverTables(const size_t thread_count) {
 
-  // load table dumps containing the main
+  // Every table is loaded by its own thread, starting with the dump
+  // containing the main followed by the delta from the last checkpoint
+  auto last_checkpoint = BufferedLogger::getInstance().getLastCheckpointID();
+  auto checkpoint_dir = Settings::getInstance()->getCheckpointDir() + "/" + std::to_string(last_checkpoint) + "/";
+  auto checkpoint_files = _listdir(checkpoint_dir);
+
   auto table_files = _listdir(Settings::getInstance()->getTableDumpDir());
   std::vector<std::thread> threadpool;
   for (auto filename : table_files) {
     if (filename[0] != '.') {
-      threadpool.push_back(std::thread(&StorageManager::recoverTable, this, filename, "", thread_count));
-    }
-  }
-  for (auto& t : threadpool) {
-    t.join();
-  }
-  threadpool.clear();
-
-  // load delta from last checkpoint
-  auto last_checkpoint = BufferedLogger::getInstance().getLastCheckpointID();
-  auto checkpoint_dir = Settings::getInstance()->getCheckpointDir() + "/" + std::to_string(last_checkpoint) + "/";
-  auto checkpoint_files = _listdir(checkpoint_dir);
-  for (auto filename : checkpoint_files) {
-    if (filename.at(0) != '.') {
-      threadpool.push_back(std::thread(&StorageManager::recoverCheckpoint, this, checkpoint_dir, filename));
+      bool has_checkpoint =
+          std::find(checkpoint_files.begin(), checkpoint_files.end(), filename) != checkpoint_files.end();
+      threadpool.push_back(std::thread([this, filename, checkpoint_dir, has_checkpoint, thread_count]() {
+        recoverTable(filename, "", thread_count);
+        if (has_checkpoint) {
+          recoverCheckpoint(checkpoint_dir, filename);
+        }
+      }));
     }
   }
   for (auto& t : threadpool) {
     t.join();
   }
 
-  // replay last delta log
+  // replay the logs written since the last checkpoint
   BufferedLogger::getInstance().restore(thread_count);
 }
 #endif
@@ -26,12 +26,17 @@
 #include "helper/stringhelpers.h"
 #include "helper/vector_helpers.h"
 #include "helper/dir.h"
+#include "helper/MappedFile.h"
 
 #include "storage/AbstractTable.h"
 #include "storage/Store.h"
 #include "storage/storage_types.h"
 #include "storage/storage_types_helper.h"
 #include "storage/meta_storage.h"
+#include "storage/MappedFixedLengthVector.h"
+#include "storage/MutableVerticalTable.h"
+#include "storage/OrderPreservingDictionary.h"
+#include "storage/FrameOfReferenceDictionary.h"
 #include "storage/GroupkeyIndex.h"
 #include "storage/DeltaIndex.h"
 #include "storage/ConcurrentUnorderedDictionary.h"
@@ -202,9 +207,21 @@ struct write_to_dict_functor_mmap {
 
   template <typename R>
   inline void operator()() {
-    auto dict = std::dynamic_pointer_cast<BaseDictionary<R>>(table->dictionaryAt(col));
     const R* ptr = (R*)(data + sizeof(size_t));
     size_t size = *((size_t*)data);  // first sizeof(size_t) bytes store dictionary size;
+
+    // fixed width values are stored sorted and contiguous, copy them in one go
+    if (auto ordered = std::dynamic_pointer_cast<OrderPreservingDictionary<R>>(table->dictionaryAt(col))) {
+      // a dumped frame of reference comes back as consecutive values and needs no copy at all
+      if (auto reference = create_frame_of_reference_dictionary<R>(ptr, ptr + size)) {
+        table->setDictionaryAt(reference, col);
+        return;
+      }
+      ordered->assign(ptr, ptr + size);
+      return;
+    }
+
+    auto dict = std::dynamic_pointer_cast<BaseDictionary<R>>(table->dictionaryAt(col));
     dict->reserve(size);
     for (size_t i = 0; i < size; ++i) {
       dict->addValue(*(ptr++));
@@ -479,7 +496,7 @@ bool SimpleTableDump::dumpDelta(std::string name, atable_ptr_t table) {
   return true;
 }
 
-bool SimpleTableDump::dumpCidVectors(std::string name, atable_ptr_t table) {
+bool SimpleTableDump::dumpCidVectors(std::string name, atable_ptr_t table, tx::transaction_cid_t cutoff) {
   verify(table);
   prepare(name);
   auto store = std::dynamic_pointer_cast<Store>(table);
@@ -489,22 +506,23 @@ bool SimpleTableDump::dumpCidVectors(std::string name, atable_ptr_t table) {
   std::ofstream data_begin(fullPath_begin, std::ios::out | std::ios::binary);
   std::ofstream data_end(fullPath_end, std::ios::out | std::ios::binary);
 
-  // note: The cid vectors are different for NV built and normal, so we better copy it once, instead of accessing the
-  // memory underneath directly.
   std::vector<tx::transaction_cid_t> beginCid;
   std::vector<tx::transaction_cid_t> endCid;
   size_t store_size = store->checkpointSize();
 
-  // copy everything to our std::vectors & write out to file
+  // commits after the cutoff are not part of the snapshot
+  auto apply_cutoff = [cutoff](tx::transaction_cid_t cid) { return cid > cutoff ? tx::INF_CID : cid; };
+
+  // expand the cid information of the store into dense vectors & write out to file
   beginCid.resize(store_size);
-  auto cid_start_begin = store->cidBeginIteratorForRecovery();
-  std::copy(cid_start_begin, cid_start_begin + store_size, beginCid.begin());
+  endCid.resize(store_size);
+  for (size_t row = 0; row < store_size; ++row) {
+    beginCid[row] = apply_cutoff(store->getBeginCid(row));
+    endCid[row] = apply_cutoff(store->getEndCid(row));
+  }
   data_begin.write((char*)&beginCid[0], store_size * sizeof(tx::transaction_cid_t));
   data_begin.close();
 
-  endCid.resize(store_size);
-  auto cid_end_begin = store->cidEndIteratorForRecovery();
-  std::copy(cid_end_begin, cid_end_begin + store_size, endCid.begin());
   data_end.write((char*)&endCid[0], store_size * sizeof(tx::transaction_cid_t));
   data_end.close();
 
@@ -515,6 +533,10 @@ bool SimpleTableDump::dumpCidVectors(std::string name, atable_ptr_t table) {
 
 namespace io {
 
+param_member_impl(TableDumpLoader::params, bool, Mapped);
+param_member_impl(TableDumpLoader::params, bool, Populate);
+param_member_impl(TableDumpLoader::params, bool, HugePages);
+
 size_t TableDumpLoader::getSize() {
   std::string path = storage::DumpHelper::buildPath({_base, _table, storage::DumpHelper::META_DATA_EXT});
   std::ifstream data(path, std::ios::binary);
@@ -527,21 +549,11 @@ size_t TableDumpLoader::getSize() {
 void TableDumpLoader::loadDictionary(std::string name, size_t col, storage::atable_ptr_t intable) {
   std::string path = storage::DumpHelper::buildPath({_base, _table, name}) + storage::DumpHelper::DICT_EXT;
 
-  // determine file size
-  struct stat stbuf;
-  if (stat(path.c_str(), &stbuf) < 0) {
-    throw std::runtime_error("unable to determine file size");
-  }
-  const size_t fsize = stbuf.st_size;
-
-  // memory map the file
-  int fd = open(path.c_str(), O_RDONLY);
-  void* ptr = (char*)mmap(NULL, fsize, PROT_READ, MAP_SHARED, fd, 0);
-  storage::write_to_dict_functor_mmap fun((const char*)ptr, intable, col);
+  // the dictionary is read completely, so fault in all pages at once
+  helper::MappedFile file(path, true, _parameters.getHugePages());
+  storage::write_to_dict_functor_mmap fun(file.data(), intable, col);
   storage::type_switch<hyrise_basic_types> ts;
   ts(intable->typeOfColumn(col), fun);
-  munmap(ptr, fsize);
-  close(fd);
 }
 
 void TableDumpLoader::loadDeltaDictionary(std::string name, size_t col, storage::atable_ptr_t intable) {
@@ -574,6 +586,24 @@ void TableDumpLoader::loadAttribute(std::string name, size_t col, size_t size, s
   data.close();
 }
 
+bool TableDumpLoader::mapAttribute(std::string name, size_t col, size_t size, storage::atable_ptr_t intable) {
+  // Only partitions holding a single column match the layout of the
+  // attribute file, wider partitions interleave their value ids
+  auto mvt = std::dynamic_pointer_cast<storage::MutableVerticalTable>(intable);
+  if (!mvt) {
+    return false;
+  }
+  auto container = std::dynamic_pointer_cast<storage::Table>(mvt->containerAt(col));
+  if (!container || container->columnCount() != 1) {
+    return false;
+  }
+
+  std::string path = storage::DumpHelper::buildPath({_base, _table, name}) + storage::DumpHelper::ATTR_EXT;
+  auto file = std::make_shared<helper::MappedFile>(path, _parameters.getPopulate(), _parameters.getHugePages());
+  container->setAttributes(std::make_shared<storage::MappedFixedLengthVector<value_id_t>>(file, 1, size));
+  return true;
+}
+
 void TableDumpLoader::loadIndices(storage::atable_ptr_t intable) {
   std::string path = storage::DumpHelper::buildPath({_base, _table + "/"}) + storage::DumpHelper::INDEX_EXT;
   std::ifstream data(path, std::ios::binary);
@@ -638,15 +668,27 @@ void TableDumpLoader::loadIndices(storage::atable_ptr_t intable) {
 std::shared_ptr<storage::AbstractTable> TableDumpLoader::load(storage::atable_ptr_t intable,
                                                               const storage::compound_metadata_list* meta,
                                                               const Loader::params& args) {
-  // Resize according to meta information
   size_t tableSize = getSize();
+
+  // Mapped attribute vectors already have their final size and are
+  // skipped by the resize below
+  std::vector<bool> mapped(intable->columnCount(), false);
+  if (_parameters.getMapped() && args.getDeltaDataStructure() == false) {
+    for (size_t i = 0; i < intable->columnCount(); ++i) {
+      mapped[i] = mapAttribute(intable->nameOfColumn(i), i, tableSize, intable);
+    }
+  }
+
+  // Resize according to meta information
   intable->resize(tableSize);
 
   if (args.getDeltaDataStructure() == false) {
     for (size_t i = 0; i < intable->columnCount(); ++i) {
       std::string name = intable->nameOfColumn(i);
       loadDictionary(name, i, intable);
-      loadAttribute(name, i, tableSize, intable);
+      if (!mapped[i]) {
+        loadAttribute(name, i, tableSize, intable);
+      }
     }
   } else {
     for (size_t i = 0; i < intable->columnCount(); ++i) {
@@ -678,8 +720,10 @@ bool TableDumpLoader::loadCidVectors(std::string name, storage::atable_ptr_t tab
 
   data_end.read((char*)&endCid[0], store_size * sizeof(tx::transaction_cid_t));
 
-  std::copy(beginCid.begin(), beginCid.end(), store->cidBeginIteratorForRecovery());
-  std::copy(endCid.begin(), endCid.end(), store->cidEndIteratorForRecovery());
+  for (size_t row = 0; row < store_size; ++row) {
+    store->setBeginCid(row, beginCid[row]);
+    store->setEndCid(row, endCid[row]);
+  }
 
   data_begin.close();
   data_end.close();
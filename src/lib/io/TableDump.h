@@ -80,9 +80,11 @@ class SimpleTableDump {
   bool dumpDelta(std::string name, std::shared_ptr<AbstractTable> table);
 
   /**
-   * For a table identified by name and table perform the dump of CID vectors
+   * For a table identified by name and table perform the dump of CID
+   * vectors. Rows committed or invalidated after the cutoff cid are
+   * dumped as if the commit did not happen yet.
    */
-  bool dumpCidVectors(std::string name, atable_ptr_t table);
+  bool dumpCidVectors(std::string name, atable_ptr_t table, tx::transaction_cid_t cutoff = tx::INF_CID);
 };
 
 }  // namespace storage
@@ -90,8 +92,25 @@ class SimpleTableDump {
 namespace io {
 
 class TableDumpLoader : public AbstractInput {
+ public:
+  /**
+   * Mapped loads the attribute vectors of single column partitions as
+   * read-only views on the dumped files instead of copying them, the
+   * loaded main is not merged in this case. Populate pre-faults the
+   * mapped files, HugePages asks for transparent huge pages.
+   */
+  class params {
+#include "parameters.inc"
+    param_member(bool, Mapped);
+    param_member(bool, Populate);
+    param_member(bool, HugePages);
+    params() : Mapped(false), Populate(false), HugePages(false) {}
+  };
+
+ private:
   std::string _base;
   std::string _table;
+  params _parameters;
 
   size_t getSize();
 
@@ -99,9 +118,11 @@ class TableDumpLoader : public AbstractInput {
   void loadDeltaDictionary(std::string name, size_t col, storage::atable_ptr_t intable);
 
   void loadAttribute(std::string name, size_t col, size_t size, storage::atable_ptr_t intable);
+  bool mapAttribute(std::string name, size_t col, size_t size, storage::atable_ptr_t intable);
 
  public:
-  TableDumpLoader(std::string base, std::string table) : _base(base), _table(table) {}
+  TableDumpLoader(std::string base, std::string table, const params& parameters = params())
+      : _base(base), _table(table), _parameters(parameters) {}
 
   storage::atable_ptr_t load(storage::atable_ptr_t, const storage::compound_metadata_list*, const Loader::params& args);
 
@@ -112,7 +133,7 @@ class TableDumpLoader : public AbstractInput {
 
   bool needs_store_wrap() { return true; }
 
-  bool needs_merge() { return true; }
+  bool needs_merge() { return !_parameters.getMapped(); }
 
   TableDumpLoader* clone() const { return new TableDumpLoader(*this); }
 };
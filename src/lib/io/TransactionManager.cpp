@@ -14,10 +14,10 @@
 #include "helper/make_unique.h"
 #include "helper/checked_cast.h"
 #include "helper/vector_helpers.h"
-#include "helper/cas.h"
 #include "storage/Store.h"
 
-#define MAX_INFLIGHT_SIZE 1024 * 1024
+// number of commits that may wait for an earlier commit to become visible
+#define MAX_INFLIGHT_SIZE 64 * 1024
 
 namespace hyrise {
 namespace tx {
@@ -55,10 +55,9 @@ storage::store_ptr_t getStore(const storage::c_atable_ptr_t& table) {
   return std::const_pointer_cast<storage::Store>(checked_pointer_cast<const storage::Store>(table));
 }
 
-TransactionManager::TransactionManager() : _transactionCount(ATOMIC_VAR_INIT(tx::START_TID)) {
-  _lastTXCommitContext = new TXCommitContext;
-  _lastFinishedCommitId = tx::UNKNOWN_CID;
-  _nextCommitId = ATOMIC_VAR_INIT(_lastFinishedCommitId + 1);
+TransactionManager::TransactionManager()
+    : _transactionCount(ATOMIC_VAR_INIT(tx::START_TID)), _commitSlots(new CommitSlot[MAX_INFLIGHT_SIZE]) {
+  reset();
 }
 
 TransactionManager::~TransactionManager() {}
@@ -75,7 +74,9 @@ transaction_id_t TransactionManager::getTransactionId() {
   return ++_transactionCount;
 }
 
-transaction_cid_t TransactionManager::getLastCommitId() { return _lastFinishedCommitId; }
+transaction_cid_t TransactionManager::getLastCommitId() { return _lastFinishedCommitId.load(); }
+
+transaction_id_t TransactionManager::getLastTransactionId() const { return _transactionCount; }
 
 TXContext TransactionManager::buildContext() {
   return {getTransactionId(), getLastCommitId()};
@@ -104,9 +105,12 @@ std::optional<const TXModifications&> TransactionManager::getModifications(const
 }
 
 void TransactionManager::reset() {
-  _lastTXCommitContext = new TXCommitContext;
+  for (size_t i = 0; i < MAX_INFLIGHT_SIZE; ++i) {
+    _commitSlots[i].cid = UNKNOWN_CID;
+    _commitSlots[i].commit_context = nullptr;
+  }
   _transactionCount = START_TID;
-  _nextCommitId = UNKNOWN_CID;
+  _nextCommitId = UNKNOWN_CID + 1;
   _lastFinishedCommitId = UNKNOWN_CID;
   _txData([](map_t& txData) { txData.clear(); });
 }
@@ -128,15 +132,8 @@ std::vector<TXContext> TransactionManager::getCurrentModifyingTransactionContext
 bool TransactionManager::isValidTransactionId(transaction_id_t tid) { return tid <= getInstance()._transactionCount; }
 
 void TransactionManager::endTransaction(transaction_id_t tid, bool flush_log) {
-
-
-
-#ifdef PERSISTENCY_BUFFEREDLOGGER
-  // log commit entry and flush the log
-  io::Logger::getInstance().logCommit(tid);
-  if (flush_log)
-    io::Logger::getInstance().flush();
-#endif
+  // the commit entry is logged by commitModifiedPositions together with the
+  // commit id, rolled back transactions must not be logged as committed
 
   // Clear all relevant data for this transaction
   _txData([&tid](map_t& txData) { txData.erase(tid); });
@@ -181,98 +178,56 @@ void TransactionManager::commitModifiedPositions(TXContext& ctx, bool flush_log)
 
 
 #ifdef PERSISTENCY_BUFFEREDLOGGER
-  io::Logger::getInstance().logCommit(ctx.tid);
+  io::Logger::getInstance().logCommit(ctx.tid, ctx.cid);
   if (flush_log)
     io::Logger::getInstance().flush();
 #endif
 }
 
-void TransactionManager::commitPendingTransactions(std::vector<TXCommitContext*>& commit_context_list,
-                                                   TXCommitContext* commit_context) {
-
-  // add ourself to the list
-  commit_context_list.push_back(commit_context);
-
-  // iterate over list of contexts until end or still running tx found
-  auto current_commit_context = commit_context->next;
-  while (current_commit_context != nullptr && current_commit_context->finished_but_uncommitted == true) {
-    // try incrementing last finished cid
-    auto previous_cid = current_commit_context->cid - 1;
-    if (atomic_cas(&_lastFinishedCommitId, previous_cid, current_commit_context->cid)) {
-      // tx committed successfully
-      // add to list
-      commit_context_list.push_back(current_commit_context);
-      current_commit_context = current_commit_context->next;
-      continue;
-    } else {
-      // could not increment last visible tx id
-      // someone else must have sneaked in
-      // so we stop here with our commit dependencies
-      break;
+void TransactionManager::advanceLastCommitId(std::vector<TXCommitContext*>& commit_context_list) {
+  while (true) {
+    auto last_cid = _lastFinishedCommitId.load();
+    auto next_cid = last_cid + 1;
+    auto& slot = _commitSlots[next_cid % MAX_INFLIGHT_SIZE];
+
+    // the next commit is still writing its commit ids. Sequentially consistent
+    // with its publication, so either we see its slot or it sees our commit id
+    if (slot.cid.load() != next_cid) {
+      return;
+    }
+
+    // only the thread publishing next_cid may touch the slot, all
+    // others retry with the new last commit id
+    if (_lastFinishedCommitId.compare_exchange_strong(last_cid, next_cid)) {
+      commit_context_list.push_back(slot.commit_context);
+      slot.commit_context = nullptr;
+      slot.cid.store(UNKNOWN_CID, std::memory_order_release);
     }
   }
 }
 
 TXCommitContext* TransactionManager::startCommitPhase(TXContext& ctx) {
-
   auto commit_context = new TXCommitContext(ctx);
+  commit_context->cid = _nextCommitId.fetch_add(1);
+  ctx.cid = commit_context->cid;
+  return commit_context;
+}
 
-  // ref count of commit_context is per default one, increment it
-  // as next pointer from list will point to us
-  commit_context->retain();
-
-  // try until we succeed
-  while (true) {
-    // integrate us in the linked list
-    if (atomic_cas<TXCommitContext*>(&_lastTXCommitContext->next, nullptr, commit_context)) {
-
-      // increment ref count again as the last commit context pointer will point to us
-      commit_context->retain();
-
-      commit_context->cid = _lastTXCommitContext->cid + 1;
-      ctx.cid = commit_context->cid;
-      auto tmp = _lastTXCommitContext;
-      _lastTXCommitContext = commit_context;
-
-      // release prev commit context
-      tmp->release();
+std::vector<TXCommitContext*> TransactionManager::finishCommitPhase(TXCommitContext* commit_context, bool flush_log) {
+  auto& slot = _commitSlots[commit_context->cid % MAX_INFLIGHT_SIZE];
 
-      return commit_context;
-    }
+  // the slot is still taken by a commit MAX_INFLIGHT_SIZE ids before
+  // us, which has to become visible before we can anyway
+  while (slot.cid.load(std::memory_order_acquire) != UNKNOWN_CID) {
+    std::this_thread::yield();
   }
-}
 
-std::vector<TXCommitContext*> TransactionManager::finishCommitPhase(TXCommitContext* commit_context, bool flush_log) {
+  // mark ourself as finished, whoever makes us visible responds for us
+  slot.commit_context = commit_context;
+  slot.cid.store(commit_context->cid);
 
   std::vector<TXCommitContext*> commit_tx_list;
-  auto previous_cid = commit_context->cid - 1;
-
-  // try incrementing last finished cid
-  if (atomic_cas(&_lastFinishedCommitId, previous_cid, commit_context->cid)) {
-
-    // everything went fine and the tx was committed
-    // make sure to commit all pending transactions
-    commitPendingTransactions(commit_tx_list, commit_context);
-  } else {
-
-    // incrementing last finished cid failed.
-    // this means we are ahead of some other transactions and need to wait
-    // so we mark ourself as finished but not committed
-    commit_context->finished_but_uncommitted = true;
-
-    // to make sure that the transaction we are waiting for has not finished
-    // before we could add our tx to the list of pending transactions we try
-    // incrementing the last finished cid again
-    if (atomic_cas(&_lastFinishedCommitId, previous_cid, commit_context->cid)) {
-      // it worked with the second try, so know the tx is committed
-      // make sure to commit all pending transactions
-      commit_context->finished_but_uncommitted = false;
-      commitPendingTransactions(commit_tx_list, commit_context);
-
-      // unmark oursefinished_but_uncommitted = false;
-    } else {
-    }
-  }
+  advanceLastCommitId(commit_tx_list);
 
   // flush cashes or log and clear tx data
   endTransaction(commit_context->tid, flush_log);
@@ -358,5 +313,28 @@ void TransactionManager::waitForAllCurrentlyRunningTransactions() const {
     }
   }
 }
+
+transaction_cid_t TransactionManager::waitForCommitIdCutoff() {
+  // commit ids are handed out in order, so every id below the next one
+  // belongs to a transaction that already entered its commit phase
+  transaction_cid_t cutoff = _nextCommitId - 1;
+  while (getLastCommitId() < cutoff) {
+    std::this_thread::yield();
+  }
+  return cutoff;
+}
+
+bool TransactionManager::waitForTransactionsUpTo(transaction_id_t tid, std::chrono::milliseconds timeout) const {
+  auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (_txData([&tid](const map_t & txData)->bool {
+    return std::any_of(
+        txData.begin(), txData.end(), [&tid](const map_t::value_type & kv) { return kv.first <= tid; });
+  })) {
+    if (std::chrono::steady_clock::now() >= deadline)
+      return false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
 }
 }
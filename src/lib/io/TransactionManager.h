@@ -3,7 +3,9 @@
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 
@@ -26,21 +28,11 @@ class TXCommitContext {
   transaction_cid_t cid = UNKNOWN;
   std::string response;
   net::AbstractConnection* connection;
-  std::atomic<bool> finished_but_uncommitted;
   std::atomic<size_t> ref_count;
-  TXCommitContext* next __attribute__((aligned(16)));
 
-  TXCommitContext(TXContext& ctx)
-      : tid(ctx.tid), cid(UNKNOWN), response(""), finished_but_uncommitted(false), ref_count(1), next(nullptr) {}
+  TXCommitContext(TXContext& ctx) : tid(ctx.tid), cid(UNKNOWN), response(""), connection(nullptr), ref_count(1) {}
 
-  TXCommitContext()
-      : tid(UNKNOWN), cid(UNKNOWN), response(""), finished_but_uncommitted(false), ref_count(1), next(nullptr) {}
-
-  ~TXCommitContext() {
-    if (next != nullptr) {
-      next->release();
-    }
-  }
+  TXCommitContext() : tid(UNKNOWN), cid(UNKNOWN), response(""), connection(nullptr), ref_count(1) {}
 
   void retain() { ++ref_count; }
 
@@ -173,20 +165,51 @@ class TransactionManager {
   */
   void waitForAllCurrentlyRunningTransactions() const;
 
+  /*
+  * Returns the highest commit id handed out so far, after all commits up to
+  * it have become visible. Only transactions that are already in their commit
+  * phase are waited for, running transactions are not affected.
+  */
+  transaction_cid_t waitForCommitIdCutoff();
+
+  /*
+  * Waits until all transactions with a tid less or equal than the given one
+  * have finished, returns false if some are still running after the timeout
+  */
+  bool waitForTransactionsUpTo(transaction_id_t tid, std::chrono::milliseconds timeout) const;
+
+  // get the last transaction id that was handed out
+  transaction_id_t getLastTransactionId() const;
+
 
  private:
   std::optional<const TXModifications&> getModifications(const transaction_id_t key) const;
   void commitModifiedPositions(TXContext& ctx, bool flush_log);
-  void commitPendingTransactions(std::vector<TXCommitContext*>& commit_context_list, TXCommitContext* commit_context);
   TXCommitContext* startCommitPhase(TXContext& ctx);
   std::vector<TXCommitContext*> finishCommitPhase(TXCommitContext* commit_context, bool flush_log);
 
+  /*
+  * Moves the last visible commit id forward over all consecutive commits
+  * that have finished, appending their contexts to commit_context_list.
+  * Any thread may call this, the thread advancing over a commit takes
+  * over its context.
+  */
+  void advanceLastCommitId(std::vector<TXCommitContext*>& commit_context_list);
+
+  // A finished commit waiting to become visible, slots are reused
+  // round robin by commit id
+  struct CommitSlot {
+    std::atomic<transaction_cid_t> cid;
+    TXCommitContext* commit_context;
+  };
 
   std::atomic<transaction_id_t> _transactionCount;
-  std::atomic<transaction_cid_t> _nextCommitId;
+  // ticket for the next commit id
+  std::atomic<transaction_cid_t> _nextCommitId __attribute__((aligned(64)));
+  // all commits up to this id are visible
+  std::atomic<transaction_cid_t> _lastFinishedCommitId __attribute__((aligned(64)));
 
-  transaction_cid_t _lastFinishedCommitId __attribute__((aligned(16)));
-  TXCommitContext* _lastTXCommitContext __attribute__((aligned(16)));
+  std::unique_ptr<CommitSlot[]> _commitSlots;
 
   using map_t = std::unordered_map<transaction_id_t, std::unique_ptr<TransactionData>>;
 
@@ -5,5 +5,19 @@ namespace hyrise {
 namespace net {
 
 AbstractConnection::~AbstractConnection() {}
+
+void AbstractConnection::beginResponse(size_t status, const std::string& contentType) {
+  _streamed_status = status;
+  _streamed_content_type = contentType;
+  _streamed_body.clear();
+}
+
+void AbstractConnection::sendResponsePart(const std::string& data) { _streamed_body.append(data); }
+
+void AbstractConnection::endResponse() {
+  std::string body;
+  body.swap(_streamed_body);
+  respond(body, _streamed_status, _streamed_content_type);
+}
 }
 }
@@ -7,19 +7,37 @@
 namespace hyrise {
 namespace net {
 
+// Content type of responses in the binary layout of access/system/ResultBatch.h
+const std::string kResultBatchContentType = "application/x-hyrise-batch";
+
 class AbstractConnection {
  public:
   virtual ~AbstractConnection();
   virtual std::string getBody() const = 0;
   virtual std::string getPath() const = 0;
   virtual bool hasBody() const = 0;
+  // Connections of the binary protocol receive query results as binary batches instead of JSON
+  virtual bool acceptsResultBatches() const { return false; }
   virtual void respond(const std::string& message,
                        size_t status = 200,
                        const std::string& contentType = "application/json") = 0;
   void setResponseTask(taskscheduler::task_ptr_t task) { _response_task = task; }
 
+  // Streamed responses send their body in parts while it is produced. Connections that
+  // cannot stream collect all parts and respond at once when the response ends.
+  virtual void beginResponse(size_t status = 200, const std::string& contentType = "application/json");
+  virtual void sendResponsePart(const std::string& data);
+  virtual void endResponse();
+  // True while the client lags behind a streamed response. Producers that can be
+  // requeued stop sending parts until it catches up, the others keep buffering.
+  virtual bool isCongested() const { return false; }
+
  private:
   taskscheduler::task_ptr_t _response_task = nullptr;
+
+  size_t _streamed_status = 200;
+  std::string _streamed_content_type;
+  std::string _streamed_body;
 };
 }
 }
@@ -10,6 +10,7 @@
 #include <memory>
 
 #include "net/Router.h"
+#include "net/ServerLoops.h"
 #include "taskscheduler/SharedScheduler.h"
 #include "access/system/RequestParseTask.h"
 #include "helper/Settings.h"
@@ -17,24 +18,72 @@
 namespace hyrise {
 namespace net {
 
+namespace {
+// Streamed responses are congested while this much of them is not yet handed to the socket
+const size_t kMaxPendingStreamBytes = 1 << 20;
+
+#ifndef NDEBUG
+void log_response(const AsyncPipeline* pipeline, const AsyncConnection* conn) {
+  char* method = (char*)"";
+  switch (conn->request.method) {
+    case EBB_GET:
+      method = (char*)"GET";
+      break;
+    case EBB_POST:
+      method = (char*)"POST";
+      break;
+    default:
+      break;
+  }
+
+  struct timeval endtime;
+  gettimeofday(&endtime, nullptr);
+  float duration =
+      endtime.tv_sec + endtime.tv_usec / 1000000.0 - conn->starttime.tv_sec - conn->starttime.tv_usec / 1000000.0;
+
+  time_t rawtime;
+  struct tm* timeinfo;
+  char timestr[80];
+  time(&rawtime);
+  timeinfo = localtime(&rawtime);
+  strftime(timestr, sizeof(timestr), "%Y-%m-%d %H:%M:%S %z", timeinfo);
+
+  printf("%s [%s] %s %s (%f s)%s\n",
+         inet_ntoa(pipeline->addr.sin_addr),
+         timestr,
+         method,
+         conn->path.c_str(),
+         duration,
+         pipeline->closed ? " not sent" : "");
+}
+#endif
+}
+
 ebb_connection* new_connection(ebb_server* server, struct sockaddr_in* addr) {
   ebb_connection* connection = (ebb_connection*)malloc(sizeof(ebb_connection));
   if (connection == nullptr) {
     return nullptr;
   }
 
-  AsyncConnection* connection_data = new AsyncConnection;
-  connection_data->addr = *addr;
+  ServerLoop* server_loop = static_cast<ServerLoop*>(server->data);
+  AsyncPipeline* pipeline = server_loop ? server_loop->acquirePipeline() : new AsyncPipeline;
+  pipeline->server_loop = server_loop;
+  pipeline->server = server;
+  pipeline->connection = connection;
+  pipeline->addr = *addr;
+  pipeline->ev_loop = server->loop;
 
   // Initializes the connection
   ebb_connection_init(connection);
-  connection->data = connection_data;
+  connection->data = pipeline;
   connection->new_request = new_request;
   connection->on_close = on_close;
   connection->on_timeout = on_timeout;
 
-  connection_data->ev_loop = server->loop;
-  connection_data->ev_write.data = connection_data;
+  // workers signal their responses as long as the pipeline lives
+  ev_async_init(&pipeline->ev_write, write_cb);
+  pipeline->ev_write.data = pipeline;
+  ev_async_start(pipeline->ev_loop, &pipeline->ev_write);
 
   return connection;
 }
@@ -42,9 +91,13 @@ ebb_connection* new_connection(ebb_server* server, struct sockaddr_in* addr) {
 int on_timeout(ebb_connection* connection) { return EBB_AGAIN; }
 
 ebb_request* new_request(ebb_connection* connection) {
-  ebb_request* request = (ebb_request*)malloc(sizeof(ebb_request));
+  AsyncPipeline* pipeline = (AsyncPipeline*)connection->data;
+  AsyncConnection* connection_data = pipeline->acquireRequest();
+  pipeline->parsing = connection_data;
+
+  ebb_request* request = &connection_data->request;
   ebb_request_init(request);
-  request->data = connection;
+  request->data = connection_data;
   request->on_complete = request_complete;
   request->on_path = request_path;
   request->on_body = request_body;
@@ -52,17 +105,19 @@ ebb_request* new_request(ebb_connection* connection) {
 }
 
 void request_complete(ebb_request* request) {
-  ebb_connection* connection = (ebb_connection*)request->data;
-  AsyncConnection* connection_data = (AsyncConnection*)connection->data;
-  connection_data->connection = connection;
-  connection_data->request = request;
+  AsyncConnection* connection_data = (AsyncConnection*)request->data;
+  AsyncPipeline* pipeline = connection_data->pipeline;
+  pipeline->parsing = nullptr;
 #ifndef NDEBUG
   gettimeofday(&connection_data->starttime, nullptr);
 #endif
   connection_data->keep_alive_flag = ebb_request_should_keep_alive(request);
 
-  ev_async_init(&connection_data->ev_write, write_cb);
-  ev_async_start(connection_data->ev_loop, &connection_data->ev_write);
+  // responses are written in this order, even if later requests finish first
+  {
+    std::lock_guard<std::mutex> lock(pipeline->mutex);
+    pipeline->requests.push_back(connection_data);
+  }
 
   // Try to route to appropriate handler based on path
   const AbstractRequestHandlerFactory* handler_factory;
@@ -78,21 +133,26 @@ void request_complete(ebb_request* request) {
   auto task = handler_factory->create(connection_data);
   task->setPriority(taskscheduler::Task::HIGH_PRIORITY);  // give RequestParseTask high priority
 
+  // keep the request on the core of the network thread that received it
+  if (pipeline->server_loop != nullptr && pipeline->server_loop->core() != taskscheduler::Task::NO_PREFERRED_CORE &&
+      pipeline->server_loop->core() < static_cast<int>(Settings::getInstance()->worker_threads))
+    task->setPreferredCore(pipeline->server_loop->core());
+
   // for tpcc stored procedure the second part of the path is the warehouse id which we use for scheduling the task
   const char proc_path[] = "/procedure/";
   const int proc_path_len = strlen(proc_path);
-  if (strncmp(connection_data->path, proc_path, proc_path_len) == 0 && connection_data->path[proc_path_len] != '0' &&
-      connection_data->body_len >= 4) {
+  const char* path = connection_data->path.c_str();
+  if (strncmp(path, proc_path, proc_path_len) == 0 && path[proc_path_len] != '0' && connection_data->body.size() >= 4) {
     char id_buffer[16];
     int i = 0;
-    while (connection_data->path[i + proc_path_len] != '\0') {
-      if (connection_data->path[i + proc_path_len] == '/') {
+    while (path[i + proc_path_len] != '\0') {
+      if (path[i + proc_path_len] == '/') {
         break;
       } else if (i >= 15) {
         printf("WARNING: id for precedure is larger than buffer!\n");
         break;
       } else {
-        id_buffer[i] = connection_data->path[i + proc_path_len];
+        id_buffer[i] = path[i + proc_path_len];
         ++i;
       }
     }
@@ -101,157 +161,220 @@ void request_complete(ebb_request* request) {
     task->setPreferredCore(core);
   }
   taskscheduler::SharedScheduler::getInstance().getScheduler()->schedule(task);
-  connection_data->waiting_for_response = true;
-}
-
-void continue_responding(ebb_connection* connection) {
-  AsyncConnection* connection_data = (AsyncConnection*)connection->data;
-  if (connection_data->keep_alive_flag == false) {
-    ebb_connection_schedule_close(connection);
-  } else {
-    // clear connection for next request
-    connection_data->reset();
-  }
 }
 
 void request_path(ebb_request* request, const char* at, size_t length) {
-  ebb_connection* connection = (ebb_connection*)request->data;
-  AsyncConnection* connection_data = (AsyncConnection*)connection->data;
-
-  connection_data->path = (char*)malloc(length + 1);
-  strncpy(connection_data->path, at, length);
-  connection_data->path[length] = '\0';
+  AsyncConnection* connection_data = (AsyncConnection*)request->data;
+  connection_data->path.assign(at, length);
 }
 
 void request_body(ebb_request* request, const char* at, size_t length) {
-  ebb_connection* connection = (ebb_connection*)request->data;
-  AsyncConnection* connection_data = (AsyncConnection*)connection->data;
-
-  if (!connection_data->body) {
-    connection_data->body = (char*)malloc(length);
-    connection_data->body_len = 0;
-  } else {
-    connection_data->body = (char*)realloc(connection_data->body, connection_data->body_len + length);
-  }
-  memcpy(connection_data->body + connection_data->body_len, at, length);
-  connection_data->body_len += length;
+  AsyncConnection* connection_data = (AsyncConnection*)request->data;
+  connection_data->body.append(at, length);
 }
 
 void request_header(ebb_request* request, const char* at, size_t length) {
-  ebb_connection* connection = (ebb_connection*)request->data;
-  AsyncConnection* connection_data = (AsyncConnection*)connection->data;
-
-  if (!connection_data->body) {
-    connection_data->body = (char*)malloc(length);
-    connection_data->body_len = 0;
-  } else {
-    connection_data->body = (char*)realloc(connection_data->body, connection_data->body_len + length);
-  }
-  memcpy(connection_data->body + connection_data->body_len, at, length);
-  connection_data->body_len += length;
+  AsyncConnection* connection_data = (AsyncConnection*)request->data;
+  connection_data->body.append(at, length);
 }
 
-void write_cb(struct ev_loop* loop, struct ev_async* w, int revents) {
-  AsyncConnection* conn = (AsyncConnection*)w->data;
+void write_cb(struct ev_loop* loop, struct ev_async* w, int revents) { pipeline_write((AsyncPipeline*)w->data); }
 
-#ifndef NDEBUG
-  char* method = (char*)"";
-  switch (conn->request->method) {
-    case EBB_GET:
-      method = (char*)"GET";
-      break;
-    case EBB_POST:
-      method = (char*)"POST";
-      break;
-    default:
-      break;
-  }
+void pipeline_write(AsyncPipeline* pipeline) {
+  std::unique_lock<std::mutex> lock(pipeline->mutex);
+  if (pipeline->writing)
+    return;
 
-  struct timeval endtime;
-  gettimeofday(&endtime, nullptr);
-  float duration =
-      endtime.tv_sec + endtime.tv_usec / 1000000.0 - conn->starttime.tv_sec - conn->starttime.tv_usec / 1000000.0;
+  while (!pipeline->requests.empty()) {
+    AsyncConnection* front = pipeline->requests.front();
+    if (!pipeline->closed && !front->pending.empty()) {
+      front->sending.clear();
+      front->sending.swap(front->pending);
+      pipeline->writing = true;
+      lock.unlock();
+      ebb_connection_write(pipeline->connection, front->sending.data(), front->sending.size(), continue_writing);
+      return;
+    }
 
-  time_t rawtime;
-  struct tm* timeinfo;
-  char timestr[80];
-  time(&rawtime);
-  timeinfo = localtime(&rawtime);
-  strftime(timestr, sizeof(timestr), "%Y-%m-%d %H:%M:%S %z", timeinfo);
-#endif
+    // responses of requests that are still running wait for the worker
+    if (!front->finished)
+      break;
 
-  // Handle the actual writing
-  if (conn->connection != nullptr) {
-    ebb_connection_write(conn->connection, conn->write_buffer, conn->write_buffer_len, continue_responding);
+    // the response is completely written, or dropped because the client is gone
 #ifndef NDEBUG
-    printf("%s [%s] %s %s (%f s)\n", inet_ntoa(conn->addr.sin_addr), timestr, method, conn->path, duration);
-#endif
-  } else {
-#ifndef NDEBUG
-    printf("%s [%s] %s %s (%f s) not sent\n", inet_ntoa(conn->addr.sin_addr), timestr, method, conn->path, duration);
+    log_response(pipeline, front);
 #endif
+    pipeline->requests.pop_front();
+    bool keep_alive = front->keep_alive_flag;
+    pipeline->releaseRequest(front);
+    if (!keep_alive && !pipeline->closed) {
+      // later requests still run, but their responses are dropped
+      pipeline->closed = true;
+      ebb_connection_schedule_close(pipeline->connection);
+    }
   }
-  ev_async_stop(conn->ev_loop, &conn->ev_write);
-  conn->waiting_for_response = false;
-  // When connection is nullptr, `continue_responding` won't fire since we never sent data to the client,
-  // thus, we'll need to clean up manually here, while connection has already been cleaned up in on `on_close`
-  if (conn->connection == nullptr)
-    delete conn;
+
+  bool release = pipeline->connection == nullptr && pipeline->requests.empty();
+  lock.unlock();
+  if (release)
+    release_pipeline(pipeline);
+}
+
+void continue_writing(ebb_connection* connection) {
+  AsyncPipeline* pipeline = (AsyncPipeline*)connection->data;
+  {
+    std::lock_guard<std::mutex> lock(pipeline->mutex);
+    pipeline->writing = false;
+  }
+  pipeline_write(pipeline);
 }
 
 void on_close(ebb_connection* connection) {
-  AsyncConnection* connection_data = (AsyncConnection*)connection->data;
-  connection_data->connection = nullptr;
+  AsyncPipeline* pipeline = (AsyncPipeline*)connection->data;
+  pipeline->connection = nullptr;
   free(connection);
-  if (!connection_data->waiting_for_response)
-    delete connection_data;
+
+  if (pipeline->parsing != nullptr) {
+    pipeline->releaseRequest(pipeline->parsing);
+    pipeline->parsing = nullptr;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(pipeline->mutex);
+    pipeline->closed = true;
+    pipeline->writing = false;
+  }
+  // releases the pipeline once no worker answers one of its requests anymore
+  pipeline_write(pipeline);
+}
+
+void release_pipeline(AsyncPipeline* pipeline) {
+  ev_async_stop(pipeline->ev_loop, &pipeline->ev_write);
+  if (pipeline->server_loop != nullptr)
+    pipeline->server_loop->releasePipeline(pipeline);
+  else
+    delete pipeline;
 }
 
-AsyncConnection::AsyncConnection()
-    : request(nullptr), path(nullptr), body(nullptr), body_len(0), write_buffer(nullptr) {}
+AsyncPipeline::AsyncPipeline() {}
+
+AsyncPipeline::~AsyncPipeline() {
+  for (auto request : _idle_requests)
+    delete request;
+}
+
+AsyncConnection* AsyncPipeline::acquireRequest() {
+  AsyncConnection* request;
+  if (_idle_requests.empty()) {
+    request = new AsyncConnection;
+  } else {
+    request = _idle_requests.back();
+    _idle_requests.pop_back();
+  }
+  request->pipeline = this;
+  return request;
+}
+
+void AsyncPipeline::releaseRequest(AsyncConnection* request) {
+  if (_idle_requests.size() >= kMaxIdleRequests) {
+    delete request;
+    return;
+  }
+  request->reset();
+  _idle_requests.push_back(request);
+}
 
-AsyncConnection::~AsyncConnection() { reset(); }
+void AsyncPipeline::reset() {
+  connection = nullptr;
+  requests.clear();
+  writing = false;
+  closed = false;
+  parsing = nullptr;
+}
 
 void AsyncConnection::reset() {
-  free(path);
-  path = nullptr;
-  free(body);
-  body_len = 0;
-  body = nullptr;
-  free(request);
-  request = nullptr;
-  free(write_buffer);
-  write_buffer = nullptr;
-  waiting_for_response = false;
+  // keeps the capacity of the buffers for the next request
+  path.clear();
+  body.clear();
+  pending.clear();
+  sending.clear();
+  finished = false;
+  keep_alive_flag = true;
 }
 
 void AsyncConnection::respond(const std::string& message, size_t status, const std::string& contentType) {
-  if (connection != nullptr) {  // when the connection was closed, don't bother allocating here
-    write_buffer = (char*)malloc(max_header_length + message.size());
-    write_buffer_len = 0;
-
-    // Copy the http status code
-    write_buffer_len += snprintf((char*)write_buffer,
-                                 max_header_length,
-                                 "HTTP/1.1 %lu OK\r\nContent-Type: %s;charset=utf-8\r\nAccess-Control-Allow-Origin: "
-                                 "*\r\nContent-Length: %lu\r\nConnection: %s\r\n\r\n",
-                                 status,
-                                 contentType.c_str(),
-                                 message.size(),
-                                 keep_alive_flag ? "Keep-Alive" : "Close");
-
-    memcpy(write_buffer + write_buffer_len, message.c_str(), message.size());
-    write_buffer_len += message.size();
+  char header[max_header_length];
+  int header_length = snprintf(header,
+                               max_header_length,
+                               "HTTP/1.1 %lu OK\r\nContent-Type: %s;charset=utf-8\r\nAccess-Control-Allow-Origin: "
+                               "*\r\nContent-Length: %lu\r\nConnection: %s\r\n\r\n",
+                               status,
+                               contentType.c_str(),
+                               message.size(),
+                               keep_alive_flag ? "Keep-Alive" : "Close");
+
+  std::lock_guard<std::mutex> lock(pipeline->mutex);
+  if (!pipeline->closed) {  // when the connection was closed, don't bother copying here
+    pending.append(header, header_length);
+    pending.append(message);
   }
-  send_response();
+  finished = true;
+  // the loop releases closed pipelines once all responses are finished, so signal it while holding the lock
+  ev_async_send(pipeline->ev_loop, &pipeline->ev_write);
+}
+
+void AsyncConnection::beginResponse(size_t status, const std::string& contentType) {
+  char header[max_header_length];
+  int header_length = snprintf(header,
+                               max_header_length,
+                               "HTTP/1.1 %lu OK\r\nContent-Type: %s;charset=utf-8\r\nAccess-Control-Allow-Origin: "
+                               "*\r\nTransfer-Encoding: chunked\r\nConnection: %s\r\n\r\n",
+                               status,
+                               contentType.c_str(),
+                               keep_alive_flag ? "Keep-Alive" : "Close");
+
+  std::lock_guard<std::mutex> lock(pipeline->mutex);
+  if (!pipeline->closed)
+    pending.append(header, header_length);
+  ev_async_send(pipeline->ev_loop, &pipeline->ev_write);
 }
 
-void AsyncConnection::send_response() { ev_async_send(ev_loop, &ev_write); }
+void AsyncConnection::sendResponsePart(const std::string& data) {
+  // an empty chunk would end the response
+  if (data.empty())
+    return;
+
+  char chunk_header[32];
+  int chunk_header_length = snprintf(chunk_header, sizeof(chunk_header), "%lx\r\n", data.size());
+
+  std::lock_guard<std::mutex> lock(pipeline->mutex);
+  if (pipeline->closed)
+    return;
+  pending.append(chunk_header, chunk_header_length);
+  pending.append(data);
+  pending.append("\r\n");
+  ev_async_send(pipeline->ev_loop, &pipeline->ev_write);
+}
+
+void AsyncConnection::endResponse() {
+  std::lock_guard<std::mutex> lock(pipeline->mutex);
+  if (!pipeline->closed)
+    pending.append("0\r\n\r\n");
+  finished = true;
+  ev_async_send(pipeline->ev_loop, &pipeline->ev_write);
+}
+
+bool AsyncConnection::isCongested() const {
+  std::lock_guard<std::mutex> lock(pipeline->mutex);
+  // only the response being written drains, later pipelined responses are buffered,
+  // otherwise their producers would wait for the requests before them
+  return !pipeline->closed && pipeline->requests.front() == this && pending.size() >= kMaxPendingStreamBytes;
+}
 
-bool AsyncConnection::hasBody() const { return body_len > 0; }
+bool AsyncConnection::hasBody() const { return !body.empty(); }
 
 std::string AsyncConnection::getPath() const { return path; }
 
-std::string AsyncConnection::getBody() const { return std::string(body, body_len); }
+std::string AsyncConnection::getBody() const { return body; }
 }
 }
@@ -7,7 +7,10 @@
 #include <cstdlib>
 #include <ev.h>
 
+#include <deque>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "net/AbstractConnection.h"
 
@@ -18,27 +21,33 @@
 namespace hyrise {
 namespace net {
 
+class AsyncPipeline;
+class ServerLoop;
+
+/*
+ * One HTTP request and its response. Keep-alive clients may send further
+ * requests before this one is answered; every request gets its own
+ * AsyncConnection and the pipeline of the client connection writes the
+ * responses in request order.
+ *
+ * The response is produced by a worker thread in pending, the event loop
+ * moves it to sending while ebb writes it. Both buffers keep their capacity
+ * when the object is reused for a later request.
+ */
 class AsyncConnection : public AbstractConnection {
  public:
-  ev_async ev_write;
-  struct ev_loop* ev_loop;
-  ebb_connection* connection;
-  ebb_request* request;
-  struct sockaddr_in addr;
+  AsyncPipeline* pipeline = nullptr;
+  ebb_request request;
   struct timeval starttime;
-  char* path;
-
-  char* body;
-  size_t body_len;
+  std::string path;
+  std::string body;
+  bool keep_alive_flag = true;
 
-  char* write_buffer;
-  size_t write_buffer_len;
+  // guarded by the mutex of the pipeline
+  std::string pending;
+  std::string sending;
+  bool finished = false;
 
-  bool keep_alive_flag;
-  bool waiting_for_response = false;
-
-  AsyncConnection();
-  ~AsyncConnection();
   void reset();
   virtual std::string getBody() const;
   virtual bool hasBody() const;
@@ -46,9 +55,48 @@ class AsyncConnection : public AbstractConnection {
   virtual void respond(const std::string& message,
                        size_t status = 200,
                        const std::string& contentType = "application/json");
+  virtual void beginResponse(size_t status = 200, const std::string& contentType = "application/json");
+  virtual void sendResponsePart(const std::string& data);
+  virtual void endResponse();
+  virtual bool isCongested() const;
+};
+
+/*
+ * The requests of one client connection in the order they arrived. Only
+ * the event loop thread parses requests and writes responses; workers
+ * fill the responses and signal ev_write while holding the mutex.
+ */
+class AsyncPipeline {
+ public:
+  static const size_t kMaxIdleRequests = 16;
+
+  ebb_connection* connection = nullptr;  // nullptr once the client closed the connection
+  ebb_server* server = nullptr;
+  ServerLoop* server_loop = nullptr;  // loop that takes the pipeline back when it is closed, nullptr if not pooled
+  struct ev_loop* ev_loop = nullptr;
+  ev_async ev_write;
+  struct sockaddr_in addr;
+
+  std::mutex mutex;
+  std::deque<AsyncConnection*> requests;
+  bool writing = false;
+  bool closed = false;
+
+  // request whose headers and body are still being parsed
+  AsyncConnection* parsing = nullptr;
+
+  AsyncPipeline();
+  ~AsyncPipeline();
+
+  AsyncConnection* acquireRequest();
+  void releaseRequest(AsyncConnection* request);
+  size_t idleRequests() const { return _idle_requests.size(); }
+
+  // Prepares a closed pipeline for the next client
+  void reset();
 
  private:
-  virtual void send_response();
+  std::vector<AsyncConnection*> _idle_requests;
 };
 
 ebb_connection* new_connection(ebb_server* server, struct sockaddr_in* addr);
@@ -63,11 +111,17 @@ void request_body(ebb_request* request, const char* at, size_t length);
 
 void write_cb(struct ev_loop* loop, struct ev_async* w, int revents);
 
-void continue_responding(ebb_connection* connection);
+// Hands the next ready part of the responses to ebb, one write at a time
+void pipeline_write(AsyncPipeline* pipeline);
+
+void continue_writing(ebb_connection* connection);
 
 void on_close(ebb_connection* connection);
 
 int on_timeout(ebb_connection* connection);
+
+// Returns a pipeline whose client is gone to the pool of its loop
+void release_pipeline(AsyncPipeline* pipeline);
 }
 }
 
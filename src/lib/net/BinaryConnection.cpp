@@ -0,0 +1,321 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "net/BinaryConnection.h"
+
+#include <arpa/inet.h>
+#include <endian.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#include "net/Router.h"
+#include "taskscheduler/SharedScheduler.h"
+
+namespace hyrise {
+namespace net {
+
+namespace {
+uint32_t readUint32(const char* data) {
+  uint32_t value;
+  memcpy(&value, data, sizeof(value));
+  return le32toh(value);
+}
+
+void appendUint32(std::string& out, uint32_t value) {
+  value = htole32(value);
+  out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+std::string frame(uint8_t type, const std::string& payload) {
+  std::string result;
+  result.reserve(kFrameHeaderSize + payload.size());
+  appendUint32(result, payload.size());
+  result.push_back(static_cast<char>(type));
+  result.append(payload);
+  return result;
+}
+
+std::string responsePayload(uint32_t status, const std::string& message) {
+  std::string payload;
+  payload.reserve(sizeof(uint32_t) + message.size());
+  appendUint32(payload, status);
+  payload.append(message);
+  return payload;
+}
+
+void setNonBlocking(int fd) { fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK); }
+}
+
+BinaryConnection::BinaryConnection(struct ev_loop* loop, int fd, BinaryListener* listener)
+    : _loop(loop), _fd(fd), _listener(listener) {
+  ev_io_init(&_read_watcher, read_cb, fd, EV_READ);
+  _read_watcher.data = this;
+  ev_io_init(&_write_watcher, write_cb, fd, EV_WRITE);
+  _write_watcher.data = this;
+  ev_async_init(&_response_watcher, response_cb);
+  _response_watcher.data = this;
+
+  ev_async_start(_loop, &_response_watcher);
+  ev_io_start(_loop, &_read_watcher);
+  if (_listener)
+    _listener->_connections.insert(this);
+}
+
+BinaryConnection::~BinaryConnection() {
+  ev_async_stop(_loop, &_response_watcher);
+  if (_listener)
+    _listener->_connections.erase(this);
+}
+
+std::string BinaryConnection::getBody() const { return _body; }
+
+std::string BinaryConnection::getPath() const { return _path; }
+
+bool BinaryConnection::hasBody() const { return !_body.empty(); }
+
+bool BinaryConnection::acceptsResultBatches() const { return true; }
+
+void BinaryConnection::respond(const std::string& message, size_t status, const std::string& contentType) {
+  // called by the worker that answers the request, the loop thread picks the frame up in response_cb
+  {
+    std::lock_guard<std::mutex> lock(_response_mutex);
+    _response = frame(contentType == kResultBatchContentType ? BatchFrame : ResponseFrame,
+                      responsePayload(status, message));
+  }
+  ev_async_send(_loop, &_response_watcher);
+}
+
+void BinaryConnection::read_cb(struct ev_loop* loop, ev_io* w, int revents) {
+  BinaryConnection* connection = static_cast<BinaryConnection*>(w->data);
+  char buffer[1 << 16];
+  ssize_t received = recv(connection->_fd, buffer, sizeof(buffer), 0);
+  if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+    return;
+  if (received <= 0) {
+    connection->close();
+    return;
+  }
+  connection->_input.append(buffer, received);
+  connection->processInput();
+}
+
+void BinaryConnection::write_cb(struct ev_loop* loop, ev_io* w, int revents) {
+  BinaryConnection* connection = static_cast<BinaryConnection*>(w->data);
+  ssize_t sent = send(connection->_fd,
+                      connection->_output.data() + connection->_output_offset,
+                      connection->_output.size() - connection->_output_offset,
+                      MSG_NOSIGNAL);
+  if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+    return;
+  if (sent < 0) {
+    connection->close();
+    return;
+  }
+  connection->_output_offset += sent;
+  if (connection->_output_offset == connection->_output.size()) {
+    connection->_output.clear();
+    connection->_output_offset = 0;
+    ev_io_stop(loop, &connection->_write_watcher);
+  }
+}
+
+void BinaryConnection::response_cb(struct ev_loop* loop, ev_async* w, int revents) {
+  BinaryConnection* connection = static_cast<BinaryConnection*>(w->data);
+  std::string response;
+  {
+    std::lock_guard<std::mutex> lock(connection->_response_mutex);
+    response.swap(connection->_response);
+  }
+  connection->_waiting_for_response = false;
+
+  // the client went away while its request was running
+  if (connection->_closed) {
+    delete connection;
+    return;
+  }
+
+  connection->_output.append(response);
+  connection->flush();
+  // requests the client sent in the meantime
+  connection->processInput();
+}
+
+void BinaryConnection::processInput() {
+  size_t offset = 0;
+  while (!_waiting_for_response && _input.size() - offset >= kFrameHeaderSize) {
+    size_t length = readUint32(_input.data() + offset);
+    if (length > kMaxFrameSize) {
+      close();
+      return;
+    }
+    if (_input.size() - offset < kFrameHeaderSize + length)
+      break;
+
+    uint8_t type = _input[offset + sizeof(uint32_t)];
+    const char* payload = _input.data() + offset + kFrameHeaderSize;
+    if (!handleFrame(type, payload, length)) {
+      close();
+      return;
+    }
+    offset += kFrameHeaderSize + length;
+  }
+  _input.erase(0, offset);
+}
+
+bool BinaryConnection::handleFrame(uint8_t type, const char* payload, size_t length) {
+  if (length < sizeof(uint32_t))
+    return false;
+
+  switch (type) {
+    case RequestFrame:
+    case PrepareFrame: {
+      size_t path_length = readUint32(payload);
+      if (path_length > length - sizeof(uint32_t))
+        return false;
+      std::string path(payload + sizeof(uint32_t), path_length);
+      std::string body(payload + sizeof(uint32_t) + path_length, length - sizeof(uint32_t) - path_length);
+
+      if (type == RequestFrame) {
+        dispatch(path, body);
+      } else {
+        uint32_t id = _next_statement_id++;
+        _statements[id] = std::make_pair(path, body);
+        std::string prepared;
+        appendUint32(prepared, id);
+        queueFrame(PreparedFrame, prepared);
+      }
+      return true;
+    }
+
+    case ExecuteFrame: {
+      auto statement = _statements.find(readUint32(payload));
+      if (statement == _statements.end()) {
+        queueFrame(ResponseFrame, responsePayload(404, "Unknown prepared statement"));
+        return true;
+      }
+      std::string body = statement->second.second;
+      if (length > sizeof(uint32_t)) {
+        if (!body.empty())
+          body.push_back('&');
+        body.append(payload + sizeof(uint32_t), length - sizeof(uint32_t));
+      }
+      dispatch(statement->second.first, body);
+      return true;
+    }
+
+    case CloseFrame:
+      _statements.erase(readUint32(payload));
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+void BinaryConnection::dispatch(const std::string& path, const std::string& body) {
+  const AbstractRequestHandlerFactory* handler_factory;
+  try {
+    handler_factory = Router::route(path);
+  }
+  catch (const RouterException& exc) {
+    std::string exception_message(exc.what());
+    queueFrame(ResponseFrame,
+               responsePayload(404, "Could not route request, std::exception was: \n" + exception_message));
+    return;
+  }
+
+  _path = path;
+  _body = body;
+  auto task = handler_factory->create(this);
+  task->setPriority(taskscheduler::Task::HIGH_PRIORITY);
+  _waiting_for_response = true;
+  taskscheduler::SharedScheduler::getInstance().getScheduler()->schedule(task);
+}
+
+void BinaryConnection::queueFrame(uint8_t type, const std::string& payload) {
+  _output.append(frame(type, payload));
+  flush();
+}
+
+void BinaryConnection::flush() {
+  if (!_output.empty())
+    ev_io_start(_loop, &_write_watcher);
+}
+
+void BinaryConnection::close() {
+  if (_closed)
+    return;
+  ev_io_stop(_loop, &_read_watcher);
+  ev_io_stop(_loop, &_write_watcher);
+  ::close(_fd);
+  _closed = true;
+  // a running request still responds to this connection, response_cb deletes it
+  if (!_waiting_for_response)
+    delete this;
+}
+
+BinaryListener::BinaryListener(struct ev_loop* loop) : _loop(loop) {
+  ev_init(&_accept_watcher, accept_cb);
+  _accept_watcher.data = this;
+}
+
+BinaryListener::~BinaryListener() { stop(); }
+
+int BinaryListener::listen(int port) {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0)
+    return -1;
+
+  int one = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(port);
+  if (bind(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0 || ::listen(fd, SOMAXCONN) < 0) {
+    ::close(fd);
+    return -1;
+  }
+  setNonBlocking(fd);
+
+  _fd = fd;
+  ev_io_set(&_accept_watcher, _fd, EV_READ);
+  ev_io_start(_loop, &_accept_watcher);
+  return fd;
+}
+
+void BinaryListener::stop() {
+  if (_fd >= 0) {
+    ev_io_stop(_loop, &_accept_watcher);
+    ::close(_fd);
+    _fd = -1;
+  }
+
+  // closing may delete a connection, which unregisters it
+  std::set<BinaryConnection*> connections;
+  connections.swap(_connections);
+  for (auto connection : connections) {
+    connection->_listener = nullptr;
+    connection->close();
+  }
+}
+
+void BinaryListener::accept_cb(struct ev_loop* loop, ev_io* w, int revents) {
+  BinaryListener* listener = static_cast<BinaryListener*>(w->data);
+  int fd = accept(w->fd, nullptr, nullptr);
+  if (fd < 0)
+    return;
+  setNonBlocking(fd);
+  int one = 1;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  // deletes itself when the client disconnects
+  new BinaryConnection(loop, fd, listener);
+}
+}
+}
@@ -0,0 +1,138 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_NET_BINARYCONNECTION_H_
+#define SRC_LIB_NET_BINARYCONNECTION_H_
+
+#include <ev.h>
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+
+#include "net/AbstractConnection.h"
+
+namespace hyrise {
+namespace net {
+
+/// Binary protocol served next to HTTP, it skips URL encoding of requests
+/// and sends query results as columnar batches (access/system/ResultBatch.h).
+///
+/// Every message is a frame of a little endian uint32 payload length, a
+/// uint8 frame type and the payload. Requests are handled one after the
+/// other in the order they arrive on a connection, clients may send
+/// further requests before the response of the previous one arrived.
+///
+/// Requests:
+///   Request:  uint32 path length, path, body; the path and body of an HTTP request, e.g.
+///             "/query/" and "query=...&performance=true"
+///   Prepare:  like Request, registers the request as statement of the connection and is
+///             answered by a Prepared frame carrying the uint32 statement id
+///   Execute:  uint32 statement id, body; runs a prepared request, a non empty body is
+///             appended to the prepared body, e.g. "parameters=..."
+///   Close:    uint32 statement id; releases a prepared statement, has no response
+///
+/// Responses:
+///   Response: uint32 status, message; JSON or any other message of a handler
+///   Batch:    uint32 status, result batch of a query
+///   Prepared: uint32 statement id
+typedef enum {
+  RequestFrame = 0x01,
+  PrepareFrame = 0x02,
+  ExecuteFrame = 0x03,
+  CloseFrame = 0x04,
+  ResponseFrame = 0x81,
+  BatchFrame = 0x82,
+  PreparedFrame = 0x83
+} frame_type_t;
+
+const size_t kFrameHeaderSize = sizeof(uint32_t) + sizeof(uint8_t);
+// Connections sending larger frames are closed
+const size_t kMaxFrameSize = 1 << 30;
+
+class BinaryListener;
+
+class BinaryConnection : public AbstractConnection {
+ public:
+  BinaryConnection(struct ev_loop* loop, int fd, BinaryListener* listener = nullptr);
+  ~BinaryConnection();
+
+  virtual std::string getBody() const;
+  virtual std::string getPath() const;
+  virtual bool hasBody() const;
+  virtual bool acceptsResultBatches() const;
+  virtual void respond(const std::string& message,
+                       size_t status = 200,
+                       const std::string& contentType = "application/json");
+
+ private:
+  friend class BinaryListener;
+
+  static void read_cb(struct ev_loop* loop, ev_io* w, int revents);
+  static void write_cb(struct ev_loop* loop, ev_io* w, int revents);
+  static void response_cb(struct ev_loop* loop, ev_async* w, int revents);
+
+  // Returns false for malformed frames, the connection is closed then
+  bool handleFrame(uint8_t type, const char* payload, size_t length);
+  void dispatch(const std::string& path, const std::string& body);
+  void queueFrame(uint8_t type, const std::string& payload);
+  // Handles buffered frames until a request waits for its response
+  void processInput();
+  void flush();
+  void close();
+
+  struct ev_loop* _loop;
+  int _fd;
+  BinaryListener* _listener;
+  ev_io _read_watcher;
+  ev_io _write_watcher;
+  ev_async _response_watcher;
+
+  std::string _input;
+  std::string _output;
+  size_t _output_offset = 0;
+
+  std::string _path;
+  std::string _body;
+  bool _waiting_for_response = false;
+  bool _closed = false;
+
+  // Frame built by the worker answering the current request
+  std::mutex _response_mutex;
+  std::string _response;
+
+  std::map<uint32_t, std::pair<std::string, std::string> > _statements;
+  uint32_t _next_statement_id = 1;
+};
+
+/// Accepts binary protocol connections on the loop and keeps track of them,
+/// so the server can close them on shutdown. Only the loop thread uses it.
+class BinaryListener {
+ public:
+  explicit BinaryListener(struct ev_loop* loop);
+  ~BinaryListener();
+
+  /// @returns the listening socket or -1 on failure
+  int listen(int port);
+
+  /// Stops accepting and closes all connections, requests still running
+  /// finish before their connection is deleted
+  void stop();
+
+  size_t connections() const { return _connections.size(); }
+
+ private:
+  friend class BinaryConnection;
+
+  static void accept_cb(struct ev_loop* loop, ev_io* w, int revents);
+
+  struct ev_loop* _loop;
+  int _fd = -1;
+  ev_io _accept_watcher;
+  std::set<BinaryConnection*> _connections;
+};
+}
+}
+
+#endif  // SRC_LIB_NET_BINARYCONNECTION_H_
@@ -0,0 +1,159 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "net/ServerLoops.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "helper/HwlocHelper.h"
+#include "net/AsyncConnection.h"
+#include "net/BinaryConnection.h"
+#include "taskscheduler/Task.h"
+
+namespace hyrise {
+namespace net {
+
+namespace {
+// Returns a bound socket, or -1. Sets reused if other sockets can bind the same port.
+int bindPort(int port, bool& reused) {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0)
+    return -1;
+
+  int one = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+#ifdef SO_REUSEPORT
+  reused = setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) == 0;
+#else
+  reused = false;
+#endif
+
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(port);
+  if (bind(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0) {
+    ::close(fd);
+    return -1;
+  }
+  return fd;
+}
+}
+
+ServerLoop::ServerLoop(ServerLoops* group, struct ev_loop* loop, int core) : _group(group), _loop(loop), _core(core) {
+  ebb_server_init(&_server, _loop);
+  _server.new_connection = new_connection;
+  _server.data = this;
+
+  ev_async_init(&_shutdown_watcher, shutdown_cb);
+  _shutdown_watcher.data = this;
+  ev_async_start(_loop, &_shutdown_watcher);
+}
+
+ServerLoop::~ServerLoop() {
+  for (auto pipeline : _idle_pipelines)
+    delete pipeline;
+}
+
+AsyncPipeline* ServerLoop::acquirePipeline() {
+  if (_idle_pipelines.empty())
+    return new AsyncPipeline;
+  AsyncPipeline* pipeline = _idle_pipelines.back();
+  _idle_pipelines.pop_back();
+  return pipeline;
+}
+
+void ServerLoop::releasePipeline(AsyncPipeline* pipeline) {
+  if (_idle_pipelines.size() >= kMaxIdlePipelines) {
+    delete pipeline;
+    return;
+  }
+  // keeps the request objects and their buffers for the next client
+  pipeline->reset();
+  _idle_pipelines.push_back(pipeline);
+}
+
+void ServerLoop::shutdown_cb(struct ev_loop* loop, ev_async* w, int revents) {
+  ServerLoop* server_loop = static_cast<ServerLoop*>(w->data);
+  ev_async_stop(loop, w);
+  if (server_loop->_server.listening)
+    ebb_server_unlisten(&server_loop->_server);
+  if (server_loop->_binary_listener)
+    server_loop->_binary_listener->stop();
+}
+
+ServerLoops::ServerLoops(size_t count, bool bindCores) {
+  int cores = getNumberOfCoresOnSystem();
+  for (size_t i = 0; i < std::max<size_t>(count, 1); ++i) {
+    struct ev_loop* loop = i == 0 ? ev_default_loop(0) : ev_loop_new(EVFLAG_AUTO);
+    int core = bindCores ? static_cast<int>(i % cores) : taskscheduler::Task::NO_PREFERRED_CORE;
+    _loops.emplace_back(new ServerLoop(this, loop, core));
+  }
+}
+
+ServerLoops::~ServerLoops() {
+  _binary_listener.reset();
+  for (auto& server_loop : _loops) {
+    struct ev_loop* loop = server_loop->loop();
+    server_loop.reset();
+    ev_loop_destroy(loop);
+  }
+}
+
+int ServerLoops::listen(int port) {
+  bool reused = false;
+  int shared_fd = -1;
+  for (auto& server_loop : _loops) {
+    int fd;
+    if (shared_fd >= 0) {
+      // a descriptor of its own, ebb closes it when the loop stops listening
+      fd = dup(shared_fd);
+    } else {
+      fd = bindPort(port, reused);
+      // without SO_REUSEPORT all loops accept on the first socket
+      if (!reused)
+        shared_fd = fd;
+    }
+    if (fd < 0)
+      return -1;
+    if (ebb_server_listen_on_fd(&server_loop->_server, fd) < 0)
+      return -1;
+  }
+  return port;
+}
+
+int ServerLoops::listenBinary(int port) {
+  _binary_listener.reset(new BinaryListener(defaultLoop()));
+  _loops.front()->_binary_listener = _binary_listener.get();
+  return _binary_listener->listen(port) < 0 ? -1 : port;
+}
+
+void ServerLoops::run() {
+  for (size_t i = 1; i < _loops.size(); ++i) {
+    ServerLoop* server_loop = _loops[i].get();
+    server_loop->_thread = std::thread([server_loop]() {
+      if (server_loop->core() != taskscheduler::Task::NO_PREFERRED_CORE)
+        bindCurrentThreadToCore(server_loop->core());
+      ev_run(server_loop->loop(), 0);
+    });
+  }
+
+  if (_loops.front()->core() != taskscheduler::Task::NO_PREFERRED_CORE)
+    bindCurrentThreadToCore(_loops.front()->core());
+  ev_run(_loops.front()->loop(), 0);
+
+  for (size_t i = 1; i < _loops.size(); ++i)
+    _loops[i]->_thread.join();
+}
+
+void ServerLoops::shutdown() {
+  for (auto& server_loop : _loops)
+    ev_async_send(server_loop->loop(), &server_loop->_shutdown_watcher);
+}
+}
+}
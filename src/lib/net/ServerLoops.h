@@ -0,0 +1,94 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_NET_SERVERLOOPS_H_
+#define SRC_LIB_NET_SERVERLOOPS_H_
+
+#include <ev.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "ebb/ebb.h"
+
+namespace hyrise {
+namespace net {
+
+class AsyncPipeline;
+class BinaryListener;
+class ServerLoops;
+
+/*
+ * One network thread: an event loop with its own HTTP server socket. A
+ * connection stays on the loop that accepted it; only the loop thread
+ * touches the pool of idle pipelines, so it needs no locking.
+ */
+class ServerLoop {
+ public:
+  static const size_t kMaxIdlePipelines = 1024;
+
+  ServerLoop(ServerLoops* group, struct ev_loop* loop, int core);
+  ~ServerLoop();
+
+  struct ev_loop* loop() const { return _loop; }
+
+  // Core the loop thread is bound to, Task::NO_PREFERRED_CORE if it is not bound
+  int core() const { return _core; }
+
+  ServerLoops* group() const { return _group; }
+
+  AsyncPipeline* acquirePipeline();
+  void releasePipeline(AsyncPipeline* pipeline);
+  size_t idlePipelines() const { return _idle_pipelines.size(); }
+
+ private:
+  friend class ServerLoops;
+
+  static void shutdown_cb(struct ev_loop* loop, ev_async* w, int revents);
+
+  ServerLoops* _group;
+  struct ev_loop* _loop;
+  int _core;
+  ebb_server _server;
+  // only set on the default loop if the binary protocol is served
+  BinaryListener* _binary_listener = nullptr;
+  ev_async _shutdown_watcher;
+  std::vector<AsyncPipeline*> _idle_pipelines;
+  std::thread _thread;
+};
+
+/*
+ * Serves HTTP requests with several event loops. Every loop listens on the
+ * same port with its own socket using SO_REUSEPORT, so the kernel spreads
+ * new connections across the loops; without SO_REUSEPORT the loops share a
+ * single listening socket. The first loop is the default loop and runs in
+ * the thread calling run().
+ */
+class ServerLoops {
+ public:
+  // With bindCores, loop i runs on core i and requests prefer the worker queue of that core
+  ServerLoops(size_t count, bool bindCores);
+  ~ServerLoops();
+
+  // Returns -1 if the port cannot be bound
+  int listen(int port);
+
+  // Serves the binary protocol on port with the default loop, returns -1 if the port cannot be bound
+  int listenBinary(int port);
+
+  // Blocks until all loops ended after shutdown()
+  void run();
+
+  // Stops accepting connections on all loops, can be called from any thread
+  void shutdown();
+
+  struct ev_loop* defaultLoop() const { return _loops.front()->loop(); }
+  size_t size() const { return _loops.size(); }
+
+ private:
+  std::vector<std::unique_ptr<ServerLoop> > _loops;
+  std::unique_ptr<BinaryListener> _binary_listener;
+};
+}
+}
+
+#endif  // SRC_LIB_NET_SERVERLOOPS_H_
@@ -1,6 +1,7 @@
 #include "net/ShutdownHandler.h"
 #include <iostream>
 #include "net/AsyncConnection.h"
+#include "net/ServerLoops.h"
 #include "ebb/ebb.h"
 
 namespace hyrise {
@@ -15,8 +16,14 @@ const std::string ShutdownHandler::vname() { return "ShutdownHandler"; }
 
 void ShutdownHandler::operator()() {
   if (auto ac = dynamic_cast<AsyncConnection*>(_connection)) {
+    // the connection may be reused as soon as the response is sent
+    ServerLoop* server_loop = ac->pipeline->server_loop;
+    ebb_server* server = ac->pipeline->server;
     ac->respond("shutting down");
-    ebb_server_unlisten(ac->connection->server);
+    if (server_loop != nullptr)
+      server_loop->group()->shutdown();
+    else
+      ebb_server_unlisten(server);
   }
 }
 }
@@ -3,6 +3,8 @@
 
 #include <cstddef>
 
+#include "helper/MemoryPolicy.h"
+
 namespace hyrise {
 namespace storage {
 
@@ -10,6 +12,8 @@ class AbstractAttributeVector {
  public:
   virtual ~AbstractAttributeVector();
   virtual size_t getColumns() const = 0;
+  // Moves the data according to policy, vectors without own memory management ignore it
+  virtual void setMemoryPolicy(const helper::MemoryPolicy& policy) {}
 };
 }
 }  // namespace hyrise::storage
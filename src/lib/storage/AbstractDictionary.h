@@ -5,6 +5,7 @@
 #include <string>
 #include <memory>
 
+#include "helper/MemoryPolicy.h"
 #include "storage/storage_types.h"
 
 namespace hyrise {
@@ -23,6 +24,8 @@ class AbstractDictionary {
   virtual size_t size() = 0;
 
   virtual void shrink() = 0;
+  // Applies policy to the values, dictionaries without a value list ignore it
+  virtual void setMemoryPolicy(const helper::MemoryPolicy& policy) {}
 
   size_t _checkpoint_size = 0;
   virtual void prepareCheckpoint() { _checkpoint_size = this->size(); }
@@ -1,6 +1,7 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #pragma once
 
+#include <algorithm>
 #include <vector>
 #include <storage/AbstractTable.h>
 #include <helper/vector_helpers.h>
@@ -60,5 +61,36 @@ class DefaultMergeStrategy : public AbstractMergeStrategy {
 
   virtual AbstractMergeStrategy* copy() { throw std::runtime_error("Merge Strategy Copy is like killing a kitten"); }
 };
+
+/*
+ * Merge strategy for chunked mains, the input tables are the chunks of the
+ * main followed by the delta. Chunks that reached the chunk size are sealed
+ * and kept as they are, the trailing smaller ones are compacted together
+ * with the delta into a new chunk. The cost of a merge is thus bounded by
+ * the chunk size and the delta instead of the size of the table.
+ */
+class ChunkedMergeStrategy : public DefaultMergeStrategy {
+ public:
+  explicit ChunkedMergeStrategy(size_t chunk_size) : _chunk_size(chunk_size) {}
+
+  virtual merge_tables determineTablesToMerge(std::vector<c_atable_ptr_t>& input_tables) const {
+    if (input_tables.empty())
+      return _merge_tables(input_tables, std::vector<c_atable_ptr_t>());
+
+    // the sealed chunks form a prefix, the delta is always merged
+    auto first_open = std::find_if(input_tables.begin(), input_tables.end() - 1, [this](const c_atable_ptr_t& t) {
+      return t->size() < _chunk_size;
+    });
+    return _merge_tables(std::vector<c_atable_ptr_t>(first_open, input_tables.end()),
+                         std::vector<c_atable_ptr_t>(input_tables.begin(), first_open));
+  }
+
+  virtual AbstractMergeStrategy* copy() { return new ChunkedMergeStrategy(_chunk_size); }
+
+  size_t chunkSize() const { return _chunk_size; }
+
+ private:
+  const size_t _chunk_size;
+};
 }
 }  // namespace hyrise::storage
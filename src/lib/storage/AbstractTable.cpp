@@ -370,6 +370,20 @@ const attr_vectors_t AbstractTable::getAttributeVectors(size_t column) const {
   throw std::runtime_error("getAttributeVectors not implemented");
 }
 
+void AbstractTable::setMemoryPolicy(const helper::MemoryPolicy& policy) {
+  _memory_policy = policy;
+  for (size_t column = 0; column < columnCount(); ++column) {
+    // columns of one partition share their attribute vector, moving it again is a no-op
+    for (const auto& vector : getAttributeVectors(column)) {
+      vector.attribute_vector->setMemoryPolicy(policy);
+    }
+    for (table_id_t table_id = 0; table_id < subtableCount(); ++table_id) {
+      if (const auto& dictionary = dictionaryByTableId(column, table_id))
+        dictionary->setMemoryPolicy(policy);
+    }
+  }
+}
+
 void AbstractTable::debugStructure(size_t level) const {
   std::cout << std::string(level, '\t') << "AbstractTable " << this << std::endl;
 }
@@ -16,6 +16,7 @@
 
 #include "io/logging.h"
 #include "helper/checked_cast.h"
+#include "helper/MemoryPolicy.h"
 #include "helper/types.h"
 #include "helper/unique_id.h"
 #include "storage/AbstractResource.h"
@@ -471,6 +472,14 @@ class AbstractTable : public AbstractResource {
 
   virtual void debugStructure(size_t level = 0) const;
 
+  /**
+  * Places the attribute vectors and dictionaries of all columns according
+  * to policy, see helper::MemoryPolicy. Tables sharing column memory with
+  * this table are affected as well.
+  */
+  virtual void setMemoryPolicy(const helper::MemoryPolicy& policy);
+  const helper::MemoryPolicy& memoryPolicy() const { return _memory_policy; }
+
   unique_id getUuid() const;
 
   void setUuid(unique_id = unique_id());
@@ -506,6 +515,7 @@ class AbstractTable : public AbstractResource {
   unique_id _uuid;
   std::string _name;
   bool logging = false;
+  helper::MemoryPolicy _memory_policy;
 };
 }
 }  // namespace hyrise::storage
@@ -1,8 +1,15 @@
 #include "storage/AttributeVectorFactory.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
 #include "storage/FixedLengthVector.h"
 #include "storage/ConcurrentFixedLengthVector.h"
 #include "storage/BitCompressedVector.h"
+#include "storage/FrequencyPartitionedVector.h"
+#include "storage/RunLengthVector.h"
 
 namespace hyrise {
 namespace storage {
@@ -16,6 +23,78 @@ baseattr_ptr_tr create_compressed_attribute_vector(size_t cols, size_t rows, std
   return std::make_shared<BitCompressedVector<value_id_t>>(cols, rows, bits);
 }
 
+namespace {
+// Smaller columns are not worth the slower row access of the encoded vectors
+const size_t encoding_min_rows = 4096;
+// An encoding has to at least halve the size of the bit-compressed column
+const size_t encoding_min_gain = 2;
+
+size_t bits_for(size_t values) {
+  return values <= 1 ? 1 : static_cast<size_t>(ceil(log(values) / log(2.0)));
+}
+}
+
+baseattr_ptr_tr create_encoded_attribute_vector(const baseattr_ptr_tr& source, size_t column, size_t dictionary_size) {
+  const size_t rows = source->size();
+  if (rows < encoding_min_rows || dictionary_size == 0)
+    return nullptr;
+
+  // Collect the statistics in a single pass
+  size_t runs = 0;
+  std::vector<size_t> counts(dictionary_size, 0);
+  value_id_t last = 0;
+  for (size_t row = 0; row < rows; ++row) {
+    value_id_t value = source->get(column, row);
+    if (row == 0 || value != last)
+      ++runs;
+    ++counts[value];
+    last = value;
+  }
+
+  const size_t value_width = sizeof(value_id_t) * 8;
+  const size_t exception_width = (sizeof(pos_t) + sizeof(value_id_t)) * 8;
+  const size_t plain_size = rows * bits_for(dictionary_size);
+  const size_t rle_size = runs * (sizeof(value_id_t) + sizeof(pos_t)) * 8;
+
+  // Frequency partitioning, try every code width narrower than the plain one
+  std::vector<value_id_t> by_frequency(dictionary_size);
+  std::iota(by_frequency.begin(), by_frequency.end(), 0);
+  std::sort(by_frequency.begin(), by_frequency.end(), [&counts](value_id_t a, value_id_t b) {
+    return counts[a] > counts[b];
+  });
+  size_t fp_size = std::numeric_limits<size_t>::max();
+  size_t fp_bits = 0;
+  size_t covered = 0, frequent = 0;
+  for (size_t bits = 1; bits < bits_for(dictionary_size); ++bits) {
+    // the largest code is the escape code for exceptions
+    size_t codes = (1ull << bits) - 1;
+    for (; frequent < std::min(codes, dictionary_size); ++frequent) {
+      covered += counts[by_frequency[frequent]];
+    }
+    size_t size = rows * bits + (rows - covered) * exception_width + frequent * value_width;
+    if (size < fp_size) {
+      fp_size = size;
+      fp_bits = bits;
+    }
+  }
+
+  if (rle_size * encoding_min_gain <= plain_size && rle_size <= fp_size) {
+    auto result = std::make_shared<RunLengthVector<value_id_t>>();
+    for (size_t row = 0; row < rows; ++row) {
+      result->push_back(source->get(column, row));
+    }
+    result->shrink_to_fit();
+    return result;
+  }
+
+  if (fp_bits > 0 && fp_size * encoding_min_gain <= plain_size) {
+    size_t codes = std::min<size_t>((1ull << fp_bits) - 1, dictionary_size);
+    std::vector<value_id_t> frequent_values(by_frequency.begin(), by_frequency.begin() + codes);
+    return std::make_shared<FrequencyPartitionedVector<value_id_t>>(source, column, frequent_values, fp_bits);
+  }
+
+  return nullptr;
+}
 
 /// Use this function to obtain an attribute vector
 baseattr_ptr_tr create_attribute_vector(size_t cols,
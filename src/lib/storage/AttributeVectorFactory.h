@@ -24,6 +24,12 @@ using baseattr_ptr_tr = std::shared_ptr<BaseAttributeVector<value_id_t>>;
 baseattr_ptr_tr create_compressed_attribute_vector(size_t cols, size_t rows, std::vector<adict_ptr_t>& dicts);
 
 
+/// Picks a more compact encoding for a finished column of a main partition
+/// based on its run and value frequency statistics. Returns the run-length
+/// or frequency-partitioned vector, or nullptr if the column is best kept
+/// as it is.
+baseattr_ptr_tr create_encoded_attribute_vector(const baseattr_ptr_tr& source, size_t column, size_t dictionary_size);
+
 /// Use this function to obtain an attribute vector
 baseattr_ptr_tr create_attribute_vector(size_t cols,
                                         size_t rows,
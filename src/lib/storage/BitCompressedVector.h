@@ -10,7 +10,9 @@
 #include <string>
 #include <stdexcept>
 #include <type_traits>
+#include <vector>
 
+#include "helper/MemoryPolicy.h"
 #include "storage/BaseAttributeVector.h"
 
 #ifndef WORD_LENGTH
@@ -58,6 +60,9 @@ class BitCompressedVector final : public BaseAttributeVector<T> {
   // The bits used for each column
   bit_size_list_t _bits;
 
+  // Placement of _data
+  helper::MemoryPolicy _policy;
+
  public:
   typedef T value_type;
 
@@ -70,7 +75,7 @@ class BitCompressedVector final : public BaseAttributeVector<T> {
     reserve(rows);
   }
 
-  virtual ~BitCompressedVector() { free(_data); }
+  virtual ~BitCompressedVector() { _deallocate(); }
 
   T get(size_t column, size_t row) const {
     checkAccess(column, row);
@@ -141,7 +146,7 @@ class BitCompressedVector final : public BaseAttributeVector<T> {
 
       // Only deallocate if there was something allocated
       if (newMemory != nullptr)
-        free(newMemory);
+        _policy.deallocate(newMemory, _allocatedBlocks * sizeof(storage_t));
 
       // set new allocarted blocks
       _allocatedBlocks = _blocks(rows);
@@ -154,8 +159,9 @@ class BitCompressedVector final : public BaseAttributeVector<T> {
    */
   void clear() {
     _size = 0;
-    free(_data);
+    _deallocate();
     _data = nullptr;
+    _allocatedBlocks = 0;
   }
 
   size_t size() { return _size; }
@@ -182,10 +188,29 @@ class BitCompressedVector final : public BaseAttributeVector<T> {
     }
   }
 
+  /*
+    Moves the data to memory allocated under policy
+   */
+  void setMemoryPolicy(const helper::MemoryPolicy& policy) override {
+    if (policy == _policy)
+      return;
+    storage_t* newMemory = nullptr;
+    if (_allocatedBlocks > 0) {
+      newMemory = static_cast<storage_t*>(policy.allocate(_allocatedBlocks * sizeof(storage_t)));
+      std::memcpy(newMemory, _data, _allocatedBlocks * sizeof(storage_t));
+    }
+    _deallocate();
+    _data = newMemory;
+    _policy = policy;
+  }
+
   std::shared_ptr<BaseAttributeVector<T>> copy() {
-    std::shared_ptr<BitCompressedVector> b = std::make_shared<BitCompressedVector>(_columns, _size, _bits);
+    std::shared_ptr<BitCompressedVector> b = std::make_shared<BitCompressedVector>(_columns, 0, _bits);
+    b->_policy = _policy;
     b->resize(_size);
-    std::memcpy(b->_data, _data, _allocatedBlocks * sizeof(storage_t));
+    // the copy only holds the blocks of its rows
+    if (_size > 0)
+      std::memcpy(b->_data, _data, _blocks(_size) * sizeof(storage_t));
     return b;
   }
 
@@ -244,14 +269,11 @@ class BitCompressedVector final : public BaseAttributeVector<T> {
   * Allocate memory given by the number of blocks
   */
   inline storage_t* _allocate(uint64_t numBlocks) {
-
-    auto data = static_cast<storage_t*>(malloc(numBlocks * sizeof(storage_t)));
-    if (data == nullptr) {
-      throw std::bad_alloc();
-    }
-    std::memset(data, 0, numBlocks * sizeof(storage_t));
-    return data;
+    // zeroed, throws std::bad_alloc on failure
+    return static_cast<storage_t*>(_policy.allocate(numBlocks * sizeof(storage_t)));
   }
+
+  inline void _deallocate() { _policy.deallocate(_data, _allocatedBlocks * sizeof(storage_t)); }
 };
 }
 }  // namespace hyrise::storage
@@ -10,7 +10,13 @@
 #include "storage/OrderPreservingDictionary.h"
 #include "storage/ConcurrentUnorderedDictionary.h"
 #include "storage/ConcurrentFixedLengthVector.h"
+#include "storage/AttributeVectorFactory.h"
 #include "storage/BitCompressedVector.h"
+#include "storage/FrameOfReferenceDictionary.h"
+#include "storage/FrequencyPartitionedVector.h"
+#include "storage/HorizontalTable.h"
+#include "storage/RunLengthVector.h"
+#include "storage/MappedFixedLengthVector.h"
 #include "storage/DictionaryFactory.h"
 #include "storage/Table.h"
 #include "storage/meta_storage.h"
@@ -58,6 +64,10 @@ ColumnStoreMerger::ColumnStoreMerger(std::shared_ptr<Store> store, bool forceFul
       _newMainSize(store->size()),
       _columnCount(_store->columnCount()),
       _forceFullIndexRebuild(forceFullIndexRebuild) {
+  // the merge maps value ids of one main dictionary per column
+  if (std::dynamic_pointer_cast<HorizontalTable>(_main))
+    throw std::runtime_error("ColumnStoreMerger does not support chunked mains");
+
   _vidMappingDelta.resize(_delta->size());
   _newTables.reserve(_columnCount);
 
@@ -75,8 +85,7 @@ ColumnStoreMerger::ColumnStoreMerger(std::shared_ptr<Store> store, bool forceFul
 
 template <typename T>
 void ColumnStoreMerger::mergeDictionarySorted(size_t column) {
-  auto mainDictionary =
-      std::dynamic_pointer_cast<storage::OrderPreservingDictionary<T>>(_main->dictionaryAt(column, 0, 0));
+  auto mainDictionary = std::dynamic_pointer_cast<storage::BaseDictionary<T>>(_main->dictionaryAt(column, 0, 0));
   auto deltaDictionary =
       std::dynamic_pointer_cast<storage::ConcurrentUnorderedDictionary<T>>(_delta->dictionaryAt(column, 0, 0));
   auto newDict = std::make_shared<OrderPreservingDictionary<T>>(deltaDictionary->size());
@@ -122,29 +131,19 @@ void ColumnStoreMerger::mergeDictionarySorted(size_t column) {
     }
   }
 
-  _mainDictMappings.push_back(mainDictMapping);
-  _deltaDictMappings.push_back(deltaDictMapping);
-
-  std::shared_ptr<Table> table;
-
-  // Poor man's attribute vector type switch
-  if (std::dynamic_pointer_cast<FixedLengthVector<value_id_t>>(
-          _main->getAttributeVectors(column)[0].attribute_vector)) {
-    table = std::make_shared<Table>(std::vector<ColumnMetadata>{_main->metadataAt(column)},
-                                    std::make_shared<FixedLengthVector<value_id_t>>(1, 0),
-                                    std::vector<adict_ptr_t>{newDict});
-  } else if (std::dynamic_pointer_cast<BitCompressedVector<value_id_t>>(
-                 _main->getAttributeVectors(column)[0].attribute_vector)) {
-    table = std::make_shared<Table>(std::vector<ColumnMetadata>{_main->metadataAt(column)},
-                                    std::make_shared<BitCompressedVector<value_id_t>>(1, 0),
-                                    std::vector<adict_ptr_t>{newDict});
-  } else {
-    throw std::runtime_error("Unsupported attribute vector type in ColumnStoreMerge");
+  adict_ptr_t mergedDict = newDict;
+  if (auto reference = create_frame_of_reference_dictionary<T>(*newDict, _newMainSize)) {
+    for (auto& valueId : mainDictMapping)
+      valueId = reference->getValueIdForValue(newDict->getValueForValueId(valueId));
+    for (auto& valueId : deltaDictMapping)
+      valueId = reference->getValueIdForValue(newDict->getValueForValueId(valueId));
+    mergedDict = reference;
   }
 
-  _newTables.push_back(table);
+  _mainDictMappings.push_back(mainDictMapping);
+  _deltaDictMappings.push_back(deltaDictMapping);
 
-  table->resize(_newMainSize);
+  createMergedTable(column, mergedDict, mergedDict != newDict);
 }
 
 template <typename T>
@@ -159,6 +158,7 @@ void ColumnStoreMerger::mergeDictionary(size_t column) {
 
   std::shared_ptr<AbstractDictionary> newDict = nullptr;
   std::shared_ptr<AbstractIndex> newIndex = nullptr;
+  bool frameOfReference = false;
 
   // execute merge and rebuild index from scratch if there is one for this particular column if:
   // - forceFullIndexRebuild flag is set
@@ -169,8 +169,7 @@ void ColumnStoreMerger::mergeDictionary(size_t column) {
       _main_indices[_currentIndexToMerge].second[0] != column ||
       (newIndex = _main_indices[_currentIndexToMerge].first->recreateIndexMergeDict(
            column, _store, newDict, _vidMappingMain, _vidMappingDelta)) == nullptr) {
-    auto mainDictionary =
-        std::dynamic_pointer_cast<storage::OrderPreservingDictionary<T>>(_main->dictionaryAt(column, 0, 0));
+    auto mainDictionary = std::dynamic_pointer_cast<storage::BaseDictionary<T>>(_main->dictionaryAt(column, 0, 0));
 
     auto deltaVector = std::dynamic_pointer_cast<storage::ConcurrentFixedLengthVector<value_id_t>>(
         _delta->getAttributeVectors(column)[0].attribute_vector);
@@ -220,34 +219,30 @@ void ColumnStoreMerger::mergeDictionary(size_t column) {
     }
 
     newDict = newDictNoIndex;
-  }
-
-  std::shared_ptr<Table> table;
 
-  // Poor man's attribute vector type switch
-  if (std::dynamic_pointer_cast<FixedLengthVector<value_id_t>>(
-          _main->getAttributeVectors(column)[0].attribute_vector)) {
-    table = std::make_shared<Table>(std::vector<ColumnMetadata>{_main->metadataAt(column)},
-                                    std::make_shared<FixedLengthVector<value_id_t>>(1, 0),
-                                    std::vector<adict_ptr_t>{newDict});
-  } else if (std::dynamic_pointer_cast<BitCompressedVector<value_id_t>>(
-                 _main->getAttributeVectors(column)[0].attribute_vector)) {
-    table = std::make_shared<Table>(std::vector<ColumnMetadata>{_main->metadataAt(column)},
-                                    std::make_shared<BitCompressedVector<value_id_t>>(1, 0),
-                                    std::vector<adict_ptr_t>{newDict});
-  } else {
-    throw std::runtime_error("Unsupported attribute vector type in ColumnStoreMerge");
+    // Dense unique integers do without a dictionary, the value ids become offsets to the smallest value.
+    // Indexed columns keep the ordered dictionary that the recreated index shares.
+    if (auto reference = create_frame_of_reference_dictionary<T>(*newDictNoIndex, _newMainSize)) {
+      for (size_t m = 0; m < _vidMappingMain.size(); ++m) {
+        value_id_t ordered = m + _vidMappingMain[m];
+        _vidMappingMain[m] = reference->getValueIdForValue(newDictNoIndex->getValueForValueId(ordered)) - m;
+      }
+      for (size_t d = 0; d < deltaDictionary->size(); ++d) {
+        _vidMappingDelta[d] = reference->getValueIdForValue(newDictNoIndex->getValueForValueId(_vidMappingDelta[d]));
+      }
+      newDict = reference;
+      frameOfReference = true;
+    }
   }
 
-  _newTables.push_back(table);
-
-  table->resize(_newMainSize);
+  auto table = createMergedTable(column, newDict, frameOfReference);
 
   if (!newIndex) {
     mergeValues(column, table, false);
   } else {
     mergeValues(column, table, true);
   }
+  encodeColumn(table);
 
   // Index present, but recreateIndexMergeDict not implemented or a full rebuild is forced
   if (_currentIndexToMerge < _main_indices.size() && _main_indices[_currentIndexToMerge].second[0] == column &&
@@ -262,6 +257,40 @@ void ColumnStoreMerger::mergeDictionary(size_t column) {
   }
 }
 
+std::shared_ptr<Table> ColumnStoreMerger::createMergedTable(size_t column,
+                                                           const adict_ptr_t& dict,
+                                                           bool frameOfReference) {
+  std::shared_ptr<Table> table;
+
+  // Poor man's attribute vector type switch, mapped mains are merged into regular vectors
+  // and read-only encoded mains are merged into bit-compressed ones before being encoded again.
+  // Frame-of-reference columns are always bit-compressed to the width of their offsets.
+  const auto& mainVector = _main->getAttributeVectors(column)[0].attribute_vector;
+  std::vector<adict_ptr_t> dicts{dict};
+  if (frameOfReference) {
+    table = std::make_shared<Table>(
+        std::vector<ColumnMetadata>{_main->metadataAt(column)}, create_compressed_attribute_vector(1, 0, dicts), dicts);
+  } else if (std::dynamic_pointer_cast<FixedLengthVector<value_id_t>>(mainVector) ||
+             std::dynamic_pointer_cast<MappedFixedLengthVector<value_id_t>>(mainVector)) {
+    table = std::make_shared<Table>(std::vector<ColumnMetadata>{_main->metadataAt(column)},
+                                    std::make_shared<FixedLengthVector<value_id_t>>(1, 0),
+                                    dicts);
+  } else if (std::dynamic_pointer_cast<BitCompressedVector<value_id_t>>(mainVector) ||
+             std::dynamic_pointer_cast<RunLengthVector<value_id_t>>(mainVector) ||
+             std::dynamic_pointer_cast<FrequencyPartitionedVector<value_id_t>>(mainVector)) {
+    table = std::make_shared<Table>(std::vector<ColumnMetadata>{_main->metadataAt(column)},
+                                    std::make_shared<BitCompressedVector<value_id_t>>(1, 0),
+                                    dicts);
+  } else {
+    throw std::runtime_error("Unsupported attribute vector type in ColumnStoreMerge");
+  }
+
+  _newTables.push_back(table);
+
+  table->resize(_newMainSize);
+  return table;
+}
+
 void ColumnStoreMerger::mergeValuesSorted(size_t column, atable_ptr_t table) {
   auto mainVector = std::dynamic_pointer_cast<storage::BaseAttributeVector<value_id_t>>(
       _main->getAttributeVectors(column)[0].attribute_vector);
@@ -294,6 +323,13 @@ void ColumnStoreMerger::mergeValues(size_t column, atable_ptr_t table, bool inde
   }
 }
 
+void ColumnStoreMerger::encodeColumn(const std::shared_ptr<Table>& table) {
+  auto vector =
+      std::dynamic_pointer_cast<BaseAttributeVector<value_id_t>>(table->getAttributeVectors(0)[0].attribute_vector);
+  if (auto encoded = create_encoded_attribute_vector(vector, 0, table->dictionaryAt(0)->size()))
+    table->setAttributes(encoded);
+}
+
 size_t ColumnStoreMerger::mergeValuesMain(size_t column, atable_ptr_t table) {
   size_t mainTableSize = _main->size();
   auto mainVector = std::dynamic_pointer_cast<storage::BaseAttributeVector<value_id_t>>(
@@ -332,13 +368,14 @@ std::vector<struct sortPermutationHelper> ColumnStoreMerger::calculatePermutatio
 
   CompoundValueKeyBuilder builder;
 
-  auto indexIterators = indexDelta->getIteratorsForKeyBetween(builder.get(), builder.get_upperbound());
+  auto indexPositions = indexDelta->getPositionsForKeyBetween(builder.get(), builder.get_upperbound());
 
-  auto deltaIndexIt = indexIterators.first;
+  auto deltaIndexIt = indexPositions.cbegin();
+  auto deltaIndexEnd = indexPositions.cend();
 
 
-  while (mainI < mainVectors[0]->size() || deltaIndexIt != indexIterators.second) {
-    bool processM = deltaIndexIt == indexIterators.second;
+  while (mainI < mainVectors[0]->size() || deltaIndexIt != deltaIndexEnd) {
+    bool processM = deltaIndexIt == deltaIndexEnd;
     bool processD = mainI >= mainVectors[0]->size();
 
     if (!processM) {
@@ -350,19 +387,19 @@ std::vector<struct sortPermutationHelper> ColumnStoreMerger::calculatePermutatio
           checkProcessM = (mainI < (*it)->size() &&
                            _mainDictMappings[*itIndexedColumns][(*it)->get(0, mainI)] <=
                                _deltaDictMappings[*itIndexedColumns]
-                                                 [(*itDelta)->getRef(0, (*deltaIndexIt).second - mainTableSize)]);
+                                                 [(*itDelta)->getRef(0, *deltaIndexIt - mainTableSize)]);
         } else {
           checkProcessM = (mainI < (*it)->size() &&
                            _mainDictMappings[*itIndexedColumns][(*it)->get(0, mainI)] <
                                _deltaDictMappings[*itIndexedColumns]
-                                                 [(*itDelta)->getRef(0, (*deltaIndexIt).second - mainTableSize)]);
+                                                 [(*itDelta)->getRef(0, *deltaIndexIt - mainTableSize)]);
           if (checkProcessM) {
             break;
           } else {
             if (mainI < (*it)->size() &&
                 _mainDictMappings[*itIndexedColumns][(*it)->get(0, mainI)] !=
                     _deltaDictMappings[*itIndexedColumns]
-                                      [(*itDelta)->getRef(0, (*deltaIndexIt).second - mainTableSize)])
+                                      [(*itDelta)->getRef(0, *deltaIndexIt - mainTableSize)])
               break;
           }
         }
@@ -379,19 +416,19 @@ std::vector<struct sortPermutationHelper> ColumnStoreMerger::calculatePermutatio
       for (auto it = deltaVectors.cbegin(); it != deltaVectors.cend(); ++it) {
         if (itIndexedColumns + 1 == indexedColumns.cend())
           checkProcessD =
-              (deltaIndexIt != indexIterators.second &&
-               _deltaDictMappings[*itIndexedColumns][(*it)->getRef(0, (*deltaIndexIt).second - mainTableSize)] <=
+              (deltaIndexIt != deltaIndexEnd &&
+               _deltaDictMappings[*itIndexedColumns][(*it)->getRef(0, *deltaIndexIt - mainTableSize)] <=
                    _mainDictMappings[*itIndexedColumns][(*itMain)->get(0, mainI)]);
         else {
           checkProcessD =
-              (deltaIndexIt != indexIterators.second &&
-               _deltaDictMappings[*itIndexedColumns][(*it)->getRef(0, (*deltaIndexIt).second - mainTableSize)] <
+              (deltaIndexIt != deltaIndexEnd &&
+               _deltaDictMappings[*itIndexedColumns][(*it)->getRef(0, *deltaIndexIt - mainTableSize)] <
                    _mainDictMappings[*itIndexedColumns][(*itMain)->get(0, mainI)]);
           if (checkProcessD) {
             break;
           } else {
-            if (deltaIndexIt != indexIterators.second &&
-                _deltaDictMappings[*itIndexedColumns][(*it)->getRef(0, (*deltaIndexIt).second - mainTableSize)] !=
+            if (deltaIndexIt != deltaIndexEnd &&
+                _deltaDictMappings[*itIndexedColumns][(*it)->getRef(0, *deltaIndexIt - mainTableSize)] !=
                     _mainDictMappings[*itIndexedColumns][(*itMain)->get(0, mainI)])
               break;
           }
@@ -411,7 +448,7 @@ std::vector<struct sortPermutationHelper> ColumnStoreMerger::calculatePermutatio
 
     if (processD) {
       sph.fromMain = false;
-      sph.position = (*deltaIndexIt).second - mainTableSize;
+      sph.position = *deltaIndexIt - mainTableSize;
       permutation.push_back(sph);
       ++deltaIndexIt;
     }
@@ -448,6 +485,7 @@ void ColumnStoreMerger::merge() {
 
     for (size_t column = 0; column < _columnCount; ++column) {
       mergeValuesSorted(column, _newTables[column]);
+      encodeColumn(std::dynamic_pointer_cast<Table>(_newTables[column]));
     }
 
     _store->clearIndices();
@@ -6,6 +6,7 @@
 #include <storage/AbstractMergeStrategy.h>
 #include <storage/AbstractMerger.h>
 #include <storage/Store.h>
+#include <storage/Table.h>
 #include "optional.hpp"
 
 namespace hyrise {
@@ -29,6 +30,10 @@ class ColumnStoreMerger {
   void mergeValuesSorted(uint64_t column, atable_ptr_t newMain);
   void mergeValues(uint64_t column, atable_ptr_t newMain, bool indexMaintenance);
   size_t mergeValuesMain(size_t column, atable_ptr_t table);
+  // Creates the single column table of a merged column, its vector type follows the old main
+  std::shared_ptr<Table> createMergedTable(size_t column, const adict_ptr_t& dict, bool frameOfReference);
+  // Replaces the attribute vector of a merged column with a compact read-only encoding where that pays off
+  void encodeColumn(const std::shared_ptr<Table>& table);
   std::vector<struct sortPermutationHelper> calculatePermutations(size_t column);
   std::shared_ptr<Store> _store;
   atable_ptr_t _main;
@@ -1,6 +1,14 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "helper/locking.h"
 #include "helper/not_implemented.h"
 #include "storage/BaseDictionary.h"
 #include "storage/DictionaryIterator.h"
@@ -36,30 +44,52 @@ class ConcurrentUnorderedDictionary : public BaseDictionary<T> {
   explicit ConcurrentUnorderedDictionary(const size_t s = 0) : _values(s), _size(s) {}
 
   ConcurrentUnorderedDictionary(const std::shared_ptr<std::vector<T>>& value_list) {
-    _writeLock.lock();
-    for (auto value : *value_list) {
+    // the list is distinct, so the values are added without checking the index
+    _values.reserve(value_list->size());
+    for (const auto& value : *value_list) {
       auto inserted = _values.push_back(value);
-      auto result = std::distance(_values.begin(), inserted);
-      _index.insert({value, result});
-      ++_size;
+      _index.insert({value, std::distance(_values.begin(), inserted)});
     }
-    _writeLock.unlock();
+    _size = value_list->size();
   }
 
 
   // Semantics differ from other dictionaries: adding the same value twice yields
-  // the same valueId. This is due to multiple threads pushing back the same
-  // value and/or testing for its existance via valueExists
-  // and the lag with inserting the resulting position into _index_unordered,
-  // where the first writer wins.
+  // the same valueId. Lookups in _index are lock-free, writers of new values
+  // only serialize with writers hashing to the same stripe, so every distinct
+  // value is pushed exactly once.
   virtual value_id_t addValue(T value) override {
-    auto inserted = _values.push_back(value);
-    auto result = std::distance(_values.begin(), inserted);
-    _writeLock.lock();
-    auto r = _index.insert({value, result});
-    _writeLock.unlock();
-    ++_size;
-    return r.first->second;
+    auto it = _index.find(value);
+    if (it != _index.end())
+      return it->second;
+
+    std::lock_guard<locking::Spinlock> lock(stripeFor(value));
+    return insertLocked(value);
+  }
+
+  // Adds all values and returns their value ids in the same order. Takes
+  // each stripe lock only once for the whole batch.
+  std::vector<value_id_t> addValues(const std::vector<T>& values) {
+    std::vector<value_id_t> result(values.size(), std::numeric_limits<value_id_t>::max());
+    std::vector<std::vector<size_t>> by_stripe(STRIPE_COUNT);
+    for (size_t i = 0; i < values.size(); ++i) {
+      auto it = _index.find(values[i]);
+      if (it != _index.end()) {
+        result[i] = it->second;
+      } else {
+        by_stripe[stripeIndex(values[i])].push_back(i);
+      }
+    }
+
+    for (size_t stripe = 0; stripe < STRIPE_COUNT; ++stripe) {
+      if (by_stripe[stripe].empty())
+        continue;
+      std::lock_guard<locking::Spinlock> lock(_stripes[stripe].lock);
+      for (auto i : by_stripe[stripe]) {
+        result[i] = insertLocked(values[i]);
+      }
+    }
+    return result;
   }
 
 
@@ -93,9 +123,10 @@ class ConcurrentUnorderedDictionary : public BaseDictionary<T> {
 
   virtual bool isOrdered() override { return false; }
   virtual std::shared_ptr<AbstractDictionary> copy() override {
-    auto d = std::make_shared<ConcurrentUnorderedDictionary<T>>(size());
+    auto d = std::make_shared<ConcurrentUnorderedDictionary<T>>();
     d->_values = _values;
     d->_index = _index;
+    d->_size = size();
     return d;
   }
   virtual std::shared_ptr<AbstractDictionary> copy_empty() override {
@@ -133,6 +164,23 @@ class ConcurrentUnorderedDictionary : public BaseDictionary<T> {
     _index.insert({value, valueId});
   }
 
+  void setValueIds(const std::vector<std::pair<T, value_id_t>>& values) {
+    // WARNING: do not use this, it's only for table recovery
+    // batched setValueId, grows the dictionary only once
+    value_id_t max_value_id = 0;
+    for (const auto& value : values) {
+      max_value_id = std::max(max_value_id, value.second);
+    }
+    if (!values.empty() && _size <= max_value_id) {
+      reserve(max_value_id + 1);
+      _size = max_value_id + 1;
+    }
+    for (const auto& value : values) {
+      _values[value.second] = value.first;
+      _index.insert(value);
+    }
+  }
+
 
 
   // These iterators are used to directly access the underlying vector for checkpointing.
@@ -144,11 +192,35 @@ class ConcurrentUnorderedDictionary : public BaseDictionary<T> {
   unsorted_iterator unsorted_end() { return _values.end(); }
 
  private:
+  static const size_t STRIPE_COUNT = 64;
+
+  struct alignas(64) stripe_t {
+    locking::Spinlock lock;
+  };
+
+  size_t stripeIndex(const T& value) const { return std::hash<T>()(value) % STRIPE_COUNT; }
+
+  locking::Spinlock& stripeFor(const T& value) { return _stripes[stripeIndex(value)].lock; }
+
+  // Must hold the stripe lock of value
+  value_id_t insertLocked(const T& value) {
+    // a writer holding the lock before us may have added the value
+    auto it = _index.find(value);
+    if (it != _index.end())
+      return it->second;
+
+    auto inserted = _values.push_back(value);
+    value_id_t result = std::distance(_values.begin(), inserted);
+    _index.insert({value, result});
+    ++_size;
+    return result;
+  }
+
   tbb::concurrent_vector<T> _values;
   tbb::concurrent_unordered_map<T, value_id_t> _index;
   std::map<T, value_id_t> _index_sorted;
-  size_t _size = 0;
-  std::mutex _writeLock;
+  std::atomic<size_t> _size{0};
+  stripe_t _stripes[STRIPE_COUNT];
 };
 }
 }  // namespace hyrise::storage
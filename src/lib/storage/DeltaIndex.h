@@ -17,6 +17,7 @@
 #include "storage/storage_types.h"
 #include "storage/AbstractIndex.h"
 #include "storage/AbstractTable.h"
+#include "storage/OptimisticBTree.h"
 
 #include <cereal/archives/binary.hpp>
 #include <cereal/types/map.hpp>
@@ -27,110 +28,77 @@ namespace storage {
 
 
 // An inverted index for the delta that can be queried and
-// is modifiable to add new values. However, the structure
-// is not threadsafe and needs to be synchronized via
-// read_lock and write_lock.
+// is modifiable to add new values. Entries are kept in an
+// OptimisticBTree, so lookups do not block concurrent inserts
+// and no external synchronization is needed.
 // Individual pos_lists for one key are stored sorted.
 template <typename T>
 class DeltaIndex : public AbstractIndex {
  private:
-  typedef std::multimap<T, pos_t> inverted_index_t;
-  typedef std::pair<typename inverted_index_t::iterator, typename inverted_index_t::iterator> range_t;
+  typedef OptimisticBTree<T> inverted_index_t;
 
   inverted_index_t _index;
-  RWMutex _mtx;
+
+  // Collects the positions of all entries starting at (key, pos) while accept(key) holds
+  template <typename F>
+  PositionRange collect(const T* key, pos_t pos, F accept) const {
+    std::shared_ptr<pos_list_t> pos_list(new pos_list_t);
+    auto visit = [&](const T& current, pos_t position) {
+      if (!accept(current))
+        return false;
+      pos_list->push_back(position);
+      return true;
+    };
+    if (key) {
+      _index.scan(*key, pos, visit);
+    } else {
+      _index.scanAll(visit);
+    }
+    return PositionRange(pos_list->cbegin(), pos_list->cend(), false, pos_list);
+  }
 
  public:
   virtual ~DeltaIndex() {}
 
   void shrink() { throw std::runtime_error("Shrink not supported for DeltaIndex"); }
 
-  void write_lock() { _mtx.lock_exclusive(); }
+  // The index synchronizes itself
+  void write_lock() {}
 
-  void unlock() { _mtx.unlock(); }
+  void unlock() {}
 
   explicit DeltaIndex(std::string id = "volatile_delta_index", size_t capacity = 1000000) : AbstractIndex(id) {}
 
-  void add(T value, pos_t pos) {
-    _index.insert({value, pos});
-  };
+  void add(T value, pos_t pos) { _index.insert(value, pos); };
 
-  static void copy(typename inverted_index_t::iterator first,
-                   typename inverted_index_t::iterator last,
-                   std::shared_ptr<pos_list_t> result) {
-    for (auto it = first; it != last; it++) {
-      result->push_back(it->second);
-    }
-  }
-
-  range_t getIteratorsForKey(T key) {
-    SharedLock sl(_mtx);
-    return _index.equal_range(key);
-  }
-
-  range_t getIteratorsForKeyBetween(T key, T upper) {
-    SharedLock sl(_mtx);
-    auto l = _index.lower_bound(key);
-    auto u = _index.upper_bound(upper);
-    return {l, u};
-  }
+  size_t size() const { return _index.size(); }
 
   PositionRange getPositionsForKey(T key) {
-    std::shared_ptr<pos_list_t> pos_list(new pos_list_t);
-    {
-      SharedLock sl(_mtx);
-      auto range = _index.equal_range(key);
-      copy(range.first, range.second, pos_list);
-    }
-    return PositionRange(pos_list->cbegin(), pos_list->cend(), false, pos_list);
+    return collect(&key, 0, [&key](const T& current) { return !(key < current); });
   };
 
   PositionRange getPositionsForKeyLT(T key) {
-    std::shared_ptr<pos_list_t> pos_list(new pos_list_t);
-    {
-      SharedLock sl(_mtx);
-      copy(_index.begin(), _index.lower_bound(key), pos_list);
-    }
-    return PositionRange(pos_list->cbegin(), pos_list->cend(), false, pos_list);
+    return collect(nullptr, 0, [&key](const T& current) { return current < key; });
   };
 
   PositionRange getPositionsForKeyLTE(T key) {
-    std::shared_ptr<pos_list_t> pos_list(new pos_list_t);
-    {
-      SharedLock sl(_mtx);
-      copy(_index.begin(), _index.upper_bound(key), pos_list);
-    }
-    return PositionRange(pos_list->cbegin(), pos_list->cend(), false, pos_list);
+    return collect(nullptr, 0, [&key](const T& current) { return !(key < current); });
   };
 
   PositionRange getPositionsForKeyBetween(T a, T b) {
     // return range [a,b]
     if (a > b)
       std::swap(a, b);
-    std::shared_ptr<pos_list_t> pos_list(new pos_list_t);
-    {
-      SharedLock sl(_mtx);
-      copy(_index.lower_bound(a), _index.upper_bound(b), pos_list);
-    }
-    return PositionRange(pos_list->cbegin(), pos_list->cend(), false, pos_list);
+    return collect(&a, 0, [&b](const T& current) { return !(b < current); });
   };
 
   PositionRange getPositionsForKeyGT(T key) {
-    std::shared_ptr<pos_list_t> pos_list(new pos_list_t);
-    {
-      SharedLock sl(_mtx);
-      copy(_index.upper_bound(key), _index.end(), pos_list);
-    }
-    return PositionRange(pos_list->cbegin(), pos_list->cend(), false, pos_list);
+    // no entry has the largest position, so this skips all entries of key
+    return collect(&key, std::numeric_limits<pos_t>::max(), [](const T&) { return true; });
   };
 
   PositionRange getPositionsForKeyGTE(T key) {
-    std::shared_ptr<pos_list_t> pos_list(new pos_list_t);
-    {
-      SharedLock sl(_mtx);
-      copy(_index.lower_bound(key), _index.end(), pos_list);
-    }
-    return PositionRange(pos_list->cbegin(), pos_list->cend(), false, pos_list);
+    return collect(&key, 0, [](const T&) { return true; });
   };
 };
 }
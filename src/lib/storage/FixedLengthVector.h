@@ -7,6 +7,7 @@
 #include <vector>
 
 
+#include "helper/MemoryPolicy.h"
 #include "helper/not_implemented.h"
 #include "storage/BaseAttributeVector.h"
 
@@ -49,7 +50,13 @@ class FixedLengthVector final : public AbstractFixedLengthVector<T> {
     _values[row * _columns + column] = value;
   }
 
-  virtual void reserve(size_t rows) override { _values.resize(_columns * rows); }
+  virtual void reserve(size_t rows) override {
+    const T* data = _values.data();
+    _values.resize(_columns * rows);
+    // growing the vector moves the values to memory the policy was not applied to yet
+    if (_values.data() != data)
+      _policy.apply(_values.data(), _values.capacity() * sizeof(T));
+  }
 
   virtual void resize(size_t rows) override { reserve(rows); }
 
@@ -59,7 +66,16 @@ class FixedLengthVector final : public AbstractFixedLengthVector<T> {
 
   size_t getColumns() const override { return _columns; }
 
-  virtual std::shared_ptr<BaseAttributeVector<T>> copy() override { return std::make_shared<FixedLengthVector>(*this); }
+  virtual std::shared_ptr<BaseAttributeVector<T>> copy() override {
+    auto copy = std::make_shared<FixedLengthVector>(*this);
+    _policy.apply(copy->_values.data(), copy->_values.capacity() * sizeof(T));
+    return copy;
+  }
+
+  void setMemoryPolicy(const helper::MemoryPolicy& policy) override {
+    _policy = policy;
+    _policy.apply(_values.data(), _values.capacity() * sizeof(T));
+  }
 
   virtual void clear() { _values.clear(); }
   virtual void rewriteColumn(const size_t, const size_t) {}
@@ -77,6 +93,7 @@ class FixedLengthVector final : public AbstractFixedLengthVector<T> {
   }
   const std::size_t _columns;
   std::vector<T> _values;
+  helper::MemoryPolicy _policy;
 };
 }
 }  // namespace hyrise::storage
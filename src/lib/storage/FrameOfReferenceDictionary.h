@@ -0,0 +1,202 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+#include "storage/BaseDictionary.h"
+#include "storage/BaseIterator.h"
+#include "storage/DictionaryIterator.h"
+#include "storage/storage_types.h"
+
+namespace hyrise {
+namespace storage {
+
+template <typename T>
+class FrameOfReferenceDictionaryIterator;
+
+/*
+ * Read-only dictionary for integer main columns with (almost) unique,
+ * densely distributed values such as generated keys or timestamps. It
+ * stores no values at all, the value id of a value is its offset to the
+ * smallest value of the column and the attribute vector holds these
+ * offsets bit-packed. Value ids are ordered like the values, so scans,
+ * joins and sorts work on it like on an OrderPreservingDictionary.
+ *
+ * The frame covers every value between the smallest and the greatest one,
+ * values without rows in between still get a value id. Looking them up
+ * yields a value id no row references, just like for a value that was
+ * deleted from the main.
+ */
+template <typename T>
+class FrameOfReferenceDictionary : public BaseDictionary<T> {
+  static_assert(std::is_integral<T>::value, "FrameOfReferenceDictionary requires an integral value type");
+
+ public:
+  explicit FrameOfReferenceDictionary(size_t size = 0) : _base(0), _size(0) {}
+
+  FrameOfReferenceDictionary(T base, size_t size) : _base(base), _size(size) {
+    if (size > std::numeric_limits<value_id_t>::max())
+      throw std::runtime_error("Frame of reference exceeds the value id range");
+  }
+
+  virtual ~FrameOfReferenceDictionary() {}
+
+  // Values can only be appended directly behind the current frame
+  value_id_t addValue(T value) {
+    if (_size == 0)
+      _base = value;
+    else if (value != getValueForValueId(_size))
+      throw std::runtime_error("FrameOfReferenceDictionary only accepts consecutive values");
+    return _size++;
+  }
+
+  T getValueForValueId(value_id_t value_id) { return _base + static_cast<T>(value_id); }
+
+  value_id_t getValueIdForValue(const T& value) const { return clamp(value); }
+
+  value_id_t findValueIdForValue(const T& value) const {
+    if (!inFrame(value))
+      return std::numeric_limits<value_id_t>::max();
+    return offset(value);
+  }
+
+  value_id_t getLowerBoundValueIdForValue(T other) { return clamp(other); }
+
+  value_id_t getUpperBoundValueIdForValue(T other) {
+    if (_size == 0 || other < _base)
+      return 0;
+    return inFrame(other) ? offset(other) + 1 : _size;
+  }
+
+  const T getSmallestValue() { return _base; }
+
+  const T getGreatestValue() { return getValueForValueId(_size - 1); }
+
+  bool isValueIdValid(value_id_t value_id) { return value_id < _size; }
+
+  bool valueExists(const T& value) const { return inFrame(value); }
+
+  void reserve(size_t size) {}
+
+  size_t size() { return _size; }
+
+  void shrink() {}
+
+  std::shared_ptr<AbstractDictionary> copy() { return std::make_shared<FrameOfReferenceDictionary<T>>(_base, _size); }
+
+  std::shared_ptr<AbstractDictionary> copy_empty() { return std::make_shared<FrameOfReferenceDictionary<T>>(); }
+
+  bool isOrdered() { return true; }
+
+  typedef DictionaryIterator<T> iterator;
+
+  iterator begin() { return iterator(std::make_shared<FrameOfReferenceDictionaryIterator<T>>(_base, 0)); }
+
+  iterator end() { return iterator(std::make_shared<FrameOfReferenceDictionaryIterator<T>>(_base, _size)); }
+
+  T base() const { return _base; }
+
+ private:
+  bool inFrame(const T& value) const { return _size > 0 && value >= _base && offset(value) < _size; }
+
+  // offsets are computed unsigned, values below the base wrap around and fail the range checks
+  uint64_t offset(const T& value) const { return static_cast<uint64_t>(value) - static_cast<uint64_t>(_base); }
+
+  value_id_t clamp(const T& value) const {
+    if (_size == 0 || value < _base)
+      return 0;
+    return std::min<uint64_t>(offset(value), _size);
+  }
+
+  T _base;
+  size_t _size;
+};
+
+
+template <typename T>
+class FrameOfReferenceDictionaryIterator : public BaseIterator<T> {
+ public:
+  FrameOfReferenceDictionaryIterator(T base, value_id_t index) : _base(base), _index(index) {}
+
+  virtual ~FrameOfReferenceDictionaryIterator() {}
+
+  void increment() { ++_index; }
+
+  bool equal(const std::shared_ptr<BaseIterator<T>>& other) const { return _index == other->getValueId(); }
+
+  T& dereference() const {
+    _current = _base + static_cast<T>(_index);
+    return _current;
+  }
+
+  value_id_t getValueId() const { return _index; }
+
+ private:
+  T _base;
+  value_id_t _index;
+  mutable T _current;
+};
+
+
+namespace detail {
+// Columns below this many distinct values keep their dictionary, it is small anyway
+const size_t kFrameOfReferenceMinimumValues = 1024;
+// The frame may be at most this many times larger than the number of distinct values
+const size_t kFrameOfReferenceMaximumSpread = 4;
+}
+
+/*
+ * Picks a frame-of-reference dictionary for a freshly merged main column
+ * if almost every row holds its own value and the values are dense enough
+ * that the bit-packed offsets need at most two bits more than the value ids
+ * of the ordered dictionary. Returns nullptr to keep the given dictionary.
+ * Callers move their value ids over with
+ * getValueIdForValue(dictionary.getValueForValueId(value_id)).
+ */
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value, std::shared_ptr<BaseDictionary<T>>>::type
+create_frame_of_reference_dictionary(BaseDictionary<T>& dictionary, size_t rows) {
+  size_t distinct = dictionary.size();
+  if (!dictionary.isOrdered() || distinct < detail::kFrameOfReferenceMinimumValues || distinct * 10 < rows * 9)
+    return nullptr;
+
+  uint64_t range =
+      static_cast<uint64_t>(dictionary.getGreatestValue()) - static_cast<uint64_t>(dictionary.getSmallestValue());
+  if (range >= std::numeric_limits<value_id_t>::max() || range >= distinct * detail::kFrameOfReferenceMaximumSpread)
+    return nullptr;
+
+  return std::make_shared<FrameOfReferenceDictionary<T>>(dictionary.getSmallestValue(), range + 1);
+}
+
+template <typename T>
+typename std::enable_if<!std::is_integral<T>::value, std::shared_ptr<BaseDictionary<T>>>::type
+create_frame_of_reference_dictionary(BaseDictionary<T>& dictionary, size_t rows) {
+  return nullptr;
+}
+
+/*
+ * Picks a frame-of-reference dictionary for the sorted values [first, last)
+ * of a main column that is loaded from disk. Only exactly consecutive values
+ * qualify since the stored value ids are positions in these values.
+ */
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value, std::shared_ptr<BaseDictionary<T>>>::type
+create_frame_of_reference_dictionary(const T* first, const T* last) {
+  size_t size = last - first;
+  if (size < detail::kFrameOfReferenceMinimumValues ||
+      static_cast<uint64_t>(*(last - 1)) - static_cast<uint64_t>(*first) != size - 1)
+    return nullptr;
+  return std::make_shared<FrameOfReferenceDictionary<T>>(*first, size);
+}
+
+template <typename T>
+typename std::enable_if<!std::is_integral<T>::value, std::shared_ptr<BaseDictionary<T>>>::type
+create_frame_of_reference_dictionary(const T* first, const T* last) {
+  return nullptr;
+}
+}
+}  // namespace hyrise::storage
@@ -0,0 +1,107 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include "storage/BaseAttributeVector.h"
+#include "storage/BitCompressedVector.h"
+#include "storage/storage_types.h"
+
+namespace hyrise {
+namespace storage {
+
+/*
+ * Read-only, single column attribute vector for skewed columns. The most
+ * frequent values get a short code that is stored bit-compressed for every
+ * row, all other values are stored as exceptions sorted by row and marked
+ * with the escape code, the largest code of the chosen width.
+ */
+template <typename T>
+class FrequencyPartitionedVector final : public BaseAttributeVector<T> {
+ public:
+  // Encodes column of source, frequent must hold fewer than 2^bits values
+  FrequencyPartitionedVector(const std::shared_ptr<BaseAttributeVector<T>>& source,
+                             size_t column,
+                             const std::vector<T>& frequent,
+                             size_t bits)
+      : _frequent(frequent),
+        _escape((1ull << bits) - 1),
+        _codes(std::make_shared<BitCompressedVector<T>>(1, source->size(), std::vector<uint64_t>{bits})) {
+    if (_frequent.size() > _escape)
+      throw std::runtime_error("Too many frequent values for the code width");
+
+    std::unordered_map<T, T> codes;
+    for (size_t code = 0; code < _frequent.size(); ++code) {
+      codes[_frequent[code]] = code;
+    }
+
+    size_t rows = source->size();
+    _codes->resize(rows);
+    for (size_t row = 0; row < rows; ++row) {
+      T value = source->get(column, row);
+      auto code = codes.find(value);
+      if (code != codes.end()) {
+        _codes->set(0, row, code->second);
+      } else {
+        _codes->set(0, row, _escape);
+        _exception_rows.push_back(row);
+        _exception_values.push_back(value);
+      }
+    }
+    _exception_rows.shrink_to_fit();
+    _exception_values.shrink_to_fit();
+  }
+
+  T get(size_t column, size_t row) const override {
+    T code = _codes->get(0, row);
+    if (code != _escape)
+      return _frequent[code];
+    auto exception = std::lower_bound(_exception_rows.begin(), _exception_rows.end(), row);
+    return _exception_values[exception - _exception_rows.begin()];
+  }
+
+  void set(size_t column, size_t row, T value) override {
+    throw std::runtime_error("FrequencyPartitionedVector is read-only");
+  }
+
+  void reserve(size_t rows) override {}
+
+  void resize(size_t rows) override {
+    if (rows != _codes->size())
+      throw std::runtime_error("FrequencyPartitionedVector cannot be resized");
+  }
+
+  uint64_t capacity() override { return _codes->size(); }
+
+  void clear() override {
+    _codes = std::make_shared<BitCompressedVector<T>>(1, 0, std::vector<uint64_t>{1});
+    _exception_rows.clear();
+    _exception_values.clear();
+  }
+
+  size_t size() override { return _codes->size(); }
+
+  size_t getColumns() const override { return 1; }
+
+  std::shared_ptr<BaseAttributeVector<T>> copy() override {
+    return std::make_shared<FrequencyPartitionedVector<T>>(*this);
+  }
+
+  void rewriteColumn(const size_t column, const size_t bits) override {}
+
+  size_t exceptionCount() const { return _exception_rows.size(); }
+
+ private:
+  std::vector<T> _frequent;
+  T _escape;
+  // never modified after construction, copies share the codes
+  std::shared_ptr<BitCompressedVector<T>> _codes;
+  std::vector<pos_t> _exception_rows;
+  std::vector<T> _exception_values;
+};
+}
+}  // namespace hyrise::storage
@@ -0,0 +1,141 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "storage/FrontCodedStringVector.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace hyrise {
+namespace storage {
+
+namespace {
+
+inline void writeLength(std::vector<char>& data, size_t length) {
+  while (length >= 0x80) {
+    data.push_back(static_cast<char>((length & 0x7f) | 0x80));
+    length >>= 7;
+  }
+  data.push_back(static_cast<char>(length));
+}
+
+inline size_t readLength(const char*& data) {
+  size_t length = 0;
+  size_t shift = 0;
+  unsigned char byte;
+  do {
+    byte = static_cast<unsigned char>(*data++);
+    length |= static_cast<size_t>(byte & 0x7f) << shift;
+    shift += 7;
+  } while (byte & 0x80);
+  return length;
+}
+}
+
+const size_t FrontCodedStringVector::block_size;
+
+void FrontCodedStringVector::push_back(const std::string& value) {
+  size_t prefix = 0;
+  if (_size % block_size == 0) {
+    _block_offsets.push_back(_data.size());
+  } else {
+    auto mismatch = std::mismatch(_last.begin(),
+                                  _last.begin() + std::min(_last.size(), value.size()),
+                                  value.begin());
+    prefix = mismatch.first - _last.begin();
+  }
+
+  writeLength(_data, prefix);
+  writeLength(_data, value.size() - prefix);
+  _data.insert(_data.end(), value.begin() + prefix, value.end());
+
+  _last = value;
+  ++_size;
+}
+
+std::string FrontCodedStringVector::at(size_t index) const {
+  std::string value;
+  seek(index, value);
+  return value;
+}
+
+size_t FrontCodedStringVector::seek(size_t index, std::string& value) const {
+  if (index >= _size)
+    throw std::out_of_range("Trying to access value beyond the end of the string vector");
+
+  size_t offset = _block_offsets[index / block_size];
+  for (size_t i = 0; i <= index % block_size; ++i) {
+    offset = next(offset, value);
+  }
+  return offset;
+}
+
+size_t FrontCodedStringVector::next(size_t offset, std::string& value) const {
+  const char* data = _data.data() + offset;
+  size_t prefix = readLength(data);
+  size_t suffix = readLength(data);
+  value.resize(prefix);
+  value.append(data, suffix);
+  return (data + suffix) - _data.data();
+}
+
+size_t FrontCodedStringVector::firstBlockGreater(const std::string& value) const {
+  size_t low = 0, high = _block_offsets.size();
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
+    // block heads are stored in full, so they are compared in place
+    const char* data = _data.data() + _block_offsets[mid];
+    readLength(data);
+    size_t length = readLength(data);
+    if (value.compare(0, std::string::npos, data, length) < 0) {
+      high = mid;
+    } else {
+      low = mid + 1;
+    }
+  }
+  return low;
+}
+
+template <typename Compare>
+size_t FrontCodedStringVector::searchBlock(size_t block, const std::string& value, Compare past) const {
+  size_t index = block * block_size;
+  size_t end = std::min(index + block_size, _size);
+  size_t offset = _block_offsets[block];
+  std::string current;
+  for (; index < end; ++index) {
+    offset = next(offset, current);
+    if (past(current, value))
+      break;
+  }
+  return index;
+}
+
+size_t FrontCodedStringVector::lower_bound(const std::string& value) const {
+  size_t block = firstBlockGreater(value);
+  if (block == 0)
+    return 0;
+  return searchBlock(block - 1, value, [](const std::string& a, const std::string& b) { return !(a < b); });
+}
+
+size_t FrontCodedStringVector::upper_bound(const std::string& value) const {
+  size_t block = firstBlockGreater(value);
+  if (block == 0)
+    return 0;
+  return searchBlock(block - 1, value, [](const std::string& a, const std::string& b) { return b < a; });
+}
+
+void FrontCodedStringVector::shrink_to_fit() {
+  _data.shrink_to_fit();
+  _block_offsets.shrink_to_fit();
+}
+
+void FrontCodedStringVector::clear() {
+  _data.clear();
+  _block_offsets.clear();
+  _last.clear();
+  _size = 0;
+}
+
+size_t FrontCodedStringVector::memoryUsage() const {
+  return _data.capacity() + _block_offsets.capacity() * sizeof(size_t);
+}
+}
+}  // namespace hyrise::storage
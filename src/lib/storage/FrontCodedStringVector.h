@@ -0,0 +1,73 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "helper/MemoryPolicy.h"
+
+namespace hyrise {
+namespace storage {
+
+/*
+ * Append-only list of strings stored in one contiguous buffer.
+ *
+ * Values are grouped into blocks of block_size entries. The first value
+ * of each block is stored in full, every following value only stores the
+ * length of the prefix it shares with its predecessor and the remaining
+ * suffix. Lengths are varint encoded. For sorted input, lookups binary
+ * search over the block heads and decode at most one block.
+ */
+class FrontCodedStringVector {
+ public:
+  static const size_t block_size = 16;
+
+  FrontCodedStringVector() : _size(0) {}
+
+  void push_back(const std::string& value);
+
+  // Decodes the value at index
+  std::string at(size_t index) const;
+
+  // Decodes the value at index into value and returns the offset of the
+  // next entry, which can be passed to next() for sequential access.
+  size_t seek(size_t index, std::string& value) const;
+
+  // Decodes the entry at offset, value must hold its predecessor
+  size_t next(size_t offset, std::string& value) const;
+
+  // Index of the first value not less than value, requires sorted input
+  size_t lower_bound(const std::string& value) const;
+
+  // Index of the first value greater than value, requires sorted input
+  size_t upper_bound(const std::string& value) const;
+
+  size_t size() const { return _size; }
+  bool empty() const { return _size == 0; }
+  const std::string& back() const { return _last; }
+
+  void reserve(size_t size) { _block_offsets.reserve((size + block_size - 1) / block_size); }
+  void shrink_to_fit();
+  void clear();
+
+  // Bytes used by the encoded values and the block offsets
+  size_t memoryUsage() const;
+
+  void setMemoryPolicy(const helper::MemoryPolicy& policy) { policy.apply(_data.data(), _data.capacity()); }
+
+ private:
+  // First block whose head compares greater than value
+  size_t firstBlockGreater(const std::string& value) const;
+
+  template <typename Compare>
+  size_t searchBlock(size_t block, const std::string& value, Compare past) const;
+
+  std::vector<char> _data;
+  std::vector<size_t> _block_offsets;
+  size_t _size;
+  // the last appended value, needed to compute the shared prefix
+  std::string _last;
+};
+}
+}  // namespace hyrise::storage
@@ -1,6 +1,7 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #pragma once
 
+#include <numeric>
 #include <vector>
 #include <map>
 #include <stdexcept>
@@ -16,6 +17,7 @@
 #include "storage/CompoundValueIdKeyBuilder.h"
 #include "storage/meta_storage.h"
 #include "storage/ConcurrentFixedLengthVector.h"
+#include "storage/PackedPositions.h"
 #include <storage/Store.h>
 
 #include <memory>
@@ -42,7 +44,7 @@ class GroupkeyIndex : public AbstractIndex {
   typedef std::map<T, pos_list_t> inverted_index_mutable_t;
   typedef OrderPreservingDictionary<T> dict_t;
   typedef std::vector<pos_t> groupkey_offsets_t;
-  typedef std::vector<pos_t> groupkey_postings_t;
+  typedef PackedPositions groupkey_postings_t;
   typedef std::shared_ptr<dict_t> dict_ptr_t;
 
   typedef std::pair<typename pos_list_t::const_iterator, typename pos_list_t::const_iterator> range_t;
@@ -60,9 +62,16 @@ class GroupkeyIndex : public AbstractIndex {
 
   std::vector<pos_t>::iterator offsetsEnd() { return _offsets.end(); }
 
-  std::vector<pos_t>::iterator postingsBegin() { return _postings.begin(); }
+  groupkey_postings_t::const_iterator postingsBegin() const { return _postings.begin(); }
 
-  std::vector<pos_t>::iterator postingsEnd() { return _postings.end(); }
+  groupkey_postings_t::const_iterator postingsEnd() const { return _postings.end(); }
+
+  // Decodes the postings in [start, end)
+  PositionRange decodePostings(size_t start, size_t end, bool sorted) const {
+    std::shared_ptr<pos_list_t> pos_list(new pos_list_t);
+    _postings.decode(start, end, *pos_list);
+    return PositionRange(pos_list->cbegin(), pos_list->cend(), sorted, pos_list);
+  }
 
   void shrink() { throw std::runtime_error("Shrink not supported for GroupkeyIndex"); }
 
@@ -103,8 +112,7 @@ class GroupkeyIndex : public AbstractIndex {
     auto deltaVector = std::dynamic_pointer_cast<storage::ConcurrentFixedLengthVector<value_id_t>>(
         oldDelta->getAttributeVectors(column).at(0).attribute_vector);
 
-    auto mainDictionary =
-        std::dynamic_pointer_cast<storage::OrderPreservingDictionary<T>>(oldMain->dictionaryAt(column, 0, 0));
+    auto mainDictionary = std::dynamic_pointer_cast<storage::BaseDictionary<T>>(oldMain->dictionaryAt(column, 0, 0));
     auto deltaDictionary =
         std::dynamic_pointer_cast<storage::ConcurrentUnorderedDictionary<T>>(oldDelta->dictionaryAt(column, 0, 0));
 
@@ -114,7 +122,7 @@ class GroupkeyIndex : public AbstractIndex {
     auto itDelta = deltaDictionary->begin();
     auto deltaEnd = deltaDictionary->end();
 
-    groupkey_postings_t newPostings;
+    pos_list_t newPostings;
     groupkey_offsets_t newOffsets;
 
     size_t mainDictSize = mainDictionary->size();
@@ -123,16 +131,29 @@ class GroupkeyIndex : public AbstractIndex {
 
     ValueId vid;
 
-    uint64_t count, c = 0, m = 0, n = 0;
-    auto postingIterator = postingsBegin();
-    auto offsetIterator = offsetsBegin();
-
-    // mapping of values to positions in deltaVector necessary to be able to build help structure for merging (_Vd)
-    // efficiently
-    std::map<T, std::vector<size_t>> deltaValueMap;
-    for (size_t j = 0; j < deltaVector->size(); ++j) {
-      deltaValueMap[deltaDictionary->getValueForValueId(deltaVector->getRef(0, j))].push_back(j);
+    uint64_t m = 0, n = 0;
+    // an index on a frame-of-reference main keeps its own dictionary, its
+    // value ids then have to be looked up instead of following the main ones
+    const bool sharedDictionary = mainDictionary == _dictionary;
+
+    // Group the delta rows by their delta value id with a counting sort, the
+    // sorted walk over the delta dictionary then picks up each group directly
+    size_t deltaSize = deltaVector->size();
+    std::vector<size_t> deltaOffsets(deltaDictionary->size() + 1, 0);
+    for (size_t j = 0; j < deltaSize; ++j) {
+      ++deltaOffsets[deltaVector->getRef(0, j) + 1];
     }
+    std::partial_sum(deltaOffsets.begin(), deltaOffsets.end(), deltaOffsets.begin());
+    std::vector<pos_t> deltaRows(deltaSize);
+    {
+      std::vector<size_t> fill(deltaOffsets.begin(), deltaOffsets.end() - 1);
+      for (size_t j = 0; j < deltaSize; ++j) {
+        deltaRows[fill[deltaVector->getRef(0, j)]++] = j;
+      }
+    }
+
+    newPostings.reserve(_postings.size() + deltaSize);
+    newOffsets.reserve(mainDictSize + deltaDictionary->size() + 1);
 
     while (itDelta != deltaEnd || m != mainDictSize) {
       if (m != mainDictSize)
@@ -141,41 +162,36 @@ class GroupkeyIndex : public AbstractIndex {
       bool processM = (itDelta == deltaEnd || (m != mainDictSize && mainDictValue <= *itDelta));
       bool processD = (m == mainDictSize || (*itDelta <= mainDictValue));
 
-      newOffsets.push_back(c);
+      newOffsets.push_back(newPostings.size());
 
       if (processM) {
         vid.valueId = newDict->addValue(mainDictValue);
 
+        // the main postings of a value keep their order and only move
+        value_id_t indexValueId = sharedDictionary ? m : _dictionary->findValueIdForValue(mainDictValue);
+        if (indexValueId != std::numeric_limits<value_id_t>::max())
+          _postings.decode(_offsets[indexValueId], _offsets[indexValueId + 1], newPostings);
+
         vidMappingMain.push_back(n - m);
         ++m;
-
-        count = *(offsetIterator + 1) - *offsetIterator;
-        c += count;
-        for (size_t j = 0; j < count; ++j) {
-          newPostings.push_back(*postingIterator);
-          ++postingIterator;
-        }
-        ++offsetIterator;
       }
 
       if (processD) {
         if (!processM)
           vid.valueId = newDict->addValue(*itDelta);
 
-        count = 0;
-        for (auto it = deltaValueMap[*itDelta].cbegin(); it != deltaValueMap[*itDelta].cend(); ++it) {
-          ++count;
-          newPostings.push_back(*it + mainTableSize);
-          vidMappingDelta[*it] = n;
+        auto deltaValueId = itDelta.getValueId();
+        for (size_t j = deltaOffsets[deltaValueId]; j < deltaOffsets[deltaValueId + 1]; ++j) {
+          newPostings.push_back(deltaRows[j] + mainTableSize);
+          vidMappingDelta[deltaRows[j]] = n;
         }
 
-        c += count;
         ++itDelta;
       }
       ++n;
     }
 
-    newOffsets.push_back(c);
+    newOffsets.push_back(newPostings.size());
 
     newDictReturn = newDict;
     return std::make_shared<GroupkeyIndex<T>>(column, newDict, newOffsets, newPostings, _id);
@@ -184,7 +200,7 @@ class GroupkeyIndex : public AbstractIndex {
   explicit GroupkeyIndex(field_t column,
                          dict_ptr_t dictionary,
                          groupkey_offsets_t offsets,
-                         groupkey_postings_t postings,
+                         const pos_list_t& postings,
                          std::string id = "volatile_groupkey")
       : AbstractIndex(id), _dictionary(dictionary), _columns({column}), _offsets(offsets), _postings(postings) {};
 
@@ -195,8 +211,8 @@ class GroupkeyIndex : public AbstractIndex {
                          bool will_recover_from_archive = false)
       : AbstractIndex(id), _columns({column}) {
     if (in != nullptr && create && !will_recover_from_archive) {
-      // save pointer to dictionary
-      _dictionary = std::static_pointer_cast<dict_t>(in->dictionaryAt(column));
+      // save pointer to dictionary, frame-of-reference mains get a dictionary of their own
+      _dictionary = std::dynamic_pointer_cast<dict_t>(in->dictionaryAt(column));
 
       // create mutable index
       inverted_index_mutable_t _index;
@@ -212,23 +228,34 @@ class GroupkeyIndex : public AbstractIndex {
         }
       }
 
+      if (!_dictionary) {
+        _dictionary = std::make_shared<dict_t>(_index.size());
+        for (auto& it : _index) {
+          _dictionary->addValue(it.first);
+        }
+      }
+
       // create readonly index
       _offsets.resize(_dictionary->size() + 1);
-      _postings.reserve(in->size());
+      pos_list_t postings;
+      postings.reserve(in->size());
 
       for (auto& it : _index) {
         // set offset
         auto value_id = _dictionary->getValueIdForValue(it.first);
-        _offsets[value_id] = _postings.size();
+        _offsets[value_id] = postings.size();
 
         // copy positions into postings
-        std::copy(it.second.begin(), it.second.end(), std::back_inserter(_postings));
+        std::copy(it.second.begin(), it.second.end(), std::back_inserter(postings));
       }
 
       // set last offset
-      _offsets[_dictionary->size()] = _postings.size();
+      _offsets[_dictionary->size()] = postings.size();
+      _postings = PackedPositions(postings);
     } else if (in != nullptr && !create) {
-      _dictionary = std::static_pointer_cast<dict_t>(in->dictionaryAt(column));
+      _dictionary = std::dynamic_pointer_cast<dict_t>(in->dictionaryAt(column));
+      if (!_dictionary)
+        _dictionary = std::make_shared<dict_t>();
     } else {
       throw std::runtime_error("Nullptr as input for GroupkeyIndex constructor.");
     }
@@ -278,19 +305,21 @@ class GroupkeyIndex : public AbstractIndex {
 
       // create readonly index
       _offsets.resize(_dictionary->size() + 1);
-      _postings.reserve(in->size());
+      pos_list_t postings;
+      postings.reserve(in->size());
 
       for (auto& it : _index) {
         // set offset
         auto value_id = _dictionary->getValueIdForValue(it.first);
-        _offsets[value_id] = _postings.size();
+        _offsets[value_id] = postings.size();
 
         // copy positions into postings
-        std::copy(it.second.begin(), it.second.end(), std::back_inserter(_postings));
+        std::copy(it.second.begin(), it.second.end(), std::back_inserter(postings));
       }
 
       // set last offset
-      _offsets[_dictionary->size()] = _postings.size();
+      _offsets[_dictionary->size()] = postings.size();
+      _postings = PackedPositions(postings);
     } else if (in != nullptr && !create) {
     } else {
       throw std::runtime_error("Nullptr as input for GroupkeyIndex constructor.");
@@ -310,10 +339,10 @@ class GroupkeyIndex : public AbstractIndex {
     if (value_id != std::numeric_limits<value_id_t>::max()) {
       auto start = _offsets[value_id];
       auto end = _offsets[value_id + 1];
-      return PositionRange(_postings.begin() + start, _postings.begin() + end, true);
+      return decodePostings(start, end, true);
     } else {
       // empty result
-      return PositionRange(_postings.begin(), _postings.begin(), true);
+      return decodePostings(0, 0, true);
     }
   }
 
@@ -323,10 +352,10 @@ class GroupkeyIndex : public AbstractIndex {
 
     if (value_exists) {
       auto end = _offsets[value_id];
-      return PositionRange(_postings.begin(), _postings.begin() + end, false);
+      return decodePostings(0, end, false);
     } else {
       // all
-      return PositionRange(_postings.begin(), _postings.end(), false);
+      return decodePostings(0, _postings.size(), false);
     }
   }
 
@@ -336,10 +365,10 @@ class GroupkeyIndex : public AbstractIndex {
 
     if (value_exists) {
       auto end = _offsets[value_id];
-      return PositionRange(_postings.begin(), _postings.begin() + end, false);
+      return decodePostings(0, end, false);
     } else {
       // all
-      return PositionRange(_postings.begin(), _postings.end(), false);
+      return decodePostings(0, _postings.size(), false);
     }
   }
 
@@ -349,10 +378,10 @@ class GroupkeyIndex : public AbstractIndex {
 
     if (value_exists) {
       auto start = _offsets[value_id];
-      return PositionRange(_postings.begin() + start, _postings.end(), false);
+      return decodePostings(start, _postings.size(), false);
     } else {
       // empty
-      return PositionRange(_postings.end(), _postings.end(), false);
+      return decodePostings(0, 0, false);
     }
   }
 
@@ -362,10 +391,10 @@ class GroupkeyIndex : public AbstractIndex {
 
     if (value_exists) {
       auto start = _offsets[value_id];
-      return PositionRange(_postings.begin() + start, _postings.end(), false);
+      return decodePostings(start, _postings.size(), false);
     } else {
       // empty
-      return PositionRange(_postings.end(), _postings.end(), false);
+      return decodePostings(0, 0, false);
     }
   }
 
@@ -383,16 +412,16 @@ class GroupkeyIndex : public AbstractIndex {
     if (value_a_exists && value_b_exists) {
       auto start = _offsets[value_id_a];
       auto end = _offsets[value_id_b];
-      return PositionRange(_postings.begin() + start, _postings.begin() + end, false);
+      return decodePostings(start, end, false);
     } else if (value_a_exists) {
       auto start = _offsets[value_id_a];
-      return PositionRange(_postings.begin() + start, _postings.end(), false);
+      return decodePostings(start, _postings.size(), false);
     } else if (value_b_exists) {
       auto end = _offsets[value_id_b];
-      return PositionRange(_postings.begin(), _postings.begin() + end, false);
+      return decodePostings(0, end, false);
     } else {
       // empty
-      return PositionRange(_postings.end(), _postings.end(), false);
+      return decodePostings(0, 0, false);
     }
   }
 
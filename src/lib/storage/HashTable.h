@@ -3,6 +3,7 @@
 
 #include <atomic>
 #include <algorithm>
+#include <functional>
 #include <set>
 #include <unordered_map>
 #include <memory>
@@ -10,6 +11,7 @@
 
 #include "helper/types.h"
 #include "helper/checked_cast.h"
+#include "helper/QueryArena.h"
 
 #include "storage/AbstractHashTable.h"
 #include "storage/AbstractTable.h"
@@ -114,14 +116,33 @@ class SingleGroupKeyHash {
   }
 };
 
+// Entries and buckets come from the query arena if the hash table is built with one
+template <class KEY>
+using hash_map_allocator_t = helper::ArenaAllocator<std::pair<const KEY, pos_t>>;
+
 // Multi Keys
-typedef std::unordered_multimap<aggregate_key_t, pos_t, GroupKeyHash<aggregate_key_t>> aggregate_hash_map_t;
-typedef std::unordered_multimap<join_key_t, pos_t, GroupKeyHash<join_key_t>> join_hash_map_t;
+typedef std::unordered_multimap<aggregate_key_t,
+                                pos_t,
+                                GroupKeyHash<aggregate_key_t>,
+                                std::equal_to<aggregate_key_t>,
+                                hash_map_allocator_t<aggregate_key_t>> aggregate_hash_map_t;
+typedef std::unordered_multimap<join_key_t,
+                                pos_t,
+                                GroupKeyHash<join_key_t>,
+                                std::equal_to<join_key_t>,
+                                hash_map_allocator_t<join_key_t>> join_hash_map_t;
 
 // Single Keys
-typedef std::unordered_multimap<aggregate_single_key_t, pos_t, SingleGroupKeyHash<aggregate_single_key_t>>
-    aggregate_single_hash_map_t;
-typedef std::unordered_multimap<join_single_key_t, pos_t, SingleGroupKeyHash<join_single_key_t>> join_single_hash_map_t;
+typedef std::unordered_multimap<aggregate_single_key_t,
+                                pos_t,
+                                SingleGroupKeyHash<aggregate_single_key_t>,
+                                std::equal_to<aggregate_single_key_t>,
+                                hash_map_allocator_t<aggregate_single_key_t>> aggregate_single_hash_map_t;
+typedef std::unordered_multimap<join_single_key_t,
+                                pos_t,
+                                SingleGroupKeyHash<join_single_key_t>,
+                                std::equal_to<join_single_key_t>,
+                                hash_map_allocator_t<join_single_key_t>> join_single_hash_map_t;
 
 /// HashTable based on a map; key specifies the key for the given map
 template <class MAP, class KEY>
@@ -196,7 +217,9 @@ class HashTable : public AbstractHashTable, public std::enable_shared_from_this<
   HashTable() {}
 
   // create a new HashTable based on a number of HashTables
-  explicit HashTable(const std::vector<std::shared_ptr<const AbstractHashTable>>& hashTables) {
+  explicit HashTable(const std::vector<std::shared_ptr<const AbstractHashTable>>& hashTables,
+                     const std::shared_ptr<helper::QueryArena>& arena = nullptr)
+      : _map(typename map_t::allocator_type(arena)) {
     _dirty = true;
     for (auto& nextElement : hashTables) {
       const auto& ht = checked_pointer_cast<const HashTable<MAP, KEY>>(nextElement);
@@ -221,8 +244,12 @@ class HashTable : public AbstractHashTable, public std::enable_shared_from_this<
   // Hash given table's columns directly into the new HashTable
   // row_offset is used if t is a TableRangeView, so that the HashTable can build the pos_lists based on the row numbers
   // of the original table
-  HashTable(c_atable_ptr_t t, const field_list_t& f, size_t row_offset = 0)
-      : _table(t), _fields(f), _numKeys(0), _dirty(true) {
+  // An arena backs the entries of the map, it is kept alive as long as the HashTable
+  HashTable(c_atable_ptr_t t,
+            const field_list_t& f,
+            size_t row_offset = 0,
+            const std::shared_ptr<helper::QueryArena>& arena = nullptr)
+      : _map(typename map_t::allocator_type(arena)), _table(t), _fields(f), _numKeys(0), _dirty(true) {
     populate_map(row_offset);
   }
 
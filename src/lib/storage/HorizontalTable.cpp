@@ -5,13 +5,14 @@
 #include <cassert>
 #include <iostream>
 #include <iterator>
+#include <numeric>
 
 namespace hyrise {
 namespace storage {
 
 static std::vector<size_t> offsetsFromParts(const std::vector<c_atable_ptr_t>& parts) {
   std::vector<size_t> offsets(parts.size());
-  auto total_size = 0;
+  size_t total_size = 0;
   size_t i = 0;
   for (const auto& part : parts) {
     offsets[i++] = total_size;
@@ -31,14 +32,18 @@ static std::vector<table_id_t> tableIdOffsets(const std::vector<c_atable_ptr_t>&
 }
 
 HorizontalTable::HorizontalTable(std::vector<c_atable_ptr_t> parts)
-    : _parts(parts), _offsets(offsetsFromParts(_parts)), _table_id_offsets(tableIdOffsets(parts)) {
+    : _parts(parts),
+      _offsets(offsetsFromParts(_parts)),
+      _table_id_offsets(tableIdOffsets(parts)),
+      _size(computeSize()) {
   assert(_parts.size() != 0);
 }
 
 HorizontalTable::~HorizontalTable() = default;
 
 inline size_t HorizontalTable::partForRow(const size_t row) const {
-  auto r = std::find_if(std::begin(_offsets), std::end(_offsets), [=](size_t offset) { return offset > row; });
+  // chunked mains consist of many parts, so search the offsets instead of walking them
+  auto r = std::upper_bound(std::begin(_offsets), std::end(_offsets), row);
   return std::distance(std::begin(_offsets), r) - 1;
 }
 
@@ -66,7 +71,7 @@ void HorizontalTable::setDictionaryAt(adict_ptr_t dict,
   throw std::runtime_error("Cannot set dictionary for HorizontalTable");
 }
 
-size_t HorizontalTable::size() const { return computeSize(); }
+size_t HorizontalTable::size() const { return _size; }
 
 size_t HorizontalTable::columnCount() const { return _parts[0]->columnCount(); }
 
@@ -89,6 +94,15 @@ size_t HorizontalTable::partitionWidth(const size_t slice) const { return _parts
 
 atable_ptr_t HorizontalTable::copy() const { throw std::runtime_error("Not implemented"); }
 
+const attr_vectors_t HorizontalTable::getAttributeVectors(size_t column) const {
+  attr_vectors_t vectors;
+  for (const auto& p : _parts) {
+    const auto& part_vectors = p->getAttributeVectors(column);
+    vectors.insert(vectors.end(), part_vectors.begin(), part_vectors.end());
+  }
+  return vectors;
+}
+
 void HorizontalTable::debugStructure(size_t level) const {
   std::cout << std::string(level, '\t') << "HorizontalTable " << this << std::endl;
   for (const auto& p : _parts) {
@@ -104,7 +118,7 @@ void HorizontalTable::persist_scattered(const pos_list_t& elements, bool new_ele
 
 size_t HorizontalTable::computeSize() const {
   return std::accumulate(
-      _parts.begin(), _parts.end(), 0, [](size_t r, const c_atable_ptr_t& t) { return r + t->size(); });
+      _parts.begin(), _parts.end(), size_t(0), [](size_t r, const c_atable_ptr_t& t) { return r + t->size(); });
 }
 }
 }
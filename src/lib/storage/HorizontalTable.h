@@ -36,16 +36,22 @@ class HorizontalTable : public AbstractTable {
   size_t partitionWidth(size_t slice) const override;
   table_id_t subtableCount() const override;
   atable_ptr_t copy() const override;
+  const attr_vectors_t getAttributeVectors(size_t column) const override;
   void debugStructure(size_t level = 0) const override;
 
+  /// The parts in row order, e.g. the chunks of a chunked main
+  const std::vector<c_atable_ptr_t>& parts() const { return _parts; }
+
  private:
   size_t partForRow(size_t row) const;
   size_t computeSize() const;
   /// subtables
   const std::vector<c_atable_ptr_t> _parts;
+  /// Offset for each subtable
   const std::vector<size_t> _offsets;
   const std::vector<table_id_t> _table_id_offsets;
-  /// Offset for each subtable
+  /// Cached, the Store asks for the size of its main on every row access
+  const size_t _size;
 
   void persist_scattered(const pos_list_t& elements, bool new_elements = true) const override;
 };
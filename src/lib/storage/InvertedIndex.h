@@ -11,6 +11,7 @@
 #include "storage/storage_types.h"
 #include "storage/AbstractIndex.h"
 #include "storage/AbstractTable.h"
+#include "storage/PackedPositions.h"
 
 #include <unordered_map>
 #include <memory>
@@ -21,7 +22,7 @@ namespace storage {
 template <typename T>
 class InvertedIndex : public AbstractIndex {
  private:
-  using inverted_index_t = std::map<T, pos_list_t>;
+  using inverted_index_t = std::map<T, PackedPositions>;
   // using inverted_index_t = std::unordered_map<T, pos_list_t>;
   inverted_index_t _index;
 
@@ -29,7 +30,7 @@ class InvertedIndex : public AbstractIndex {
                                  const typename inverted_index_t::const_iterator end) {
     pos_list_t pos;
     while (begin != end) {
-      pos.insert(pos.end(), begin->second.begin(), begin->second.end());
+      begin->second.decode(0, begin->second.size(), pos);
       begin++;
     }
     std::sort(pos.begin(), pos.end());
@@ -39,10 +40,8 @@ class InvertedIndex : public AbstractIndex {
  public:
   virtual ~InvertedIndex() {};
 
-  void shrink() {
-    for (auto& e : _index)
-      e.second.shrink_to_fit();
-  };
+  // posting lists are packed to their exact size on construction
+  void shrink() {};
 
   void write_lock() {};
 
@@ -55,16 +54,12 @@ class InvertedIndex : public AbstractIndex {
   explicit InvertedIndex(const c_atable_ptr_t& in, field_t column, std::string id = "inverted_index")
       : AbstractIndex(id) {
     if (in != nullptr) {
+      std::map<T, pos_list_t> index;
       for (size_t row = 0; row < in->size(); ++row) {
-        T tmp = in->getValue<T>(column, row);
-        typename inverted_index_t::iterator find = _index.find(tmp);
-        if (find == _index.end()) {
-          pos_list_t pos;
-          pos.push_back(row);
-          _index[tmp] = pos;
-        } else {
-          find->second.push_back(row);
-        }
+        index[in->getValue<T>(column, row)].push_back(row);
+      }
+      for (const auto& entry : index) {
+        _index.emplace_hint(_index.end(), entry.first, PackedPositions(entry.second));
       }
     }
   };
@@ -73,13 +68,12 @@ class InvertedIndex : public AbstractIndex {
    * returns a list of positions where key was found.
    */
   pos_list_t getPositionsForKey(T key) {
+    pos_list_t pos;
     typename inverted_index_t::iterator it = _index.find(key);
     if (it != _index.end()) {
-      return it->second;
-    } else {
-      pos_list_t empty;
-      return empty;
+      it->second.decode(0, it->second.size(), pos);
     }
+    return pos;
   };
 
   pos_list_t getPositionsForKeyLT(T key) {
@@ -103,11 +97,6 @@ class InvertedIndex : public AbstractIndex {
   };
 
   bool exists(T key) const { return _index.count(key) > 0; }
-
-  const pos_list_t& getPositionsForKeyRef(T key) {
-    const auto& it = _index.find(key);
-    return it->second;
-  };
 };
 }
 }  // namespace hyrise::storage
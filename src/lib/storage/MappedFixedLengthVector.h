@@ -0,0 +1,90 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+
+#include "helper/MappedFile.h"
+#include "storage/FixedLengthVector.h"
+
+namespace hyrise {
+namespace storage {
+
+/**
+ * Read-only attribute vector whose values live directly in a memory
+ * mapped file, e.g. the raw value ids written by SimpleTableDump. It
+ * is only meant to back main partitions: all modifying operations
+ * throw, copy() materializes the values into a FixedLengthVector.
+ */
+template <typename T>
+class MappedFixedLengthVector final : public AbstractFixedLengthVector<T> {
+ public:
+  MappedFixedLengthVector(std::shared_ptr<helper::MappedFile> file, std::size_t columns, std::size_t rows)
+      : _file(file), _columns(columns), _rows(rows), _values(reinterpret_cast<const T*>(file->data())) {
+    if (_file->size() < _columns * _rows * sizeof(T)) {
+      throw std::runtime_error("Mapped file " + _file->path() + " is too small for the attribute vector");
+    }
+  }
+
+  T inc(size_t, size_t) override { throw std::runtime_error("Mapped attribute vectors are read-only"); }
+
+  virtual T get(size_t column, size_t row) const override { return getRef(column, row); }
+
+  virtual const T& getRef(size_t column, size_t row) const override {
+    check_access(column, row);
+    return _values[row * _columns + column];
+  }
+
+  virtual void set(size_t, size_t, T) override { throw std::runtime_error("Mapped attribute vectors are read-only"); }
+
+  virtual void reserve(size_t rows) override {
+    if (rows > _rows)
+      throw std::runtime_error("Mapped attribute vectors cannot grow");
+  }
+
+  virtual void resize(size_t rows) override {
+    if (rows != _rows)
+      throw std::runtime_error("Mapped attribute vectors cannot be resized");
+  }
+
+  virtual std::uint64_t capacity() override { return _rows; }
+
+  virtual std::uint64_t size() override { return _rows; }
+
+  size_t getColumns() const override { return _columns; }
+
+  virtual std::shared_ptr<BaseAttributeVector<T>> copy() override {
+    auto result = std::make_shared<FixedLengthVector<T>>(_columns, _rows);
+    for (size_t row = 0; row < _rows; ++row) {
+      for (size_t column = 0; column < _columns; ++column) {
+        result->set(column, row, getRef(column, row));
+      }
+    }
+    return result;
+  }
+
+  virtual void clear() override { throw std::runtime_error("Mapped attribute vectors are read-only"); }
+
+  virtual void rewriteColumn(const size_t, const size_t) override {}
+
+  const T* data() const { return _values; }
+
+ private:
+  void check_access(std::size_t columns, std::size_t rows) const {
+#ifdef EXPENSIVE_ASSERTIONS
+    if (columns >= _columns) {
+      throw std::out_of_range("Accessing column beyond boundaries");
+    }
+    if (rows >= _rows) {
+      throw std::out_of_range("Accessing row beyond boundaries");
+    }
+#endif
+  }
+
+  const std::shared_ptr<helper::MappedFile> _file;
+  const std::size_t _columns;
+  const std::size_t _rows;
+  const T* _values;
+};
+}
+}  // namespace hyrise::storage
@@ -0,0 +1,395 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <immintrin.h>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "helper/locking.h"
+#include "storage/storage_types.h"
+
+namespace hyrise {
+namespace storage {
+
+namespace detail {
+constexpr size_t btree_capacity(size_t available, size_t per_entry) {
+  return available / per_entry > 4 ? available / per_entry : 4;
+}
+}
+
+/*
+ * Insert-only B+-tree of (key, position) entries, ordered by key and then
+ * by position. Nodes span a few cache lines and carry a version counter
+ * for optimistic lock coupling: readers never take locks, they validate
+ * the version of every node they read and restart on a concurrent change.
+ * Writers only lock the nodes they modify. Full nodes are split eagerly
+ * on the way down, so a split never has to propagate upwards.
+ *
+ * Optimistic reads may observe a node while it is being modified, which
+ * is only harmless for trivial key types. Other key types (strings) fall
+ * back to a tree-wide reader/writer lock.
+ */
+template <typename K>
+class OptimisticBTree {
+ public:
+  struct entry_t {
+    K key;
+    pos_t pos;
+  };
+
+  static const bool optimistic = std::is_trivial<K>::value;
+
+ private:
+  static const size_t node_size = 1024;
+
+  struct Node {
+    // bit 1 is the lock bit, every unlock increments the version
+    std::atomic<uint64_t> version;
+    bool leaf;
+    uint16_t count;
+
+    explicit Node(bool is_leaf) : version(0), leaf(is_leaf), count(0) {}
+  };
+
+  struct Leaf : public Node {
+    static const size_t capacity = detail::btree_capacity(node_size - sizeof(Node) - sizeof(void*), sizeof(entry_t));
+    entry_t entries[capacity];
+    Leaf* next;
+
+    Leaf() : Node(true), next(nullptr) {}
+
+    size_t lowerBound(const entry_t& entry) const {
+      return std::lower_bound(entries, entries + this->count, entry, less) - entries;
+    }
+
+    void insert(const entry_t& entry) {
+      size_t position = lowerBound(entry);
+      std::copy_backward(entries + position, entries + this->count, entries + this->count + 1);
+      entries[position] = entry;
+      ++this->count;
+    }
+  };
+
+  struct Inner : public Node {
+    static const size_t capacity =
+        detail::btree_capacity(node_size - sizeof(Node) - sizeof(Node*), sizeof(entry_t) + sizeof(Node*));
+    // children[i] holds the entries in [keys[i - 1], keys[i])
+    entry_t keys[capacity];
+    Node* children[capacity + 1];
+
+    Inner() : Node(false) {}
+
+    size_t childIndex(const entry_t& entry) const {
+      return std::upper_bound(keys, keys + this->count, entry, less) - keys;
+    }
+
+    void insertChild(const entry_t& separator, Node* right) {
+      size_t position = childIndex(separator);
+      std::copy_backward(keys + position, keys + this->count, keys + this->count + 1);
+      std::copy_backward(children + position + 1, children + this->count + 1, children + this->count + 2);
+      keys[position] = separator;
+      children[position + 1] = right;
+      ++this->count;
+    }
+  };
+
+  std::atomic<Node*> _root;
+  std::atomic<size_t> _size;
+  RWMutex _mtx;
+
+  static bool less(const entry_t& a, const entry_t& b) {
+    return a.key < b.key || (!(b.key < a.key) && a.pos < b.pos);
+  }
+
+  static uint64_t readLock(const Node* node, bool& restart) {
+    uint64_t version = node->version.load(std::memory_order_acquire);
+    if (version & 2) {
+      _mm_pause();
+      restart = true;
+    }
+    return version;
+  }
+
+  static void validate(const Node* node, uint64_t version, bool& restart) {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (node->version.load(std::memory_order_relaxed) != version)
+      restart = true;
+  }
+
+  static void upgrade(Node* node, uint64_t version, bool& restart) {
+    if (!node->version.compare_exchange_strong(version, version + 2))
+      restart = true;
+  }
+
+  static void writeUnlock(Node* node) { node->version.fetch_add(2, std::memory_order_release); }
+
+  // Must hold the locks of parent and node, a null parent means node is the root
+  void split(Leaf* leaf, Inner* parent);
+  void split(Inner* inner, Inner* parent);
+
+  void linkSplit(Node* left, const entry_t& separator, Node* right, Inner* parent) {
+    if (parent) {
+      parent->insertChild(separator, right);
+    } else {
+      auto root = new Inner();
+      root->count = 1;
+      root->keys[0] = separator;
+      root->children[0] = left;
+      root->children[1] = right;
+      _root.store(root);
+    }
+  }
+
+  bool tryInsert(const entry_t& entry);
+
+  // Finds the leaf holding the first entry not less than entry, or the
+  // leftmost leaf for a null entry
+  bool findLeaf(const entry_t* entry, Leaf*& leaf, uint64_t& version) const;
+
+  template <typename F>
+  void scanOptimistic(const entry_t* from, F visit) const;
+
+  static void destroy(Node* node) {
+    if (node->leaf) {
+      delete static_cast<Leaf*>(node);
+    } else {
+      auto inner = static_cast<Inner*>(node);
+      for (size_t i = 0; i <= inner->count; ++i) {
+        destroy(inner->children[i]);
+      }
+      delete inner;
+    }
+  }
+
+ public:
+  OptimisticBTree() : _root(new Leaf()), _size(0) {}
+
+  ~OptimisticBTree() { destroy(_root.load()); }
+
+  OptimisticBTree(const OptimisticBTree&) = delete;
+  OptimisticBTree& operator=(const OptimisticBTree&) = delete;
+
+  void insert(const K& key, pos_t pos) {
+    entry_t entry{key, pos};
+    if (optimistic) {
+      while (!tryInsert(entry)) {
+      }
+    } else {
+      ExclusiveLock lock(_mtx);
+      while (!tryInsert(entry)) {
+      }
+    }
+    ++_size;
+  }
+
+  /*
+   * Calls visit(key, pos) for all entries in order, starting with the
+   * first entry not less than (key, pos), until visit returns false.
+   */
+  template <typename F>
+  void scan(const K& key, pos_t pos, F visit) const {
+    entry_t from{key, pos};
+    if (optimistic) {
+      scanOptimistic(&from, visit);
+    } else {
+      SharedLock lock(_mtx);
+      scanOptimistic(&from, visit);
+    }
+  }
+
+  // Same as scan, starting at the smallest entry
+  template <typename F>
+  void scanAll(F visit) const {
+    if (optimistic) {
+      scanOptimistic(nullptr, visit);
+    } else {
+      SharedLock lock(_mtx);
+      scanOptimistic(nullptr, visit);
+    }
+  }
+
+  size_t size() const { return _size.load(); }
+};
+
+template <typename K>
+void OptimisticBTree<K>::split(Leaf* leaf, Inner* parent) {
+  auto right = new Leaf();
+  size_t middle = leaf->count / 2;
+  std::copy(leaf->entries + middle, leaf->entries + leaf->count, right->entries);
+  right->count = leaf->count - middle;
+  right->next = leaf->next;
+  leaf->count = middle;
+  leaf->next = right;
+  linkSplit(leaf, right->entries[0], right, parent);
+}
+
+template <typename K>
+void OptimisticBTree<K>::split(Inner* inner, Inner* parent) {
+  auto right = new Inner();
+  size_t middle = inner->count / 2;
+  // the middle key moves up into the parent
+  entry_t separator = inner->keys[middle];
+  std::copy(inner->keys + middle + 1, inner->keys + inner->count, right->keys);
+  std::copy(inner->children + middle + 1, inner->children + inner->count + 1, right->children);
+  right->count = inner->count - middle - 1;
+  inner->count = middle;
+  linkSplit(inner, separator, right, parent);
+}
+
+template <typename K>
+bool OptimisticBTree<K>::tryInsert(const entry_t& entry) {
+  bool restart = false;
+  Node* node = _root.load();
+  uint64_t version = readLock(node, restart);
+  if (restart || node != _root.load())
+    return false;
+
+  Inner* parent = nullptr;
+  uint64_t parent_version = 0;
+
+  // Locks parent and node for a split, returns false if that failed
+  auto lockForSplit = [&]() {
+    if (parent) {
+      upgrade(parent, parent_version, restart);
+      if (restart)
+        return false;
+    }
+    upgrade(node, version, restart);
+    if (restart || (!parent && node != _root.load())) {
+      if (!restart)
+        writeUnlock(node);
+      if (parent)
+        writeUnlock(parent);
+      return false;
+    }
+    return true;
+  };
+
+  while (!node->leaf) {
+    auto inner = static_cast<Inner*>(node);
+    if (inner->count == Inner::capacity) {
+      if (lockForSplit()) {
+        split(inner, parent);
+        writeUnlock(inner);
+        if (parent)
+          writeUnlock(parent);
+      }
+      return false;
+    }
+
+    if (parent) {
+      validate(parent, parent_version, restart);
+      if (restart)
+        return false;
+    }
+
+    parent = inner;
+    parent_version = version;
+
+    node = inner->children[inner->childIndex(entry)];
+    validate(inner, version, restart);
+    if (restart)
+      return false;
+    version = readLock(node, restart);
+    if (restart)
+      return false;
+  }
+
+  auto leaf = static_cast<Leaf*>(node);
+  if (leaf->count == Leaf::capacity) {
+    if (lockForSplit()) {
+      split(leaf, parent);
+      writeUnlock(leaf);
+      if (parent)
+        writeUnlock(parent);
+    }
+    return false;
+  }
+
+  upgrade(leaf, version, restart);
+  if (restart)
+    return false;
+  if (parent) {
+    validate(parent, parent_version, restart);
+    if (restart) {
+      writeUnlock(leaf);
+      return false;
+    }
+  }
+  leaf->insert(entry);
+  writeUnlock(leaf);
+  return true;
+}
+
+template <typename K>
+bool OptimisticBTree<K>::findLeaf(const entry_t* entry, Leaf*& leaf, uint64_t& version) const {
+  bool restart = false;
+  Node* node = _root.load();
+  version = readLock(node, restart);
+  if (restart || node != _root.load())
+    return false;
+
+  while (!node->leaf) {
+    auto inner = static_cast<const Inner*>(node);
+    Node* child = inner->children[entry ? inner->childIndex(*entry) : 0];
+    validate(inner, version, restart);
+    if (restart)
+      return false;
+    node = child;
+    version = readLock(node, restart);
+    if (restart)
+      return false;
+  }
+  leaf = static_cast<Leaf*>(node);
+  return true;
+}
+
+template <typename K>
+template <typename F>
+void OptimisticBTree<K>::scanOptimistic(const entry_t* from, F visit) const {
+  std::vector<entry_t> buffer;
+  buffer.reserve(Leaf::capacity);
+
+  // After a restart, continue right behind the last visited entry
+  entry_t resume;
+  bool has_resume = from != nullptr;
+  if (has_resume)
+    resume = *from;
+
+  while (true) {
+    Leaf* leaf;
+    uint64_t version;
+    if (!findLeaf(has_resume ? &resume : nullptr, leaf, version))
+      continue;
+
+    bool first_leaf = true;
+    bool restart = false;
+    while (!restart) {
+      size_t begin = (first_leaf && has_resume) ? leaf->lowerBound(resume) : 0;
+      buffer.assign(leaf->entries + begin, leaf->entries + std::max<size_t>(begin, leaf->count));
+      Leaf* next = leaf->next;
+      validate(leaf, version, restart);
+      if (restart)
+        break;
+
+      for (const auto& entry : buffer) {
+        if (!visit(entry.key, entry.pos))
+          return;
+        resume = {entry.key, entry.pos + 1};
+        has_resume = true;
+      }
+
+      if (next == nullptr)
+        return;
+      version = readLock(next, restart);
+      leaf = next;
+      first_leaf = false;
+    }
+  }
+}
+}
+}  // namespace hyrise::storage
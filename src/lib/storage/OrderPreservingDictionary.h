@@ -10,6 +10,7 @@
 #include "storage/BaseDictionary.h"
 #include "storage/BaseIterator.h"
 #include "storage/DictionaryIterator.h"
+#include "storage/FrontCodedStringVector.h"
 #include "storage/storage_types.h"
 
 namespace hyrise {
@@ -46,6 +47,10 @@ class OrderPreservingDictionary : public BaseDictionary<T> {
 
   void shrink() { _values->shrink_to_fit(); }
 
+  void setMemoryPolicy(const helper::MemoryPolicy& policy) override {
+    policy.apply(_values->data(), _values->capacity() * sizeof(T));
+  }
+
   /**
    * Return value of given value id
    *
@@ -118,6 +123,15 @@ class OrderPreservingDictionary : public BaseDictionary<T> {
 
   void reserve(size_t size) { _values->reserve(size); }
 
+  /**
+   * Replace all values with the sorted range [first, last) in one go,
+   * used for bulk loading instead of repeated addValue calls.
+   */
+  template <typename InputIterator>
+  void assign(InputIterator first, InputIterator last) {
+    _values->assign(first, last);
+  }
+
   size_t size() { return _values->size(); }
 
   std::shared_ptr<AbstractDictionary> copy() { throw std::runtime_error("Dictionaries cannot be copied"); }
@@ -172,5 +186,172 @@ class OrderPreservingDictionaryIterator : public BaseIterator<T> {
 
   value_id_t getValueId() const { return _index; }
 };
+
+
+/*
+ * Iterator over a front-coded string dictionary, decodes the values
+ * sequentially and keeps the current one.
+ */
+template <>
+class OrderPreservingDictionaryIterator<hyrise_string_t> : public BaseIterator<hyrise_string_t> {
+ public:
+  typedef std::shared_ptr<FrontCodedStringVector> vector_type;
+
+  vector_type _values;
+  size_t _index;
+  size_t _offset;
+  mutable hyrise_string_t _current;
+
+  OrderPreservingDictionaryIterator(const vector_type& values, size_t index)
+      : _values(values), _index(index), _offset(0) {
+    if (_index < _values->size())
+      _offset = _values->seek(_index, _current);
+  }
+
+  virtual ~OrderPreservingDictionaryIterator() {}
+
+  void increment() {
+    if (++_index < _values->size())
+      _offset = _values->next(_offset, _current);
+  }
+
+  bool equal(const std::shared_ptr<BaseIterator<hyrise_string_t>>& other) const {
+    auto it = std::dynamic_pointer_cast<OrderPreservingDictionaryIterator<hyrise_string_t>>(other);
+    return _values.get() == it->_values.get() && _index == it->_index;
+  }
+
+  hyrise_string_t& dereference() const { return _current; }
+
+  value_id_t getValueId() const { return _index; }
+};
+
+
+/*
+ * Strings are the bulk of most dictionaries, so instead of one heap
+ * allocated std::string per value they are front-coded into a single
+ * buffer. Lookups binary search over the block heads and decode a single
+ * block. Values are not addressable anymore, getValueList() and
+ * swapValues() materialize them.
+ */
+template <>
+class OrderPreservingDictionary<hyrise_string_t> : public BaseDictionary<hyrise_string_t> {
+ public:
+  typedef std::vector<hyrise_string_t> vector_type;
+  typedef std::shared_ptr<vector_type> shared_vector_type;
+
+ private:
+  std::shared_ptr<FrontCodedStringVector> _values;
+
+ public:
+  OrderPreservingDictionary() : _values(std::make_shared<FrontCodedStringVector>()) {}
+
+  explicit OrderPreservingDictionary(size_t size) : _values(std::make_shared<FrontCodedStringVector>()) {
+    _values->reserve(size);
+  }
+
+  virtual ~OrderPreservingDictionary() {}
+
+  void shrink() { _values->shrink_to_fit(); }
+
+  void setMemoryPolicy(const helper::MemoryPolicy& policy) override { _values->setMemoryPolicy(policy); }
+
+  value_id_t addValue(hyrise_string_t value) {
+#ifdef EXPENSIVE_ASSERTIONS
+    if (!_values->empty() && (value <= _values->back()))
+      throw std::runtime_error("Can't insert value smaller or equal to last value");
+#endif
+    _values->push_back(value);
+    return _values->size() - 1;
+  }
+
+  hyrise_string_t getValueForValueId(value_id_t value_id) {
+#ifdef EXPENSIVE_ASSERTIONS
+    if (value_id >= _values->size())
+      throw std::out_of_range("Trying to access value_id larger than available values");
+#endif
+    return _values->at(value_id);
+  }
+
+  value_id_t getValueIdForValue(const hyrise_string_t& value) const { return _values->lower_bound(value); }
+
+  value_id_t findValueIdForValue(const hyrise_string_t& value) const {
+    value_id_t value_id = _values->lower_bound(value);
+    if (value_id != _values->size() && _values->at(value_id) == value) {
+      return value_id;
+    } else {
+      return std::numeric_limits<value_id_t>::max();
+    }
+  }
+
+  value_id_t getLowerBoundValueIdForValue(hyrise_string_t other) { return _values->lower_bound(other); }
+
+  value_id_t getUpperBoundValueIdForValue(hyrise_string_t other) { return _values->upper_bound(other); }
+
+  const hyrise_string_t getSmallestValue() {
+    assert(_values->size() > 0);
+    return _values->at(0);
+  }
+
+  const hyrise_string_t getGreatestValue() {
+    assert(_values->size() > 0);
+    return _values->back();
+  }
+
+  bool isValueIdValid(value_id_t value_id) { return value_id < _values->size(); }
+
+  bool valueExists(const hyrise_string_t& value) const {
+    return findValueIdForValue(value) != std::numeric_limits<value_id_t>::max();
+  }
+
+  void reserve(size_t size) { _values->reserve(size); }
+
+  template <typename InputIterator>
+  void assign(InputIterator first, InputIterator last) {
+    _values->clear();
+    for (; first != last; ++first) {
+      _values->push_back(*first);
+    }
+  }
+
+  size_t size() { return _values->size(); }
+
+  std::shared_ptr<AbstractDictionary> copy() { throw std::runtime_error("Dictionaries cannot be copied"); }
+
+  std::shared_ptr<AbstractDictionary> copy_empty() {
+    return std::make_shared<OrderPreservingDictionary<hyrise_string_t>>();
+  }
+
+  bool isOrdered() { return true; }
+
+  typedef DictionaryIterator<hyrise_string_t> iterator;
+
+  iterator begin() {
+    return iterator(std::make_shared<OrderPreservingDictionaryIterator<hyrise_string_t>>(_values, 0));
+  }
+
+  iterator end() {
+    return iterator(std::make_shared<OrderPreservingDictionaryIterator<hyrise_string_t>>(_values, _values->size()));
+  }
+
+  shared_vector_type getValueList() const {
+    auto values = std::make_shared<vector_type>();
+    values->reserve(_values->size());
+    std::string current;
+    size_t offset = 0;
+    for (size_t i = 0; i < _values->size(); ++i) {
+      offset = i == 0 ? _values->seek(0, current) : _values->next(offset, current);
+      values->push_back(current);
+    }
+    return values;
+  }
+
+  void swapValues(vector_type& new_values) {
+    auto old_values = getValueList();
+    assign(new_values.begin(), new_values.end());
+    std::swap(*old_values, new_values);
+  }
+
+  size_t memoryUsage() const { return _values->memoryUsage(); }
+};
 }
 }  // namespace hyrise::storage
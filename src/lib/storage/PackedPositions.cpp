@@ -0,0 +1,50 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "storage/PackedPositions.h"
+
+#include <algorithm>
+
+namespace hyrise {
+namespace storage {
+
+PackedPositions::PackedPositions(const pos_list_t& positions) : _bits(1), _size(positions.size()) {
+  pos_t max_position = positions.empty() ? 0 : *std::max_element(positions.begin(), positions.end());
+  if (max_position > 0)
+    _bits = 64 - __builtin_clzll(max_position);
+
+  _data.resize((_size * _bits + 63) / 64);
+  size_t bit = 0;
+  for (const auto& position : positions) {
+    size_t word = bit / 64;
+    size_t offset = bit % 64;
+    _data[word] |= static_cast<uint64_t>(position) << offset;
+    if (offset + _bits > 64)
+      _data[word + 1] = static_cast<uint64_t>(position) >> (64 - offset);
+    bit += _bits;
+  }
+}
+
+void PackedPositions::decode(size_t begin, size_t end, pos_list_t& out) const {
+  if (begin >= end)
+    return;
+
+  out.reserve(out.size() + end - begin);
+  const uint64_t value_mask = mask();
+  size_t bit = begin * _bits;
+  const uint64_t* word = _data.data() + bit / 64;
+  size_t offset = bit % 64;
+
+  // walk the words sequentially instead of recomputing the location of every value
+  for (size_t i = begin; i < end; ++i) {
+    uint64_t value = *word >> offset;
+    offset += _bits;
+    if (offset >= 64) {
+      ++word;
+      offset -= 64;
+      if (offset > 0)
+        value |= *word << (_bits - offset);
+    }
+    out.push_back(value & value_mask);
+  }
+}
+}
+}  // namespace hyrise::storage
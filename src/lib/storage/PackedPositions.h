@@ -0,0 +1,85 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <boost/iterator/iterator_facade.hpp>
+
+#include <cereal/types/vector.hpp>
+
+#include "storage/storage_types.h"
+
+namespace hyrise {
+namespace storage {
+
+/*
+ * Read-only list of positions, bit-packed with the width of the largest
+ * position. Used for the posting lists of the main indices, where 64 bit
+ * per position would often exceed the size of the indexed column.
+ */
+class PackedPositions {
+ public:
+  class const_iterator
+      : public boost::iterator_facade<const_iterator, pos_t, boost::random_access_traversal_tag, pos_t> {
+   public:
+    const_iterator() : _positions(nullptr), _index(0) {}
+    const_iterator(const PackedPositions* positions, size_t index) : _positions(positions), _index(index) {}
+
+   private:
+    friend class boost::iterator_core_access;
+
+    pos_t dereference() const { return _positions->get(_index); }
+    bool equal(const const_iterator& other) const { return _index == other._index; }
+    void increment() { ++_index; }
+    void decrement() { --_index; }
+    void advance(std::ptrdiff_t n) { _index += n; }
+    std::ptrdiff_t distance_to(const const_iterator& other) const { return other._index - _index; }
+
+    const PackedPositions* _positions;
+    size_t _index;
+  };
+
+  PackedPositions() : _bits(1), _size(0) {}
+
+  explicit PackedPositions(const pos_list_t& positions);
+
+  pos_t get(size_t index) const {
+    size_t bit = index * _bits;
+    size_t word = bit / 64;
+    size_t offset = bit % 64;
+    uint64_t value = _data[word] >> offset;
+    if (offset + _bits > 64)
+      value |= _data[word + 1] << (64 - offset);
+    return value & mask();
+  }
+
+  pos_t operator[](size_t index) const { return get(index); }
+
+  // Appends the positions in [begin, end) to out
+  void decode(size_t begin, size_t end, pos_list_t& out) const;
+
+  size_t size() const { return _size; }
+
+  size_t bits() const { return _bits; }
+
+  const_iterator begin() const { return const_iterator(this, 0); }
+
+  const_iterator end() const { return const_iterator(this, _size); }
+
+  size_t memoryUsage() const { return _data.capacity() * sizeof(uint64_t); }
+
+  template <class Archive>
+  void serialize(Archive& ar) {
+    ar(_bits, _size, _data);
+  }
+
+ private:
+  uint64_t mask() const { return _bits == 64 ? ~0ull : (1ull << _bits) - 1; }
+
+  uint64_t _bits;
+  uint64_t _size;
+  std::vector<uint64_t> _data;
+};
+}
+}  // namespace hyrise::storage
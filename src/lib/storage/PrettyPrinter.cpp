@@ -116,9 +116,9 @@ void PrettyPrinter::special_print(const Store* store,
     for (size_t column = 0; column < columns; ++column) {
       tp << generateValue(store, column, row);
     }
-    writeTid(tp, store->_tidVector[row]);
-    writeCid(tp, store->_cidBeginVector[row]);
-    writeCid(tp, store->_cidEndVector[row]);
+    writeTid(tp, store->tid(row));
+    writeCid(tp, store->getBeginCid(row));
+    writeCid(tp, store->getEndCid(row));
   }
   tp.printFooter();
 }
@@ -0,0 +1,101 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "storage/BaseAttributeVector.h"
+#include "storage/storage_types.h"
+
+namespace hyrise {
+namespace storage {
+
+/*
+ * Read-only, single column attribute vector that stores runs of equal
+ * values as (value, end row) pairs. Meant for sorted or low cardinality
+ * main columns, it is built once at merge time by appending the values in
+ * row order. Accessing a row is a binary search over the run ends, scans
+ * and aggregates can work on whole runs through forEachRun.
+ */
+template <typename T>
+class RunLengthVector final : public BaseAttributeVector<T> {
+ public:
+  RunLengthVector() {}
+
+  // Appends value as the next row
+  void push_back(T value) {
+    if (!_values.empty() && _values.back() == value) {
+      ++_ends.back();
+    } else {
+      _values.push_back(value);
+      _ends.push_back(rows() + 1);
+    }
+  }
+
+  T get(size_t column, size_t row) const override { return _values[runIndex(row)]; }
+
+  void set(size_t column, size_t row, T value) override {
+    throw std::runtime_error("RunLengthVector is read-only");
+  }
+
+  void reserve(size_t rows) override {}
+
+  void resize(size_t rows) override {
+    if (rows != this->rows())
+      throw std::runtime_error("RunLengthVector cannot be resized");
+  }
+
+  uint64_t capacity() override { return rows(); }
+
+  void clear() override {
+    _values.clear();
+    _ends.clear();
+  }
+
+  size_t size() override { return rows(); }
+
+  size_t rows() const { return _ends.empty() ? 0 : _ends.back(); }
+
+  size_t getColumns() const override { return 1; }
+
+  std::shared_ptr<BaseAttributeVector<T>> copy() override { return std::make_shared<RunLengthVector<T>>(*this); }
+
+  void rewriteColumn(const size_t column, const size_t bits) override {}
+
+  void shrink_to_fit() {
+    _values.shrink_to_fit();
+    _ends.shrink_to_fit();
+  }
+
+  size_t runCount() const { return _values.size(); }
+
+  // Index of the run that contains row
+  size_t runIndex(size_t row) const { return std::upper_bound(_ends.begin(), _ends.end(), row) - _ends.begin(); }
+
+  T runValue(size_t run) const { return _values[run]; }
+
+  pos_t runBegin(size_t run) const { return run == 0 ? 0 : _ends[run - 1]; }
+
+  pos_t runEnd(size_t run) const { return _ends[run]; }
+
+  // Calls f(value, length) for the runs covering [begin, end), clipped to that range
+  template <typename F>
+  void forEachRun(size_t begin, size_t end, F f) const {
+    for (size_t run = runIndex(begin); begin < end; ++run) {
+      size_t run_end = std::min<size_t>(_ends[run], end);
+      f(_values[run], run_end - begin);
+      begin = run_end;
+    }
+  }
+
+  size_t memoryUsage() const { return _values.capacity() * sizeof(T) + _ends.capacity() * sizeof(pos_t); }
+
+ private:
+  std::vector<T> _values;
+  // exclusive end row of each run
+  std::vector<pos_t> _ends;
+};
+}
+}  // namespace hyrise::storage
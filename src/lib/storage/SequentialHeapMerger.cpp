@@ -1,16 +1,47 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "storage/SequentialHeapMerger.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
 #include <queue>
 
 #include "helper/vector_helpers.h"
 #include "storage/DictionaryIterator.h"
 #include "storage/ColumnMetadata.h"
 #include "storage/DictionaryFactory.h"
+#include "storage/FrameOfReferenceDictionary.h"
+#include "taskscheduler/SharedScheduler.h"
 
 namespace hyrise {
 namespace storage {
 
+namespace {
+// Columns whose dictionaries are still to be merged, shared with the scheduled tasks
+struct DictionaryMergeState {
+  explicit DictionaryMergeState(size_t columns) : columns(columns) {}
+
+  const size_t columns;
+  std::atomic<size_t> next_column{0};
+  size_t merged_columns = 0;
+  std::mutex mutex;
+  std::condition_variable merged;
+};
+
+class DictionaryMergeTask : public taskscheduler::Task {
+ public:
+  explicit DictionaryMergeTask(std::function<void()> merge) : _merge(merge) {}
+  virtual void operator()() { _merge(); }
+  const std::string vname() { return "DictionaryMergeTask"; }
+
+ private:
+  std::function<void()> _merge;
+};
+}
+
 void SequentialHeapMerger::mergeValues(const std::vector<c_atable_ptr_t>& input_tables,
                                        atable_ptr_t merged_table,
                                        const column_mapping_t& column_mapping,
@@ -23,36 +54,81 @@ void SequentialHeapMerger::mergeValues(const std::vector<c_atable_ptr_t>& input_
 
   std::vector<value_id_mapping_t> mappingPerAtrtibute(input_tables[0]->columnCount());
 
-  for (const auto& kv : column_mapping) {
-    const auto& source = kv.first;
-    const auto& destination = kv.second;
-    switch (merged_table->metadataAt(destination).getType()) {
-      case IntegerType:
-      case IntegerTypeDelta:
-      case IntegerTypeDeltaConcurrent:
-        mergeValues<hyrise_int_t>(
-            input_tables, source, merged_table, destination, mappingPerAtrtibute[source], useValid, valid);
-        break;
-
-      case FloatType:
-      case FloatTypeDelta:
-      case FloatTypeDeltaConcurrent:
-        mergeValues<hyrise_float_t>(
-            input_tables, source, merged_table, destination, mappingPerAtrtibute[source], useValid, valid);
-        break;
-
-      case StringType:
-      case StringTypeDelta:
-      case StringTypeDeltaConcurrent:
-        mergeValues<hyrise_string_t>(
-            input_tables, source, merged_table, destination, mappingPerAtrtibute[source], useValid, valid);
-        break;
-      case IntegerNoDictType:
-      case FloatNoDictType:
-        merged_table->setDictionaryAt(makeDictionary(merged_table->typeOfColumn(destination)), destination);
-      default:
-        break;
+  // The dictionaries of the columns are independent of each other and merged
+  // in parallel. Setting them rewrites the attribute vectors that the columns
+  // of a partition share, so this happens afterwards.
+  std::vector<std::pair<size_t, size_t>> columns(column_mapping.begin(), column_mapping.end());
+  std::vector<adict_ptr_t> new_dicts(columns.size());
+  std::vector<std::exception_ptr> errors(columns.size());
+
+  auto merge_dictionary = [&](size_t i) {
+    const auto& source = columns[i].first;
+    const auto& destination = columns[i].second;
+    try {
+      switch (merged_table->metadataAt(destination).getType()) {
+        case IntegerType:
+        case IntegerTypeDelta:
+        case IntegerTypeDeltaConcurrent:
+          new_dicts[i] = mergeDictionary<hyrise_int_t>(
+              input_tables, source, merged_table, destination, mappingPerAtrtibute[source], useValid, valid);
+          break;
+
+        case FloatType:
+        case FloatTypeDelta:
+        case FloatTypeDeltaConcurrent:
+          new_dicts[i] = mergeDictionary<hyrise_float_t>(
+              input_tables, source, merged_table, destination, mappingPerAtrtibute[source], useValid, valid);
+          break;
+
+        case StringType:
+        case StringTypeDelta:
+        case StringTypeDeltaConcurrent:
+          new_dicts[i] = mergeDictionary<hyrise_string_t>(
+              input_tables, source, merged_table, destination, mappingPerAtrtibute[source], useValid, valid);
+          break;
+        case IntegerNoDictType:
+        case FloatNoDictType:
+          new_dicts[i] = makeDictionary(merged_table->typeOfColumn(destination));
+        default:
+          break;
+      }
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  };
+
+  // Tasks only touch the locals of this merge for the columns they claim, the
+  // merging thread waits for those. Tasks that start late find no column left.
+  auto state = std::make_shared<DictionaryMergeState>(columns.size());
+  std::function<void()> merge_dictionaries = [state, merge_dictionary]() {
+    for (size_t i = state->next_column++; i < state->columns; i = state->next_column++) {
+      merge_dictionary(i);
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (++state->merged_columns == state->columns)
+        state->merged.notify_all();
     }
+  };
+
+  // The merging thread takes part itself, so the merge also finishes when no worker is free
+  auto& shared_scheduler = taskscheduler::SharedScheduler::getInstance();
+  if (shared_scheduler.isInitialized()) {
+    auto scheduler = shared_scheduler.getScheduler();
+    size_t task_count = std::min(columns.size(), scheduler->getNumberOfWorker());
+    for (size_t t = 1; t < task_count; ++t) {
+      scheduler->schedule(std::make_shared<DictionaryMergeTask>(merge_dictionaries));
+    }
+  }
+  merge_dictionaries();
+  {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->merged.wait(lock, [&state]() { return state->merged_columns == state->columns; });
+  }
+
+  for (size_t i = 0; i < columns.size(); ++i) {
+    if (errors[i])
+      std::rethrow_exception(errors[i]);
+    if (new_dicts[i])
+      merged_table->setDictionaryAt(new_dicts[i], columns[i].second);
   }
 
   merged_table->resize(newSize);
@@ -67,13 +143,13 @@ void SequentialHeapMerger::mergeValues(const std::vector<c_atable_ptr_t>& input_
 }
 
 template <typename T>
-void SequentialHeapMerger::mergeValues(const std::vector<c_atable_ptr_t>& input_tables,
-                                       size_t source_column_index,
-                                       atable_ptr_t merged_table,
-                                       size_t destination_column_index,
-                                       value_id_mapping_t& value_id_mapping,
-                                       bool useValid,
-                                       const std::vector<bool>& valid) {
+adict_ptr_t SequentialHeapMerger::mergeDictionary(const std::vector<c_atable_ptr_t>& input_tables,
+                                                  size_t source_column_index,
+                                                  const c_atable_ptr_t& merged_table,
+                                                  size_t destination_column_index,
+                                                  value_id_mapping_t& value_id_mapping,
+                                                  bool useValid,
+                                                  const std::vector<bool>& valid) {
 
   std::vector<adict_ptr_t> value_id_maps;
   adict_ptr_t new_dict;
@@ -92,8 +168,7 @@ void SequentialHeapMerger::mergeValues(const std::vector<c_atable_ptr_t>& input_
 
   // Create new BaseDictionary - shrink when merge finished?
   new_dict = createNewDict<T>(input_tables, value_id_maps, value_id_mapping, source_column_index, useValid, valid);
-  // set new value id map for column
-  merged_table->setDictionaryAt(new_dict, destination_column_index);
+  return new_dict;
 }
 
 
@@ -209,6 +284,16 @@ adict_ptr_t SequentialHeapMerger::createNewDict(const std::vector<c_atable_ptr_t
   }
 
   new_dict->shrink();
+
+  // Dense unique integers do without a dictionary, the value ids become offsets to the smallest value
+  size_t rows = useValid ? std::count(valid.begin(), valid.end(), true) : part_counter;
+  if (auto reference = create_frame_of_reference_dictionary<T>(*new_dict, rows)) {
+    for (auto& mapping : value_id_mapping) {
+      for (auto& value_id : mapping)
+        value_id = reference->getValueIdForValue(new_dict->getValueForValueId(value_id));
+    }
+    return reference;
+  }
   return new_dict;
 }
 
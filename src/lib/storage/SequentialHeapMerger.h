@@ -21,14 +21,15 @@ class SequentialHeapMerger : public AbstractMerger {
  private:
   typedef std::vector<std::vector<value_id_t> > value_id_mapping_t;
 
+  // Merges the dictionaries of one column, safe to call for different columns in parallel
   template <typename T>
-  void mergeValues(const std::vector<c_atable_ptr_t>& input_tables,
-                   size_t source_column_index,
-                   atable_ptr_t merged_table,
-                   size_t destination_column,
-                   value_id_mapping_t& mapping,
-                   bool useValid,
-                   const std::vector<bool>& valid);
+  adict_ptr_t mergeDictionary(const std::vector<c_atable_ptr_t>& input_tables,
+                              size_t source_column_index,
+                              const c_atable_ptr_t& merged_table,
+                              size_t destination_column,
+                              value_id_mapping_t& mapping,
+                              bool useValid,
+                              const std::vector<bool>& valid);
 
 
   void copyValues(const std::vector<c_atable_ptr_t>& input_tables,
@@ -1,13 +1,16 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include <storage/Store.h>
+#include <algorithm>
 #include <iostream>
 #include <map>
+#include <numeric>
 
 #include <io/TransactionManager.h>
 #include <io/StorageManager.h>
 #include <storage/storage_types.h>
 #include <storage/PrettyPrinter.h>
 #include <storage/DeltaIndex.h>
+#include <storage/HorizontalTable.h>
 #include <storage/meta_storage.h>
 #include <storage/storage_types.h>
 
@@ -15,10 +18,13 @@
 #include <helper/locking.h>
 #include <helper/cas.h>
 
+#include "storage/AttributeVectorFactory.h"
 #include "storage/DictionaryFactory.h"
 #include "storage/ConcurrentUnorderedDictionary.h"
 #include "storage/ConcurrentFixedLengthVector.h"
 #include "storage/CompoundValueKeyBuilder.h"
+#include "storage/FixedLengthVector.h"
+#include "storage/MutableVerticalTable.h"
 
 
 #define DELTA_SIZE_DEFAULT_MAX 10000000
@@ -31,6 +37,46 @@ TableMerger* createDefaultMerger() {
   return new TableMerger(new DefaultMergeStrategy, new SequentialHeapMerger, false);
 }
 
+namespace {
+// Picks the encoding of every column of a newly merged chunk, as the ColumnStoreMerger does. Encoded
+// vectors hold a single column, so a chunk with an encoded column becomes vertically partitioned.
+atable_ptr_t encodeMergedChunk(const atable_ptr_t& chunk) {
+  if (!std::dynamic_pointer_cast<Table>(chunk))
+    return chunk;
+
+  std::vector<baseattr_ptr_tr> encoded(chunk->columnCount());
+  bool anyEncoded = false;
+  for (size_t column = 0; column < chunk->columnCount(); ++column) {
+    if (chunk->typeOfColumn(column) == IntegerNoDictType || chunk->typeOfColumn(column) == FloatNoDictType)
+      continue;
+    const auto& attr = chunk->getAttributeVectors(column)[0];
+    auto vector = std::dynamic_pointer_cast<BaseAttributeVector<value_id_t>>(attr.attribute_vector);
+    encoded[column] =
+        create_encoded_attribute_vector(vector, attr.attribute_offset, chunk->dictionaryAt(column)->size());
+    anyEncoded = anyEncoded || encoded[column];
+  }
+  if (!anyEncoded)
+    return chunk;
+
+  std::vector<atable_ptr_t> columns;
+  for (size_t column = 0; column < chunk->columnCount(); ++column) {
+    auto vector = encoded[column];
+    if (!vector) {
+      const auto& attr = chunk->getAttributeVectors(column)[0];
+      auto source = std::dynamic_pointer_cast<BaseAttributeVector<value_id_t>>(attr.attribute_vector);
+      auto plain = std::make_shared<FixedLengthVector<value_id_t>>(1, chunk->size());
+      for (size_t row = 0; row < chunk->size(); ++row)
+        plain->set(0, row, source->get(attr.attribute_offset, row));
+      vector = plain;
+    }
+    columns.push_back(std::make_shared<Table>(std::vector<ColumnMetadata>{chunk->metadataAt(column)},
+                                              vector,
+                                              std::vector<adict_ptr_t>{chunk->dictionaryAt(column)}));
+  }
+  return std::make_shared<MutableVerticalTable>(columns);
+}
+}
+
 Store::Store() : merger(createDefaultMerger()) { setUuid(); }
 
 namespace {
@@ -45,32 +91,21 @@ Store::Store(atable_ptr_t main_table)
     : _delta_size(0),
       _main_table(main_table),
       merger(createDefaultMerger()),
-      delta(main_table->copy_structure(create_concurrent_dict, create_concurrent_storage)),
-      _cidBeginVector(main_table->size(), 0),
-      _cidEndVector(main_table->size(), tx::INF_CID),
-      _tidVector(main_table->size(), tx::UNKNOWN) {
+      delta(main_table->copy_structure(create_concurrent_dict, create_concurrent_storage)) {
   setUuid();
-  _main_pos_list.reserve(main_table->size());
-  for (size_t i = 0; i < _main_table->size(); i++) {
-    _main_pos_list.push_back(i);
-  }
+  std::lock_guard<std::mutex> lock(_statistics_mutex);
+  updateMainStatistics();
 }
 
 Store::Store(const std::string& tableName, atable_ptr_t main_table)
     : _delta_size(0),
       _main_table(main_table),
       merger(createDefaultMerger()),
-      delta(main_table->copy_structure(create_concurrent_dict, create_concurrent_storage)),
-      _cidBeginVector(main_table->size(), 0),
-      _cidEndVector(main_table->size(), tx::INF_CID),
-      _tidVector(main_table->size(), tx::UNKNOWN),
-      _main_dirty(false) {
+      delta(main_table->copy_structure(create_concurrent_dict, create_concurrent_storage)) {
   setUuid();
   setName(tableName);
-  _main_pos_list.reserve(main_table->size());
-  for (size_t i = 0; i < _main_table->size(); i++) {
-    _main_pos_list.push_back(i);
-  }
+  std::lock_guard<std::mutex> lock(_statistics_mutex);
+  updateMainStatistics();
 }
 
 
@@ -87,37 +122,63 @@ void Store::merge() {
   if (loggingEnabled())
     new_delta->enableLogging();
 
-  // Prepare the merge
-  std::vector<c_atable_ptr_t> tmp{_main_table, delta};
+  // Prepare the merge, a chunked main takes part with each of its chunks
+  std::vector<c_atable_ptr_t> tmp;
+  if (auto chunked = std::dynamic_pointer_cast<HorizontalTable>(_main_table))
+    tmp = chunked->parts();
+  else
+    tmp.push_back(_main_table);
+  tmp.push_back(delta);
 
   // get valid positions
-  std::vector<bool> validPositions(_cidBeginVector.size());
+  const size_t main_size = _main_table->size();
+  const size_t store_size = main_size + _cidBeginVector.size();
+  std::vector<bool> validPositions(store_size);
   tx::transaction_cid_t last_commit_id = tx::TransactionManager::getInstance().getLastCommitId();
-  functional::forEachWithIndex(_cidBeginVector, [&](size_t i, bool v) {
-    validPositions[i] = isVisibleForTransaction(i, last_commit_id, tx::MERGE_TID);
-  });
+  for (size_t i = 0; i < store_size; ++i) {
+    validPositions[i] = isVisible(i, main_size, last_commit_id, tx::MERGE_TID);
+  }
 
   auto tables = merger->merge(tmp, true, validPositions, getName());
-  assert(tables.size() == 1);
-  _main_table = tables.front();
+  assert(!tables.empty());
+  tables.back() = encodeMergedChunk(tables.back());
+
+  // Chunks the merge strategy kept come first and keep their positions and
+  // MVCC state, all other rows are part of the newly merged chunk, which is
+  // visible to every transaction. The delta vectors start out empty again.
+  size_t kept_rows = 0;
+  for (size_t i = 0; i + 1 < tables.size(); ++i) {
+    kept_rows += tables[i]->size();
+  }
+  for (auto it = _main_row_states.begin(); it != _main_row_states.end();) {
+    if (it->first >= kept_rows)
+      it = _main_row_states.unsafe_erase(it);
+    else
+      ++it;
+  }
+  setMainChunks(tables);
+  {
+    std::lock_guard<std::mutex> lock(_statistics_mutex);
+    updateMainStatistics();
+  }
 
-  // Fixup the cid and tid vectors
-  _cidBeginVector = tbb::concurrent_vector<tx::transaction_cid_t>(_main_table->size(), tx::UNKNOWN_CID);
-  _cidEndVector = tbb::concurrent_vector<tx::transaction_cid_t>(_main_table->size(), tx::INF_CID);
-  _tidVector = tbb::concurrent_vector<tx::transaction_id_t>(_main_table->size(), tx::START_TID);
+  _cidBeginVector.clear();
+  _cidEndVector.clear();
+  _tidVector.clear();
 
 #ifdef REUSE_MAIN_DICTS
   // copy merged main's dictionaries for delta
   for (size_t column = 0; column < columnCount(); ++column) {
-    const AbstractDictionary* dict = _main_table->dictionaryAt(column).get();
+    const AbstractDictionary* dict = tables.back()->dictionaryAt(column).get();
     switch (typeOfColumn(column)) {
       case IntegerType:
       case IntegerTypeDelta:
       case IntegerTypeDeltaConcurrent:
         // case IntegerNoDictType:
-        new_delta->setDictionaryAt(std::make_shared<ConcurrentUnorderedDictionary<hyrise_int_t>>(
-                                       ((OrderPreservingDictionary<hyrise_int_t>*)dict)->getValueList()),
-                                   column);
+        // frame-of-reference mains have no value list to reuse, their delta starts out empty
+        if (auto ordered = dynamic_cast<const OrderPreservingDictionary<hyrise_int_t>*>(dict))
+          new_delta->setDictionaryAt(
+              std::make_shared<ConcurrentUnorderedDictionary<hyrise_int_t>>(ordered->getValueList()), column);
         break;
       case FloatType:
       case FloatTypeDelta:
@@ -153,13 +214,89 @@ void Store::merge() {
   }
 #endif
 
-  _main_pos_list.clear();
-  _main_pos_list.reserve(_main_table->size());
-  for (size_t i = 0; i < _main_table->size(); i++) {
-    _main_pos_list.push_back(i);
+  // after a merge, _main is clean again (no updates on row in delta) unless kept chunks have deleted rows
+  _main_dirty = !_main_row_states.empty();
+}
+
+void Store::setMainChunks(const std::vector<atable_ptr_t>& chunks) {
+  std::vector<c_atable_ptr_t> parts;
+  for (const auto& chunk : chunks) {
+    if (chunk->size() > 0)
+      parts.push_back(chunk);
+  }
+
+  atable_ptr_t main;
+  if (parts.size() <= 1)
+    main = parts.empty() ? chunks.back() : std::const_pointer_cast<AbstractTable>(parts.front());
+  else
+    main = std::make_shared<HorizontalTable>(parts);
+
+  // place the new main before it is visible, sealed chunks already use the policy and are not moved again
+  if (!_memory_policy.isDefault())
+    main->setMemoryPolicy(_memory_policy);
+  _main_table = main;
+}
+
+void Store::setMemoryPolicy(const helper::MemoryPolicy& policy) {
+  _memory_policy = policy;
+  _main_table->setMemoryPolicy(policy);
+}
+
+void Store::setMainChunkSize(size_t rows) {
+  // main indices map the value ids of a single main dictionary
+  if (!_main_indices.empty())
+    throw std::runtime_error("Store " + getName() + " has main indices, its main cannot be chunked");
+#ifdef PERSISTENCY_BUFFEREDLOGGER
+  // checkpoints persist the main as a single table
+  if (loggingEnabled())
+    throw std::runtime_error("Store " + getName() + " is logged, its main cannot be chunked");
+#endif
+  _main_chunk_size = rows;
+  setMerger(new TableMerger(new ChunkedMergeStrategy(rows), new SequentialHeapMerger, false));
+}
+
+size_t Store::mainChunkCount() const {
+  auto chunked = std::dynamic_pointer_cast<HorizontalTable>(_main_table);
+  return chunked ? chunked->parts().size() : 1;
+}
+
+std::vector<size_t> Store::chunkOffsets() const {
+  std::vector<size_t> offsets{0};
+  if (auto chunked = std::dynamic_pointer_cast<HorizontalTable>(_main_table)) {
+    for (size_t part = 1; part < chunked->parts().size(); ++part)
+      offsets.push_back(offsets.back() + chunked->parts()[part - 1]->size());
   }
-  // after a merge, _main is clean again (no updates on row in delta)
-  _main_dirty = false;
+  offsets.push_back(_main_table->size());
+  return offsets;
+}
+
+std::vector<std::pair<c_atable_ptr_t, std::shared_ptr<const ChunkStatistics>>> Store::mainStatistics() const {
+  std::lock_guard<std::mutex> lock(_statistics_mutex);
+  // only scans mains that were replaced without setMain or a merge
+  updateMainStatistics();
+  return _main_statistics;
+}
+
+void Store::updateMainStatistics() const {
+  std::vector<c_atable_ptr_t> chunks;
+  if (auto chunked = std::dynamic_pointer_cast<HorizontalTable>(_main_table))
+    chunks = chunked->parts();
+  else
+    chunks.push_back(_main_table);
+
+  std::vector<std::pair<c_atable_ptr_t, std::shared_ptr<const ChunkStatistics>>> statistics;
+  for (const auto& chunk : chunks) {
+    auto known = std::find_if(_main_statistics.begin(),
+                              _main_statistics.end(),
+                              [&chunk](const std::pair<c_atable_ptr_t, std::shared_ptr<const ChunkStatistics>>& entry) {
+      return entry.first == chunk;
+    });
+    if (known != _main_statistics.end())
+      statistics.push_back(*known);
+    else
+      statistics.emplace_back(chunk, std::make_shared<ChunkStatistics>(chunk));
+  }
+  _main_statistics.swap(statistics);
 }
 
 atable_ptr_t Store::getMainTable() const { return _main_table; }
@@ -193,7 +330,8 @@ const adict_ptr_t& Store::dictionaryAt(const size_t column, const size_t row, co
 }
 
 const adict_ptr_t& Store::dictionaryByTableId(const size_t column, const table_id_t table_id) const {
-  if (table_id == 0)
+  // the chunks of a chunked main have table ids of their own, the delta comes last
+  if (table_id < _main_table->subtableCount())
     return _main_table->dictionaryByTableId(column, table_id);
   else
     return delta->dictionaryByTableId(column, table_id);
@@ -205,7 +343,7 @@ inline Store::table_offset_idx_t Store::responsibleTable(const size_t row) const
     return {_main_table, row, 0};
   }
   assert(row - offset < delta->size());
-  return {delta, row - offset, 1};
+  return {delta, row - offset, _main_table->subtableCount()};
 }
 
 void Store::setValueId(const size_t column, const size_t row, ValueId vid) {
@@ -216,7 +354,7 @@ void Store::setValueId(const size_t column, const size_t row, ValueId vid) {
 ValueId Store::getValueId(const size_t column, const size_t row) const {
   auto location = responsibleTable(row);
   ValueId valueId = location.table->getValueId(column, location.offset_in_table);
-  valueId.table = location.table_index;
+  valueId.table += location.table_index;
   return valueId;
 }
 
@@ -239,15 +377,18 @@ void Store::setMerger(TableMerger* _merger) {
   merger = _merger;
 }
 
-void Store::setMain(atable_ptr_t main) { _main_table = main; }
+void Store::setMain(atable_ptr_t main) {
+  _main_table = main;
+  std::lock_guard<std::mutex> lock(_statistics_mutex);
+  updateMainStatistics();
+}
 
 void Store::setDelta(atable_ptr_t _delta) {
   delta = _delta;
   _delta_size = delta->size();
-  size_t new_size = this->size();
-  _cidBeginVector.resize(new_size, tx::INF_CID);
-  _cidEndVector.resize(new_size, tx::INF_CID);
-  _tidVector.resize(new_size, tx::START_TID);
+  _cidBeginVector.resize(_delta_size, tx::INF_CID);
+  _cidEndVector.resize(_delta_size, tx::INF_CID);
+  _tidVector.resize(_delta_size, tx::START_TID);
   if (loggingEnabled()) {
     _delta->enableLogging();
   }
@@ -287,37 +428,105 @@ void Store::debugStructure(size_t level) const {
   delta->debugStructure(level + 1);
 }
 
+Store::main_row_state_t& Store::mainRowState(pos_t pos) {
+  return _main_row_states.insert({pos, {tx::START_TID, tx::INF_CID}}).first->second;
+}
+
+tx::transaction_id_t Store::tid(size_t row) const {
+  const size_t main_size = _main_table->size();
+  if (row >= main_size) {
+    return _tidVector[row - main_size];
+  }
+  auto it = _main_row_states.find(row);
+  return it == _main_row_states.end() ? tx::START_TID : it->second.tid;
+}
+
+void Store::setTid(size_t row, tx::transaction_id_t tid) {
+  const size_t main_size = _main_table->size();
+  if (row >= main_size) {
+    _tidVector[row - main_size] = tid;
+  } else if (tid != tx::START_TID || _main_row_states.count(row) > 0) {
+    mainRowState(row).tid = tid;
+  }
+}
+
+tx::transaction_cid_t Store::getBeginCid(size_t row) const {
+  const size_t main_size = _main_table->size();
+  return row >= main_size ? _cidBeginVector[row - main_size] : tx::UNKNOWN_CID;
+}
+
+tx::transaction_cid_t Store::getEndCid(size_t row) const {
+  const size_t main_size = _main_table->size();
+  if (row >= main_size) {
+    return _cidEndVector[row - main_size];
+  }
+  auto it = _main_row_states.find(row);
+  return it == _main_row_states.end() ? tx::INF_CID : it->second.cid_end;
+}
+
+void Store::setBeginCid(size_t row, tx::transaction_cid_t cid) {
+  const size_t main_size = _main_table->size();
+  if (row >= main_size) {
+    _cidBeginVector[row - main_size] = cid;
+  } else if (cid != tx::UNKNOWN_CID) {
+    throw std::runtime_error("Rows of the main partition are visible to every transaction");
+  }
+}
+
+void Store::setEndCid(size_t row, tx::transaction_cid_t cid) {
+  const size_t main_size = _main_table->size();
+  if (row >= main_size) {
+    _cidEndVector[row - main_size] = cid;
+  } else if (cid != tx::INF_CID || _main_row_states.count(row) > 0) {
+    mainRowState(row).cid_end = cid;
+  }
+}
+
+inline bool Store::isVisible(pos_t pos,
+                             size_t main_size,
+                             tx::transaction_cid_t last_commit_id,
+                             tx::transaction_id_t tid) const {
+  if (pos >= main_size) {
+    pos -= main_size;
+    return last_commit_id < _cidEndVector[pos] && (last_commit_id >= _cidBeginVector[pos] || _tidVector[pos] == tid);
+  }
+  auto it = _main_row_states.find(pos);
+  return it == _main_row_states.end() || last_commit_id < it->second.cid_end;
+}
+
 bool Store::isVisibleForTransaction(pos_t pos, tx::transaction_cid_t last_commit_id, tx::transaction_id_t tid) const {
-  return last_commit_id < _cidEndVector[pos] && (last_commit_id >= _cidBeginVector[pos] || _tidVector[pos] == tid);
+  return isVisible(pos, _main_table->size(), last_commit_id, tid);
 }
 
 // This method iterates of the pos list and validates each position
 void Store::validatePositions(pos_list_t& pos, tx::transaction_cid_t last_commit_id, tx::transaction_id_t tid) const {
-  // Make sure we captured all rows
-  // assert(_cidBeginVector.size() == size() && _cidEndVector.size() == size() && _tidVector.size() == size());
-
-  // Pos is nullptr, we should circumvent
-  auto end = std::remove_if(
-      std::begin(pos), std::end(pos), [&](const pos_t& v) { return !isVisibleForTransaction(v, last_commit_id, tid); });
+  const size_t main_size = _main_table->size();
+  auto end = std::remove_if(std::begin(pos), std::end(pos), [&](const pos_t& v) {
+    return !isVisible(v, main_size, last_commit_id, tid);
+  });
 
   if (end != pos.end())
     pos.erase(end, pos.end());
 }
 
 pos_list_t Store::buildValidPositions(tx::transaction_cid_t last_commit_id, tx::transaction_id_t tid) const {
+  const size_t main_size = _main_table->size();
+  const size_t store_size = main_size + _cidBeginVector.size();
   pos_list_t result;
+  result.reserve(store_size);
   if (!_main_dirty) {
-    result.reserve(size());
-    std::copy(_main_pos_list.begin(), _main_pos_list.end(), std::back_inserter(result));
-    for (size_t i = _main_table->size(); i < _cidBeginVector.size(); i++) {
-      if (isVisibleForTransaction(i, last_commit_id, tid))
-        result.push_back(i);
-    }
+    // no row of the main was invalidated, so all of them are visible
+    result.resize(main_size);
+    std::iota(result.begin(), result.end(), 0);
   } else {
-    functional::forEachWithIndex(_cidBeginVector, [&](size_t i, tx::transaction_cid_t v) {
-      if (isVisibleForTransaction(i, last_commit_id, tid))
+    for (size_t i = 0; i < main_size; i++) {
+      if (isVisible(i, main_size, last_commit_id, tid))
         result.push_back(i);
-    });
+    }
+  }
+  for (size_t i = main_size; i < store_size; i++) {
+    if (isVisible(i, main_size, last_commit_id, tid))
+      result.push_back(i);
   }
   return std::move(result);
 }
@@ -338,13 +547,12 @@ std::pair<size_t, size_t> Store::appendToDelta(size_t num_rows) {
 
   delta->resize(prior_delta_size + num_rows);
 
-  auto main_size = _main_table->size();
-  auto new_size = main_size + prior_delta_size + num_rows;
+  auto new_size = prior_delta_size + num_rows;
 
   auto grow_and_fill = [=](tbb::concurrent_vector<tx::transaction_id_t>& vector, tx::transaction_id_t value) {
     vector.grow_to_at_least(new_size);
     // ... we can fill the drawn range without interferring with other threads
-    std::fill(std::begin(vector) + main_size + prior_delta_size, std::begin(vector) + new_size, value);
+    std::fill(std::begin(vector) + prior_delta_size, std::begin(vector) + new_size, value);
   };
   grow_and_fill(_cidBeginVector, tx::INF_CID);
   grow_and_fill(_cidEndVector, tx::INF_CID);
@@ -357,8 +565,6 @@ void Store::copyRowToDelta(const c_atable_ptr_t& source,
                            const size_t src_row,
                            const size_t dst_row,
                            tx::transaction_id_t tid) {
-  auto main_tables_size = _main_table->size();
-
 #ifdef REUSE_MAIN_DICTS
   bool copy_values = source.get() != this;
 #else
@@ -366,13 +572,12 @@ void Store::copyRowToDelta(const c_atable_ptr_t& source,
 #endif
 
   // Update the validity
-  _tidVector[main_tables_size + dst_row] = tid;
+  _tidVector[dst_row] = tid;
 
-// assert((_cidEndVector[main_tables_size + dst_row] == 0));
 #ifdef DEBUG
-  if (_cidEndVector[main_tables_size + dst_row] == 0) {
-    throw std::runtime_error("CID-Vector Not Initialized Error. Details:" + std::to_string(main_tables_size) + " - " +
-                             std::to_string(dst_row) + " - " + std::to_string(this->size()));
+  if (_cidEndVector[dst_row] == 0) {
+    throw std::runtime_error("CID-Vector Not Initialized Error. Details:" + std::to_string(_main_table->size()) +
+                             " - " + std::to_string(dst_row) + " - " + std::to_string(this->size()));
   }
 #endif
 
@@ -382,9 +587,8 @@ void Store::copyRowToDelta(const c_atable_ptr_t& source,
 void Store::copyRowToDeltaFromJSONVector(const std::vector<Json::Value>& source,
                                          size_t dst_row,
                                          tx::transaction_id_t tid) {
-  auto main_tables_size = _main_table->size();
   // Update the validity
-  _tidVector[main_tables_size + dst_row] = tid;
+  _tidVector[dst_row] = tid;
 
   delta->copyRowFromJSONVector(source, dst_row);
 }
@@ -392,23 +596,24 @@ void Store::copyRowToDeltaFromJSONVector(const std::vector<Json::Value>& source,
 void Store::copyRowToDeltaFromStringVector(const std::vector<std::string>& source,
                                            size_t dst_row,
                                            tx::transaction_id_t tid) {
-  auto main_tables_size = _main_table->size();
-
   // Update the validity
-  _tidVector[main_tables_size + dst_row] = tid;
+  _tidVector[dst_row] = tid;
 
   delta->copyRowFromStringVector(source, dst_row);
 }
 
 void Store::commitPositions(const pos_list_t& pos, const tx::transaction_cid_t cid, bool valid) {
+  const size_t main_size = _main_table->size();
   for (const auto& p : pos) {
     if (valid) {
-      _cidBeginVector[p] = cid;
-      _tidVector[p] = tx::START_TID;
+      // only rows of the delta are ever inserted
+      _cidBeginVector[p - main_size] = cid;
+      _tidVector[p - main_size] = tx::START_TID;
+    } else if (p < main_size) {
+      _main_dirty = true;
+      mainRowState(p).cid_end = cid;
     } else {
-      if (p < _main_table->size())
-        _main_dirty = true;
-      _cidEndVector[p] = cid;
+      _cidEndVector[p - main_size] = cid;
     }
   }
 
@@ -418,9 +623,9 @@ void Store::commitPositions(const pos_list_t& pos, const tx::transaction_cid_t c
 void Store::revertPositions(const pos_list_t& pos, bool valid) {
   for (const auto& p : pos) {
     if (valid) {
-      _cidBeginVector[p] = tx::INF_CID;
+      setBeginCid(p, tx::INF_CID);
     } else {
-      _cidEndVector[p] = tx::INF_CID;
+      setEndCid(p, tx::INF_CID);
     }
   }
 
@@ -429,10 +634,10 @@ void Store::revertPositions(const pos_list_t& pos, bool valid) {
 
 tx::TX_CODE Store::checkForConcurrentCommit(const pos_list_t& pos, const tx::transaction_id_t tid) const {
   for (const auto& p : pos) {
-    if (_tidVector[p] != tid) {
+    if (this->tid(p) != tid) {
       return tx::TX_CODE::TX_FAIL_CONCURRENT_COMMIT;
     }
-    if (_cidEndVector[p] != tx::INF_CID) {
+    if (getEndCid(p) != tx::INF_CID) {
       return tx::TX_CODE::TX_FAIL_CONCURRENT_COMMIT;
     }
   }
@@ -440,11 +645,21 @@ tx::TX_CODE Store::checkForConcurrentCommit(const pos_list_t& pos, const tx::tra
 }
 
 tx::TX_CODE Store::markForDeletion(const pos_t pos, const tx::transaction_id_t tid) {
-  if (atomic_cas(&_tidVector[pos], tx::START_TID, tid)) {
+  const size_t main_size = _main_table->size();
+  if (pos < main_size) {
+    // a main row locked by another transaction keeps its state, an entry is only
+    // created for the row we are about to lock
+    auto it = _main_row_states.find(pos);
+    if (it != _main_row_states.end() && it->second.tid != tx::START_TID && it->second.tid != tid)
+      return tx::TX_CODE::TX_FAIL_CONCURRENT_COMMIT;
+  }
+
+  auto& row_tid = pos < main_size ? mainRowState(pos).tid : _tidVector[pos - main_size];
+  if (atomic_cas(&row_tid, tx::START_TID, tid)) {
     return tx::TX_CODE::TX_OK;
   }
 
-  if (_tidVector[pos] == tid && _cidEndVector[pos] == tx::INF_CID) {
+  if (row_tid == tid && getEndCid(pos) == tx::INF_CID) {
     // It is a row that we inserted ourselves. So we leave it as it is.
     // No need for a CAS here since we already have it "locked"
     // WARNING:
@@ -458,8 +673,8 @@ tx::TX_CODE Store::markForDeletion(const pos_t pos, const tx::transaction_id_t t
 
 tx::TX_CODE Store::unmarkForDeletion(const pos_list_t& pos, const tx::transaction_id_t tid) {
   for (const auto& p : pos) {
-    if (_tidVector[p] == tid)
-      _tidVector[p] = tx::START_TID;
+    if (this->tid(p) == tid)
+      setTid(p, tx::START_TID);
   }
   return tx::TX_CODE::TX_OK;
 }
@@ -468,6 +683,8 @@ tx::TX_CODE Store::unmarkForDeletion(const pos_list_t& pos, const tx::transactio
 void Store::persist_scattered(const pos_list_t& elements, bool new_elements) const {}
 
 void Store::addMainIndex(std::shared_ptr<AbstractIndex> index, std::vector<field_t> columns) {
+  if (_main_chunk_size > 0)
+    throw std::runtime_error("Store " + getName() + " has a chunked main, which cannot be indexed");
   _index_lock.lock();
   _main_indices.push_back(std::make_pair(index, columns));
   _index_lock.unlock();
@@ -492,24 +709,29 @@ void Store::clearIndices() {
 
   _main_indices.clear();
   _delta_indices.clear();
-
-  _index_lock.unlock();
 }
 
-struct AddValueToDeltaIndexFunctor {
+struct AddValuesToDeltaIndexFunctor {
   typedef bool value_type;
 
   c_atable_ptr_t _delta;
   std::shared_ptr<AbstractIndex> _index;
-  pos_t _row, _row_offset;
+  pos_t _first_row, _row_offset;
+  size_t _row_count;
   size_t _column;
 
-  AddValueToDeltaIndexFunctor(c_atable_ptr_t delta,
-                              std::shared_ptr<AbstractIndex> index,
-                              pos_t row,
-                              pos_t row_offset,
-                              size_t column)
-      : _delta(delta), _index(index), _row(row), _row_offset(row_offset), _column(column) {}
+  AddValuesToDeltaIndexFunctor(c_atable_ptr_t delta,
+                               std::shared_ptr<AbstractIndex> index,
+                               pos_t first_row,
+                               size_t row_count,
+                               pos_t row_offset,
+                               size_t column)
+      : _delta(delta),
+        _index(index),
+        _first_row(first_row),
+        _row_offset(row_offset),
+        _row_count(row_count),
+        _column(column) {}
 
   template <typename ValueType>
   value_type operator()() {
@@ -517,39 +739,48 @@ struct AddValueToDeltaIndexFunctor {
     if (!idx)
       throw std::runtime_error("Index on delta of store needs to be of type DeltaIndex");
 
-    ValueType value = _delta->getValue<ValueType>(_column, _row - _row_offset);
-    idx->write_lock();
-    idx->add(value, _row);
-    idx->unlock();
+    for (pos_t row = _first_row; row < _first_row + _row_count; ++row) {
+      idx->add(_delta->getValue<ValueType>(_column, row - _row_offset), row);
+    }
     return true;
   }
 };
 
-void Store::addRowToDeltaIndices(pos_t row) {
-  // iterate over all delta indices of the store
-  // and add the respective new values of the row
+void Store::addRowToDeltaIndices(pos_t row) { addRowsToDeltaIndices(row, 1); }
 
-  // TODO: needs to makesure index vector is not modfied during iterating over it
+void Store::addRowsToDeltaIndices(pos_t first_row, size_t row_count) {
+  // iterate over all delta indices of the store
+  // and add the respective new values of the rows
+
+  // work on a snapshot, indices may be added concurrently. The lock is
+  // taken once per batch, not once per row.
+  std::vector<std::pair<std::shared_ptr<AbstractIndex>, std::vector<field_t>>> delta_indices;
+  {
+    std::lock_guard<locking::Spinlock> indexLock(_index_lock);
+    if (_delta_indices.empty())
+      return;
+    delta_indices = _delta_indices;
+  }
 
-  for (auto index_column_pair : _delta_indices) {
-    auto index = index_column_pair.first;
-    auto columns = index_column_pair.second;
-    storage::type_switch<hyrise_basic_types> ts;
+  auto delta_table = getDeltaTable();
+  const pos_t main_size = _main_table->size();
+  storage::type_switch<hyrise_basic_types> ts;
+  for (const auto& index_column_pair : delta_indices) {
+    const auto& index = index_column_pair.first;
+    const auto& columns = index_column_pair.second;
     if (columns.size() == 1) {
-      AddValueToDeltaIndexFunctor functor(getDeltaTable(), index, row, _main_table->size(), columns[0]);
-
+      AddValuesToDeltaIndexFunctor functor(delta_table, index, first_row, row_count, main_size, columns[0]);
       ts(typeOfColumn(columns[0]), functor);
     } else {
-      CompoundValueKeyBuilder builder;
-      for (auto column : columns) {
-        AddValueToCompoundKeyFunctor functor(builder, getDeltaTable().get(), row - _main_table->size(), column);
-        ts(typeOfColumn(column), functor);
-      }
-
       auto delta_index = std::dynamic_pointer_cast<DeltaIndex<compound_value_key_t>>(index);
-      delta_index->write_lock();
-      delta_index->add(builder.get(), row);
-      delta_index->unlock();
+      for (pos_t row = first_row; row < first_row + row_count; ++row) {
+        CompoundValueKeyBuilder builder;
+        for (auto column : columns) {
+          AddValueToCompoundKeyFunctor functor(builder, delta_table.get(), row - main_size, column);
+          ts(typeOfColumn(column), functor);
+        }
+        delta_index->add(builder.get(), row);
+      }
     }
   }
 }
@@ -571,6 +802,10 @@ const std::vector<std::pair<std::shared_ptr<AbstractIndex>, std::vector<field_t>
 }
 
 void Store::enableLogging() {
+#ifdef PERSISTENCY_BUFFEREDLOGGER
+  if (_main_chunk_size > 0)
+    throw std::runtime_error("Store " + getName() + " has a chunked main, which cannot be logged");
+#endif
   logging = true;
   _main_table->enableLogging();
   delta->enableLogging();
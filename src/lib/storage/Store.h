@@ -9,6 +9,7 @@
 #pragma once
 
 #include <map>
+#include <mutex>
 #include <set>
 
 #include <storage/MutableVerticalTable.h>
@@ -17,6 +18,7 @@
 #include <storage/AbstractMergeStrategy.h>
 #include <storage/SequentialHeapMerger.h>
 #include <storage/PrettyPrinter.h>
+#include <storage/TableStatistics.h>
 
 #include <helper/types.h>
 #include "helper/locking.h"
@@ -24,6 +26,7 @@
 #include <json.h>
 
 
+#include "tbb/concurrent_unordered_map.h"
 #include "tbb/concurrent_vector.h"
 
 namespace hyrise {
@@ -53,6 +56,20 @@ class Store : public AbstractTable {
   /// @param _merger Pointer to a merger instance.
   void setMerger(TableMerger* _merger);
 
+  /// Keeps the main as a list of chunks of at least the given number of
+  /// rows. Merges then only compact the delta with the last, not yet full
+  /// chunk instead of rewriting the whole main. Throws for stores with main
+  /// indices and, with the buffered logger, for logged stores.
+  void setMainChunkSize(size_t rows);
+  size_t mainChunkCount() const;
+  /// First row of every main chunk followed by the first row of the delta
+  std::vector<size_t> chunkOffsets() const;
+
+  /// The main chunks with their statistics. The statistics are computed
+  /// when the store is created with its main, by setMain and by every merge
+  /// for the chunks it produces, kept chunks keep theirs.
+  std::vector<std::pair<c_atable_ptr_t, std::shared_ptr<const ChunkStatistics>>> mainStatistics() const;
+
   /// Resize the current delta size atomically to new size and return
   /// a pair of start and end for the resized delta that can be used
   /// as a write area that is safe to use
@@ -75,8 +92,8 @@ class Store : public AbstractTable {
   void revertPositions(const pos_list_t& pos, bool valid);
 
   // TID handling
-  inline tx::transaction_id_t tid(size_t row) const { return _tidVector[row]; }
-  inline void setTid(size_t row, tx::transaction_id_t tid) { _tidVector[row] = tid; }
+  tx::transaction_id_t tid(size_t row) const;
+  void setTid(size_t row, tx::transaction_id_t tid);
   tx::TX_CODE checkForConcurrentCommit(const pos_list_t& pos, tx::transaction_id_t tid) const;
   tx::TX_CODE markForDeletion(pos_t pos, tx::transaction_id_t tid);
   tx::TX_CODE unmarkForDeletion(const pos_list_t& pos, tx::transaction_id_t tid);
@@ -96,14 +113,18 @@ class Store : public AbstractTable {
   unsigned partitionCount() const override;
   size_t partitionWidth(size_t slice) const override;
   void print(size_t limit = (size_t) - 1) const override;
-  table_id_t subtableCount() const override { return 2; }
+  table_id_t subtableCount() const override { return _main_table->subtableCount() + 1; }
   atable_ptr_t copy() const override;
   const attr_vectors_t getAttributeVectors(size_t column) const override;
   void debugStructure(size_t level = 0) const override;
+  // Only applies to the main, merged mains inherit the policy
+  void setMemoryPolicy(const helper::MemoryPolicy& policy) override;
   void persist_scattered(const pos_list_t& elements, bool new_elements = true) const override;
   void addMainIndex(std::shared_ptr<AbstractIndex> index, std::vector<size_t> columns);
   void addDeltaIndex(std::shared_ptr<AbstractIndex> index, std::vector<size_t> columns);
   void addRowToDeltaIndices(pos_t row);
+  // Adds the consecutive rows [first_row, first_row + row_count) to all delta indices
+  void addRowsToDeltaIndices(pos_t first_row, size_t row_count);
   std::vector<std::vector<size_t>> getIndexedColumns() const;
   const std::vector<std::pair<std::shared_ptr<AbstractIndex>, std::vector<field_t>>>& getMainIndices() const;
   const std::vector<std::pair<std::shared_ptr<AbstractIndex>, std::vector<field_t>>>& getDeltaIndices() const;
@@ -112,26 +133,13 @@ class Store : public AbstractTable {
   virtual void enableLogging();
   virtual void setName(const std::string name);
 
-  tx::transaction_cid_t getBeginCid(size_t row) {
-    return _cidBeginVector[row];
-  };
-  tx::transaction_cid_t getEndCid(size_t row) {
-    return _cidEndVector[row];
-  };
-  void setBeginCid(size_t row, tx::transaction_cid_t cid) {
-    _cidBeginVector[row] = cid;
-  };
-  void setEndCid(size_t row, tx::transaction_cid_t cid) {
-    _cidEndVector[row] = cid;
-  };
-
-
-
-  tbb::concurrent_vector<tx::transaction_cid_t>::iterator cidBeginIteratorForRecovery() {
-    return _cidBeginVector.begin();
-  }
-  tbb::concurrent_vector<tx::transaction_cid_t>::iterator cidEndIteratorForRecovery() { return _cidEndVector.begin(); }
+  tx::transaction_cid_t getBeginCid(size_t row) const;
+  tx::transaction_cid_t getEndCid(size_t row) const;
+  void setBeginCid(size_t row, tx::transaction_cid_t cid);
+  void setEndCid(size_t row, tx::transaction_cid_t cid);
 
+  /// Number of main rows with their own MVCC entry
+  size_t mainRowStateCount() const { return _main_row_states.size(); }
 
   size_t checkpointSize() {
     return _checkpoint_size;
@@ -160,6 +168,9 @@ class Store : public AbstractTable {
   //* checkpointing housekeeping
   size_t _checkpoint_size;
 
+  //* Minimal rows of a main chunk, 0 if the main is not chunked
+  size_t _main_chunk_size = 0;
+
   //* Indices for the Store
   std::vector<std::pair<std::shared_ptr<AbstractIndex>, std::vector<field_t>>> _main_indices, _delta_indices;
   locking::Spinlock _index_lock;
@@ -171,7 +182,31 @@ class Store : public AbstractTable {
   } table_offset_idx_t;
   table_offset_idx_t responsibleTable(size_t row) const;
 
+  // Uses the merged tables as main, more than one become the chunks of a HorizontalTable
+  void setMainChunks(const std::vector<atable_ptr_t>& chunks);
+
+  // Matches the statistics to the current main chunks, requires _statistics_mutex
+  void updateMainStatistics() const;
+  mutable std::mutex _statistics_mutex;
+  mutable std::vector<std::pair<c_atable_ptr_t, std::shared_ptr<const ChunkStatistics>>> _main_statistics;
+
+  bool isVisible(pos_t pos,
+                 size_t main_size,
+                 tx::transaction_cid_t last_commit_id,
+                 tx::transaction_id_t tid) const;
+
   // TX Management
+  // Rows of the main are visible to every transaction, their begin CID is
+  // UNKNOWN_CID. Main rows only get an entry in _main_row_states once they
+  // are locked or deleted, all others are valid with START_TID and INF_CID.
+  struct main_row_state_t {
+    tx::transaction_id_t tid;
+    tx::transaction_cid_t cid_end;
+  };
+  tbb::concurrent_unordered_map<pos_t, main_row_state_t> _main_row_states;
+  main_row_state_t& mainRowState(pos_t pos);
+
+  // Dense vectors for the delta, indexed by the position in the delta
   // _cidBeginVector stores the CID of the transaction that created the row
   // _cidEndVector stores the CID of the transaction that deleted the row
   tbb::concurrent_vector<tx::transaction_id_t> _cidBeginVector;
@@ -181,10 +216,8 @@ class Store : public AbstractTable {
   tbb::concurrent_vector<tx::transaction_id_t> _tidVector;
 
   friend class PrettyPrinter;
-  // main table pos_list
-  pos_list_t _main_pos_list;
   // flag if main was updated
-  bool _main_dirty;
+  bool _main_dirty = false;
 };
 }
 }
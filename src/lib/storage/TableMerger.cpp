@@ -1,6 +1,7 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "storage/TableMerger.h"
 
+#include <algorithm>
 #include <cassert>
 
 #include "storage/AbstractMerger.h"
@@ -18,6 +19,22 @@ column_mapping_t identityMap(atable_ptr_t input) {
   return map;
 }
 
+namespace {
+// The merger only sees the tables to merge, so it only gets their part of the valid vector
+std::vector<bool> validOfTables(const std::vector<c_atable_ptr_t>& input_tables,
+                                const std::vector<c_atable_ptr_t>& selected_tables,
+                                const std::vector<bool>& valid) {
+  std::vector<bool> result;
+  size_t offset = 0;
+  for (const auto& table : input_tables) {
+    if (std::find(selected_tables.begin(), selected_tables.end(), table) != selected_tables.end())
+      result.insert(result.end(), valid.begin() + offset, valid.begin() + offset + table->size());
+    offset += table->size();
+  }
+  return result;
+}
+}
+
 std::vector<atable_ptr_t> TableMerger::mergeToTable(atable_ptr_t dest,
                                                     std::vector<c_atable_ptr_t>& input_tables,
                                                     bool useValid,
@@ -40,6 +57,9 @@ std::vector<atable_ptr_t> TableMerger::mergeToTable(atable_ptr_t dest,
   for (const auto& tab : tables.tables_not_to_merge)
     result.push_back(std::const_pointer_cast<AbstractTable>(tab));
 
+  if (useValid && !tables.tables_not_to_merge.empty())
+    valid = validOfTables(input_tables, tables.tables_to_merge, valid);
+
   if (tables.tables_to_merge.size() > 0) {
     // copy metadata
     auto mapping = calculateMapping(tables.tables_to_merge.front(), dest);
@@ -71,14 +91,18 @@ std::vector<atable_ptr_t> TableMerger::merge(std::vector<c_atable_ptr_t>& input_
   }
 
   merge_tables tables = _strategy->determineTablesToMerge(input_tables);
-  assert(tables.tables_to_merge.size() != 1);
+  // a single table is only merged on its own to turn it into a main next to the tables that are kept
+  assert(tables.tables_to_merge.size() != 1 || !tables.tables_not_to_merge.empty());
 
   // Prepare modifiable output vector
   std::vector<atable_ptr_t> result;
   for (const auto& tab : tables.tables_not_to_merge)
     result.push_back(std::const_pointer_cast<AbstractTable>(tab));
 
-  if (tables.tables_to_merge.size() > 1) {
+  if (useValid && !tables.tables_not_to_merge.empty())
+    valid = validOfTables(input_tables, tables.tables_to_merge, valid);
+
+  if (!tables.tables_to_merge.empty()) {
 
     // calculate new size - insert only
     size_t new_size = _strategy->calculateNewSize(tables.tables_to_merge, useValid, valid);
@@ -0,0 +1,119 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "storage/TableStatistics.h"
+
+#include "storage/HorizontalTable.h"
+#include "storage/Store.h"
+
+namespace hyrise {
+namespace storage {
+
+const size_t ChunkStatistics::kHistogramBuckets;
+
+ChunkStatistics::ChunkStatistics(const c_atable_ptr_t& chunk) : _rows(chunk->size()), _columns(chunk->columnCount()) {
+  for (size_t column = 0; column < _columns.size(); ++column) {
+    ColumnStatistics& statistics = _columns[column];
+    statistics.distinct = _rows;
+
+    std::vector<size_t> counts;
+    try {
+      const auto& dict = chunk->dictionaryAt(column);
+      if (!dict)
+        continue;
+      statistics.distinct = dict->size();
+      if (!dict->isOrdered() || _rows == 0)
+        continue;
+
+      counts.resize(statistics.distinct, 0);
+      for (size_t row = 0; row < _rows; ++row) {
+        value_id_t value_id = chunk->getValueId(column, row).valueId;
+        if (value_id >= counts.size())
+          throw std::out_of_range("value id outside of dictionary");
+        ++counts[value_id];
+      }
+    } catch (const std::exception&) {
+      // columns without dictionary only report their size
+      continue;
+    }
+
+    // every bucket ends at the value id that fills it up to its share of the rows
+    size_t buckets = std::min(kHistogramBuckets, _rows);
+    size_t rows_seen = 0;
+    bool first = true;
+    for (value_id_t value_id = 0; value_id < counts.size(); ++value_id) {
+      if (counts[value_id] == 0)
+        continue;
+      if (first) {
+        statistics.min = value_id;
+        first = false;
+      }
+      statistics.max = value_id;
+      rows_seen += counts[value_id];
+      while (statistics.histogram.size() < buckets && rows_seen * buckets >= (statistics.histogram.size() + 1) * _rows)
+        statistics.histogram.push_back(value_id);
+    }
+  }
+}
+
+double ChunkStatistics::rowsBelow(size_t column, value_id_t value_id) const {
+  const ColumnStatistics& statistics = _columns.at(column);
+  if (statistics.histogram.empty())
+    return _rows / 2.0;
+  if (value_id <= statistics.min)
+    return 0;
+  if (value_id > statistics.max)
+    return _rows;
+
+  // buckets ending below the value id are fully counted, the rows of the bucket containing it
+  // are assumed to be spread evenly over its value ids
+  const auto& histogram = statistics.histogram;
+  size_t full_buckets = std::lower_bound(histogram.begin(), histogram.end(), value_id) - histogram.begin();
+  double first = (full_buckets == 0) ? statistics.min : histogram[full_buckets - 1] + 1.0;
+  double last = histogram[full_buckets];
+  double part = (value_id - first) / (last - first + 1.0);
+  double rows_per_bucket = static_cast<double>(_rows) / histogram.size();
+  return std::min<double>(_rows, (full_buckets + part) * rows_per_bucket);
+}
+
+
+TableStatistics::TableStatistics(const c_atable_ptr_t& table) : _table(table) {
+  if (auto store = std::dynamic_pointer_cast<const Store>(table)) {
+    for (const auto& chunk : store->mainStatistics()) {
+      _chunk_tables.push_back(chunk.first);
+      _chunks.push_back(chunk.second);
+    }
+    _delta = store->getDeltaTable();
+    return;
+  }
+
+  if (auto chunked = std::dynamic_pointer_cast<const HorizontalTable>(table))
+    _chunk_tables = chunked->parts();
+  else
+    _chunk_tables.push_back(table);
+  for (const auto& chunk : _chunk_tables)
+    _chunks.push_back(std::make_shared<ChunkStatistics>(chunk));
+}
+
+size_t TableStatistics::rows() const { return _table->size(); }
+
+size_t TableStatistics::deltaRows() const { return _delta ? _delta->size() : 0; }
+
+size_t TableStatistics::deltaDistinct(size_t column) const {
+  if (!_delta)
+    return 0;
+  try {
+    return _delta->dictionaryAt(column)->size();
+  } catch (const std::exception&) {
+    return deltaRows();
+  }
+}
+
+double TableStatistics::distinctValues(size_t column) const {
+  // chunks have dictionaries of their own, so a value may be counted once per chunk; the delta
+  // dictionary starts out with the values of the main and adds at most one value per row
+  double distinct = std::min(deltaDistinct(column), deltaRows());
+  for (const auto& chunk : _chunks)
+    distinct += chunk->column(column).distinct;
+  return std::max(1.0, std::min<double>(distinct, rows()));
+}
+}
+}
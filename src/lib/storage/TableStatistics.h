@@ -0,0 +1,99 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+/** @file TableStatistics.h
+ *
+ * Contains the statistics used to estimate the cardinality of predicates
+ * and joins.
+ */
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "helper/checked_cast.h"
+#include "storage/AbstractTable.h"
+#include "storage/BaseDictionary.h"
+#include "storage/storage_types.h"
+
+namespace hyrise {
+namespace storage {
+
+/// Statistics of one column of a main chunk. Main dictionaries are
+/// ordered, so value ids compare like the values they stand for.
+struct ColumnStatistics {
+  /// Number of values in the dictionary
+  size_t distinct = 0;
+  /// Smallest and largest value id in use, only valid if histogram is not empty
+  value_id_t min = 0;
+  value_id_t max = 0;
+  /// Largest value id of each equi-depth bucket, every bucket holds about
+  /// the same number of rows. Empty for unordered or missing dictionaries.
+  std::vector<value_id_t> histogram;
+};
+
+/// Statistics of a main chunk. Mains don't change until the next merge,
+/// so the statistics are computed once per chunk.
+class ChunkStatistics {
+ public:
+  static const size_t kHistogramBuckets = 32;
+
+  explicit ChunkStatistics(const c_atable_ptr_t& chunk);
+
+  size_t rows() const { return _rows; }
+  const ColumnStatistics& column(size_t column) const { return _columns.at(column); }
+
+  /// Estimated number of rows whose value id is smaller than value_id
+  double rowsBelow(size_t column, value_id_t value_id) const;
+
+ private:
+  size_t _rows;
+  std::vector<ColumnStatistics> _columns;
+};
+
+/// Statistics of a table: the statistics of its main chunks and the size
+/// and dictionaries of the delta, which grow with every insert. Stores
+/// keep the statistics of their main chunks, other tables are treated as
+/// main chunks whose statistics are computed when the object is created.
+class TableStatistics {
+ public:
+  explicit TableStatistics(const c_atable_ptr_t& table);
+
+  size_t rows() const;
+  size_t deltaRows() const;
+  size_t chunkCount() const { return _chunks.size(); }
+  const ChunkStatistics& chunk(size_t index) const { return *_chunks.at(index); }
+
+  /// Number of values in the delta dictionary of a column
+  size_t deltaDistinct(size_t column) const;
+
+  /// Upper bound of the distinct values of a column in main and delta
+  double distinctValues(size_t column) const;
+
+  /// Estimated fraction of rows whose value is smaller than value, or
+  /// smaller or equal if inclusive is set. The delta is assumed to share
+  /// the distribution of the main. Returns a negative value if the main
+  /// has no histogram for the column.
+  template <typename T>
+  double fractionBelow(size_t column, const T& value, bool inclusive) const {
+    double main_rows = 0;
+    double rows_below = 0;
+    for (size_t i = 0; i < _chunks.size(); ++i) {
+      if (_chunks[i]->column(column).histogram.empty())
+        continue;
+      const auto& dict = checked_pointer_cast<BaseDictionary<T>>(_chunk_tables[i]->dictionaryAt(column));
+      value_id_t bound =
+          inclusive ? dict->getUpperBoundValueIdForValue(value) : dict->getLowerBoundValueIdForValue(value);
+      main_rows += _chunks[i]->rows();
+      rows_below += _chunks[i]->rowsBelow(column, bound);
+    }
+    return (main_rows > 0) ? rows_below / main_rows : -1.0;
+  }
+
+ private:
+  c_atable_ptr_t _table;
+  c_atable_ptr_t _delta;
+  std::vector<c_atable_ptr_t> _chunk_tables;
+  std::vector<std::shared_ptr<const ChunkStatistics> > _chunks;
+};
+}
+}
@@ -2,6 +2,10 @@
 #include "storage/TableUtils.h"
 
 #include "storage/AbstractTable.h"
+#include "storage/MutableVerticalTable.h"
+#include "storage/RunLengthVector.h"
+#include "storage/Store.h"
+#include "storage/Table.h"
 
 namespace hyrise {
 namespace storage {
@@ -18,5 +22,16 @@ column_mapping_t calculateMapping(const AbstractTable& input, const AbstractTabl
   }
   return map;
 }
+std::shared_ptr<RunLengthVector<value_id_t>> leadingRunLengthVector(const AbstractTable& table, size_t column) {
+  // Only these tables map their rows directly onto their attribute vectors
+  if (dynamic_cast<const Table*>(&table) == nullptr && dynamic_cast<const MutableVerticalTable*>(&table) == nullptr &&
+      dynamic_cast<const Store*>(&table) == nullptr)
+    return nullptr;
+
+  const auto& vectors = table.getAttributeVectors(column);
+  if (vectors.empty())
+    return nullptr;
+  return std::dynamic_pointer_cast<RunLengthVector<value_id_t>>(vectors.front().attribute_vector);
+}
 }
 }
@@ -4,9 +4,13 @@
 #include <memory>
 #include <unordered_map>
 
+#include "helper/types.h"
+
 namespace hyrise {
 namespace storage {
 class AbstractTable;
+template <typename T>
+class RunLengthVector;
 
 typedef std::unordered_map<size_t, size_t> column_mapping_t;
 
@@ -14,5 +18,9 @@ column_mapping_t calculateMapping(const std::shared_ptr<const AbstractTable>& in
                                   const std::shared_ptr<const AbstractTable>& dest);
 
 column_mapping_t calculateMapping(const AbstractTable& input, const AbstractTable& dest);
+
+// Returns the run-length encoded vector holding the first rows of column,
+// e.g. those of the main of a store, or nullptr if the column is not stored that way
+std::shared_ptr<RunLengthVector<value_id_t>> leadingRunLengthVector(const AbstractTable& table, size_t column);
 }
 }
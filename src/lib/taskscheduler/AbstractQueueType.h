@@ -3,6 +3,7 @@
 #pragma once
 
 #include <tbb/concurrent_priority_queue.h>
+#include <atomic>
 #include <memory>
 #include "helper/not_implemented.h"
 #include "Task.h"
@@ -26,5 +27,11 @@ class AbstractQueueType {
   // currently not used
   virtual size_t size() = 0;
 };
+
+// Counter of the high priority tasks waiting in a queue, nullptr for queues that do not prioritize
+template <class Queue>
+inline const std::atomic<size_t>* waitingHighPriorityTasks(const Queue&) {
+  return nullptr;
+}
 }
 }
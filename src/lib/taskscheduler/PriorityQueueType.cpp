@@ -3,8 +3,19 @@
 #include "PriorityQueueType.h"
 namespace hyrise {
 namespace taskscheduler {
-void PriorityQueueType::push(const std::shared_ptr<Task>& task) { _runQueue.push(task); }
-bool PriorityQueueType::try_pop(std::shared_ptr<Task>& task) { return _runQueue.try_pop(task); }
+void PriorityQueueType::push(const std::shared_ptr<Task>& task) {
+  // running tasks yield while high priority tasks wait
+  if (task->getPriority() <= Task::HIGH_PRIORITY)
+    ++_waitingHighPriorityTasks;
+  _runQueue.push(task);
+}
+bool PriorityQueueType::try_pop(std::shared_ptr<Task>& task) {
+  if (!_runQueue.try_pop(task))
+    return false;
+  if (task->getPriority() <= Task::HIGH_PRIORITY)
+    --_waitingHighPriorityTasks;
+  return true;
+}
 size_t PriorityQueueType::unsafe_size() { return _runQueue.size(); }
 size_t PriorityQueueType::size() { NOT_IMPLEMENTED }
 }
@@ -10,12 +10,20 @@ namespace taskscheduler {
 
 class PriorityQueueType : public AbstractQueueType {
   tbb::concurrent_priority_queue<std::shared_ptr<Task>, CompareTaskPtr> _runQueue;
+  std::atomic<size_t> _waitingHighPriorityTasks{0};
 
  public:
   void push(const std::shared_ptr<Task>& task);
   bool try_pop(std::shared_ptr<Task>& task);
   size_t unsafe_size();
   size_t size();
+
+  // tasks running from this queue yield while high priority tasks wait in it
+  const std::atomic<size_t>& waitingHighPriorityTasks() const { return _waitingHighPriorityTasks; }
 };
+
+inline const std::atomic<size_t>* waitingHighPriorityTasks(const PriorityQueueType& queue) {
+  return &queue.waitingHighPriorityTasks();
+}
 }
 }
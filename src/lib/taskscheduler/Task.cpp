@@ -158,6 +158,16 @@ void Task::setPreferredCore(int core) { _preferredCore = core; }
 
 int Task::getPreferredCore() { return _preferredCore; }
 
+bool Task::runPreemptible(const std::atomic<size_t>* waiting_high_priority_tasks) {
+  _yielded = false;
+  _preemptible = true;
+  _waitingHighPriorityTasks = waiting_high_priority_tasks;
+  (*this)();
+  _waitingHighPriorityTasks = nullptr;
+  _preemptible = false;
+  return !_yielded;
+}
+
 WaitTask::WaitTask() { _finished = false; }
 
 void WaitTask::operator()() {
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <vector>
 #include <memory>
 #include <condition_variable>
@@ -108,6 +109,14 @@ class Task : public TaskDoneObserver, public std::enable_shared_from_this<Task>
   // if true, the DynamicPriorityScheduler will determine the number of instances.
   bool _dynamic = false;
 
+  // high priority tasks waiting in the queue of the scheduler thread that
+  // runs the task, only set while the task runs preemptible
+  const std::atomic<size_t>* _waitingHighPriorityTasks = nullptr;
+  // set while a scheduler that enqueues yielded tasks again runs the task
+  bool _preemptible = false;
+  // set by yield(), the task is not done yet
+  bool _yielded = false;
+
   std::shared_ptr<AbstractTaskScheduler> _scheduler;
 
  public:
@@ -263,6 +272,28 @@ class Task : public TaskDoneObserver, public std::enable_shared_from_this<Task>
   bool isDynamic() { return _dynamic; }
 
   void setScheduler(std::shared_ptr<AbstractTaskScheduler> scheduler) { _scheduler = scheduler; }
+
+  /*
+   * Cooperative yielding: long running tasks process their input in morsels
+   * and check shouldYield() between two morsels. If it returns true, the task
+   * keeps its progress, calls yield() and returns from operator(). The
+   * scheduler then enqueues the task again as its own continuation instead of
+   * notifying its done observers, so waiting high priority tasks run first.
+   */
+  bool shouldYield() const {
+    return _waitingHighPriorityTasks != nullptr && _priority > HIGH_PRIORITY && *_waitingHighPriorityTasks > 0;
+  }
+  // tasks may only yield() while this is true, other callers run them to completion
+  bool isPreemptible() const { return _preemptible; }
+  void yield() { _yielded = true; }
+  bool yielded() const { return _yielded; }
+  /*
+   * runs the task for a scheduler that supports continuations; returns false
+   * if the task yielded and has to be enqueued again. The task yields while
+   * the given counter of its queue reports waiting high priority tasks,
+   * without a counter it runs to completion.
+   */
+  bool runPreemptible(const std::atomic<size_t>* waiting_high_priority_tasks = nullptr);
 };
 
 class CompareTaskPtr {
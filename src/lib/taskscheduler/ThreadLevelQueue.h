@@ -127,9 +127,13 @@ class ThreadLevelQueue : public AbstractTaskScheduler,
       if (_runQueue.try_pop(task)) {
         retries = 0;
         _blocked = true;
-        (*task)();
-        LOG4CXX_DEBUG(_logger, "Executed task " << task->vname());
-        task->notifyDoneObservers();
+        if (task->runPreemptible(waitingHighPriorityTasks(_runQueue))) {
+          LOG4CXX_DEBUG(_logger, "Executed task " << task->vname());
+          task->notifyDoneObservers();
+        } else {
+          // the continuation is queued behind the high priority tasks
+          _runQueue.push(task);
+        }
         _blocked = false;
       } else {
         if (retries++ < 10000) {
@@ -108,9 +108,13 @@ class WSThreadLevelQueue : virtual public ThreadLevelQueue<QUEUE> {
       }
       if (task) {
         retries = 0;
-        (*task)();
-        LOG4CXX_DEBUG(_logger, "Executed task " << task->vname());
-        task->notifyDoneObservers();
+        if (task->runPreemptible(waitingHighPriorityTasks(_runQueue))) {
+          LOG4CXX_DEBUG(_logger, "Executed task " << task->vname());
+          task->notifyDoneObservers();
+        } else {
+          // the continuation is queued behind the high priority tasks
+          _runQueue.push(task);
+        }
       }
     }
   }